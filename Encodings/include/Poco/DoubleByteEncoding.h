@@ -20,6 +20,9 @@
 
 #include "Poco/Encodings.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/Mutex.h"
+#include <atomic>
+#include <vector>
 
 
 namespace Poco {
@@ -37,6 +40,13 @@ class Encodings_API DoubleByteEncoding: public TextEncoding
 	/// Subclasses must provide encoding names, a static CharacterMap, as well
 	/// as static Mapping and reverse Mapping tables, and provide these to the
 	/// DoubleByteEncoding constructor.
+	///
+	/// On first use, the mapping tables are expanded into two-level
+	/// lookup tables, indexed by the high and low byte of the
+	/// encoded character or Unicode code point, respectively.
+	/// Constructing a DoubleByteEncoding is therefore cheap, and
+	/// the memory for the lookup tables is only allocated for
+	/// encodings that are actually used.
 {
 public:
 	struct Mapping
@@ -54,6 +64,17 @@ public:
 	int queryConvert(const unsigned char* bytes, int length) const;
 	int sequenceLength(const unsigned char* bytes, int length) const;
 
+	int convert(const char* bytes, std::size_t length, std::string& utf8, int defaultChar = '?') const;
+		/// Converts length bytes of text in this encoding to UTF-8,
+		/// and appends the result to utf8.
+		///
+		/// Malformed or unmappable byte sequences are replaced
+		/// with defaultChar. Returns the number of such sequences.
+		///
+		/// This gives the same result as a TextConverter from this
+		/// encoding to UTF8Encoding, but is considerably faster, as it
+		/// does not go through virtual function calls for every character.
+
 protected:
 	DoubleByteEncoding(const char** names, const TextEncoding::CharacterMap& charMap, const Mapping mappingTable[], std::size_t mappingTableSize, const Mapping reverseMappingTable[], std::size_t reverseMappingTableSize);
 		/// Creates a DoubleByteEncoding using the given mapping and reverse-mapping tables.
@@ -107,12 +128,27 @@ protected:
 private:
 	DoubleByteEncoding();
 
+	void buildTables() const;
+		/// Builds the lookup tables from the mapping tables.
+
+	const UInt16* tables() const;
+		/// Returns the lookup tables, building them if necessary.
+
+	enum
+	{
+		UNMAPPED = 0xFFFF /// Lookup table entry for characters that cannot be mapped.
+	};
+
 	const char** _names;
 	const TextEncoding::CharacterMap& _charMap;
 	const Mapping* _mappingTable;
 	const std::size_t _mappingTableSize;
 	const Mapping* _reverseMappingTable;
 	const std::size_t _reverseMappingTableSize;
+
+	mutable std::vector<UInt16> _tables;
+	mutable std::atomic<bool> _tablesReady;
+	mutable FastMutex _mutex;
 };
 
 
@@ -14,7 +14,6 @@
 
 #include "Poco/DoubleByteEncoding.h"
 #include "Poco/String.h"
-#include <algorithm>
 
 
 namespace Poco {
@@ -26,7 +25,8 @@ DoubleByteEncoding::DoubleByteEncoding(const char* names[], const TextEncoding::
 	_mappingTable(mappingTable),
 	_mappingTableSize(mappingTableSize),
 	_reverseMappingTable(reverseMappingTable),
-	_reverseMappingTableSize(reverseMappingTableSize)
+	_reverseMappingTableSize(reverseMappingTableSize),
+	_tablesReady(false)
 {
 }
 
@@ -132,36 +132,152 @@ int DoubleByteEncoding::sequenceLength(const unsigned char* bytes, int length) c
 }
 
 
-struct MappingLessThan
+namespace
 {
-	bool operator () (const DoubleByteEncoding::Mapping& mapping, const Poco::UInt16& key) const
+	inline char* writeUTF8(int ch, char* out)
 	{
-		return mapping.from < key;
+		if (ch < 0x80)
+		{
+			*out++ = static_cast<char>(ch);
+		}
+		else if (ch < 0x800)
+		{
+			*out++ = static_cast<char>(0xC0 | (ch >> 6));
+			*out++ = static_cast<char>(0x80 | (ch & 0x3F));
+		}
+		else if (ch < 0x10000)
+		{
+			*out++ = static_cast<char>(0xE0 | (ch >> 12));
+			*out++ = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+			*out++ = static_cast<char>(0x80 | (ch & 0x3F));
+		}
+		else
+		{
+			*out++ = static_cast<char>(0xF0 | (ch >> 18));
+			*out++ = static_cast<char>(0x80 | ((ch >> 12) & 0x3F));
+			*out++ = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+			*out++ = static_cast<char>(0x80 | (ch & 0x3F));
+		}
+		return out;
+	}
+
+
+	const std::size_t FORWARD_INDEX = 0;
+	const std::size_t REVERSE_INDEX = 256;
+	const std::size_t BLOCKS = 512;
+
+
+	inline Poco::UInt16 lookup(const Poco::UInt16* tables, std::size_t index, Poco::UInt16 key)
+	{
+		return tables[BLOCKS + (tables[index + (key >> 8)] << 8) + (key & 0xFF)];
 	}
-};
+}
+
+
+int DoubleByteEncoding::convert(const char* bytes, std::size_t length, std::string& utf8, int defaultChar) const
+{
+	const UInt16* t = tables();
+	const unsigned char* it = reinterpret_cast<const unsigned char*>(bytes);
+	const unsigned char* end = it + length;
+	std::string::size_type offset = utf8.size();
+	utf8.resize(offset + (defaultChar < 0x10000 ? 3 : 4)*length);
+	char* out = &utf8[0] + offset;
+	int errors = 0;
+	while (it < end)
+	{
+		int ch = _charMap[*it];
+		if (ch >= 0)
+		{
+			++it;
+		}
+		else if (ch == -2 && end - it >= 2)
+		{
+			UInt16 uc = lookup(t, FORWARD_INDEX, static_cast<UInt16>((it[0] << 8) | it[1]));
+			ch = uc == UNMAPPED ? -1 : uc;
+			it += 2;
+		}
+		else if (ch == -2)
+		{
+			it = end;
+		}
+		else
+		{
+			++it;
+		}
+		if (ch < 0)
+		{
+			ch = defaultChar;
+			++errors;
+		}
+		out = writeUTF8(ch, out);
+	}
+	utf8.resize(out - utf8.data());
+	return errors;
+}
 
 
 int DoubleByteEncoding::map(Poco::UInt16 encoded) const
 {
-	const Mapping* begin = _mappingTable;
-	const Mapping* end = begin + _mappingTableSize;
-	const Mapping* it = std::lower_bound(begin, end, encoded, MappingLessThan());
-	if (it != end && it->from == encoded)
-		return it->to;
-	else
-		return -1;
+	UInt16 ch = lookup(tables(), FORWARD_INDEX, encoded);
+	return ch == UNMAPPED ? -1 : ch;
 }
 
 
 int DoubleByteEncoding::reverseMap(int cp) const
 {
-	const Mapping* begin = _reverseMappingTable;
-	const Mapping* end = begin + _reverseMappingTableSize;
-	const Mapping* it = std::lower_bound(begin, end, static_cast<Poco::UInt16>(cp), MappingLessThan());
-	if (it != end && it->from == cp)
-		return it->to;
-	else
-		return -1;
+	if (cp < 0 || cp > 0xFFFF) return -1;
+
+	UInt16 encoded = lookup(tables(), REVERSE_INDEX, static_cast<UInt16>(cp));
+	return encoded == UNMAPPED ? -1 : encoded;
+}
+
+
+const Poco::UInt16* DoubleByteEncoding::tables() const
+{
+	if (!_tablesReady.load(std::memory_order_acquire))
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (!_tablesReady.load(std::memory_order_relaxed))
+		{
+			buildTables();
+			_tablesReady.store(true, std::memory_order_release);
+		}
+	}
+	return _tables.data();
+}
+
+
+void DoubleByteEncoding::buildTables() const
+{
+	// The tables start with the block numbers for the high bytes of
+	// encoded characters (forward) and code points (reverse), followed
+	// by blocks of 256 entries for the low bytes. Block 0 is shared by
+	// all high bytes that have no mappings.
+	std::vector<UInt16> tables(BLOCKS, 0);
+	tables.resize(BLOCKS + 256, UNMAPPED);
+
+	auto set = [&tables](std::size_t index, UInt16 key, UInt16 value)
+	{
+		std::size_t slot = index + (key >> 8);
+		if (tables[slot] == 0)
+		{
+			tables[slot] = static_cast<UInt16>((tables.size() - BLOCKS)/256);
+			tables.resize(tables.size() + 256, UNMAPPED);
+		}
+		tables[BLOCKS + (tables[slot] << 8) + (key & 0xFF)] = value;
+	};
+
+	for (std::size_t i = 0; i < _mappingTableSize; ++i)
+	{
+		// single-byte characters are covered by the CharacterMap
+		if (_mappingTable[i].from > 0xFF)
+			set(FORWARD_INDEX, _mappingTable[i].from, _mappingTable[i].to);
+	}
+	for (std::size_t i = 0; i < _reverseMappingTableSize; ++i)
+	{
+		set(REVERSE_INDEX, _reverseMappingTable[i].from, _reverseMappingTable[i].to);
+	}
+	_tables.swap(tables);
 }
 
 
@@ -12,7 +12,31 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/ISO8859_4Encoding.h"
+#include "Poco/Windows932Encoding.h"
+#include "Poco/Windows936Encoding.h"
+#include "Poco/Windows949Encoding.h"
 #include "Poco/Windows950Encoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/TextConverter.h"
+#include "Poco/Random.h"
+
+
+namespace
+{
+	bool convertsLikeTextConverter(const Poco::DoubleByteEncoding& enc, const std::string& text)
+		/// Returns true if the bulk conversion gives the same result
+		/// as a TextConverter.
+	{
+		Poco::UTF8Encoding utf8;
+		Poco::TextConverter converter(enc, utf8);
+		std::string expected;
+		int expectedErrors = converter.convert(text.data(), static_cast<int>(text.size()), expected);
+
+		std::string result("prefix");
+		int errors = enc.convert(text.data(), text.size(), result);
+		return result == "prefix" + expected && errors == expectedErrors;
+	}
+}
 
 
 DoubleByteEncodingTest::DoubleByteEncodingTest(const std::string& name): CppUnit::TestCase(name)
@@ -101,6 +125,45 @@ void DoubleByteEncodingTest::testDoubleByteReverse()
 	assertTrue (seq[1] == 0x40);
 
 	assertTrue (enc.convert(0x3004, seq, 2) == 0);
+	assertTrue (enc.convert(0x13000, seq, 2) == 0);
+	assertTrue (enc.convert(-1, seq, 2) == 0);
+}
+
+
+void DoubleByteEncodingTest::testConvert()
+{
+	Poco::Windows950Encoding enc950;
+
+	const unsigned char text[] = { 'a', 0xA1, 0x40, 'b', 0x92, 'c', 0xA1, 0x41 };
+	std::string utf8;
+	assertTrue (enc950.convert(reinterpret_cast<const char*>(text), sizeof(text), utf8) == 1);
+	assertTrue (utf8 == "a\xE3\x80\x80" "b?c\xEF\xBC\x8C");
+
+	utf8.clear();
+	assertTrue (enc950.convert(reinterpret_cast<const char*>(text), 2, utf8, '_') == 1);
+	assertTrue (utf8 == "a_");
+
+	Poco::ISO8859_4Encoding enc8859_4;
+	Poco::Windows932Encoding enc932;
+	Poco::Windows936Encoding enc936;
+	Poco::Windows949Encoding enc949;
+	const Poco::DoubleByteEncoding* encodings[] = { &enc8859_4, &enc932, &enc936, &enc949, &enc950 };
+
+	Poco::Random rnd;
+	rnd.seed(42);
+	for (const auto pEnc: encodings)
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			std::string text;
+			int length = rnd.next(200);
+			for (int k = 0; k < length; ++k)
+			{
+				text += static_cast<char>(rnd.next(4) ? 0x80 + rnd.next(128) : rnd.next(128));
+			}
+			assertTrue (convertsLikeTextConverter(*pEnc, text));
+		}
+	}
 }
 
 
@@ -122,6 +185,7 @@ CppUnit::Test* DoubleByteEncodingTest::suite()
 	CppUnit_addTest(pSuite, DoubleByteEncodingTest, testSingleByteReverse);
 	CppUnit_addTest(pSuite, DoubleByteEncodingTest, testDoubleByte);
 	CppUnit_addTest(pSuite, DoubleByteEncodingTest, testDoubleByteReverse);
+	CppUnit_addTest(pSuite, DoubleByteEncodingTest, testConvert);
 
 	return pSuite;
 }
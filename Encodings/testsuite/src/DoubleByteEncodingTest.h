@@ -27,6 +27,7 @@ public:
 	void testSingleByteReverse();
 	void testDoubleByte();
 	void testDoubleByteReverse();
+	void testConvert();
 
 	void setUp();
 	void tearDown();
@@ -23,12 +23,14 @@
 #include "Poco/File.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/NumberFormatter.h"
+#include <functional>
 
 
 namespace Poco {
 
 
 class ArchiveCompressor;
+class PurgeStrategy;
 
 
 class Foundation_API ArchiveStrategy
@@ -36,7 +38,17 @@ class Foundation_API ArchiveStrategy
 	/// to rename a rotated log file for archiving.
 	///
 	/// Archived files can be automatically compressed,
-	/// using the gzip file format.
+	/// using the gzip file format. Compression is done by
+	/// a background thread, using a ParallelDeflatingOutputStream,
+	/// so that the blocks of a file are compressed in parallel by
+	/// the default Executor. The result is a single, standard gzip
+	/// stream.
+	///
+	/// If compression is enabled, the log file is only renamed
+	/// to a temporary name by archive(). Renaming the archived files,
+	/// compressing and purging are done by the background thread,
+	/// one job after the other, so that the thread writing to the
+	/// log file never waits for compression.
 {
 public:
 	ArchiveStrategy();
@@ -50,15 +62,60 @@ public:
 	void compress(bool flag = true);
 		/// Enables or disables compression of archived files.	
 
+	void compressionLevel(int level);
+		/// Sets the compression level, from 1 (fastest) to
+		/// 9 (best compression), or -1 for the zlib default (6).
+
+	int getCompressionLevel() const;
+		/// Returns the compression level.
+
+	void purge(PurgeStrategy& strategy, const std::string& path);
+		/// Purges archived log files using the given strategy.
+		///
+		/// If compression is enabled, purging is done by the
+		/// background thread once all pending compression jobs
+		/// have completed. The strategy must stay valid until then
+		/// (see wait()). Otherwise, the files are purged immediately.
+
+	void wait();
+		/// Waits until all background compression and
+		/// purging jobs have completed.
+
 protected:
+	typedef std::function<void(const std::string&)> Archiver;
+
+	void archiveFile(const std::string& path, const Archiver& archiver);
+		/// Archives the closed log file with the given path, by
+		/// calling archiver with the path of the file to archive.
+		/// The archiver renames it, using moveFile() and exists().
+		///
+		/// Without compression, archiver is called immediately.
+		/// Otherwise, the log file is renamed to a temporary name
+		/// and archiver is called by the background thread, after
+		/// all preceding jobs have completed.
+
 	void moveFile(const std::string& oldName, const std::string& newName);
+		/// Renames an archived file. If compression is enabled,
+		/// compressed files are renamed including their ".gz"
+		/// extension, and uncompressed files are compressed.
+		///
+		/// If called outside the background thread, e.g. by an
+		/// archive() implementation not using archiveFile(), waits
+		/// for all pending jobs before renaming the file.
+
 	bool exists(const std::string& name);
+		/// Returns true if an archived file with the given name,
+		/// or, if compression is enabled, its compressed
+		/// version exists.
 	
+
 private:
 	ArchiveStrategy(const ArchiveStrategy&);
 	ArchiveStrategy& operator = (const ArchiveStrategy&);
 	
 	bool _compress;
+	int _compressionLevel;
+	int _tempCount;
 	ArchiveCompressor* _pCompressor;
 };
 
@@ -72,6 +129,9 @@ public:
 	ArchiveByNumberStrategy();
 	~ArchiveByNumberStrategy();
 	LogFile* archive(LogFile* pFile);
+
+private:
+	void archiveByNumber(const std::string& basePath, const std::string& filePath);
 };
 
 
@@ -87,21 +147,25 @@ public:
 	
 	~ArchiveByTimestampStrategy()
 	{
+		wait();
 	}
 	
 	LogFile* archive(LogFile* pFile)
 		/// Archives the file by appending the current timestamp to the
-		/// file name. If the new file name exists, additionally a monotonic
-		/// increasing number is appended to the log file name.
+		/// file name. If the new file name exists, the existing files
+		/// with that name get a monotonic increasing number appended.
 	{
 		std::string path = pFile->path();
 		delete pFile;
 		std::string archPath = path;
 		archPath.append(".");
 		DateTimeFormatter::append(archPath, DT().timestamp(), "%Y%m%d%H%M%S%i");
-		
-		if (exists(archPath)) archiveByNumber(archPath);
-		else moveFile(path, archPath);
+
+		archiveFile(path, [this, archPath](const std::string& filePath)
+			{
+				if (exists(archPath)) archiveByNumber(archPath);
+				moveFile(filePath, archPath);
+			});
 
 		return new LogFile(path);
 	}
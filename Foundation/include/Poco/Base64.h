@@ -0,0 +1,118 @@
+//
+// Base64.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Definition of class Base64.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base64_INCLUDED
+#define Foundation_Base64_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+
+
+namespace Poco {
+
+
+enum Base64EncodingOptions
+{
+	BASE64_URL_ENCODING = 0x01,
+		/// Use the URL and filename-safe alphabet,
+		/// replacing '+' with '-' and '/' with '_'.
+		///
+		/// Will also set line length to unlimited.
+
+	BASE64_NO_PADDING   = 0x02
+		/// Do not append padding characters ('=') at end.
+};
+
+
+class Foundation_API Base64
+	/// This class provides static member functions for
+	/// Base64 encoding and decoding of memory buffers,
+	/// as specified in RFC 4648.
+	///
+	/// On x86 and x64 processors, encoding and decoding
+	/// are done 24 or 12 bytes at a time using AVX2 or SSSE3
+	/// instructions, if supported by the processor.
+	///
+	/// See Base64Encoder and Base64Decoder for streams
+	/// that encode and decode data on the fly.
+{
+public:
+	static std::size_t encodedLength(std::size_t length, int options = 0);
+		/// Returns the number of characters encode() produces
+		/// for length bytes.
+
+	static std::size_t encode(const void* buffer, std::size_t length, char* encoded, int options = 0);
+		/// Base64-encodes length bytes from buffer and writes the
+		/// result to encoded, which must have room for at least
+		/// encodedLength(length, options) characters. No line breaks
+		/// are inserted and the result is not zero-terminated.
+		///
+		/// The options can be a combination of BASE64_URL_ENCODING
+		/// and BASE64_NO_PADDING.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const std::string& data, int options = 0);
+		/// Returns the Base64 encoding of the given data.
+
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes decode() produces
+		/// for length characters.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* buffer, int options = 0);
+		/// Decodes length Base64 characters and writes the result
+		/// to buffer, which must have room for at least
+		/// decodedLength(length) bytes.
+		///
+		/// Padding characters are only allowed at the end. If
+		/// BASE64_NO_PADDING is given, the padding may be omitted.
+		/// If BASE64_URL_ENCODING is given, the URL and filename-safe
+		/// alphabet is expected.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the input contains characters
+		/// not in the alphabet (including whitespace), or
+		/// if the input is truncated.
+
+	static std::string decode(const std::string& encoded, int options = 0);
+		/// Returns the decoded data for the given Base64 string.
+		/// See decode() above.
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base64::encodedLength(std::size_t length, int options)
+{
+	if (options & BASE64_NO_PADDING)
+		return (length*4 + 2)/3;
+	else
+		return (length + 2)/3*4;
+}
+
+
+inline std::size_t Base64::decodedLength(std::size_t length)
+{
+	return (length + 3)/4*3;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Base64_INCLUDED
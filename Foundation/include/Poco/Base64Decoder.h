@@ -35,26 +35,35 @@ class Foundation_API Base64DecoderBuf: public UnbufferedStreamBuf
 	/// underlying streambuf, so the state
 	/// of the istream will not reflect that of
 	/// its streambuf.
+	///
+	/// Data read in blocks (e.g., with istream::read()
+	/// or StreamCopier) is decoded using Base64::decode().
+	/// No more characters are taken from the istream than
+	/// are needed to produce the requested number of bytes.
 {
 public:
 	Base64DecoderBuf(std::istream& istr, int options = 0);
 	~Base64DecoderBuf();
 
 private:
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
+
 	int readFromDevice();
+	std::streamsize xsgetn(char* p, std::streamsize count);
 	int readOne();
+	int readChars(int maxChars);
 
 	int             _options;
 	unsigned char   _group[3];
 	int             _groupLength;
 	int             _groupIndex;
+	char            _pending[BUFFER_SIZE];
+	int             _pendingPos;
+	int             _pendingEnd;
 	std::streambuf& _buf;
-	const unsigned char* _pInEncoding;
-
-	static unsigned char IN_ENCODING[256];
-	static bool          IN_ENCODING_INIT;
-	static unsigned char IN_ENCODING_URL[256];
-	static bool          IN_ENCODING_URL_INIT;
 
 private:
 	Base64DecoderBuf(const Base64DecoderBuf&);
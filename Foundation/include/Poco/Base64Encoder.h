@@ -19,6 +19,7 @@
 
 
 #include "Poco/Foundation.h"
+#include "Poco/Base64.h"
 #include "Poco/UnbufferedStreamBuf.h"
 #include <ostream>
 
@@ -26,24 +27,15 @@
 namespace Poco {
 
 
-enum Base64EncodingOptions
-{
-	BASE64_URL_ENCODING = 0x01,
-		/// Use the URL and filename-safe alphabet,
-		/// replacing '+' with '-' and '/' with '_'.
-		///
-		/// Will also set line length to unlimited.
-
-	BASE64_NO_PADDING   = 0x02
-		/// Do not append padding characters ('=') at end.
-};
-
-
 class Foundation_API Base64EncoderBuf: public UnbufferedStreamBuf
 	/// This streambuf base64-encodes all data written
 	/// to it and forwards it to a connected
 	/// ostream.
 	///
+	/// Data written in blocks (e.g., with ostream::write()
+	/// or StreamCopier) is encoded a line at a time using
+	/// Base64::encode().
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -68,7 +60,14 @@ public:
 		/// Returns the currently set line length.
 
 private:
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
+
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+	int writeGroup();
 
 	int             _options;
 	unsigned char   _group[3];
@@ -76,12 +75,6 @@ private:
 	int             _pos;
 	int             _lineLength;
 	std::streambuf& _buf;
-	const unsigned char* _pOutEncoding;
-
-	static const unsigned char OUT_ENCODING[64];
-	static const unsigned char OUT_ENCODING_URL[64];
-
-	friend class Base64DecoderBuf;
 
 	Base64EncoderBuf(const Base64EncoderBuf&);
 	Base64EncoderBuf& operator = (const Base64EncoderBuf&);
@@ -0,0 +1,98 @@
+//
+// CPUFeatures.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Definition of the CPUFeatures class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUFeatures_INCLUDED
+#define Foundation_CPUFeatures_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+//
+// POCO_HAVE_X86_SIMD is defined if the compiler can generate
+// SSE/AVX/SHA code for individual functions, which are then selected
+// at runtime, depending on the capabilities of the processor.
+// Define POCO_NO_SIMD to build the portable implementations only.
+//
+#if !defined(POCO_NO_SIMD)
+	#if (POCO_ARCH == POCO_ARCH_IA32 || POCO_ARCH == POCO_ARCH_AMD64)
+		#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+			#define POCO_HAVE_X86_SIMD 1
+		#endif
+	#endif
+#endif
+
+
+//
+// POCO_SIMD_TARGET(isa) enables the given instruction set
+// extensions (e.g., "sse4.2,pclmul") for a single function.
+// Visual C++ does not require this.
+//
+#if defined(POCO_HAVE_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+	#define POCO_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define POCO_SIMD_TARGET(isa)
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API CPUFeatures
+	/// This class provides information about the instruction set
+	/// extensions supported by the processor (and operating system)
+	/// the program is running on.
+	///
+	/// It is used to select optimized implementations of
+	/// algorithms (checksums, message digests, encoders) at runtime.
+	/// The processor is queried only once; all functions
+	/// return false on architectures other than x86 and x64,
+	/// or if POCO_NO_SIMD has been defined.
+{
+public:
+	static bool hasSSSE3();
+		/// Returns true if the processor supports SSSE3.
+
+	static bool hasSSE41();
+		/// Returns true if the processor supports SSE 4.1.
+
+	static bool hasSSE42();
+		/// Returns true if the processor supports SSE 4.2,
+		/// including the CRC32 (CRC-32C) instruction.
+
+	static bool hasPCLMULQDQ();
+		/// Returns true if the processor supports the
+		/// carry-less multiplication instruction.
+
+	static bool hasAVX2();
+		/// Returns true if the processor supports AVX2 and the
+		/// operating system saves the AVX register state.
+
+	static bool hasSHA();
+		/// Returns true if the processor supports the
+		/// SHA-1 and SHA-256 extensions (SHA-NI).
+
+private:
+	CPUFeatures();
+	CPUFeatures(const CPUFeatures&);
+	CPUFeatures& operator = (const CPUFeatures&);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CPUFeatures_INCLUDED
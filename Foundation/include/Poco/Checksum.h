@@ -33,7 +33,8 @@ public:
 	{
 		TYPE_ADLER32 = ChecksumImpl::TYPE_ADLER32_IMPL,
 		TYPE_CRC32 = ChecksumImpl::TYPE_CRC32_IMPL,
-		TYPE_CRC64 = ChecksumImpl::TYPE_CRC64_IMPL
+		TYPE_CRC64 = ChecksumImpl::TYPE_CRC64_IMPL,
+		TYPE_CRC32C = ChecksumImpl::TYPE_CRC32C_IMPL
 	};
 
 	Checksum();
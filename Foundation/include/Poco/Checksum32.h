@@ -26,7 +26,7 @@ namespace Poco {
 
 
 class Foundation_API Checksum32 : public ChecksumImpl
-	/// This class calculates CRC-32 or Adler-32 checksums
+	/// This class calculates CRC-32, CRC-32C or Adler-32 checksums
 	/// for arbitrary data.
 	///
 	/// A cyclic redundancy check (CRC) is a type of hash function, which is used to produce a
@@ -37,7 +37,14 @@ class Foundation_API Checksum32 : public ChecksumImpl
 	/// It is almost as reliable as a 32-bit cyclic redundancy check for protecting against
 	/// accidental modification of data, such as distortions occurring during a transmission,
 	/// but is significantly faster to calculate in software.
-	
+	///
+	/// CRC-32C (Castagnoli) uses a different polynomial with better error
+	/// detection properties. It is used by iSCSI, SCTP, ext4 and many
+	/// storage formats, and modern processors compute it in hardware.
+	///
+	/// On x86 and x64 processors, the implementation selects at runtime
+	/// between the portable code and code using PCLMULQDQ (CRC-32),
+	/// SSE 4.2 (CRC-32C) and AVX2 (Adler-32) instructions.
 {
 public:
 	Checksum32();
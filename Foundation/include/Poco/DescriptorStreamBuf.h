@@ -0,0 +1,67 @@
+//
+// DescriptorStreamBuf.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  DescriptorStreamBuf
+//
+// Definition of the DescriptorStreamBuf class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_DescriptorStreamBuf_INCLUDED
+#define Foundation_DescriptorStreamBuf_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+namespace Poco {
+
+
+class Foundation_API DescriptorStreamBuf
+	/// DescriptorStreamBuf is an interface implemented by stream
+	/// buffers that read from or write to an operating system
+	/// file descriptor, like FileStreamBuf or Net::SocketStreamBuf.
+	///
+	/// StreamCopier uses this interface to let the kernel move data
+	/// directly between two descriptors (using copy_file_range(),
+	/// sendfile() or splice() on Linux), without copying it
+	/// through user space buffers.
+{
+public:
+	DescriptorStreamBuf();
+		/// Creates the DescriptorStreamBuf.
+
+	virtual ~DescriptorStreamBuf();
+		/// Destroys the DescriptorStreamBuf.
+
+	virtual int readDescriptor() = 0;
+		/// Returns the descriptor data can be read from directly,
+		/// or -1 if this is not possible.
+		///
+		/// Must return -1 if the stream buffer still holds buffered
+		/// input data, or if the descriptor must not be accessed
+		/// directly (e.g., for a secure socket).
+
+	virtual int writeDescriptor() = 0;
+		/// Writes any buffered output data to the descriptor and
+		/// returns the descriptor data can be written to directly,
+		/// or -1 if this is not possible.
+
+	virtual void transferred(Poco::UInt64 count) = 0;
+		/// Tells the stream buffer that count bytes have been read
+		/// from or written to its descriptor directly, so that it can
+		/// update its position.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_DescriptorStreamBuf_INCLUDED
@@ -0,0 +1,227 @@
+//
+// Executor.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Executor
+//
+// Definition of the Executor class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Executor_INCLUDED
+#define Foundation_Executor_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Future.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/ActiveRunnable.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API Executor
+	/// An Executor runs tasks on a fixed set of worker threads,
+	/// using work stealing.
+	///
+	/// Each worker thread has its own task queue. Tasks submitted
+	/// by a worker thread (e.g., subtasks of a task) go into the
+	/// worker's queue, where the worker takes the most recent one
+	/// first. Tasks submitted by other threads go into a shared
+	/// queue. A worker that runs out of tasks takes tasks from the
+	/// shared queue, or steals the oldest tasks from the other
+	/// workers' queues.
+	///
+	/// Unlike ThreadPool::start(), submitting a task never fails
+	/// because all threads are busy; the task is queued instead.
+	/// The shared queue can be given a capacity, in which case
+	/// threads other than the worker threads are blocked when
+	/// submitting a task to a full queue, until there is space
+	/// again (see also tryExecute()).
+	///
+	/// submit() returns a Future for the result of the task,
+	/// which can be waited for, or used to attach a continuation.
+	/// A worker thread waiting for a Future runs other pending
+	/// tasks in the meantime, so tasks can wait for their
+	/// subtasks without starving the Executor.
+	///
+	/// Tasks must not throw exceptions through execute(); any
+	/// exception thrown by a task started with execute() is
+	/// passed to the ErrorHandler. Exceptions thrown by tasks
+	/// started with submit() are stored in the Future.
+{
+public:
+	typedef std::function<void()> Task;
+
+	explicit Executor(int threads = 0, std::size_t queueCapacity = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates the Executor with the given number of worker
+		/// threads (if zero, one per processor) and the given
+		/// capacity of the shared queue (zero means unlimited).
+
+	Executor(const std::string& name, int threads = 0, std::size_t queueCapacity = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates the Executor with the given name, which is used
+		/// for naming the worker threads. See the other constructor
+		/// for the remaining arguments.
+
+	~Executor();
+		/// Shuts down and destroys the Executor.
+
+	template <class F>
+	auto submit(F f) -> Future<decltype(f())>
+		/// Submits the callable f for execution and returns
+		/// a Future for its result.
+	{
+		typedef decltype(f()) R;
+
+		std::shared_ptr<FutureHolder<R>> pHolder(new FutureHolder<R>(this));
+		execute([pHolder, f]() mutable
+			{
+				pHolder->run(f);
+			});
+		return Future<R>(pHolder);
+	}
+
+	void execute(const Task& task);
+		/// Submits the task for execution.
+		///
+		/// If the shared queue has a capacity and is full, and the
+		/// calling thread is not a worker thread, waits until the
+		/// task can be queued.
+		///
+		/// Throws an IllegalStateException if the Executor has been
+		/// shut down.
+
+	bool tryExecute(const Task& task);
+		/// Submits the task for execution, unless the shared queue
+		/// is full. Returns true if the task has been queued.
+
+	void shutdown();
+		/// Runs all pending tasks, then stops the worker threads.
+		/// No new tasks can be submitted by other threads afterwards.
+
+	int threads() const;
+		/// Returns the number of worker threads.
+
+	std::size_t queueCapacity() const;
+		/// Returns the capacity of the shared queue, or zero if unlimited.
+
+	std::size_t pending() const;
+		/// Returns the number of tasks waiting to be run.
+
+	const std::string& name() const;
+		/// Returns the name of the Executor.
+
+	static Executor* current();
+		/// Returns the Executor whose worker thread is calling,
+		/// or null if the calling thread is not a worker thread.
+
+	static bool runPending();
+		/// If the calling thread is a worker thread, takes one pending
+		/// task of its Executor and runs it. Returns true if a task
+		/// has been run.
+
+	static Executor& defaultExecutor();
+		/// Returns a reference to the default Executor, which
+		/// has one worker thread per processor.
+
+private:
+	Executor(const Executor&);
+	Executor& operator = (const Executor&);
+
+	struct Worker;
+
+	void start(int threads, int stackSize);
+	bool enqueue(const Task& task, bool block);
+	bool take(Worker& worker, Task& task);
+	void work(Worker& worker);
+	void wakeUp();
+	static void run(Task& task);
+
+	std::string              _name;
+	std::size_t              _capacity;
+	std::vector<Worker*>     _workers;
+	std::deque<Task>         _queue;
+	FastMutex                _queueMutex;
+	Condition                _notFull;
+	FastMutex                _idleMutex;
+	Condition                _idle;
+	std::atomic<std::size_t> _pending;
+	std::atomic<int>         _sleeping;
+	std::atomic<bool>        _stopped;
+};
+
+
+template <class OwnerType>
+class ExecutorStarter
+	/// A StarterType policy for ActiveMethod that runs the
+	/// method as a task of the default Executor, rather than
+	/// in a thread from the default ThreadPool.
+	///
+	/// Usage:
+	///     ActiveMethod<int, int, MyClass, ExecutorStarter<MyClass> > method;
+{
+public:
+	static void start(OwnerType* /*pOwner*/, ActiveRunnableBase::Ptr pRunnable)
+	{
+		ActiveRunnableBase* pTask = pRunnable.get();
+		pTask->duplicate(); // The runnable will release itself.
+		try
+		{
+			Executor::defaultExecutor().execute([pTask]()
+				{
+					pTask->run();
+				});
+		}
+		catch (...)
+		{
+			pTask->release();
+			throw;
+		}
+	}
+};
+
+
+//
+// inlines
+//
+inline int Executor::threads() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline std::size_t Executor::queueCapacity() const
+{
+	return _capacity;
+}
+
+
+inline std::size_t Executor::pending() const
+{
+	return _pending.load();
+}
+
+
+inline const std::string& Executor::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Executor_INCLUDED
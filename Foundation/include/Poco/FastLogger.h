@@ -0,0 +1,480 @@
+//
+// FastLogger.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  FastLogger
+//
+// Definition of the FastLogger class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FastLogger_INCLUDED
+#define Foundation_FastLogger_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Message.h"
+#include "Poco/Logger.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Any.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace Impl {
+
+	enum FastLogArgType
+	{
+		FLA_BOOL = 1,
+		FLA_CHAR,
+		FLA_SCHAR,
+		FLA_UCHAR,
+		FLA_SHORT,
+		FLA_USHORT,
+		FLA_INT,
+		FLA_UINT,
+		FLA_LONG,
+		FLA_ULONG,
+		FLA_LONGLONG,
+		FLA_ULONGLONG,
+		FLA_FLOAT,
+		FLA_DOUBLE,
+		FLA_STRING
+	};
+
+	template <typename T>
+	struct FastLogArg;
+		/// Encodes a log argument of type T. Not defined
+		/// for unsupported argument types.
+
+	template <typename T, int TYPE>
+	struct FastLogScalarArg
+	{
+		static std::size_t size(const T&)
+		{
+			return 1 + sizeof(T);
+		}
+
+		static void write(char*& p, const T& value)
+		{
+			*p++ = static_cast<char>(TYPE);
+			std::memcpy(p, &value, sizeof(T));
+			p += sizeof(T);
+		}
+	};
+
+	struct FastLogStringArg
+	{
+		static std::size_t size(std::size_t length)
+		{
+			return 1 + sizeof(UInt32) + length;
+		}
+
+		static void write(char*& p, const char* str, std::size_t length)
+		{
+			*p++ = static_cast<char>(FLA_STRING);
+			UInt32 len = static_cast<UInt32>(length);
+			std::memcpy(p, &len, sizeof(len));
+			p += sizeof(len);
+			std::memcpy(p, str, length);
+			p += length;
+		}
+	};
+
+	template <> struct FastLogArg<bool>: FastLogScalarArg<bool, FLA_BOOL> { };
+	template <> struct FastLogArg<char>: FastLogScalarArg<char, FLA_CHAR> { };
+	template <> struct FastLogArg<signed char>: FastLogScalarArg<signed char, FLA_SCHAR> { };
+	template <> struct FastLogArg<unsigned char>: FastLogScalarArg<unsigned char, FLA_UCHAR> { };
+	template <> struct FastLogArg<short>: FastLogScalarArg<short, FLA_SHORT> { };
+	template <> struct FastLogArg<unsigned short>: FastLogScalarArg<unsigned short, FLA_USHORT> { };
+	template <> struct FastLogArg<int>: FastLogScalarArg<int, FLA_INT> { };
+	template <> struct FastLogArg<unsigned>: FastLogScalarArg<unsigned, FLA_UINT> { };
+	template <> struct FastLogArg<long>: FastLogScalarArg<long, FLA_LONG> { };
+	template <> struct FastLogArg<unsigned long>: FastLogScalarArg<unsigned long, FLA_ULONG> { };
+	template <> struct FastLogArg<long long>: FastLogScalarArg<long long, FLA_LONGLONG> { };
+	template <> struct FastLogArg<unsigned long long>: FastLogScalarArg<unsigned long long, FLA_ULONGLONG> { };
+	template <> struct FastLogArg<float>: FastLogScalarArg<float, FLA_FLOAT> { };
+	template <> struct FastLogArg<double>: FastLogScalarArg<double, FLA_DOUBLE> { };
+
+	template <>
+	struct FastLogArg<std::string>
+	{
+		static std::size_t size(const std::string& str)
+		{
+			return FastLogStringArg::size(str.size());
+		}
+
+		static void write(char*& p, const std::string& str)
+		{
+			FastLogStringArg::write(p, str.data(), str.size());
+		}
+	};
+
+	template <>
+	struct FastLogArg<const char*>
+	{
+		static std::size_t size(const char* str)
+		{
+			return FastLogStringArg::size(str ? std::strlen(str) : 0);
+		}
+
+		static void write(char*& p, const char* str)
+		{
+			FastLogStringArg::write(p, str, str ? std::strlen(str) : 0);
+		}
+	};
+
+	template <>
+	struct FastLogArg<char*>: FastLogArg<const char*> { };
+
+	template <std::size_t N>
+	struct FastLogArg<char[N]>: FastLogArg<const char*> { };
+
+	inline std::size_t fastLogArgsSize()
+	{
+		return 0;
+	}
+
+	template <typename T, typename... Args>
+	inline std::size_t fastLogArgsSize(const T& arg, const Args&... args)
+	{
+		return FastLogArg<T>::size(arg) + fastLogArgsSize(args...);
+	}
+
+	inline void fastLogWriteArgs(char*&)
+	{
+	}
+
+	template <typename T, typename... Args>
+	inline void fastLogWriteArgs(char*& p, const T& arg, const Args&... args)
+	{
+		FastLogArg<T>::write(p, arg);
+		fastLogWriteArgs(p, args...);
+	}
+
+}
+
+
+class Foundation_API FastLogger: public Runnable
+	/// FastLogger is a logger for high message rates that defers
+	/// all formatting and I/O to a background thread.
+	///
+	/// Logging a message does not create a Message, format a string,
+	/// allocate memory or take a lock. Instead, the calling thread
+	/// appends a compact binary record to its own lock-free
+	/// single-producer/single-consumer ring buffer. The record consists
+	/// of a pointer to a static Format descriptor (priority, format
+	/// string and source location), a timestamp and the raw bytes
+	/// of the arguments (strings are copied).
+	///
+	/// A background thread collects the records from all ring buffers,
+	/// orders them by time, formats the text with Poco::format() and
+	/// passes the resulting Message objects to the channel in batches.
+	/// Any Channel can be used as the sink.
+	///
+	/// Log statements are usually written with the poco_fast_* macros,
+	/// which check the level and create the Format descriptor as a
+	/// function-local static:
+	///
+	///     FastLogger logger(Logger::get("Requests"));
+	///     ...
+	///     poco_fast_information(logger, "%s %s took %d us", method, path, micros);
+	///
+	/// Supported argument types are bool, all character, integer and
+	/// floating-point types, std::string and C strings.
+	///
+	/// If a ring buffer is full, the logging thread waits for the
+	/// background thread to make room (default), or drops the message
+	/// if blocking has been disabled with setBlocking(false).
+	///
+	/// The FastLogger must outlive all threads logging through it.
+{
+public:
+	class Foundation_API Format
+		/// Format describes a log statement: its priority, its
+		/// format string (see Poco::format()) and its source location.
+		///
+		/// Format objects are referenced, not copied, by log records
+		/// and must therefore stay valid until the records have been
+		/// processed; they are usually function-local statics.
+	{
+	public:
+		Format(Message::Priority prio, const char* fmt, const char* file = 0, int line = 0);
+			/// Creates the Format.
+
+		~Format();
+			/// Destroys the Format.
+
+		Message::Priority priority() const;
+			/// Returns the priority.
+
+		const std::string& format() const;
+			/// Returns the format string.
+
+		const char* file() const;
+			/// Returns the source file, or 0 if not specified.
+
+		int line() const;
+			/// Returns the source line.
+
+	private:
+		Format();
+		Format(const Format&);
+		Format& operator = (const Format&);
+
+		Message::Priority _prio;
+		std::string       _format;
+		const char*       _file;
+		int               _line;
+	};
+
+	static const std::size_t DEFAULT_BUFFER_SIZE = 65536;
+
+	FastLogger(const std::string& name, Channel::Ptr pChannel, int level = Message::PRIO_INFORMATION, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the FastLogger with the given name, channel and level,
+		/// and starts its background thread. Every logging thread gets
+		/// a ring buffer of (at least) bufferSize bytes.
+
+	explicit FastLogger(Logger& logger, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the FastLogger using the name, level and channel
+		/// of the given Logger, and starts its background thread.
+
+	~FastLogger();
+		/// Processes all pending records, stops the
+		/// background thread and destroys the FastLogger.
+
+	const std::string& name() const;
+		/// Returns the name of the logger, which is used as
+		/// the source of all messages.
+
+	void setLevel(int level);
+		/// Sets the logger's log level.
+
+	int getLevel() const;
+		/// Returns the logger's log level.
+
+	bool is(int level) const;
+		/// Returns true if at least the given log level is set.
+
+	void setBlocking(bool blocking);
+		/// Specifies whether logging threads wait for free space
+		/// in their ring buffer (true, default), or drop messages
+		/// when the buffer is full (false).
+
+	bool getBlocking() const;
+		/// Returns true if logging threads wait for free space
+		/// in their ring buffer.
+
+	template <typename... Args>
+	void log(const Format& format, const Args&... args)
+		/// Appends a record for the given Format and arguments
+		/// to the calling thread's ring buffer, if the format's
+		/// priority is enabled.
+	{
+		if (!is(format.priority())) return;
+
+		RecordHeader header;
+		header.pFormat = &format;
+		header.time = Timestamp().epochMicroseconds();
+		header.argc = static_cast<UInt32>(sizeof...(Args));
+		header.reserved = 0;
+
+		RingBuffer* pRing;
+		char* p = reserve(pRing, sizeof(header) + Impl::fastLogArgsSize(args...));
+		if (p)
+		{
+			std::memcpy(p, &header, sizeof(header));
+			p += sizeof(header);
+			Impl::fastLogWriteArgs(p, args...);
+			commit(pRing);
+		}
+	}
+
+	void flush();
+		/// Waits until all records logged before the call
+		/// have been passed to the channel.
+
+	UInt64 dropped() const;
+		/// Returns the number of messages dropped because
+		/// a ring buffer was full.
+
+protected:
+	void run();
+
+private:
+	FastLogger();
+	FastLogger(const FastLogger&);
+	FastLogger& operator = (const FastLogger&);
+
+	struct RecordHeader
+	{
+		const Format*      pFormat;
+		Timestamp::TimeVal time;
+		UInt32             argc;
+		UInt32             reserved;
+	};
+
+	class RingBuffer;
+	struct ThreadBuffers;
+	typedef std::shared_ptr<RingBuffer> RingBufferPtr;
+	typedef std::vector<RingBufferPtr> RingBufferVec;
+
+	enum
+	{
+		MAX_BATCH = 1024,
+		IDLE_WAIT = 5 // milliseconds
+	};
+
+	void start();
+	RingBuffer* threadBuffer();
+	char* reserve(RingBuffer*& pRing, std::size_t size);
+	void commit(RingBuffer* pRing);
+	bool drain();
+	void decode(const char* pRecord, const RingBuffer& ring, Message& msg);
+	void logBatch();
+
+	std::string         _name;
+	Channel::Ptr        _pChannel;
+	std::atomic<int>    _level;
+	std::atomic<bool>   _blocking;
+	std::atomic<bool>   _stopped;
+	std::atomic<UInt64> _dropped;
+	std::size_t         _bufferSize;
+	UInt32              _id;
+	FastMutex           _mutex;
+	RingBufferVec       _rings;
+	Thread              _thread;
+	Event               _wakeUp;
+	Event               _drained;
+
+	// used by the background thread only
+	std::vector<Message>     _batch;
+	std::size_t              _batchSize;
+	std::vector<std::size_t> _order;
+	std::vector<Any>         _args;
+	std::string              _text;
+};
+
+
+//
+// inlines
+//
+inline Message::Priority FastLogger::Format::priority() const
+{
+	return _prio;
+}
+
+
+inline const std::string& FastLogger::Format::format() const
+{
+	return _format;
+}
+
+
+inline const char* FastLogger::Format::file() const
+{
+	return _file;
+}
+
+
+inline int FastLogger::Format::line() const
+{
+	return _line;
+}
+
+
+inline const std::string& FastLogger::name() const
+{
+	return _name;
+}
+
+
+inline int FastLogger::getLevel() const
+{
+	return _level.load(std::memory_order_relaxed);
+}
+
+
+inline bool FastLogger::is(int level) const
+{
+	return _level.load(std::memory_order_relaxed) >= level;
+}
+
+
+inline bool FastLogger::getBlocking() const
+{
+	return _blocking.load(std::memory_order_relaxed);
+}
+
+
+inline UInt64 FastLogger::dropped() const
+{
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+
+} // namespace Poco
+
+
+//
+// convenience macros
+//
+#define poco_fast_log(logger, prio, fmt, ...) \
+	do \
+	{ \
+		if ((logger).is(prio)) \
+		{ \
+			static const Poco::FastLogger::Format pocoFastLogFormat((prio), (fmt), __FILE__, __LINE__); \
+			(logger).log(pocoFastLogFormat, ##__VA_ARGS__); \
+		} \
+	} \
+	while (false)
+
+#define poco_fast_fatal(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_FATAL, fmt, ##__VA_ARGS__)
+
+#define poco_fast_critical(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_CRITICAL, fmt, ##__VA_ARGS__)
+
+#define poco_fast_error(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_ERROR, fmt, ##__VA_ARGS__)
+
+#define poco_fast_warning(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_WARNING, fmt, ##__VA_ARGS__)
+
+#define poco_fast_notice(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_NOTICE, fmt, ##__VA_ARGS__)
+
+#define poco_fast_information(logger, fmt, ...) \
+	poco_fast_log(logger, Poco::Message::PRIO_INFORMATION, fmt, ##__VA_ARGS__)
+
+#if defined(_DEBUG) || defined(POCO_LOG_DEBUG)
+	#define poco_fast_debug(logger, fmt, ...) \
+		poco_fast_log(logger, Poco::Message::PRIO_DEBUG, fmt, ##__VA_ARGS__)
+
+	#define poco_fast_trace(logger, fmt, ...) \
+		poco_fast_log(logger, Poco::Message::PRIO_TRACE, fmt, ##__VA_ARGS__)
+#else
+	#define poco_fast_debug(logger, fmt, ...)
+	#define poco_fast_trace(logger, fmt, ...)
+#endif
+
+
+#endif // Foundation_FastLogger_INCLUDED
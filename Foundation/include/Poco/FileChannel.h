@@ -29,6 +29,7 @@ namespace Poco {
 
 
 class LogFile;
+class Timer;
 class RotateStrategy;
 class ArchiveStrategy;
 class PurgeStrategy;
@@ -126,6 +127,13 @@ class Foundation_API FileChannel: public Channel
 	///   * true:       Compress archived log files.
 	///   * false:      Do not compress archived log files.
 	///
+	/// Compression is done in the background, with the blocks of a
+	/// file compressed in parallel. The compression level can be set
+	/// with the "compressionLevel" property, from 1 (fastest) to 9
+	/// (best compression); "default" selects the zlib default (6).
+	/// If compression is enabled, archived files are also purged in
+	/// the background, after they have been compressed.
+	///
 	/// Archived log files can be automatically purged, either if
 	/// they reach a certain age, or if the number of archived
 	/// log files reaches a given maximum number. This is
@@ -154,6 +162,29 @@ class Foundation_API FileChannel: public Channel
 	///   * true:  Every message is immediately flushed to the log file (default).
 	///   * false: Messages are not immediately flushed to the log file.
 	///
+	/// If flush is false, messages are collected in a write buffer
+	/// and written to the log file together, with a single system
+	/// call, when the buffer is full. The following properties
+	/// control the buffering:
+	///
+	///   * bufferSize:    The size of the write buffer, given as
+	///                    <n> (bytes), <n> K or <n> M (default 8 K).
+	///   * flushInterval: If greater than zero, a background timer
+	///                    writes the buffer to the file every <n>
+	///                    milliseconds (default 0, no timer).
+	///   * flushPriority: Messages with the given priority or a higher
+	///                    one (e.g., "error", see Logger::parseLevel())
+	///                    are written immediately, together with the
+	///                    buffered messages. The default is "none".
+	///
+	/// For example, a channel for a high-volume request log could
+	/// be configured with flush = false, bufferSize = 1 M,
+	/// flushInterval = 500 and flushPriority = error.
+	///
+	/// The file size used for size-based rotation includes the
+	/// buffered messages, and the buffer is written to the file
+	/// before the file is rotated or the channel is closed.
+	///
 	/// The rotateOnOpen property specifies whether an existing log file should be
 	/// rotated (and archived) when the channel is opened. Valid values are:
 	///
@@ -196,6 +227,8 @@ public:
 		///   * compress:     Enable or disable compression of
 		///                   archived files. See the FileChannel class
 		///                   for details.
+		///   * compressionLevel: The compression level for archived
+		///                   files. See the FileChannel class for details.
 		///   * purgeAge:     Maximum age of an archived log file before
 		///                   it is purged. See the FileChannel class for
 		///                   details.
@@ -205,6 +238,13 @@ public:
 		///   * flush:        Specifies whether messages are immediately
 		///                   flushed to the log file. See the FileChannel class
 		///                   for details.
+		///   * bufferSize:   The size of the write buffer used if flush
+		///                   is false. See the FileChannel class for details.
+		///   * flushInterval: The interval in milliseconds for writing
+		///                   the buffer to the file if flush is false.
+		///                   Takes effect when the channel is opened.
+		///   * flushPriority: The priority of messages that are flushed
+		///                   immediately, even if flush is false.
 		///   * rotateOnOpen: Specifies whether an existing log file should be
 		///                   rotated and archived when the channel is opened.
 
@@ -227,9 +267,13 @@ public:
 	static const std::string PROP_ARCHIVE;
 	static const std::string PROP_TIMES;
 	static const std::string PROP_COMPRESS;
+	static const std::string PROP_COMPRESSIONLEVEL;
 	static const std::string PROP_PURGEAGE;
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_FLUSHPRIORITY;
 	static const std::string PROP_ROTATEONOPEN;
 
 protected:
@@ -237,9 +281,13 @@ protected:
 	void setRotation(const std::string& rotation);
 	void setArchive(const std::string& archive);
 	void setCompress(const std::string& compress);
+	void setCompressionLevel(const std::string& level);
 	void setPurgeAge(const std::string& age);
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
+	void setBufferSize(const std::string& size);
+	void setFlushInterval(const std::string& interval);
+	void setFlushPriority(const std::string& priority);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
 	void purge();
 
@@ -248,17 +296,26 @@ private:
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
 	Timespan::TimeDiff extractFactor(const std::string& value, std::string::const_iterator start) const;
+	void onFlush(Timer& timer);
+	static int parseCompressionLevel(const std::string& level);
 
 	std::string      _path;
 	std::string      _times;
 	std::string      _rotation;
 	std::string      _archive;
 	bool             _compress;
+	std::string      _compressionLevel;
 	std::string      _purgeAge;
 	std::string      _purgeCount;
 	bool             _flush;
+	std::string      _bufferSize;
+	std::size_t      _bufferBytes;
+	long             _flushInterval;
+	std::string      _flushPriority;
+	int              _flushPrio;
 	bool             _rotateOnOpen;
 	LogFile*         _pFile;
+	Timer*           _pFlushTimer;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
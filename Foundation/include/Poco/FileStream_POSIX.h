@@ -20,6 +20,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/BufferedBidirectionalStreamBuf.h"
+#include "Poco/DescriptorStreamBuf.h"
 #include <istream>
 #include <ostream>
 
@@ -27,7 +28,7 @@
 namespace Poco {
 
 
-class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf
+class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf, public DescriptorStreamBuf
 	/// This stream buffer handles Fileio
 {
 public:
@@ -50,6 +51,17 @@ public:
 	std::streampos seekpos(std::streampos pos, std::ios::openmode mode = std::ios::in | std::ios::out);
 		/// Change to specified position, according to mode.
 
+	int readDescriptor();
+		/// Returns the file descriptor if the file has been opened
+		/// for reading and no input data is buffered, or -1 otherwise.
+
+	int writeDescriptor();
+		/// Flushes buffered output data and returns the file descriptor
+		/// if the file has been opened for writing, or -1 otherwise.
+
+	void transferred(Poco::UInt64 count);
+		/// Advances the file position by count bytes.
+
 protected:
 	enum
 	{
@@ -0,0 +1,41 @@
+//
+// FlatHashMap.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashMap
+//
+// Definition of the FlatHashMap class template.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashMap_INCLUDED
+#define Foundation_FlatHashMap_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/HashMap.h"
+#include "Poco/FlatHashTable.h"
+
+
+namespace Poco {
+
+
+template <class Key, class Mapped, class HashFunc = Hash<Key> >
+using FlatHashMap = HashMap<Key, Mapped, HashFunc, FlatHashTable>;
+	/// A HashMap that stores its entries in a FlatHashTable.
+	///
+	/// A FlatHashMap can be used just like a HashMap, with the
+	/// exception that inserting an entry can invalidate
+	/// iterators and references to other entries.
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashMap_INCLUDED
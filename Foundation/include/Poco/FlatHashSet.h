@@ -0,0 +1,41 @@
+//
+// FlatHashSet.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashSet
+//
+// Definition of the FlatHashSet class template.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashSet_INCLUDED
+#define Foundation_FlatHashSet_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/HashSet.h"
+#include "Poco/FlatHashTable.h"
+
+
+namespace Poco {
+
+
+template <class Value, class HashFunc = Hash<Value> >
+using FlatHashSet = HashSet<Value, HashFunc, FlatHashTable>;
+	/// A HashSet that stores its elements in a FlatHashTable.
+	///
+	/// A FlatHashSet can be used just like a HashSet, with the
+	/// exception that inserting an element can invalidate
+	/// iterators and references to other elements.
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashSet_INCLUDED
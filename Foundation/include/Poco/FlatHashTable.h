@@ -0,0 +1,579 @@
+//
+// FlatHashTable.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashTable class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashTable_INCLUDED
+#define Foundation_FlatHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Hash.h"
+#include <iterator>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_FLAT_HASH_TABLE_SSE2
+#endif
+
+
+namespace Poco {
+
+
+template <class Value, class HashFunc = Hash<Value> >
+class FlatHashTable
+	/// This class implements an open addressing hash table
+	/// in the style of the "Swiss table".
+	///
+	/// All elements are stored in a single array of slots.
+	/// A separate array holds one control byte per slot, which
+	/// either marks the slot as empty or deleted, or contains
+	/// seven bits of the hash value of the element stored in the slot.
+	/// Lookups probe the control bytes in groups of 16 (using SSE2
+	/// instructions, if available), and only compare elements
+	/// whose control byte matches. Compared to LinearHashTable,
+	/// this avoids one memory allocation per bucket and a pointer
+	/// indirection per lookup.
+	///
+	/// FlatHashTable has the same interface as LinearHashTable
+	/// and can be used as the table of a HashMap or HashSet
+	/// (see FlatHashMap and FlatHashSet).
+	///
+	/// Unlike with LinearHashTable, inserting an element can
+	/// invalidate all iterators and references to elements, if
+	/// the table needs to grow. Erasing an element does not
+	/// invalidate iterators and references to other elements.
+	///
+	/// The FlatHashTable is not thread safe.
+	///
+	/// Value must support comparison for equality.
+{
+public:
+	typedef Value               ValueType;
+	typedef Value&              Reference;
+	typedef const Value&        ConstReference;
+	typedef Value*              Pointer;
+	typedef const Value*        ConstPointer;
+	typedef HashFunc            Hash;
+	typedef signed char         Control;
+
+	class ConstIterator: public std::iterator<std::forward_iterator_tag, Value>
+	{
+	public:
+		ConstIterator():
+			_pCtrl(0),
+			_pSlot(0),
+			_pEnd(0)
+		{
+		}
+
+		ConstIterator(const Control* pCtrl, Value* pSlot, const Control* pEnd):
+			_pCtrl(pCtrl),
+			_pSlot(pSlot),
+			_pEnd(pEnd)
+		{
+			skipFree();
+		}
+
+		bool operator == (const ConstIterator& it) const
+		{
+			return _pCtrl == it._pCtrl;
+		}
+
+		bool operator != (const ConstIterator& it) const
+		{
+			return _pCtrl != it._pCtrl;
+		}
+
+		const Value& operator * () const
+		{
+			return *_pSlot;
+		}
+
+		const Value* operator -> () const
+		{
+			return _pSlot;
+		}
+
+		ConstIterator& operator ++ () // prefix
+		{
+			++_pCtrl;
+			++_pSlot;
+			skipFree();
+			return *this;
+		}
+
+		ConstIterator operator ++ (int) // postfix
+		{
+			ConstIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+	protected:
+		void skipFree()
+		{
+			while (_pCtrl != _pEnd && *_pCtrl < 0)
+			{
+				++_pCtrl;
+				++_pSlot;
+			}
+		}
+
+		const Control* _pCtrl;
+		Value*         _pSlot;
+		const Control* _pEnd;
+
+		friend class FlatHashTable;
+	};
+
+	class Iterator: public ConstIterator
+	{
+	public:
+		Iterator()
+		{
+		}
+
+		Iterator(const Control* pCtrl, Value* pSlot, const Control* pEnd):
+			ConstIterator(pCtrl, pSlot, pEnd)
+		{
+		}
+
+		Value& operator * ()
+		{
+			return *this->_pSlot;
+		}
+
+		const Value& operator * () const
+		{
+			return *this->_pSlot;
+		}
+
+		Value* operator -> ()
+		{
+			return this->_pSlot;
+		}
+
+		const Value* operator -> () const
+		{
+			return this->_pSlot;
+		}
+
+		Iterator& operator ++ () // prefix
+		{
+			ConstIterator::operator ++ ();
+			return *this;
+		}
+
+		Iterator operator ++ (int) // postfix
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		friend class FlatHashTable;
+	};
+
+	FlatHashTable(std::size_t initialReserve = 64):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable, with room for at least
+		/// initialReserve elements.
+	{
+		allocate(calcCapacity(initialReserve));
+	}
+
+	FlatHashTable(const FlatHashTable& table):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0),
+		_hash(table._hash)
+		/// Creates the FlatHashTable by copying another one.
+	{
+		allocate(calcCapacity(table._size));
+		for (ConstIterator it = table.begin(); it != table.end(); ++it)
+		{
+			insertUnique(hashOf(*it), *it);
+		}
+	}
+
+	~FlatHashTable()
+		/// Destroys the FlatHashTable.
+	{
+		destroy();
+	}
+
+	FlatHashTable& operator = (const FlatHashTable& table)
+		/// Assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashTable& table)
+		/// Swaps the FlatHashTable with another one.
+	{
+		using std::swap;
+		swap(_pCtrl, table._pCtrl);
+		swap(_pSlots, table._pSlots);
+		swap(_capacity, table._capacity);
+		swap(_size, table._size);
+		swap(_growthLeft, table._growthLeft);
+		swap(_hash, table._hash);
+	}
+
+	ConstIterator begin() const
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return ConstIterator(_pCtrl, _pSlots, _pCtrl + _capacity);
+	}
+
+	ConstIterator end() const
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return ConstIterator(_pCtrl + _capacity, _pSlots + _capacity, _pCtrl + _capacity);
+	}
+
+	Iterator begin()
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return Iterator(_pCtrl, _pSlots, _pCtrl + _capacity);
+	}
+
+	Iterator end()
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return Iterator(_pCtrl + _capacity, _pSlots + _capacity, _pCtrl + _capacity);
+	}
+
+	ConstIterator find(const Value& value) const
+		/// Finds an entry in the table.
+	{
+		std::size_t pos = findPosition(hashOf(value), value);
+		if (pos != _capacity)
+			return ConstIterator(_pCtrl + pos, _pSlots + pos, _pCtrl + _capacity);
+		else
+			return end();
+	}
+
+	Iterator find(const Value& value)
+		/// Finds an entry in the table.
+	{
+		std::size_t pos = findPosition(hashOf(value), value);
+		if (pos != _capacity)
+			return Iterator(_pCtrl + pos, _pSlots + pos, _pCtrl + _capacity);
+		else
+			return end();
+	}
+
+	std::size_t count(const Value& value) const
+		/// Returns the number of elements with the given
+		/// value, with is either 1 or 0.
+	{
+		return findPosition(hashOf(value), value) != _capacity ? 1 : 0;
+	}
+
+	std::pair<Iterator, bool> insert(const Value& value)
+		/// Inserts an element into the table.
+		///
+		/// If the element already exists in the table,
+		/// a pair(iterator, false) with iterator pointing to the
+		/// existing element is returned.
+		/// Otherwise, the element is inserted an a
+		/// pair(iterator, true) with iterator
+		/// pointing to the new element is returned.
+	{
+		std::size_t hash = hashOf(value);
+		std::size_t pos = findPosition(hash, value);
+		if (pos != _capacity)
+		{
+			return std::make_pair(Iterator(_pCtrl + pos, _pSlots + pos, _pCtrl + _capacity), false);
+		}
+		if (_growthLeft == 0) grow();
+		pos = insertUnique(hash, value);
+		return std::make_pair(Iterator(_pCtrl + pos, _pSlots + pos, _pCtrl + _capacity), true);
+	}
+
+	void erase(Iterator it)
+		/// Erases the element pointed to by it.
+	{
+		if (it != end())
+		{
+			std::size_t pos = it._pCtrl - _pCtrl;
+			_pSlots[pos].~Value();
+			_pCtrl[pos] = CTRL_DELETED;
+			--_size;
+		}
+	}
+
+	void erase(const Value& value)
+		/// Erases the element with the given value, if it exists.
+	{
+		Iterator it = find(value);
+		erase(it);
+	}
+
+	void clear()
+		/// Erases all elements.
+	{
+		FlatHashTable emptyTable;
+		swap(emptyTable);
+	}
+
+	std::size_t size() const
+		/// Returns the number of elements in the table.
+	{
+		return _size;
+	}
+
+	bool empty() const
+		/// Returns true iff the table is empty.
+	{
+		return _size == 0;
+	}
+
+	std::size_t buckets() const
+		/// Returns the number of allocated slots.
+	{
+		return _capacity;
+	}
+
+protected:
+	enum
+	{
+		GROUP_WIDTH = 16
+	};
+
+	enum
+	{
+		CTRL_EMPTY   = -128,
+		CTRL_DELETED = -2
+	};
+
+	static std::size_t mix(std::size_t hash)
+		/// Spreads the bits of the given hash value,
+		/// as hash functions like Poco::hash(Int32)
+		/// leave the high bits mostly unused.
+	{
+#if defined(POCO_PTR_IS_64_BIT)
+		UInt64 h = static_cast<UInt64>(hash)*0x9E3779B97F4A7C15ULL;
+		return static_cast<std::size_t>(h ^ (h >> 32));
+#else
+		UInt32 h = static_cast<UInt32>(hash)*0x9E3779B1U;
+		return static_cast<std::size_t>(h ^ (h >> 16));
+#endif
+	}
+
+	std::size_t hashOf(const Value& value) const
+	{
+		return mix(_hash(value));
+	}
+
+	static Control h2(std::size_t hash)
+	{
+		return static_cast<Control>(hash & 0x7F);
+	}
+
+	std::size_t firstGroup(std::size_t hash) const
+	{
+		return ((hash >> 7)*GROUP_WIDTH) & (_capacity - 1);
+	}
+
+	std::size_t nextGroup(std::size_t group, std::size_t probe) const
+		/// Triangular probing over groups visits every
+		/// group, as the number of groups is a power of two.
+	{
+		return (group + probe*GROUP_WIDTH) & (_capacity - 1);
+	}
+
+#if defined(POCO_FLAT_HASH_TABLE_SSE2)
+
+	static unsigned matchControl(const Control* pGroup, Control ctrl)
+	{
+		__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pGroup));
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(ctrl))));
+	}
+
+	static unsigned matchFree(const Control* pGroup)
+		/// Returns a bit mask of the empty or deleted
+		/// slots in the group.
+	{
+		__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pGroup));
+		return static_cast<unsigned>(_mm_movemask_epi8(group));
+	}
+
+#else
+
+	static unsigned matchControl(const Control* pGroup, Control ctrl)
+	{
+		unsigned mask = 0;
+		for (int i = 0; i < GROUP_WIDTH; ++i)
+		{
+			if (pGroup[i] == ctrl) mask |= 1U << i;
+		}
+		return mask;
+	}
+
+	static unsigned matchFree(const Control* pGroup)
+	{
+		unsigned mask = 0;
+		for (int i = 0; i < GROUP_WIDTH; ++i)
+		{
+			if (pGroup[i] < 0) mask |= 1U << i;
+		}
+		return mask;
+	}
+
+#endif
+
+	static unsigned lowestBit(unsigned mask)
+	{
+#if defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+		unsigned n = 0;
+		while (!(mask & 1))
+		{
+			mask >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	std::size_t findPosition(std::size_t hash, const Value& value) const
+		/// Returns the position of the given value,
+		/// or _capacity if it is not in the table.
+	{
+		Control ctrl = h2(hash);
+		std::size_t group = firstGroup(hash);
+		for (std::size_t probe = 1; probe <= _capacity/GROUP_WIDTH; ++probe)
+		{
+			const Control* pGroup = _pCtrl + group;
+			unsigned mask = matchControl(pGroup, ctrl);
+			while (mask)
+			{
+				unsigned i = lowestBit(mask);
+				if (_pSlots[group + i] == value) return group + i;
+				mask &= mask - 1;
+			}
+			if (matchControl(pGroup, CTRL_EMPTY)) break;
+			group = nextGroup(group, probe);
+		}
+		return _capacity;
+	}
+
+	std::size_t insertUnique(std::size_t hash, const Value& value)
+		/// Inserts a value not yet in the table, which
+		/// must have room for it, and returns its position.
+	{
+		std::size_t group = firstGroup(hash);
+		std::size_t probe = 1;
+		unsigned mask = matchFree(_pCtrl + group);
+		while (!mask)
+		{
+			group = nextGroup(group, probe++);
+			mask = matchFree(_pCtrl + group);
+		}
+		std::size_t pos = group + lowestBit(mask);
+		new (_pSlots + pos) Value(value);
+		if (_pCtrl[pos] == CTRL_EMPTY) --_growthLeft;
+		_pCtrl[pos] = h2(hash);
+		++_size;
+		return pos;
+	}
+
+	void grow()
+		/// Rehashes the table. The capacity is doubled,
+		/// unless the table is mostly filled with deleted slots.
+	{
+		std::size_t capacity = _size < maxLoad(_capacity)/2 ? _capacity : 2*_capacity;
+		FlatHashTable tmp(maxLoad(capacity));
+		for (Iterator it = begin(); it != end(); ++it)
+		{
+			tmp.insertUnique(hashOf(*it), *it);
+		}
+		swap(tmp);
+	}
+
+	static std::size_t maxLoad(std::size_t capacity)
+	{
+		return capacity - capacity/8;
+	}
+
+	static std::size_t calcCapacity(std::size_t size)
+	{
+		std::size_t capacity = GROUP_WIDTH;
+		while (maxLoad(capacity) < size) capacity *= 2;
+		return capacity;
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		_pSlots = static_cast<Value*>(::operator new(capacity*sizeof(Value)));
+		try
+		{
+			_pCtrl = new Control[capacity];
+		}
+		catch (...)
+		{
+			::operator delete(_pSlots);
+			_pSlots = 0;
+			throw;
+		}
+		std::memset(_pCtrl, CTRL_EMPTY, capacity);
+		_capacity = capacity;
+		_size = 0;
+		_growthLeft = maxLoad(capacity);
+	}
+
+	void destroy()
+	{
+		for (std::size_t i = 0; i < _capacity; ++i)
+		{
+			if (_pCtrl[i] >= 0) _pSlots[i].~Value();
+		}
+		delete [] _pCtrl;
+		::operator delete(_pSlots);
+		_pCtrl = 0;
+		_pSlots = 0;
+		_capacity = 0;
+		_size = 0;
+		_growthLeft = 0;
+	}
+
+private:
+	Control*    _pCtrl;
+	Value*      _pSlots;
+	std::size_t _capacity;
+	std::size_t _size;
+	std::size_t _growthLeft;
+	HashFunc    _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashTable_INCLUDED
@@ -0,0 +1,414 @@
+//
+// Future.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Executor
+//
+// Definition of the Future class template and its helpers.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Future_INCLUDED
+#define Foundation_Future_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Executor;
+
+
+class Foundation_API FutureHolderBase
+	/// The shared state of a Future, apart from the value.
+	///
+	/// Do not use this class directly, use Future instead.
+{
+public:
+	typedef std::function<void()> Continuation;
+
+	explicit FutureHolderBase(Executor* pExecutor);
+		/// Creates the FutureHolderBase. Continuations are
+		/// run by the given Executor, or, if it is null,
+		/// by the thread that completes the future.
+
+	virtual ~FutureHolderBase();
+		/// Destroys the FutureHolderBase.
+
+	void wait();
+		/// Waits until the result is available.
+		///
+		/// If called by a worker thread of an Executor, the
+		/// thread runs other pending tasks while waiting.
+
+	bool tryWait(long milliseconds);
+		/// Waits up to the given time until the result is available.
+		/// Returns true if the result is available.
+
+	bool ready() const;
+		/// Returns true if the result is available.
+
+	void setException(std::exception_ptr exc);
+		/// Completes the future with the given exception.
+
+	std::exception_ptr exception() const;
+		/// Returns the exception the future has been completed
+		/// with, or a null pointer. Must only be called once the
+		/// result is available.
+
+	void rethrow() const;
+		/// Rethrows the exception the future has been completed with,
+		/// if any. Must only be called once the result is available.
+
+	void onReady(const Continuation& continuation);
+		/// Registers a continuation to be run when the result is
+		/// available, or runs it right away if it is.
+		///
+		/// If the Executor has been shut down, the continuation
+		/// is run by the thread that completes the future, or
+		/// that calls onReady().
+
+	Executor* executor() const;
+		/// Returns the Executor that runs continuations, or null.
+
+protected:
+	void complete();
+		/// Makes the result available and runs the continuations.
+		/// Exceptions thrown by continuations run in the calling
+		/// thread are passed to the ErrorHandler.
+
+private:
+	FutureHolderBase(const FutureHolderBase&);
+	FutureHolderBase& operator = (const FutureHolderBase&);
+
+	void run(const Continuation& continuation);
+
+	Executor*                 _pExecutor;
+	std::atomic<bool>         _ready;
+	std::exception_ptr        _exception;
+	std::vector<Continuation> _continuations;
+	Event                     _event;
+	mutable FastMutex         _mutex;
+};
+
+
+template <class T>
+class FutureHolder: public FutureHolderBase
+	/// The shared state of a Future.
+	///
+	/// Do not use this class directly, use Future instead.
+{
+public:
+	explicit FutureHolder(Executor* pExecutor):
+		FutureHolderBase(pExecutor)
+	{
+	}
+
+	void setValue(const T& value)
+	{
+		_pValue.reset(new T(value));
+		complete();
+	}
+
+	void setValue(T&& value)
+	{
+		_pValue.reset(new T(std::move(value)));
+		complete();
+	}
+
+	const T& value() const
+	{
+		return *_pValue;
+	}
+
+	template <class F>
+	void run(F& f)
+		/// Calls f and completes the future with its
+		/// result or exception.
+	{
+		try
+		{
+			_pValue.reset(new T(f()));
+		}
+		catch (...)
+		{
+			setException(std::current_exception());
+			return;
+		}
+		complete();
+	}
+
+private:
+	std::unique_ptr<T> _pValue;
+};
+
+
+template <>
+class FutureHolder<void>: public FutureHolderBase
+	/// The shared state of a Future<void>.
+	///
+	/// Do not use this class directly, use Future instead.
+{
+public:
+	explicit FutureHolder(Executor* pExecutor):
+		FutureHolderBase(pExecutor)
+	{
+	}
+
+	void setValue()
+	{
+		complete();
+	}
+
+	template <class F>
+	void run(F& f)
+		/// Calls f and completes the future, with f's
+		/// exception if it throws.
+	{
+		try
+		{
+			f();
+		}
+		catch (...)
+		{
+			setException(std::current_exception());
+			return;
+		}
+		setValue();
+	}
+};
+
+
+template <class T>
+class Future
+	/// A Future holds the result of a task submitted to an
+	/// Executor (see Executor::submit()).
+	///
+	/// The result can be obtained with get(), which waits for
+	/// the task to complete and rethrows any exception thrown
+	/// by the task. Alternatively, a continuation can be attached
+	/// with then(); it is run by the Executor when the result
+	/// is available and yields another Future.
+	///
+	/// Futures are cheap to copy; all copies share the same result.
+{
+public:
+	typedef FutureHolder<T> Holder;
+	typedef std::shared_ptr<Holder> HolderPtr;
+
+	Future()
+		/// Creates an empty Future.
+	{
+	}
+
+	explicit Future(const HolderPtr& pHolder):
+		_pHolder(pHolder)
+		/// Creates the Future for the given shared state.
+	{
+	}
+
+	bool valid() const
+		/// Returns true if the Future has a shared state.
+	{
+		return _pHolder.get() != 0;
+	}
+
+	bool ready() const
+		/// Returns true if the result is available.
+	{
+		return holder().ready();
+	}
+
+	void wait() const
+		/// Waits until the result is available.
+	{
+		holder().wait();
+	}
+
+	void wait(long milliseconds) const
+		/// Waits up to the given time until the result is available.
+		/// Throws a TimeoutException if it is not available in time.
+	{
+		if (!holder().tryWait(milliseconds))
+			throw TimeoutException("Future result not available");
+	}
+
+	bool tryWait(long milliseconds) const
+		/// Waits up to the given time until the result is available.
+		/// Returns true if the result is available.
+	{
+		return holder().tryWait(milliseconds);
+	}
+
+	const T& get() const
+		/// Waits for the result and returns it. Rethrows the
+		/// exception thrown by the task, if any.
+	{
+		holder().wait();
+		holder().rethrow();
+		return holder().value();
+	}
+
+	template <class F>
+	auto then(F f) const -> Future<decltype(f(std::declval<const T&>()))>
+		/// Returns a Future for the result of calling f with the result
+		/// of this Future, once it is available. If this Future holds an
+		/// exception, f is not called and the exception is passed on.
+	{
+		typedef decltype(f(std::declval<const T&>())) R;
+
+		std::shared_ptr<FutureHolder<R>> pNext(new FutureHolder<R>(holder().executor()));
+		HolderPtr pThis(_pHolder);
+		_pHolder->onReady([pThis, pNext, f]() mutable
+			{
+				if (pThis->exception())
+				{
+					pNext->setException(pThis->exception());
+				}
+				else
+				{
+					auto call = [&]() { return f(pThis->value()); };
+					pNext->run(call);
+				}
+			});
+		return Future<R>(pNext);
+	}
+
+private:
+	Holder& holder() const
+	{
+		poco_check_ptr (_pHolder.get());
+
+		return *_pHolder;
+	}
+
+	HolderPtr _pHolder;
+};
+
+
+template <>
+class Future<void>
+	/// A Future for a task that does not return a value.
+	/// See the Future class template for more information.
+{
+public:
+	typedef FutureHolder<void> Holder;
+	typedef std::shared_ptr<Holder> HolderPtr;
+
+	Future()
+	{
+	}
+
+	explicit Future(const HolderPtr& pHolder):
+		_pHolder(pHolder)
+	{
+	}
+
+	bool valid() const
+	{
+		return _pHolder.get() != 0;
+	}
+
+	bool ready() const
+	{
+		return holder().ready();
+	}
+
+	void wait() const
+	{
+		holder().wait();
+	}
+
+	void wait(long milliseconds) const
+	{
+		if (!holder().tryWait(milliseconds))
+			throw TimeoutException("Future result not available");
+	}
+
+	bool tryWait(long milliseconds) const
+	{
+		return holder().tryWait(milliseconds);
+	}
+
+	void get() const
+		/// Waits for the task to complete. Rethrows the
+		/// exception thrown by the task, if any.
+	{
+		holder().wait();
+		holder().rethrow();
+	}
+
+	template <class F>
+	auto then(F f) const -> Future<decltype(f())>
+		/// Returns a Future for the result of calling f once this
+		/// Future has completed. If this Future holds an exception,
+		/// f is not called and the exception is passed on.
+	{
+		typedef decltype(f()) R;
+
+		std::shared_ptr<FutureHolder<R>> pNext(new FutureHolder<R>(holder().executor()));
+		HolderPtr pThis(_pHolder);
+		_pHolder->onReady([pThis, pNext, f]() mutable
+			{
+				if (pThis->exception())
+					pNext->setException(pThis->exception());
+				else
+					pNext->run(f);
+			});
+		return Future<R>(pNext);
+	}
+
+private:
+	Holder& holder() const
+	{
+		poco_check_ptr (_pHolder.get());
+
+		return *_pHolder;
+	}
+
+	HolderPtr _pHolder;
+};
+
+
+//
+// inlines
+//
+inline bool FutureHolderBase::ready() const
+{
+	return _ready.load(std::memory_order_acquire);
+}
+
+
+inline std::exception_ptr FutureHolderBase::exception() const
+{
+	return _exception;
+}
+
+
+inline Executor* FutureHolderBase::executor() const
+{
+	return _pExecutor;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Future_INCLUDED
@@ -78,11 +78,16 @@ private:
 };
 
 
-template <class Key, class Mapped, class HashFunc = Hash<Key> >
+template <class Key, class Mapped, class HashFunc = Hash<Key>, template <class, class> class Table = LinearHashTable>
 class HashMap
 	/// This class implements a map using a LinearHashTable.
 	///
 	/// A HashMap can be used just like a std::map.
+	///
+	/// The underlying hash table can be selected with the
+	/// Table template argument. Passing FlatHashTable
+	/// (see FlatHashMap) stores all entries in a single
+	/// open addressing table.
 {
 public:
 	typedef Key                 KeyType;
@@ -96,7 +101,7 @@ public:
 	typedef std::pair<KeyType, MappedType> PairType;
 	
 	typedef HashMapEntryHash<ValueType, HashFunc> HashType;
-	typedef LinearHashTable<ValueType, HashType>  HashTable;
+	typedef Table<ValueType, HashType>            HashTable;
 	
 	typedef typename HashTable::Iterator      Iterator;
 	typedef typename HashTable::ConstIterator ConstIterator;
@@ -203,7 +208,8 @@ public:
 
 	ConstReference operator [] (const KeyType& key) const
 	{
-		ConstIterator it = _table.find(key);
+		ValueType value(key);
+		ConstIterator it = _table.find(value);
 		if (it != _table.end())
 			return it->second;
 		else
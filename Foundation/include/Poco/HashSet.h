@@ -25,11 +25,16 @@
 namespace Poco {
 
 
-template <class Value, class HashFunc = Hash<Value> >
+template <class Value, class HashFunc = Hash<Value>, template <class, class> class Table = LinearHashTable>
 class HashSet
 	/// This class implements a set using a LinearHashTable.
 	///
 	/// A HashSet can be used just like a std::set.
+	///
+	/// The underlying hash table can be selected with the
+	/// Table template argument. Passing FlatHashTable
+	/// (see FlatHashSet) stores all elements in a single
+	/// open addressing table.
 {
 public:
 	typedef Value        ValueType;
@@ -39,7 +44,7 @@ public:
 	typedef const Value* ConstPointer;
 	typedef HashFunc     Hash;
 	
-	typedef LinearHashTable<ValueType, Hash> HashTable;
+	typedef Table<ValueType, Hash>           HashTable;
 	
 	typedef typename HashTable::Iterator      Iterator;
 	typedef typename HashTable::ConstIterator ConstIterator;
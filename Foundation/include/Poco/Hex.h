@@ -0,0 +1,68 @@
+//
+// Hex.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Hex
+//
+// Definition of class Hex.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Hex_INCLUDED
+#define Foundation_Hex_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+
+
+namespace Poco {
+
+
+class Foundation_API Hex
+	/// This class provides static member functions for
+	/// hexadecimal (hexBinary) encoding and decoding
+	/// of memory buffers. Each byte is encoded as
+	/// two hexadecimal digits.
+	///
+	/// On x86 and x64 processors, encoding and decoding
+	/// are done 32 or 16 bytes at a time using AVX2 or SSSE3
+	/// instructions, if supported by the processor.
+	///
+	/// See HexBinaryEncoder and HexBinaryDecoder for streams
+	/// that encode and decode data on the fly.
+{
+public:
+	static std::size_t encode(const void* buffer, std::size_t length, char* encoded, bool uppercase = false);
+		/// Encodes length bytes from buffer and writes the
+		/// 2*length hexadecimal digits to encoded. The result
+		/// is not zero-terminated.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const std::string& data, bool uppercase = false);
+		/// Returns the hexadecimal encoding of the given data.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* buffer);
+		/// Decodes length hexadecimal digits (upper or lower case)
+		/// and writes the length/2 bytes to buffer.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if length is odd, or if the
+		/// input contains other characters (including whitespace).
+
+	static std::string decode(const std::string& encoded);
+		/// Returns the decoded data for the given hexadecimal string.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Hex_INCLUDED
@@ -39,15 +39,30 @@ class Foundation_API HexBinaryDecoderBuf: public UnbufferedStreamBuf
 	/// underlying streambuf, so the state
 	/// of the istream will not reflect that of
 	/// its streambuf.
+	///
+	/// Data read in blocks (e.g., with istream::read()
+	/// or StreamCopier) is decoded using Hex::decode().
+	/// No more characters are taken from the istream than
+	/// are needed to produce the requested number of bytes.
 {
 public:
 	HexBinaryDecoderBuf(std::istream& istr);
 	~HexBinaryDecoderBuf();
 	
 private:
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
+
 	int readFromDevice();
+	std::streamsize xsgetn(char* p, std::streamsize count);
 	int readOne();
+	int readChars(int maxChars);
 
+	char            _pending[BUFFER_SIZE];
+	int             _pendingPos;
+	int             _pendingEnd;
 	std::streambuf& _buf;
 };
 
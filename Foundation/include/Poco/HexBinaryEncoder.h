@@ -35,6 +35,10 @@ class Foundation_API HexBinaryEncoderBuf: public UnbufferedStreamBuf
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// Data written in blocks (e.g., with ostream::write()
+	/// or StreamCopier) is encoded a line at a time using
+	/// Hex::encode().
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -62,7 +66,13 @@ public:
 		/// Specify whether hex digits a-f are written in upper or lower case.
 	
 private:
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
+
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
 
 	int _pos;
 	int _lineLength;
@@ -100,6 +110,10 @@ class Foundation_API HexBinaryEncoder: public HexBinaryEncoderIOS, public std::o
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// Data written in blocks (e.g., with ostream::write()
+	/// or StreamCopier) is encoded a line at a time using
+	/// Hex::encode().
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -45,10 +45,25 @@ public:
 	void write(const std::string& text, bool flush = true);
 		/// Writes the given text to the log file.
 		/// If flush is true, the text will be immediately
-		/// flushed to the file.
+		/// flushed to the file. Otherwise, the text is
+		/// collected in the write buffer until the buffer
+		/// is full or flush() is called.
+
+	void flush();
+		/// Writes the contents of the write buffer to the file.
+
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the write buffer in bytes
+		/// (default DEFAULT_BUFFER_SIZE). Texts written
+		/// with flush set to false are collected in the
+		/// buffer until it is full.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the write buffer in bytes.
 
 	UInt64 size() const;
-		/// Returns the current size in bytes of the log file.
+		/// Returns the current size in bytes of the log file,
+		/// including the contents of the write buffer.
 
 	Timestamp creationDate() const;
 		/// Returns the date and time the log file was created.
@@ -67,6 +82,24 @@ inline void LogFile::write(const std::string& text, bool flush)
 }
 
 
+inline void LogFile::flush()
+{
+	flushImpl();
+}
+
+
+inline void LogFile::setBufferSize(std::size_t size)
+{
+	setBufferSizeImpl(size);
+}
+
+
+inline std::size_t LogFile::getBufferSize() const
+{
+	return getBufferSizeImpl();
+}
+
+
 inline UInt64 LogFile::size() const
 {
 	return sizeImpl();
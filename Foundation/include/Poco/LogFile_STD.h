@@ -5,7 +5,7 @@
 // Package: Logging
 // Module:  LogFile
 //
-// Definition of the LogFileImpl class using iostreams.
+// Definition of the LogFileImpl class using POSIX file descriptors.
 //
 // Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
 // and Contributors.
@@ -20,7 +20,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
-#include "Poco/FileStream.h"
+#include <string>
 
 
 namespace Poco {
@@ -30,20 +30,35 @@ class Foundation_API LogFileImpl
 	/// The implementation of LogFile for non-Windows platforms.
 	/// The native filesystem APIs are used for
 	/// total control over locking behavior.
+	///
+	/// The file is opened with O_APPEND. Messages are collected in
+	/// a write buffer and written with a single writev() call
+	/// together with the message that causes the buffer to be
+	/// written. The file size is tracked locally.
 {
 public:
+	static const std::size_t DEFAULT_BUFFER_SIZE = 8192;
+
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
 	void writeImpl(const std::string& text, bool flush);
+	void flushImpl();
+	void setBufferSizeImpl(std::size_t size);
+	std::size_t getBufferSizeImpl() const;
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
 
 private:
+	void openFile();
+	void writeFile(const char* pData1, std::size_t size1, const char* pData2, std::size_t size2, const char* pData3, std::size_t size3);
+
 	std::string _path;
-	mutable Poco::FileOutputStream _str;
-	Timestamp _creationDate;
-	UInt64 _size;
+	int         _fd;
+	std::string _buffer;
+	std::size_t _bufferSize;
+	Timestamp   _creationDate;
+	UInt64      _size;
 };
 
 
@@ -21,6 +21,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
 #include "Poco/UnWindows.h"
+#include <string>
 
 
 namespace Poco {
@@ -30,20 +31,31 @@ class Foundation_API LogFileImpl
 	/// The implementation of LogFile for Windows.
 	/// The native filesystem APIs are used for
 	/// total control over locking behavior.
+	///
+	/// Messages are collected in a write buffer, which
+	/// is written with a single WriteFile() call.
 {
 public:
+	static const std::size_t DEFAULT_BUFFER_SIZE = 8192;
+
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
 	void writeImpl(const std::string& text, bool flush);
+	void flushImpl();
+	void setBufferSizeImpl(std::size_t size);
+	std::size_t getBufferSizeImpl() const;
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
 
 private:
 	void createFile();
+	void writeBuffer();
 
 	std::string _path;
 	HANDLE      _hFile;
+	std::string _buffer;
+	std::size_t _bufferSize;
 	Timestamp   _creationDate;
 };
 
@@ -23,6 +23,7 @@
 #include "Poco/Message.h"
 #include "Poco/Format.h"
 #include "Poco/AutoPtr.h"
+#include <atomic>
 #include <map>
 #include <vector>
 #include <cstddef>
@@ -78,6 +79,11 @@ class Foundation_API Logger: public Channel
 	/// Examples:
 	///     poco_warning(logger, "This is a warning");
 	///     poco_information_f2(logger, "An informational message with args: %d, %d", 1, 2);
+	///
+	/// Looking up an existing logger with get(), root() or has() does not
+	/// acquire a lock, and neither does checking the log level, so these
+	/// can be called frequently from many threads. Creating, destroying and
+	/// reconfiguring loggers is serialized.
 {
 public:
 	typedef AutoPtr<Logger> Ptr;
@@ -448,8 +454,6 @@ public:
 	static const std::string ROOT; /// The name of the root logger ("").
 
 protected:
-	typedef std::map<std::string, Ptr> LoggerMap;
-
 	Logger(const std::string& name, Channel::Ptr pChannel, int level);
 	~Logger();
 
@@ -462,19 +466,22 @@ protected:
 	static Ptr find(const std::string& name);
 
 private:
-	typedef std::unique_ptr<LoggerMap> LoggerMapPtr;
+	struct Entry;
+	struct Table;
 
 	Logger();
 	Logger(const Logger&);
 	Logger& operator = (const Logger&);
 
-	std::string  _name;
-	Channel::Ptr _pChannel;
-	int          _level;
+	static Logger* lookup(const std::string& name);
+
+	std::string      _name;
+	Channel::Ptr     _pChannel;
+	std::atomic<int> _level;
 
 	// definitions in Foundation.cpp
-	static LoggerMapPtr _pLoggerMap;
-	static Mutex        _mapMtx;
+	static std::atomic<Table*> _pTable;
+	static Mutex               _mapMtx;
 };
 
 
@@ -625,13 +632,13 @@ inline const std::string& Logger::name() const
 
 inline int Logger::getLevel() const
 {
-	return _level;
+	return _level.load(std::memory_order_relaxed);
 }
 
 
 inline void Logger::log(const std::string& text, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio));
 	}
@@ -640,7 +647,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 
 inline void Logger::log(const std::string& text, Message::Priority prio, const char* file, int line)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio, file, line));
 	}
@@ -746,55 +753,55 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 
 inline bool Logger::is(int level) const
 {
-	return _level >= level;
+	return getLevel() >= level;
 }
 
 
 inline bool Logger::fatal() const
 {
-	return _level >= Message::PRIO_FATAL;
+	return getLevel() >= Message::PRIO_FATAL;
 }
 
 
 inline bool Logger::critical() const
 {
-	return _level >= Message::PRIO_CRITICAL;
+	return getLevel() >= Message::PRIO_CRITICAL;
 }
 
 
 inline bool Logger::error() const
 {
-	return _level >= Message::PRIO_ERROR;
+	return getLevel() >= Message::PRIO_ERROR;
 }
 
 
 inline bool Logger::warning() const
 {
-	return _level >= Message::PRIO_WARNING;
+	return getLevel() >= Message::PRIO_WARNING;
 }
 
 
 inline bool Logger::notice() const
 {
-	return _level >= Message::PRIO_NOTICE;
+	return getLevel() >= Message::PRIO_NOTICE;
 }
 
 
 inline bool Logger::information() const
 {
-	return _level >= Message::PRIO_INFORMATION;
+	return getLevel() >= Message::PRIO_INFORMATION;
 }
 
 
 inline bool Logger::debug() const
 {
-	return _level >= Message::PRIO_DEBUG;
+	return getLevel() >= Message::PRIO_DEBUG;
 }
 
 
 inline bool Logger::trace() const
 {
-	return _level >= Message::PRIO_TRACE;
+	return getLevel() >= Message::PRIO_TRACE;
 }
 
 
@@ -0,0 +1,218 @@
+//
+// MappedFile.h
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Definition of the MappedFile class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFile_INCLUDED
+#define Foundation_MappedFile_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <cstddef>
+#include <string>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFile
+	/// MappedFile maps a file, or a window into a file, into memory.
+	///
+	/// Unlike SharedMemory, which always maps a file as a whole,
+	/// MappedFile can map an arbitrary range of the file. Files
+	/// larger than the available address space can therefore be
+	/// processed by moving a window of fixed size over them.
+	///
+	/// The expected access pattern can be passed to the operating
+	/// system with advise(). The hint is kept and applied to every
+	/// window mapped later.
+	///
+	/// A mapping cannot change the size of the file; only existing
+	/// data can be modified in AM_WRITE mode.
+	///
+	/// The size of the file is determined when it is opened and
+	/// is not updated if the file grows or shrinks afterwards; see
+	/// fileSize(). If the file is truncated by another process while
+	/// it is mapped, accessing a page beyond its new end raises a
+	/// SIGBUS signal (on Windows, an access violation), which is not
+	/// turned into an exception. Only map files that are not truncated
+	/// while in use.
+	///
+	/// To read a mapped file through a std::istream, see
+	/// MappedFileInputStream.
+{
+public:
+	enum AccessMode
+	{
+		AM_READ = 0,
+		AM_WRITE
+	};
+
+	enum Advice
+	{
+		ADV_NORMAL = 0,  /// No special treatment.
+		ADV_SEQUENTIAL,  /// Data will be accessed sequentially; read ahead aggressively.
+		ADV_RANDOM,      /// Data will be accessed randomly; do not read ahead.
+		ADV_WILLNEED     /// Data will be needed soon; start reading it in.
+	};
+
+	enum Options
+	{
+		OPT_HUGE_PAGES = 0x01,
+			/// Ask the system to back the mapping with huge pages,
+			/// if supported (transparent huge pages on Linux).
+		OPT_POPULATE   = 0x02
+			/// Read the entire window into memory when it is mapped,
+			/// if supported (Linux only).
+	};
+
+	MappedFile();
+		/// Creates a MappedFile without an open file.
+
+	MappedFile(const std::string& path, AccessMode mode = AM_READ, int options = 0);
+		/// Opens the given file and maps it as a whole.
+		///
+		/// Throws a FileException if the file cannot be opened,
+		/// or a SystemException if it cannot be mapped.
+
+	~MappedFile();
+		/// Unmaps and closes the file.
+
+	void open(const std::string& path, AccessMode mode = AM_READ, int options = 0);
+		/// Opens the given file, without mapping anything.
+		///
+		/// Throws a FileException if the file cannot be opened.
+
+	void close();
+		/// Unmaps and closes the file.
+
+	bool isOpen() const;
+		/// Returns true if a file is open.
+
+	void map(Poco::UInt64 offset = 0, std::size_t length = 0);
+		/// Maps the given range of the file, replacing the current
+		/// window, if any. The offset does not need to be aligned.
+		///
+		/// If length is 0, or the range extends beyond the end of
+		/// the file, the window ends at the end of the file.
+		///
+		/// Throws an InvalidArgumentException if offset is beyond the
+		/// end of the file, or a SystemException if the range cannot
+		/// be mapped.
+
+	void unmap();
+		/// Unmaps the current window.
+
+	void advise(Advice advice);
+		/// Passes a hint about the expected access pattern to the
+		/// system, for the current and all following windows.
+		///
+		/// Hints are ignored on platforms that do not support them.
+
+	void flush();
+		/// Writes modified data in the current window back to the file.
+
+	char* begin() const;
+		/// Returns the start address of the current window,
+		/// or NULL if nothing is mapped.
+
+	char* end() const;
+		/// Returns the one-past-end address of the current window,
+		/// or NULL if nothing is mapped.
+
+	std::size_t size() const;
+		/// Returns the size of the current window.
+
+	Poco::UInt64 offset() const;
+		/// Returns the position of the current window in the file.
+
+	Poco::UInt64 fileSize() const;
+		/// Returns the size of the file at the time it was opened.
+
+	const std::string& path() const;
+		/// Returns the path of the file.
+
+	static std::size_t granularity();
+		/// Returns the alignment required by the system for
+		/// the offset of a mapping (the page size on POSIX platforms,
+		/// and the allocation granularity on Windows).
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator = (const MappedFile&);
+
+	void applyAdvice();
+
+	std::string  _path;
+	AccessMode   _mode;
+	int          _options;
+	Advice       _advice;
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	void*        _hFile;
+	void*        _hMapping;
+#else
+	int          _fd;
+#endif
+	Poco::UInt64 _fileSize;
+	char*        _pMapping;
+	std::size_t  _mappingSize;
+	char*        _pBegin;
+	std::size_t  _size;
+	Poco::UInt64 _offset;
+};
+
+
+//
+// inlines
+//
+inline char* MappedFile::begin() const
+{
+	return _pBegin;
+}
+
+
+inline char* MappedFile::end() const
+{
+	return _pBegin ? _pBegin + _size : 0;
+}
+
+
+inline std::size_t MappedFile::size() const
+{
+	return _size;
+}
+
+
+inline Poco::UInt64 MappedFile::offset() const
+{
+	return _offset;
+}
+
+
+inline Poco::UInt64 MappedFile::fileSize() const
+{
+	return _fileSize;
+}
+
+
+inline const std::string& MappedFile::path() const
+{
+	return _path;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFile_INCLUDED
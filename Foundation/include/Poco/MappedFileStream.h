@@ -0,0 +1,143 @@
+//
+// MappedFileStream.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedFileStream
+//
+// Definition of the MappedFileStreamBuf, MappedFileIOS and MappedFileInputStream classes.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFileStream_INCLUDED
+#define Foundation_MappedFileStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/MappedFile.h"
+#include "Poco/StreamUtil.h"
+#include <streambuf>
+#include <istream>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFileStreamBuf: public std::streambuf
+	/// MappedFileStreamBuf is a read-only stream buffer that
+	/// makes the contents of a memory-mapped file available
+	/// to a std::istream, without copying them.
+	///
+	/// The file is mapped through a window of the given size,
+	/// which is moved over the file as it is read, so that
+	/// files of any size can be read. If the window size is 0,
+	/// the file is mapped as a whole.
+	///
+	/// Only the data present when the file was opened is read;
+	/// data appended later is not seen. Truncating the file while
+	/// it is being read raises a SIGBUS signal, not an exception
+	/// (see MappedFile).
+{
+public:
+	enum
+	{
+		DEFAULT_WINDOW_SIZE = 16*1024*1024
+	};
+
+	MappedFileStreamBuf(const std::string& path, std::size_t windowSize = DEFAULT_WINDOW_SIZE);
+		/// Opens the given file for reading, and advises the system
+		/// that it will be read sequentially.
+
+	~MappedFileStreamBuf();
+		/// Destroys the MappedFileStreamBuf.
+
+	MappedFile& file();
+		/// Returns the underlying MappedFile, e.g. to give a
+		/// different access pattern hint.
+
+protected:
+	int_type underflow();
+	std::streamsize showmanyc();
+	pos_type seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode mode = std::ios::in);
+	pos_type seekpos(pos_type pos, std::ios::openmode mode = std::ios::in);
+
+private:
+	Poco::UInt64 position() const;
+	void moveTo(Poco::UInt64 pos);
+
+	MappedFile   _file;
+	std::size_t  _windowSize;
+
+	MappedFileStreamBuf(const MappedFileStreamBuf&);
+	MappedFileStreamBuf& operator = (const MappedFileStreamBuf&);
+};
+
+
+class Foundation_API MappedFileIOS: public virtual std::ios
+	/// The base class for MappedFileInputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	MappedFileIOS(const std::string& path, std::size_t windowSize);
+		/// Creates the basic stream.
+
+	~MappedFileIOS();
+		/// Destroys the stream.
+
+	MappedFileStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying streambuf.
+
+protected:
+	MappedFileStreamBuf _buf;
+};
+
+
+class Foundation_API MappedFileInputStream: public MappedFileIOS, public std::istream
+	/// An input stream for reading a file through a memory mapping.
+	///
+	/// Can be used in place of a FileInputStream wherever
+	/// a std::istream is expected. Since the stream buffer
+	/// directly refers to the mapped file, no data is copied
+	/// into an intermediate buffer.
+	///
+	/// Unlike with a FileInputStream, the file must not be
+	/// truncated while it is being read, as this raises
+	/// a SIGBUS signal instead of an exception.
+	///
+	/// Throws a FileException if the file cannot be opened.
+{
+public:
+	MappedFileInputStream(const std::string& path, std::size_t windowSize = MappedFileStreamBuf::DEFAULT_WINDOW_SIZE);
+		/// Creates a MappedFileInputStream for the given file.
+
+	~MappedFileInputStream();
+		/// Destroys the MappedFileInputStream.
+};
+
+
+//
+// inlines
+//
+inline MappedFile& MappedFileStreamBuf::file()
+{
+	return _file;
+}
+
+
+inline MappedFileStreamBuf* MappedFileIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFileStream_INCLUDED
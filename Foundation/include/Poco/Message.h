@@ -132,6 +132,9 @@ public:
 	long getTid() const;
 		/// Returns the numeric thread identifier for the message.
 
+	void setOsTid(IntPtr tid);
+		/// Sets the numeric OS thread identifier for the message.
+
 	IntPtr getOsTid() const;
 		/// Returns the numeric OS thread identifier for the message.
 
@@ -0,0 +1,402 @@
+//
+// Parallel.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Parallel
+//
+// Definition of the parallel algorithms.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Parallel_INCLUDED
+#define Foundation_Parallel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Executor.h"
+#include "Poco/Mutex.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+namespace Poco {
+
+
+class ParallelPolicy
+	/// ParallelPolicy controls how the parallel algorithms
+	/// (parallelFor(), parallelReduce(), parallelTransform()
+	/// and parallelSort()) execute.
+	///
+	/// The algorithms split their range into chunks, which are
+	/// processed by the worker threads of an Executor and by the
+	/// calling thread. Chunks start large and become smaller
+	/// towards the end of the range, so that threads finish at
+	/// about the same time, but never become smaller than the
+	/// grain size. A range not larger than the grain size is
+	/// processed serially by the calling thread.
+	///
+	/// A policy can be used to cancel a running algorithm from
+	/// another thread, or from within the algorithm's function.
+	/// Chunks that have not been started when cancel() is called
+	/// are skipped, leaving the result incomplete.
+{
+public:
+	enum
+	{
+		DEFAULT_GRAIN_SIZE = 1024
+	};
+
+	ParallelPolicy():
+		_pExecutor(&Executor::defaultExecutor()),
+		_grainSize(DEFAULT_GRAIN_SIZE),
+		_cancelled(false)
+		/// Creates a ParallelPolicy using the default Executor
+		/// and the default grain size.
+	{
+	}
+
+	explicit ParallelPolicy(std::size_t grainSize):
+		_pExecutor(&Executor::defaultExecutor()),
+		_grainSize(grainSize),
+		_cancelled(false)
+		/// Creates a ParallelPolicy using the default Executor
+		/// and the given grain size.
+	{
+	}
+
+	ParallelPolicy(Executor& executor, std::size_t grainSize = DEFAULT_GRAIN_SIZE):
+		_pExecutor(&executor),
+		_grainSize(grainSize),
+		_cancelled(false)
+		/// Creates a ParallelPolicy using the given Executor
+		/// and grain size.
+	{
+	}
+
+	Executor& executor() const
+		/// Returns the Executor running the chunks.
+	{
+		return *_pExecutor;
+	}
+
+	void setGrainSize(std::size_t grainSize)
+		/// Sets the minimum number of elements in a chunk.
+	{
+		_grainSize = grainSize;
+	}
+
+	std::size_t getGrainSize() const
+		/// Returns the minimum number of elements in a chunk.
+	{
+		return _grainSize;
+	}
+
+	void cancel()
+		/// Cancels the algorithm using the policy.
+	{
+		_cancelled = true;
+	}
+
+	bool isCancelled() const
+		/// Returns true if cancel() has been called.
+	{
+		return _cancelled;
+	}
+
+private:
+	ParallelPolicy(const ParallelPolicy&);
+	ParallelPolicy& operator = (const ParallelPolicy&);
+
+	Executor*         _pExecutor;
+	std::size_t       _grainSize;
+	std::atomic<bool> _cancelled;
+};
+
+
+namespace Impl {
+
+
+template <class Body>
+void parallelChunks(std::size_t count, std::size_t grainSize, ParallelPolicy& policy, const Body& body)
+	/// Calls body(begin, end) for consecutive chunks of the
+	/// range [0, count), in parallel. Rethrows the first
+	/// exception thrown by body, after all chunks in progress
+	/// have finished.
+{
+	if (count == 0 || policy.isCancelled()) return;
+
+	if (grainSize == 0) grainSize = 1;
+	std::size_t helpers = std::min<std::size_t>(policy.executor().threads(), (count - 1)/grainSize);
+	if (helpers == 0)
+	{
+		body(0, count);
+		return;
+	}
+
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::exception_ptr exception;
+	FastMutex mutex;
+	const std::size_t divisor = 2*(helpers + 1);
+
+	auto work = [&]()
+	{
+		while (!failed && !policy.isCancelled())
+		{
+			std::size_t begin = next.load();
+			std::size_t size;
+			do
+			{
+				if (begin >= count) return;
+				std::size_t remaining = count - begin;
+				size = std::min(remaining, std::max(grainSize, remaining/divisor));
+			}
+			while (!next.compare_exchange_weak(begin, begin + size));
+
+			try
+			{
+				body(begin, begin + size);
+			}
+			catch (...)
+			{
+				FastMutex::ScopedLock lock(mutex);
+				if (!exception) exception = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<Future<void> > futures;
+	futures.reserve(helpers);
+	try
+	{
+		for (std::size_t i = 0; i < helpers; i++)
+		{
+			futures.push_back(policy.executor().submit(work));
+		}
+	}
+	catch (...)
+	{
+		// fewer helpers, e.g. because the Executor has been shut down
+	}
+	work();
+	for (std::vector<Future<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+	{
+		it->wait();
+	}
+	if (exception) std::rethrow_exception(exception);
+}
+
+
+} // namespace Impl
+
+
+template <class Index, class F>
+void parallelFor(Index first, Index last, F f, ParallelPolicy& policy)
+	/// Calls f(i) for every i in [first, last), in parallel.
+{
+	if (last <= first) return;
+
+	Impl::parallelChunks(static_cast<std::size_t>(last - first), policy.getGrainSize(), policy,
+		[first, &f](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				f(static_cast<Index>(first + i));
+			}
+		});
+}
+
+
+template <class Index, class F>
+void parallelFor(Index first, Index last, F f)
+	/// Calls f(i) for every i in [first, last), in parallel,
+	/// using a default ParallelPolicy.
+{
+	ParallelPolicy policy;
+	parallelFor(first, last, f, policy);
+}
+
+
+template <class Iterator, class T, class BinaryOp>
+T parallelReduce(Iterator first, Iterator last, T init, BinaryOp op, ParallelPolicy& policy)
+	/// Combines init and all elements in [first, last) with op,
+	/// in parallel. The operation must be associative, but need
+	/// not be commutative; elements are combined in order.
+{
+	typedef std::pair<std::size_t, T> Partial;
+
+	std::vector<Partial> partials;
+	FastMutex mutex;
+	Impl::parallelChunks(static_cast<std::size_t>(std::distance(first, last)), policy.getGrainSize(), policy,
+		[first, &op, &partials, &mutex](std::size_t begin, std::size_t end)
+		{
+			Iterator it = first + begin;
+			T value = *it;
+			for (++it; it != first + end; ++it)
+			{
+				value = op(value, *it);
+			}
+			FastMutex::ScopedLock lock(mutex);
+			partials.push_back(Partial(begin, value));
+		});
+
+	std::sort(partials.begin(), partials.end(),
+		[](const Partial& a, const Partial& b)
+		{
+			return a.first < b.first;
+		});
+	T result = init;
+	for (typename std::vector<Partial>::iterator it = partials.begin(); it != partials.end(); ++it)
+	{
+		result = op(result, it->second);
+	}
+	return result;
+}
+
+
+template <class Iterator, class T, class BinaryOp>
+T parallelReduce(Iterator first, Iterator last, T init, BinaryOp op)
+	/// Combines init and all elements in [first, last) with op,
+	/// in parallel, using a default ParallelPolicy.
+{
+	ParallelPolicy policy;
+	return parallelReduce(first, last, init, op, policy);
+}
+
+
+template <class Iterator, class T>
+T parallelReduce(Iterator first, Iterator last, T init)
+	/// Returns the sum of init and all elements in [first, last),
+	/// computed in parallel.
+{
+	ParallelPolicy policy;
+	return parallelReduce(first, last, init, std::plus<T>(), policy);
+}
+
+
+template <class InputIterator, class OutputIterator, class F>
+OutputIterator parallelTransform(InputIterator first, InputIterator last, OutputIterator result, F f, ParallelPolicy& policy)
+	/// Assigns f(*(first + i)) to *(result + i) for every element
+	/// in [first, last), in parallel. Both iterators must be random
+	/// access iterators. Returns the end of the output range.
+{
+	std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+	Impl::parallelChunks(count, policy.getGrainSize(), policy,
+		[first, result, &f](std::size_t begin, std::size_t end)
+		{
+			InputIterator in = first + begin;
+			OutputIterator out = result + begin;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				*out++ = f(*in++);
+			}
+		});
+	return result + count;
+}
+
+
+template <class InputIterator, class OutputIterator, class F>
+OutputIterator parallelTransform(InputIterator first, InputIterator last, OutputIterator result, F f)
+	/// Transforms [first, last) into result, in parallel,
+	/// using a default ParallelPolicy.
+{
+	ParallelPolicy policy;
+	return parallelTransform(first, last, result, f, policy);
+}
+
+
+template <class Iterator, class Compare>
+void parallelSort(Iterator first, Iterator last, Compare comp, ParallelPolicy& policy)
+	/// Sorts the elements in [first, last) using comp, in parallel.
+	///
+	/// The range is divided into blocks, which are sorted in
+	/// parallel and then merged pairwise, again in parallel.
+	/// The sort is not stable.
+{
+	std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+	std::size_t grainSize = std::max<std::size_t>(policy.getGrainSize(), 1);
+	std::size_t maxBlocks = 2*(static_cast<std::size_t>(policy.executor().threads()) + 1);
+	std::size_t blocks = 1;
+	while (blocks < maxBlocks && count/(2*blocks) >= grainSize) blocks *= 2;
+
+	if (blocks == 1)
+	{
+		if (!policy.isCancelled()) std::sort(first, last, comp);
+		return;
+	}
+
+	std::vector<std::size_t> bounds(blocks + 1);
+	for (std::size_t i = 0; i <= blocks; i++)
+	{
+		bounds[i] = count/blocks*i + std::min(i, count % blocks);
+	}
+
+	Impl::parallelChunks(blocks, 1, policy,
+		[first, &comp, &bounds](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				std::sort(first + bounds[i], first + bounds[i + 1], comp);
+			}
+		});
+
+	for (std::size_t width = 1; width < blocks; width *= 2)
+	{
+		Impl::parallelChunks(blocks/(2*width), 1, policy,
+			[first, &comp, &bounds, width](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					std::size_t lo = 2*width*i;
+					std::inplace_merge(first + bounds[lo], first + bounds[lo + width], first + bounds[lo + 2*width], comp);
+				}
+			});
+	}
+}
+
+
+template <class Iterator, class Compare>
+void parallelSort(Iterator first, Iterator last, Compare comp)
+	/// Sorts the elements in [first, last) using comp, in parallel,
+	/// using a default ParallelPolicy.
+{
+	ParallelPolicy policy;
+	parallelSort(first, last, comp, policy);
+}
+
+
+template <class Iterator>
+void parallelSort(Iterator first, Iterator last, ParallelPolicy& policy)
+	/// Sorts the elements in [first, last) in ascending order,
+	/// in parallel.
+{
+	parallelSort(first, last, std::less<typename std::iterator_traits<Iterator>::value_type>(), policy);
+}
+
+
+template <class Iterator>
+void parallelSort(Iterator first, Iterator last)
+	/// Sorts the elements in [first, last) in ascending order,
+	/// in parallel, using a default ParallelPolicy.
+{
+	ParallelPolicy policy;
+	parallelSort(first, last, policy);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Parallel_INCLUDED
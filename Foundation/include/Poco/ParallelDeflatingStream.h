@@ -0,0 +1,193 @@
+//
+// ParallelDeflatingStream.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Definition of the ParallelDeflatingStreamBuf, ParallelDeflatingIOS and ParallelDeflatingOutputStream classes.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ParallelDeflatingStream_INCLUDED
+#define Foundation_ParallelDeflatingStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/Executor.h"
+#include "Poco/Future.h"
+#include <ostream>
+#include <deque>
+#include <memory>
+#include <string>
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API ParallelDeflatingStreamBuf: public BufferedStreamBuf
+	/// This is the streambuf class used by ParallelDeflatingOutputStream.
+	///
+	/// The data written to the stream is split into blocks, which
+	/// are compressed by the tasks of an Executor, and written
+	/// to the output stream in their original order.
+	///
+	/// With FORMAT_SINGLE_MEMBER, the result is a single gzip
+	/// member, like the output of pigz. Every block is compressed
+	/// with the last 32 KB of the preceding block as dictionary, so
+	/// the compression ratio is close to that of DeflatingOutputStream.
+	///
+	/// With FORMAT_MULTI_MEMBER, every block is written as a separate
+	/// gzip member, compressed independently of the other blocks.
+	/// Each member records its size in an extra header field (subfield
+	/// ID "PZ"), so that ParallelInflatingInputStream can decompress
+	/// the members in parallel as well. gzip and other tools read the
+	/// result as a concatenation of gzip members.
+	///
+	/// Data is only compressed in complete blocks, so flushing the
+	/// stream does not write a partial block. The last block is
+	/// compressed and written by close().
+{
+public:
+	enum Format
+	{
+		FORMAT_SINGLE_MEMBER, /// Write a single gzip member.
+		FORMAT_MULTI_MEMBER   /// Write one gzip member per block.
+	};
+
+	enum
+	{
+		DEFAULT_BLOCK_SIZE = 128*1024
+	};
+
+	ParallelDeflatingStreamBuf(std::ostream& ostr, int level, Format format, std::size_t blockSize, Executor& executor);
+		/// Creates a ParallelDeflatingStreamBuf for compressing data passed
+		/// through and forwarding it to the given output stream.
+
+	~ParallelDeflatingStreamBuf();
+		/// Destroys the ParallelDeflatingStreamBuf.
+
+	int close();
+		/// Compresses the remaining data, waits for all blocks
+		/// to be written and finishes up the stream.
+		///
+		/// Must be called to complete the gzip stream.
+
+protected:
+	int writeToDevice(const char* buffer, std::streamsize length);
+
+private:
+	enum
+	{
+		STREAM_BUFFER_SIZE = 8192,
+		DICTIONARY_SIZE    = 32768
+	};
+
+	struct Block
+	{
+		std::string  data;
+		Poco::UInt32 crc;
+		Poco::UInt32 size;
+	};
+
+	typedef std::shared_ptr<std::string> InputPtr;
+
+	void submitBlock(bool last);
+	void writeBlocks(std::size_t maxPending);
+	void writeHeader();
+	void writeTrailer();
+	static Block compressBlock(InputPtr pInput, InputPtr pPrevious, int level, bool last);
+	static Block compressMember(InputPtr pInput, int level);
+
+	std::ostream*             _pOstr;
+	int                       _level;
+	Format                    _format;
+	std::size_t               _blockSize;
+	Executor&                 _executor;
+	std::size_t               _maxPending;
+	InputPtr                  _pInput;
+	InputPtr                  _pPrevious;
+	std::deque<Future<Block>> _pending;
+	Poco::UInt32              _crc;
+	Poco::UInt32              _size;
+	bool                      _started;
+};
+
+
+class Foundation_API ParallelDeflatingIOS: public virtual std::ios
+	/// The base class for ParallelDeflatingOutputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	ParallelDeflatingIOS(std::ostream& ostr, int level, ParallelDeflatingStreamBuf::Format format, std::size_t blockSize, Executor& executor);
+		/// Creates a ParallelDeflatingIOS for compressing data passed
+		/// through and forwarding it to the given output stream.
+
+	~ParallelDeflatingIOS();
+		/// Destroys the ParallelDeflatingIOS.
+
+	ParallelDeflatingStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying stream buffer.
+
+protected:
+	ParallelDeflatingStreamBuf _buf;
+};
+
+
+class Foundation_API ParallelDeflatingOutputStream: public std::ostream, public ParallelDeflatingIOS
+	/// This stream compresses all data passing through it into
+	/// gzip format, using multiple threads.
+	///
+	/// See ParallelDeflatingStreamBuf for a description of the
+	/// output formats. The blocks are compressed by the given
+	/// Executor, or by Executor::defaultExecutor(). At most two
+	/// blocks per worker thread are kept in memory.
+	///
+	/// After all data has been written to the stream, close()
+	/// must be called to ensure completion of compression.
+	/// Example:
+	///     std::ofstream ostr("data.gz", std::ios::binary);
+	///     ParallelDeflatingOutputStream deflater(ostr);
+	///     deflater << "Hello, world!" << std::endl;
+	///     deflater.close();
+	///     ostr.close();
+{
+public:
+	ParallelDeflatingOutputStream(std::ostream& ostr, int level = Z_DEFAULT_COMPRESSION, ParallelDeflatingStreamBuf::Format format = ParallelDeflatingStreamBuf::FORMAT_SINGLE_MEMBER, std::size_t blockSize = ParallelDeflatingStreamBuf::DEFAULT_BLOCK_SIZE);
+		/// Creates a ParallelDeflatingOutputStream that compresses
+		/// blocks of the given size using the default Executor.
+
+	ParallelDeflatingOutputStream(std::ostream& ostr, Executor& executor, int level = Z_DEFAULT_COMPRESSION, ParallelDeflatingStreamBuf::Format format = ParallelDeflatingStreamBuf::FORMAT_SINGLE_MEMBER, std::size_t blockSize = ParallelDeflatingStreamBuf::DEFAULT_BLOCK_SIZE);
+		/// Creates a ParallelDeflatingOutputStream that compresses
+		/// blocks of the given size using the given Executor.
+
+	~ParallelDeflatingOutputStream();
+		/// Destroys the ParallelDeflatingOutputStream.
+
+	int close();
+		/// Finishes up the stream.
+		///
+		/// Must be called to complete the gzip stream.
+
+protected:
+	virtual int sync();
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ParallelDeflatingStream_INCLUDED
@@ -0,0 +1,145 @@
+//
+// ParallelInflatingStream.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Definition of the ParallelInflatingStreamBuf, ParallelInflatingIOS and ParallelInflatingInputStream classes.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ParallelInflatingStream_INCLUDED
+#define Foundation_ParallelInflatingStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/Executor.h"
+#include "Poco/Future.h"
+#include <istream>
+#include <deque>
+#include <memory>
+#include <string>
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API ParallelInflatingStreamBuf: public BufferedStreamBuf
+	/// This is the streambuf class used by ParallelInflatingInputStream.
+	///
+	/// Reads a gzip file consisting of one or more members.
+	/// Members that record their size in an extra header field
+	/// (subfield ID "PZ"), as written by ParallelDeflatingOutputStream
+	/// in FORMAT_MULTI_MEMBER, are read ahead and decompressed by
+	/// the tasks of an Executor. All other members are decompressed
+	/// sequentially on the calling thread.
+	///
+	/// Data following the last complete member that does not start
+	/// with a gzip header is ignored.
+{
+public:
+	ParallelInflatingStreamBuf(std::istream& istr, Executor& executor);
+		/// Creates a ParallelInflatingStreamBuf for expanding the compressed
+		/// data read from the given input stream.
+
+	~ParallelInflatingStreamBuf();
+		/// Destroys the ParallelInflatingStreamBuf.
+
+protected:
+	int readFromDevice(char* buffer, std::streamsize length);
+
+private:
+	enum
+	{
+		STREAM_BUFFER_SIZE = 32768,
+		INPUT_BUFFER_SIZE  = 65536,
+		HEADER_SIZE        = 20,
+		MAX_INFLATE_RATIO  = 1032
+	};
+
+	typedef std::shared_ptr<std::string> MemberPtr;
+
+	bool fillInput(std::size_t size);
+	bool startMember();
+	int inflateSequential(char* buffer, std::streamsize length);
+	static std::string inflateMember(MemberPtr pMember);
+
+	std::istream*                   _pIstr;
+	Executor&                       _executor;
+	std::size_t                     _maxPending;
+	std::string                     _input;
+	std::size_t                     _inputPos;
+	std::deque<Future<std::string>> _pending;
+	std::string                     _output;
+	std::size_t                     _outputPos;
+	z_stream                        _zstr;
+	bool                            _sequential;
+	bool                            _firstMember;
+	bool                            _eof;
+};
+
+
+class Foundation_API ParallelInflatingIOS: public virtual std::ios
+	/// The base class for ParallelInflatingInputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	ParallelInflatingIOS(std::istream& istr, Executor& executor);
+		/// Creates a ParallelInflatingIOS for expanding the compressed data
+		/// read from the given input stream.
+
+	~ParallelInflatingIOS();
+		/// Destroys the ParallelInflatingIOS.
+
+	ParallelInflatingStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying stream buffer.
+
+protected:
+	ParallelInflatingStreamBuf _buf;
+};
+
+
+class Foundation_API ParallelInflatingInputStream: public std::istream, public ParallelInflatingIOS
+	/// This stream decompresses gzip data read from another
+	/// input stream, using multiple threads for files written
+	/// by ParallelDeflatingOutputStream in FORMAT_MULTI_MEMBER.
+	///
+	/// Any other gzip file, including the concatenation of several
+	/// gzip files, is decompressed as well, but on the calling thread
+	/// only. See ParallelInflatingStreamBuf for details.
+	///
+	/// Throws a DataFormatException if the data is not in gzip format
+	/// or is corrupt.
+{
+public:
+	ParallelInflatingInputStream(std::istream& istr);
+		/// Creates a ParallelInflatingInputStream for expanding the compressed data
+		/// read from the given input stream, using the default Executor.
+
+	ParallelInflatingInputStream(std::istream& istr, Executor& executor);
+		/// Creates a ParallelInflatingInputStream for expanding the compressed data
+		/// read from the given input stream, using the given Executor.
+
+	~ParallelInflatingInputStream();
+		/// Destroys the ParallelInflatingInputStream.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ParallelInflatingStream_INCLUDED
@@ -52,7 +52,9 @@ protected:
 		///
 		/// All files with the same name as the one given in path,
 		/// plus some suffix (e.g., .1, .20050929081500, .1.gz) are
-		/// considered archived files.
+		/// considered archived files. Files with a suffix starting
+		/// with "~" are log files that ArchiveStrategy has not yet
+		/// archived, and are not listed.
 
 private:
 	PurgeStrategy(const PurgeStrategy&);
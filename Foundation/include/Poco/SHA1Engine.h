@@ -58,6 +58,10 @@ private:
 
 	typedef UInt8 BYTE;
 
+	void transform(const BYTE* data, std::size_t blocks);
+		/// Processes the given number of complete blocks
+		/// directly from data.
+
 	struct Context
 	{
 		UInt32 digest[5]; // Message digest
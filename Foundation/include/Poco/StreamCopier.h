@@ -30,6 +30,17 @@ namespace Poco {
 class Foundation_API StreamCopier
 	/// This class provides static methods to copy the contents from one stream
 	/// into another.
+	///
+	/// The buffer used by copyStream() and copyToString() starts with the
+	/// given size and grows up to 256 KB while the input stream delivers
+	/// full buffers.
+	///
+	/// On Linux, if both stream buffers implement the DescriptorStreamBuf
+	/// interface (e.g., FileInputStream, FileOutputStream and
+	/// Net::SocketStream), copyStream() lets the kernel move the data
+	/// directly between the underlying descriptors, using copy_file_range(),
+	/// sendfile() or splice(). If this is not possible, or fails, the
+	/// remaining data is copied through a buffer.
 {
 public:
 	static std::streamsize copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize = 8192);
@@ -0,0 +1,183 @@
+//
+// StringRef.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringRef
+//
+// Definition of the StringRef class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringRef_INCLUDED
+#define Foundation_StringRef_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <ostream>
+#include <algorithm>
+
+
+namespace Poco {
+
+
+class StringRef
+	/// A non-owning, read-only reference to a contiguous sequence
+	/// of characters, similar to C++17 std::string_view.
+	///
+	/// A StringRef does not copy the referenced characters; the
+	/// owner of the characters must keep them alive and unchanged
+	/// for as long as the StringRef is in use.
+	/// The referenced characters are not necessarily zero-terminated.
+{
+public:
+	typedef const char* Iterator;
+	typedef std::size_t SizeType;
+
+	static const SizeType NPOS = static_cast<SizeType>(-1);
+
+	StringRef():
+		_pData(""),
+		_size(0)
+		/// Creates an empty StringRef.
+	{
+	}
+
+	StringRef(const char* pData, SizeType size):
+		_pData(pData),
+		_size(size)
+		/// Creates a StringRef referencing size characters starting at pData.
+	{
+	}
+
+	StringRef(const char* pStr):
+		_pData(pStr),
+		_size(std::strlen(pStr))
+		/// Creates a StringRef referencing the zero-terminated string pStr.
+	{
+	}
+
+	StringRef(const std::string& str):
+		_pData(str.data()),
+		_size(str.size())
+		/// Creates a StringRef referencing the contents of str.
+	{
+	}
+
+	const char* data() const
+		/// Returns a pointer to the first referenced character.
+	{
+		return _pData;
+	}
+
+	SizeType size() const
+		/// Returns the number of referenced characters.
+	{
+		return _size;
+	}
+
+	SizeType length() const
+		/// Returns the number of referenced characters.
+	{
+		return _size;
+	}
+
+	bool empty() const
+		/// Returns true if no characters are referenced.
+	{
+		return _size == 0;
+	}
+
+	Iterator begin() const
+	{
+		return _pData;
+	}
+
+	Iterator end() const
+	{
+		return _pData + _size;
+	}
+
+	char operator [] (SizeType pos) const
+	{
+		return _pData[pos];
+	}
+
+	StringRef substr(SizeType pos, SizeType n = NPOS) const
+		/// Returns a StringRef referencing a part of this one.
+	{
+		if (pos > _size) pos = _size;
+		return StringRef(_pData + pos, std::min(n, _size - pos));
+	}
+
+	SizeType find(char c, SizeType pos = 0) const
+		/// Returns the position of the first occurrence of c
+		/// at or after pos, or NPOS if not found.
+	{
+		for (; pos < _size; ++pos)
+		{
+			if (_pData[pos] == c) return pos;
+		}
+		return NPOS;
+	}
+
+	int compare(const StringRef& other) const
+		/// Lexicographically compares this with other.
+	{
+		int rc = _size && other._size ? std::memcmp(_pData, other._pData, std::min(_size, other._size)) : 0;
+		if (rc != 0) return rc;
+		return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+	}
+
+	bool operator == (const StringRef& other) const
+	{
+		return _size == other._size && (_size == 0 || std::memcmp(_pData, other._pData, _size) == 0);
+	}
+
+	bool operator != (const StringRef& other) const
+	{
+		return !(*this == other);
+	}
+
+	bool operator < (const StringRef& other) const
+	{
+		return compare(other) < 0;
+	}
+
+	std::string toString() const
+		/// Returns a copy of the referenced characters.
+	{
+		return std::string(_pData, _size);
+	}
+
+	void assignTo(std::string& str) const
+		/// Assigns the referenced characters to str.
+	{
+		str.assign(_pData, _size);
+	}
+
+private:
+	const char* _pData;
+	SizeType    _size;
+};
+
+
+inline std::ostream& operator << (std::ostream& ostr, const StringRef& ref)
+{
+	ostr.write(ref.data(), static_cast<std::streamsize>(ref.size()));
+	return ostr;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringRef_INCLUDED
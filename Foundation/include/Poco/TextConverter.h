@@ -30,6 +30,13 @@ class TextEncoding;
 class Foundation_API TextConverter
 	/// A TextConverter converts strings from one encoding
 	/// into another.
+	///
+	/// Conversions without a transform function between UTF-8 and
+	/// UTF-8, UTF-16, UTF-32 (in native byte order) or Latin-1 are done
+	/// with UTFTranscoder, which converts whole blocks of text at a time.
+	/// If the source contains invalid sequences or characters that
+	/// cannot be represented in the target encoding, the text is converted
+	/// character by character instead, with the same result.
 {
 public:
 	typedef int (*Transform)(int);
@@ -0,0 +1,189 @@
+//
+// TimerWheel.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  TimerWheel
+//
+// Definition of the TimerWheel class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_TimerWheel_INCLUDED
+#define Foundation_TimerWheel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/Clock.h"
+#include <functional>
+#include <vector>
+
+
+namespace Poco {
+
+
+class ThreadPool;
+
+
+class Foundation_API TimerWheel: protected Runnable
+	/// TimerWheel is a scheduler for large numbers of timeouts,
+	/// based on a hierarchical timing wheel.
+	///
+	/// Time is divided into ticks of a configurable length (in
+	/// milliseconds). Timers are kept in four levels of 256 slots
+	/// each; a timer due within the next 256 ticks is placed in a
+	/// slot of the first level, timers further in the future go into
+	/// the slots of the upper levels and are moved down (cascaded)
+	/// as time advances. Scheduling and cancelling a timer therefore
+	/// take constant time, independent of the number of timers, and
+	/// cancelled timers do not leave entries behind.
+	///
+	/// A TimerWheel can be used in two ways:
+	///
+	///   - With its own thread (see start()). Expired callbacks are
+	///     either called by the wheel's thread, or handed over in
+	///     batches to a ThreadPool.
+	///   - Driven by another thread, which calls process() regularly,
+	///     and uses nextTimeout() to find out how long it may wait.
+	///     This is how SocketReactor uses it.
+	///
+	/// Callbacks are called no earlier than the requested delay,
+	/// rounded up to the next tick.
+{
+public:
+	typedef std::function<void()> Callback;
+	typedef UInt64 Handle;
+		/// Identifies a scheduled timer. Zero is never a valid handle.
+
+	enum
+	{
+		LEVELS = 4,
+		SLOTS  = 256
+	};
+
+	explicit TimerWheel(long tick = 1);
+		/// Creates the TimerWheel with the given tick length
+		/// in milliseconds.
+
+	~TimerWheel();
+		/// Stops the wheel's thread, if running, and destroys
+		/// the TimerWheel. Pending timers are discarded.
+
+	void start();
+		/// Starts a thread that advances the wheel and
+		/// calls expired callbacks.
+
+	void start(ThreadPool& pool);
+		/// Starts a thread that advances the wheel. Expired
+		/// callbacks are passed in batches to the given thread pool.
+		/// If no thread is available, the wheel's thread calls them.
+
+	void stop();
+		/// Stops the wheel's thread. Callbacks already passed to
+		/// the thread pool will still be called.
+
+	Handle schedule(const Callback& callback, long delay);
+		/// Schedules the callback to be called once, after
+		/// the given delay in milliseconds. Returns a handle
+		/// that can be passed to cancel().
+
+	Handle schedule(const Callback& callback, long delay, long interval);
+		/// Schedules the callback to be called first after the given
+		/// delay, then repeatedly at the given interval (both in
+		/// milliseconds), until cancelled.
+
+	bool cancel(Handle handle);
+		/// Cancels the timer with the given handle.
+		///
+		/// Returns true if the timer was pending, or false if it
+		/// has already expired (or been cancelled). A callback that
+		/// has already been taken from the wheel may still be called.
+
+	std::size_t process();
+		/// Advances the wheel to the current time and calls all
+		/// expired callbacks in the calling thread. Returns the number
+		/// of callbacks called.
+		///
+		/// Must not be used while the wheel's own thread is running.
+
+	long nextTimeout() const;
+		/// Returns the number of milliseconds until the next timer
+		/// may expire, or -1 if no timer is scheduled. The result is
+		/// a lower bound; no timer expires earlier.
+
+	std::size_t size() const;
+		/// Returns the number of scheduled timers.
+
+	long tick() const;
+		/// Returns the tick length in milliseconds.
+
+protected:
+	void run();
+
+private:
+	TimerWheel(const TimerWheel&);
+	TimerWheel& operator = (const TimerWheel&);
+
+	struct Node
+	{
+		Callback callback;
+		UInt64   expiry;
+		UInt64   interval;
+		UInt32   generation;
+		Int32    prev;
+		Int32    next;
+		Int32    slot;
+	};
+
+	typedef std::vector<Callback> Batch;
+
+	UInt64 currentTick() const;
+	UInt64 expiryTick(long delay) const;
+	void link(Int32 index);
+	void unlink(Int32 index);
+	Int32 allocate();
+	void release(Int32 index);
+	void cascade(int level);
+	void advance(UInt64 target, Batch& batch);
+	UInt64 nextTick() const;
+	long millisecondsUntil(UInt64 tick) const;
+	void dispatch(Batch& batch);
+
+	const UInt64        _tickMicroseconds;
+	const Clock         _start;
+	UInt64              _now;
+	std::vector<Node>   _nodes;
+	Int32               _free;
+	Int32               _slots[LEVELS*SLOTS];
+	std::size_t         _count;
+	UInt64              _wakeTick;
+	ThreadPool*         _pPool;
+	Thread              _thread;
+	Event               _wakeUp;
+	bool                _stopped;
+	mutable FastMutex   _mutex;
+};
+
+
+//
+// inlines
+//
+inline long TimerWheel::tick() const
+{
+	return static_cast<long>(_tickMicroseconds/1000);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TimerWheel_INCLUDED
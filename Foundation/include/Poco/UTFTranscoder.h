@@ -0,0 +1,99 @@
+//
+// UTFTranscoder.h
+//
+// Library: Foundation
+// Package: Text
+// Module:  UTFTranscoder
+//
+// Definition of the UTFTranscoder class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_UTFTranscoder_INCLUDED
+#define Foundation_UTFTranscoder_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/UTFString.h"
+
+
+namespace Poco {
+
+
+class Foundation_API UTFTranscoder
+	/// This class provides static member functions for validating
+	/// UTF-8 text and for converting between UTF-8, UTF-16, UTF-32
+	/// and Latin-1 (ISO-8859-1) text in memory buffers.
+	///
+	/// UTF-8 is validated according to RFC 3629: overlong forms,
+	/// surrogates and code points above U+10FFFF are rejected.
+	/// UTF-16 and UTF-32 are expected in native byte order.
+	///
+	/// On x86 and x64 processors, validation is done 32 or 16 bytes
+	/// at a time using AVX2 or SSSE3 instructions, if supported by the
+	/// processor, and runs of ASCII characters are converted a block
+	/// at a time.
+	///
+	/// TextConverter and UnicodeConverter use this class
+	/// for the encodings it supports.
+{
+public:
+	static bool isValidUTF8(const char* utf8, std::size_t length);
+		/// Returns true if the given buffer contains
+		/// well-formed UTF-8 text.
+
+	static std::size_t utf8ToUTF16(const char* utf8, std::size_t length, UTF16Char* utf16);
+		/// Converts length bytes of UTF-8 text to UTF-16. The output
+		/// buffer must have room for length characters.
+		///
+		/// Returns the number of UTF-16 characters written.
+		/// Throws a DataFormatException if the input is not valid UTF-8.
+
+	static std::size_t utf8ToUTF32(const char* utf8, std::size_t length, UTF32Char* utf32);
+		/// Converts length bytes of UTF-8 text to UTF-32. The output
+		/// buffer must have room for length characters.
+		///
+		/// Returns the number of UTF-32 characters written.
+		/// Throws a DataFormatException if the input is not valid UTF-8.
+
+	static std::size_t utf8ToLatin1(const char* utf8, std::size_t length, char* latin1);
+		/// Converts length bytes of UTF-8 text to Latin-1. The output
+		/// buffer must have room for length characters.
+		///
+		/// Returns the number of characters written. Throws a
+		/// DataFormatException if the input is not valid UTF-8,
+		/// or if it contains characters above U+00FF.
+
+	static std::size_t utf16ToUTF8(const UTF16Char* utf16, std::size_t length, char* utf8);
+		/// Converts length UTF-16 characters to UTF-8. The output
+		/// buffer must have room for 3*length bytes.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the input contains unpaired
+		/// surrogates.
+
+	static std::size_t utf32ToUTF8(const UTF32Char* utf32, std::size_t length, char* utf8);
+		/// Converts length UTF-32 characters to UTF-8. The output
+		/// buffer must have room for 4*length bytes.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the input contains surrogates
+		/// or values above U+10FFFF.
+
+	static std::size_t latin1ToUTF8(const char* latin1, std::size_t length, char* utf8);
+		/// Converts length Latin-1 characters to UTF-8. The output
+		/// buffer must have room for 2*length bytes.
+		///
+		/// Returns the number of bytes written.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_UTFTranscoder_INCLUDED
@@ -0,0 +1,139 @@
+//
+// DigestBenchmark.cpp
+//
+// This sample measures the throughput of the checksum
+// (CRC-32, CRC-32C, Adler-32, CRC-64) and message digest
+// (MD5, SHA-1, SHA-256, SHA-512) implementations
+// for different buffer sizes.
+//
+// Usage: DigestBenchmark [<megabytes per test>]
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Checksum.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/DigestEngine.h"
+#include "Poco/MD5Engine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/SHA2Engine.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Stopwatch.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+
+using Poco::Checksum;
+using Poco::CPUFeatures;
+using Poco::DigestEngine;
+using Poco::Stopwatch;
+
+
+const std::size_t BUFFER_SIZES[] = {64, 4096, 1024*1024};
+const std::size_t BUFFER_COUNT = sizeof(BUFFER_SIZES)/sizeof(BUFFER_SIZES[0]);
+
+
+void printResult(std::size_t bytes, Poco::Clock::ClockDiff time)
+{
+	double mbps = time > 0 ? static_cast<double>(bytes)/static_cast<double>(time) : 0.0;
+	std::cout << std::setw(12) << std::fixed << std::setprecision(1) << mbps;
+}
+
+
+void benchmarkChecksum(const std::string& label, Checksum::Type type, const std::vector<char>& data, std::size_t total)
+{
+	std::cout << std::setw(12) << std::left << label << std::right;
+	for (std::size_t i = 0; i < BUFFER_COUNT; ++i)
+	{
+		std::size_t size = BUFFER_SIZES[i];
+		std::size_t rounds = total/size;
+		Poco::UInt64 sum = 0;
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t r = 0; r < rounds; ++r)
+		{
+			Checksum checksum(type);
+			checksum.update(&data[0], static_cast<unsigned>(size));
+			sum += checksum.checksum();
+		}
+		sw.stop();
+		printResult(rounds*size, sw.elapsed());
+		if (sum == 1) std::cout << "*"; // keep the result alive
+	}
+	std::cout << std::endl;
+}
+
+
+void benchmarkDigest(const std::string& label, DigestEngine& engine, const std::vector<char>& data, std::size_t total)
+{
+	std::cout << std::setw(12) << std::left << label << std::right;
+	for (std::size_t i = 0; i < BUFFER_COUNT; ++i)
+	{
+		std::size_t size = BUFFER_SIZES[i];
+		std::size_t rounds = total/size;
+		std::size_t sum = 0;
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t r = 0; r < rounds; ++r)
+		{
+			engine.update(&data[0], size);
+			sum += engine.digest()[0];
+		}
+		sw.stop();
+		printResult(rounds*size, sw.elapsed());
+		if (sum == 1) std::cout << "*"; // keep the result alive
+	}
+	std::cout << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t megabytes = argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 256;
+	std::size_t total = megabytes*1024*1024;
+
+	std::vector<char> data(BUFFER_SIZES[BUFFER_COUNT - 1]);
+	Poco::UInt32 x = 1;
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		x = x*1103515245 + 12345;
+		data[i] = static_cast<char>(x >> 16);
+	}
+
+	std::cout << "CPU features:"
+		<< (CPUFeatures::hasSSSE3() ? " SSSE3" : "")
+		<< (CPUFeatures::hasSSE42() ? " SSE4.2" : "")
+		<< (CPUFeatures::hasPCLMULQDQ() ? " PCLMULQDQ" : "")
+		<< (CPUFeatures::hasAVX2() ? " AVX2" : "")
+		<< (CPUFeatures::hasSHA() ? " SHA" : "")
+		<< std::endl << std::endl;
+
+	std::cout << std::setw(12) << std::left << "[MB/s]" << std::right;
+	for (std::size_t i = 0; i < BUFFER_COUNT; ++i)
+	{
+		std::cout << std::setw(12) << (std::to_string(BUFFER_SIZES[i]) + " B");
+	}
+	std::cout << std::endl;
+
+	benchmarkChecksum("CRC-32", Checksum::TYPE_CRC32, data, total);
+	benchmarkChecksum("CRC-32C", Checksum::TYPE_CRC32C, data, total);
+	benchmarkChecksum("Adler-32", Checksum::TYPE_ADLER32, data, total);
+	benchmarkChecksum("CRC-64", Checksum::TYPE_CRC64, data, total);
+
+	Poco::MD5Engine md5;
+	benchmarkDigest("MD5", md5, data, total);
+	Poco::SHA1Engine sha1;
+	benchmarkDigest("SHA-1", sha1, data, total);
+	Poco::SHA2Engine sha256(Poco::SHA2Engine::SHA_256);
+	benchmarkDigest("SHA-256", sha256, data, total);
+	Poco::SHA2Engine sha512(Poco::SHA2Engine::SHA_512);
+	benchmarkDigest("SHA-512", sha512, data, total);
+
+	return 0;
+}
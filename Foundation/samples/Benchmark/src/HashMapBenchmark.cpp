@@ -0,0 +1,153 @@
+//
+// HashMapBenchmark.cpp
+//
+// This sample compares the performance of HashMap (based on
+// LinearHashTable), FlatHashMap, std::unordered_map and
+// OrderedMap (tsl::ordered_map) for integer and string keys.
+//
+// Usage: HashMapBenchmark [<number of keys>]
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/HashMap.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/OrderedMap.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Stopwatch.h"
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+
+template <class Map, class Key>
+void insertKeys(Map& map, const std::vector<Key>& keys)
+{
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		map[*it] = 1;
+	}
+}
+
+
+template <class Map, class Key>
+std::size_t findKeys(const Map& map, const std::vector<Key>& keys)
+{
+	std::size_t found = 0;
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		if (map.find(*it) != map.end()) ++found;
+	}
+	return found;
+}
+
+
+template <class Map, class Key>
+void eraseKeys(Map& map, const std::vector<Key>& keys)
+{
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		map.erase(*it);
+	}
+}
+
+
+template <class Key>
+void eraseKeys(Poco::OrderedMap<Key, int>& map, const std::vector<Key>& keys)
+	// OrderedMap::erase() preserves the insertion order and
+	// is thus O(n); unordered_erase() is the equivalent of
+	// erase() in the other maps.
+{
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		map.unordered_erase(*it);
+	}
+}
+
+
+template <class Map, class Key>
+void Benchmark(const std::vector<Key>& keys, const std::vector<Key>& missing, const std::string& label)
+{
+	Poco::Stopwatch sw;
+	Map map;
+
+	sw.start();
+	insertKeys(map, keys);
+	sw.stop();
+	Poco::Clock::ClockDiff insertTime = sw.elapsed();
+
+	sw.restart();
+	std::size_t found = findKeys(map, keys);
+	sw.stop();
+	Poco::Clock::ClockDiff findTime = sw.elapsed();
+
+	sw.restart();
+	found += findKeys(map, missing);
+	sw.stop();
+	Poco::Clock::ClockDiff missTime = sw.elapsed();
+
+	sw.restart();
+	eraseKeys(map, keys);
+	sw.stop();
+	Poco::Clock::ClockDiff eraseTime = sw.elapsed();
+
+	std::cout << std::setw(24) << std::left << label << std::right
+		<< std::setw(12) << insertTime
+		<< std::setw(12) << findTime
+		<< std::setw(12) << missTime
+		<< std::setw(12) << eraseTime
+		<< (found == keys.size() ? "" : "  (lookup error)")
+		<< std::endl;
+}
+
+
+void printHeader(const std::string& title)
+{
+	std::cout << std::endl << title << std::endl
+		<< std::setw(24) << std::left << "[us]" << std::right
+		<< std::setw(12) << "insert"
+		<< std::setw(12) << "find"
+		<< std::setw(12) << "find miss"
+		<< std::setw(12) << "erase"
+		<< std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int n = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 1000000;
+
+	std::vector<int> intKeys;
+	std::vector<int> intMissing;
+	std::vector<std::string> strKeys;
+	std::vector<std::string> strMissing;
+	for (int i = 0; i < n; ++i)
+	{
+		int k = static_cast<int>((static_cast<unsigned>(i)*2654435761U) & 0x7FFFFFFF);
+		intKeys.push_back(2*k);
+		intMissing.push_back(2*k + 1);
+		strKeys.push_back("key" + Poco::NumberFormatter::format0(k, 10));
+		strMissing.push_back("miss" + Poco::NumberFormatter::format0(k, 10));
+	}
+
+	printHeader(Poco::NumberFormatter::format(n) + " int keys");
+	Benchmark<Poco::HashMap<int, int> >(intKeys, intMissing, "HashMap");
+	Benchmark<Poco::FlatHashMap<int, int> >(intKeys, intMissing, "FlatHashMap");
+	Benchmark<std::unordered_map<int, int> >(intKeys, intMissing, "std::unordered_map");
+	Benchmark<Poco::OrderedMap<int, int> >(intKeys, intMissing, "OrderedMap");
+
+	printHeader(Poco::NumberFormatter::format(n) + " string keys");
+	Benchmark<Poco::HashMap<std::string, int> >(strKeys, strMissing, "HashMap");
+	Benchmark<Poco::FlatHashMap<std::string, int> >(strKeys, strMissing, "FlatHashMap");
+	Benchmark<std::unordered_map<std::string, int> >(strKeys, strMissing, "std::unordered_map");
+	Benchmark<Poco::OrderedMap<std::string, int> >(strKeys, strMissing, "OrderedMap");
+
+	return 0;
+}
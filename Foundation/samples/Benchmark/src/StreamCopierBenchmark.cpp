@@ -0,0 +1,144 @@
+//
+// StreamCopierBenchmark.cpp
+//
+// This sample measures the throughput of StreamCopier when
+// copying a file to another file, with FileInputStream and
+// FileOutputStream (copied by the kernel on Linux) and with
+// standard library streams (copied through a growing buffer),
+// compared to a plain loop with a fixed 8 KB buffer, and of
+// File::copyTo().
+//
+// Usage: StreamCopierBenchmark [<megabytes>]
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Stopwatch.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+
+using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
+using Poco::Stopwatch;
+
+
+const int ROUNDS = 5;
+
+
+Poco::UInt64 copyFixed(std::istream& istr, std::ostream& ostr)
+{
+	std::vector<char> buffer(8192);
+	Poco::UInt64 len = 0;
+	while (istr.read(&buffer[0], buffer.size()) || istr.gcount() > 0)
+	{
+		ostr.write(&buffer[0], istr.gcount());
+		len += istr.gcount();
+	}
+	return len;
+}
+
+
+void printResult(const std::string& label, Poco::UInt64 bytes, Poco::Clock::ClockDiff time)
+{
+	double mbps = time > 0 ? static_cast<double>(bytes)/static_cast<double>(time) : 0.0;
+	std::cout << std::setw(36) << std::left << label << std::right
+		<< std::setw(10) << std::fixed << std::setprecision(1) << mbps << " MB/s" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t megabytes = argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 256;
+
+	TemporaryFile srcFile;
+	TemporaryFile destFile;
+	{
+		std::vector<char> block(1024*1024);
+		Poco::UInt32 x = 1;
+		for (std::size_t i = 0; i < block.size(); ++i)
+		{
+			x = x*1103515245 + 12345;
+			block[i] = static_cast<char>(x >> 16);
+		}
+		FileOutputStream ostr(srcFile.path());
+		for (std::size_t i = 0; i < megabytes; ++i)
+		{
+			ostr.write(&block[0], block.size());
+		}
+	}
+	const std::string& src = srcFile.path();
+	const std::string& dest = destFile.path();
+
+	Poco::UInt64 bytes = 0;
+	Stopwatch sw;
+
+	sw.restart();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		FileInputStream istr(src);
+		FileOutputStream ostr(dest);
+		bytes += copyFixed(istr, ostr);
+	}
+	sw.stop();
+	printResult("8 KB buffer loop (Poco::FileStream)", bytes, sw.elapsed());
+
+	bytes = 0;
+	sw.restart();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		std::ifstream istr(src.c_str(), std::ios::binary);
+		std::ofstream ostr(dest.c_str(), std::ios::binary | std::ios::trunc);
+		bytes += StreamCopier::copyStream64(istr, ostr);
+	}
+	sw.stop();
+	printResult("copyStream (std::fstream)", bytes, sw.elapsed());
+
+	bytes = 0;
+	sw.restart();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		FileInputStream istr(src);
+		FileOutputStream ostr(dest);
+		bytes += StreamCopier::copyStream64(istr, ostr);
+	}
+	sw.stop();
+	printResult("copyStream (Poco::FileStream)", bytes, sw.elapsed());
+
+	bytes = 0;
+	sw.restart();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		FileInputStream istr(src);
+		std::string str;
+		bytes += StreamCopier::copyToString64(istr, str);
+	}
+	sw.stop();
+	printResult("copyToString", bytes, sw.elapsed());
+
+	bytes = 0;
+	sw.restart();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		Poco::File(src).copyTo(dest);
+		bytes += Poco::File(src).getSize();
+	}
+	sw.stop();
+	printResult("File::copyTo", bytes, sw.elapsed());
+
+	return 0;
+}
@@ -0,0 +1,180 @@
+//
+// LoggingBenchmark.cpp
+//
+// This sample measures the cost of a log statement (in nanoseconds
+// per call, as seen by the logging thread) for Logger and FastLogger.
+//
+// Usage: LoggingBenchmark [<threads> [<messages per thread> [<log file>]]]
+//
+// Without a log file, messages are passed to a NullChannel after
+// formatting; with a log file, they are written through a
+// PatternFormatter to a FileChannel.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Logger.h"
+#include "Poco/FastLogger.h"
+#include "Poco/NullChannel.h"
+#include "Poco/FileChannel.h"
+#include "Poco/FormattingChannel.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include "Poco/AutoPtr.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Logger;
+using Poco::FastLogger;
+using Poco::Channel;
+using Poco::Message;
+using Poco::Thread;
+using Poco::Stopwatch;
+using Poco::AutoPtr;
+
+
+class LoggerRunnable: public Poco::Runnable
+{
+public:
+	LoggerRunnable(Logger& logger, int count):
+		_logger(logger),
+		_count(count),
+		_elapsed(0)
+	{
+	}
+
+	void run()
+	{
+		std::string path("/index.html");
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _count; ++i)
+		{
+			_logger.information("GET %s took %d us (%.2f kB)", path, i, 1.5);
+		}
+		sw.stop();
+		_elapsed = sw.elapsed();
+	}
+
+	Poco::Timestamp::TimeDiff elapsed() const
+	{
+		return _elapsed;
+	}
+
+private:
+	Logger& _logger;
+	int _count;
+	Poco::Timestamp::TimeDiff _elapsed;
+};
+
+
+class FastLoggerRunnable: public Poco::Runnable
+{
+public:
+	FastLoggerRunnable(FastLogger& logger, int count):
+		_logger(logger),
+		_count(count),
+		_elapsed(0)
+	{
+	}
+
+	void run()
+	{
+		std::string path("/index.html");
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _count; ++i)
+		{
+			poco_fast_information(_logger, "GET %s took %d us (%.2f kB)", path, i, 1.5);
+		}
+		sw.stop();
+		_elapsed = sw.elapsed();
+	}
+
+	Poco::Timestamp::TimeDiff elapsed() const
+	{
+		return _elapsed;
+	}
+
+private:
+	FastLogger& _logger;
+	int _count;
+	Poco::Timestamp::TimeDiff _elapsed;
+};
+
+
+template <class R, class L>
+void benchmark(const std::string& label, L& logger, int threads, int count)
+{
+	std::vector<R*> runnables;
+	std::vector<Thread*> workers;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i)
+	{
+		runnables.push_back(new R(logger, count));
+		workers.push_back(new Thread);
+		workers.back()->start(*runnables.back());
+	}
+	double callerTime = 0;
+	for (int i = 0; i < threads; ++i)
+	{
+		workers[i]->join();
+		callerTime += runnables[i]->elapsed();
+		delete workers[i];
+		delete runnables[i];
+	}
+	sw.stop();
+
+	double calls = static_cast<double>(threads)*count;
+	std::cout << std::left << std::setw(12) << label
+		<< std::right << std::setw(10) << std::fixed << std::setprecision(1)
+		<< callerTime*1000/calls << " ns/call"
+		<< std::setw(12) << sw.elapsed()/1000 << " ms wall time" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int threads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 1;
+	int count = argc > 2 ? Poco::NumberParser::parse(argv[2]) : 1000000;
+
+	AutoPtr<Channel> pChannel;
+	if (argc > 3)
+	{
+		AutoPtr<Poco::FileChannel> pFileChannel = new Poco::FileChannel(argv[3]);
+		AutoPtr<Poco::PatternFormatter> pFormatter = new Poco::PatternFormatter("%Y-%m-%d %H:%M:%S.%i [%I] %p %s: %t");
+		pChannel = new Poco::FormattingChannel(pFormatter, pFileChannel);
+	}
+	else
+	{
+		pChannel = new Poco::NullChannel;
+	}
+
+	std::cout << threads << " thread(s), " << count << " messages per thread" << std::endl;
+
+	Logger& logger = Logger::create("Benchmark", pChannel, Message::PRIO_INFORMATION);
+	benchmark<LoggerRunnable>("Logger", logger, threads, count);
+
+	{
+		Stopwatch sw;
+		sw.start();
+		FastLogger fastLogger(logger, 1 << 20);
+		benchmark<FastLoggerRunnable>("FastLogger", fastLogger, threads, count);
+		fastLogger.flush();
+		sw.stop();
+		std::cout << "FastLogger drained after " << sw.elapsed()/1000 << " ms, "
+			<< fastLogger.dropped() << " dropped" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+//
+// ParallelBenchmark.cpp
+//
+// This sample compares the parallel algorithms (parallelFor(),
+// parallelReduce(), parallelTransform() and parallelSort())
+// with their serial counterparts from the standard library,
+// at several data sizes.
+//
+// Usage: ParallelBenchmark [<threads> [<grain size>]]
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Parallel.h"
+#include "Poco/Executor.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Executor;
+using Poco::ParallelPolicy;
+using Poco::Stopwatch;
+
+
+template <class F>
+double measure(F f, std::size_t size)
+	/// Returns the time for one run of f in microseconds,
+	/// repeating f for small sizes to get a stable result.
+{
+	int runs = static_cast<int>(std::max<std::size_t>(1, 10000000/(size + 1)/10));
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < runs; ++i) f();
+	sw.stop();
+	return static_cast<double>(sw.elapsed())/runs;
+}
+
+
+void report(const std::string& label, std::size_t size, double serial, double parallel)
+{
+	std::cout << std::left << std::setw(12) << label
+		<< std::right << std::setw(10) << size
+		<< std::setw(14) << std::fixed << std::setprecision(1) << serial
+		<< std::setw(14) << parallel
+		<< std::setw(10) << std::setprecision(2) << serial/parallel << "x" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int threads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 0;
+	std::size_t grainSize = argc > 2 ? Poco::NumberParser::parse(argv[2]) : ParallelPolicy::DEFAULT_GRAIN_SIZE;
+
+	Executor executor("ParallelBenchmark", threads);
+	ParallelPolicy policy(executor, grainSize);
+
+	std::cout << executor.threads() << " worker thread(s), grain size " << grainSize << std::endl << std::endl;
+	std::cout << std::left << std::setw(12) << "algorithm"
+		<< std::right << std::setw(10) << "size"
+		<< std::setw(14) << "serial [us]"
+		<< std::setw(14) << "parallel [us]"
+		<< std::setw(11) << "speedup" << std::endl;
+
+	Poco::Random rnd;
+	const std::size_t sizes[] = {1000, 10000, 100000, 1000000, 10000000};
+	for (std::size_t size: sizes)
+	{
+		std::vector<double> data(size);
+		for (std::size_t i = 0; i < size; ++i) data[i] = rnd.nextDouble();
+		std::vector<double> out(size);
+
+		double serial = measure([&]()
+			{
+				for (std::size_t i = 0; i < size; ++i) out[i] = std::sqrt(data[i])*std::log(data[i] + 1);
+			}, size);
+		double parallel = measure([&]()
+			{
+				Poco::parallelFor(std::size_t(0), size, [&](std::size_t i) { out[i] = std::sqrt(data[i])*std::log(data[i] + 1); }, policy);
+			}, size);
+		report("for", size, serial, parallel);
+
+		volatile double sum = 0;
+		serial = measure([&]() { sum = std::accumulate(data.begin(), data.end(), 0.0); }, size);
+		parallel = measure([&]() { sum = Poco::parallelReduce(data.begin(), data.end(), 0.0, std::plus<double>(), policy); }, size);
+		report("reduce", size, serial, parallel);
+
+		serial = measure([&]() { std::transform(data.begin(), data.end(), out.begin(), [](double d) { return std::exp(d); }); }, size);
+		parallel = measure([&]() { Poco::parallelTransform(data.begin(), data.end(), out.begin(), [](double d) { return std::exp(d); }, policy); }, size);
+		report("transform", size, serial, parallel);
+
+		serial = measure([&]() { out = data; std::sort(out.begin(), out.end()); }, size);
+		parallel = measure([&]() { out = data; Poco::parallelSort(out.begin(), out.end(), policy); }, size);
+		report("sort", size, serial, parallel);
+	}
+
+	return 0;
+}
@@ -13,16 +13,27 @@
 
 
 #include "Poco/ArchiveStrategy.h"
+#include "Poco/PurgeStrategy.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/File.h"
 #include "Poco/Path.h"
-#include "Poco/DeflatingStream.h"
-#include "Poco/StreamCopier.h"
 #include "Poco/Exception.h"
 #include "Poco/ActiveDispatcher.h"
 #include "Poco/ActiveMethod.h"
-#include "Poco/Void.h"
+#include "Poco/ActiveResult.h"
 #include "Poco/FileStream.h"
+#include "Poco/ParallelDeflatingStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Thread.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+#include <functional>
+#include <memory>
+#include <atomic>
 
 
 namespace Poco {
@@ -34,21 +45,44 @@ namespace Poco {
 
 
 class ArchiveCompressor: public ActiveDispatcher
+	/// The background thread of an ArchiveStrategy.
+	/// Executes compression and purging jobs one after
+	/// the other.
 {
 public:
+	typedef std::function<void()> Job;
+
 	ArchiveCompressor():
-		compress(this, &ArchiveCompressor::compressImpl)
+		execute(this, &ArchiveCompressor::executeImpl),
+		_pThread(0)
 	{
 	}
-	
+
 	~ArchiveCompressor()
 	{
 	}
-	
-	ActiveMethod<void, std::string, ArchiveCompressor, ActiveStarter<ActiveDispatcher> > compress;
 
-protected:
-	void compressImpl(const std::string& path)
+	void post(const Job& job)
+	{
+		_pLastResult.reset(new ActiveResult<void>(execute(job)));
+	}
+
+	void wait()
+	{
+		if (_pLastResult) _pLastResult->wait();
+	}
+
+	bool isCurrent() const
+		/// Returns true if called by the background thread.
+	{
+		Thread* pThread = _pThread.load();
+		return pThread && pThread == Thread::current();
+	}
+
+	static void compressFile(const std::string& path, int level)
+		/// Compresses the given file into a gzip file with the
+		/// same name plus ".gz", and removes the original file.
+		/// If compression fails, the original file is kept.
 	{
 		std::string gzPath(path);
 		gzPath.append(".gz");
@@ -56,11 +90,13 @@ protected:
 		FileOutputStream ostr(gzPath);
 		try
 		{
-			DeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP);
+			ParallelDeflatingOutputStream deflater(ostr, level);
 			StreamCopier::copyStream(istr, deflater);
-			if (!deflater.good() || !ostr.good()) throw WriteFileException(gzPath);
+			if (istr.bad()) throw ReadFileException(path);
+			if (!deflater.good()) throw WriteFileException(gzPath);
 			deflater.close();
 			ostr.close();
+			if (!ostr.good()) throw WriteFileException(gzPath);
 			istr.close();
 		}
 		catch (Poco::Exception&)
@@ -73,8 +109,35 @@ protected:
 		}
 		File f(path);
 		f.remove();
-		return;
 	}
+
+protected:
+	ActiveMethod<void, Job, ArchiveCompressor, ActiveStarter<ActiveDispatcher> > execute;
+
+	void executeImpl(const Job& job)
+	{
+		_pThread.store(Thread::current());
+		try
+		{
+			job();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+
+private:
+	std::unique_ptr<ActiveResult<void> > _pLastResult;
+	std::atomic<Thread*> _pThread;
 };
 
 
@@ -85,6 +148,8 @@ protected:
 
 ArchiveStrategy::ArchiveStrategy():
 	_compress(false),
+	_compressionLevel(Z_DEFAULT_COMPRESSION),
+	_tempCount(0),
 	_pCompressor(0)
 {
 }
@@ -92,7 +157,11 @@ ArchiveStrategy::ArchiveStrategy():
 
 ArchiveStrategy::~ArchiveStrategy()
 {
-	delete _pCompressor;
+	if (_pCompressor)
+	{
+		_pCompressor->wait();
+		delete _pCompressor;
+	}
 }
 
 
@@ -102,8 +171,70 @@ void ArchiveStrategy::compress(bool flag)
 }
 
 
+void ArchiveStrategy::compressionLevel(int level)
+{
+	if (level != Z_DEFAULT_COMPRESSION && (level < 1 || level > 9))
+		throw InvalidArgumentException("compression level must be between 1 and 9");
+
+	_compressionLevel = level;
+}
+
+
+int ArchiveStrategy::getCompressionLevel() const
+{
+	return _compressionLevel;
+}
+
+
+void ArchiveStrategy::purge(PurgeStrategy& strategy, const std::string& path)
+{
+	if (_compress)
+	{
+		if (!_pCompressor) _pCompressor = new ArchiveCompressor;
+		PurgeStrategy* pStrategy = &strategy;
+		_pCompressor->post([pStrategy, path]() { pStrategy->purge(path); });
+	}
+	else strategy.purge(path);
+}
+
+
+void ArchiveStrategy::wait()
+{
+	if (_pCompressor) _pCompressor->wait();
+}
+
+
+void ArchiveStrategy::archiveFile(const std::string& path, const Archiver& archiver)
+{
+	if (_compress)
+	{
+		// Move the log file out of the way, so that a new one can
+		// be opened right away, and leave the rest to the background
+		// thread, which sees the files of all preceding jobs.
+		std::string tempPath;
+		do
+		{
+			tempPath = path;
+			tempPath.append(".~");
+			NumberFormatter::append(tempPath, ++_tempCount);
+		}
+		while (File(tempPath).exists());
+		File(path).renameTo(tempPath);
+
+		if (!_pCompressor) _pCompressor = new ArchiveCompressor;
+		_pCompressor->post([archiver, tempPath]() { archiver(tempPath); });
+	}
+	else archiver(path);
+}
+
+
 void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& newPath)
 {
+	bool background = _pCompressor && _pCompressor->isCurrent();
+
+	// the file may still be compressed
+	if (!background) wait();
+
 	bool compressed = false;
 	Path p(oldPath);
 	File f(oldPath);
@@ -122,8 +253,16 @@ void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& ne
 	else
 	{
 		f.renameTo(newPath);
-		if (!_pCompressor) _pCompressor = new ArchiveCompressor;
-		_pCompressor->compress(newPath);
+		if (background)
+		{
+			ArchiveCompressor::compressFile(newPath, _compressionLevel);
+		}
+		else
+		{
+			if (!_pCompressor) _pCompressor = new ArchiveCompressor;
+			int level = _compressionLevel;
+			_pCompressor->post([newPath, level]() { ArchiveCompressor::compressFile(newPath, level); });
+		}
 	}
 }
 
@@ -158,6 +297,7 @@ ArchiveByNumberStrategy::ArchiveByNumberStrategy()
 
 ArchiveByNumberStrategy::~ArchiveByNumberStrategy()
 {
+	wait();
 }
 
 
@@ -165,6 +305,16 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 {
 	std::string basePath = pFile->path();
 	delete pFile;
+	archiveFile(basePath, [this, basePath](const std::string& filePath)
+		{
+			archiveByNumber(basePath, filePath);
+		});
+	return new LogFile(basePath);
+}
+
+
+void ArchiveByNumberStrategy::archiveByNumber(const std::string& basePath, const std::string& filePath)
+{
 	int n = -1;
 	std::string path;
 	do
@@ -177,9 +327,10 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 	
 	while (n >= 0)
 	{
-		std::string oldPath = basePath;
+		std::string oldPath = filePath;
 		if (n > 0)
 		{
+			oldPath = basePath;
 			oldPath.append(".");
 			NumberFormatter::append(oldPath, n - 1);
 		}
@@ -189,7 +340,6 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 		moveFile(oldPath, newPath);
 		--n;
 	}
-	return new LogFile(basePath);
 }
 
 
@@ -0,0 +1,381 @@
+//
+// Base64.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base64.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Exception.h"
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char OUT_ENCODING[]     = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const char OUT_ENCODING_URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	const UInt8 INVALID = 0xFF;
+
+
+	class DecodingTable
+		/// Maps characters to their 6-bit values,
+		/// or INVALID if not in the alphabet.
+	{
+	public:
+		DecodingTable(const char* alphabet)
+		{
+			for (int i = 0; i < 256; ++i) _table[i] = INVALID;
+			for (int i = 0; i < 64; ++i) _table[static_cast<UInt8>(alphabet[i])] = static_cast<UInt8>(i);
+		}
+
+		UInt32 operator [] (char c) const
+		{
+			return _table[static_cast<UInt8>(c)];
+		}
+
+	private:
+		UInt8 _table[256];
+	};
+
+
+	const DecodingTable& decodingTable(int options)
+	{
+		static const DecodingTable table(OUT_ENCODING);
+		static const DecodingTable tableURL(OUT_ENCODING_URL);
+
+		return (options & BASE64_URL_ENCODING) ? tableURL : table;
+	}
+
+
+#if defined(POCO_HAVE_X86_SIMD)
+
+
+	//
+	// The SIMD kernels follow the algorithms described by Wojciech Mula
+	// and Daniel Lemire in "Faster Base64 Encoding and Decoding Using
+	// AVX2 Instructions" (ACM Transactions on the Web, 2018).
+	//
+	// Encoding spreads each group of 3 bytes over 4 bytes with a shuffle,
+	// extracts the four 6-bit indices with two multiplications and maps
+	// the indices to characters by adding an offset from a 16-entry table.
+	//
+	// Decoding maps characters to their values with range comparisons,
+	// checks that all characters are valid, and merges the 6-bit values
+	// with two multiply-adds, followed by a shuffle. A block containing
+	// an invalid character (including padding) is left to the scalar code.
+	//
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline __m128i encodeIndices(__m128i in)
+	{
+		in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+		const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+		const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		return _mm_or_si128(t1, t3);
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline __m128i encodeCharacters(__m128i indices, __m128i offsets)
+	{
+		__m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+		return _mm_add_epi8(_mm_shuffle_epi8(offsets, result), indices);
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t encodeSSSE3(const UInt8* in, std::size_t length, char* out, const char* alphabet)
+		/// Encodes 12 bytes at a time (reading 16). Returns the number of bytes encoded.
+	{
+		const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62),
+			static_cast<char>(alphabet[63] - 63), 'A', 0, 0);
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), encodeCharacters(encodeIndices(data), offsets));
+			done += 12;
+			out += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t encodeAVX2(const UInt8* in, std::size_t length, char* out, const char* alphabet)
+		/// Encodes 24 bytes at a time (reading 28). Returns the number of bytes encoded.
+	{
+		const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62),
+			static_cast<char>(alphabet[63] - 63), 'A', 0, 0,
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62),
+			static_cast<char>(alphabet[63] - 63), 'A', 0, 0);
+		std::size_t done = 0;
+		while (length - done >= 28)
+		{
+			__m256i data = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done)));
+			data = _mm256_inserti128_si256(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 12)), 1);
+			data = _mm256_shuffle_epi8(data, shuffle);
+			const __m256i t0 = _mm256_and_si256(data, _mm256_set1_epi32(0x0FC0FC00));
+			const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+			const __m256i t2 = _mm256_and_si256(data, _mm256_set1_epi32(0x003F03F0));
+			const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+			const __m256i indices = _mm256_or_si256(t1, t3);
+			__m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+			const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+			result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+			result = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, result), indices);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+			done += 24;
+			out += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline bool decodeValues(__m128i in, __m128i& values, char c62, char c63)
+		/// Maps 16 characters to their 6-bit values.
+		/// Returns false if any character is invalid.
+	{
+		const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), in));
+		const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), in));
+		const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+		const __m128i is62 = _mm_cmpeq_epi8(in, _mm_set1_epi8(c62));
+		const __m128i is63 = _mm_cmpeq_epi8(in, _mm_set1_epi8(c63));
+		const __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, is62)), is63);
+		if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+		__m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+		shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+		shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+		shift = _mm_or_si128(shift, _mm_and_si128(is62, _mm_set1_epi8(static_cast<char>(62 - c62))));
+		shift = _mm_or_si128(shift, _mm_and_si128(is63, _mm_set1_epi8(static_cast<char>(63 - c63))));
+		values = _mm_add_epi8(in, shift);
+		return true;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline __m128i packValues(__m128i values)
+		/// Merges 16 6-bit values into 12 bytes
+		/// (followed by 4 zero bytes).
+	{
+		const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+		return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t decodeSSSE3(const char* in, std::size_t length, UInt8* out, const char* alphabet)
+		/// Decodes 16 characters at a time, writing 16 bytes (12 valid).
+		/// Stops 8 characters before the end of the input, so the
+		/// writes stay within decodedLength(length).
+		/// Returns the number of characters decoded.
+	{
+		std::size_t done = 0;
+		while (length - done >= 24)
+		{
+			__m128i values;
+			if (!decodeValues(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done)), values, alphabet[62], alphabet[63])) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), packValues(values));
+			done += 16;
+			out += 12;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t decodeAVX2(const char* in, std::size_t length, UInt8* out, const char* alphabet)
+		/// Decodes 32 characters at a time, writing 32 bytes (24 valid).
+		/// Stops 12 characters before the end of the input, so the
+		/// writes stay within decodedLength(length).
+		/// Returns the number of characters decoded.
+	{
+		const char c62 = alphabet[62];
+		const char c63 = alphabet[63];
+		std::size_t done = 0;
+		while (length - done >= 44)
+		{
+			const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(data, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), data));
+			const __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(data, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), data));
+			const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(data, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), data));
+			const __m256i is62 = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(c62));
+			const __m256i is63 = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(c63));
+			const __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, is62)), is63);
+			if (_mm256_movemask_epi8(valid) != -1) break;
+
+			__m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(is62, _mm256_set1_epi8(static_cast<char>(62 - c62))));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(is63, _mm256_set1_epi8(static_cast<char>(63 - c63))));
+			const __m256i values = _mm256_add_epi8(data, shift);
+
+			__m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+			merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), merged);
+			done += 32;
+			out += 24;
+		}
+		return done;
+	}
+
+
+#endif // POCO_HAVE_X86_SIMD
+
+
+	const bool useAVX2 = CPUFeatures::hasAVX2();
+	const bool useSSSE3 = CPUFeatures::hasSSSE3();
+}
+
+
+std::size_t Base64::encode(const void* buffer, std::size_t length, char* encoded, int options)
+{
+	const char* alphabet = (options & BASE64_URL_ENCODING) ? OUT_ENCODING_URL : OUT_ENCODING;
+	const UInt8* in = reinterpret_cast<const UInt8*>(buffer);
+	char* out = encoded;
+
+#if defined(POCO_HAVE_X86_SIMD)
+	std::size_t done = 0;
+	if (useAVX2)
+		done = encodeAVX2(in, length, out, alphabet);
+	else if (useSSSE3)
+		done = encodeSSSE3(in, length, out, alphabet);
+	in += done;
+	out += done/3*4;
+	length -= done;
+#endif
+
+	while (length >= 3)
+	{
+		out[0] = alphabet[in[0] >> 2];
+		out[1] = alphabet[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+		out[2] = alphabet[((in[1] & 0x0F) << 2) | (in[2] >> 6)];
+		out[3] = alphabet[in[2] & 0x3F];
+		in += 3;
+		out += 4;
+		length -= 3;
+	}
+	if (length > 0)
+	{
+		UInt8 in1 = length > 1 ? in[1] : 0;
+		*out++ = alphabet[in[0] >> 2];
+		*out++ = alphabet[((in[0] & 0x03) << 4) | (in1 >> 4)];
+		if (length > 1) *out++ = alphabet[(in1 & 0x0F) << 2];
+		if (!(options & BASE64_NO_PADDING))
+		{
+			if (length == 1) *out++ = '=';
+			*out++ = '=';
+		}
+	}
+	return out - encoded;
+}
+
+
+std::string Base64::encode(const std::string& data, int options)
+{
+	std::string result(encodedLength(data.size(), options), '\0');
+	if (!result.empty())
+	{
+		result.resize(encode(data.data(), data.size(), &result[0], options));
+	}
+	return result;
+}
+
+
+std::size_t Base64::decode(const char* encoded, std::size_t length, void* buffer, int options)
+{
+	const DecodingTable& table = decodingTable(options);
+	const char* in = encoded;
+	UInt8* out = reinterpret_cast<UInt8*>(buffer);
+
+	std::size_t rem = length % 4;
+	if (rem == 1 || (rem > 1 && !(options & BASE64_NO_PADDING)))
+		throw DataFormatException("Truncated Base64 data");
+	if (rem == 0 && length > 0 && encoded[length - 1] == '=')
+	{
+		// the final group is padded; decode it like an unpadded one
+		rem = encoded[length - 2] == '=' ? 2 : 3;
+		length -= 4;
+	}
+	else length -= rem;
+	const char* tail = encoded + length;
+
+#if defined(POCO_HAVE_X86_SIMD)
+	const char* alphabet = (options & BASE64_URL_ENCODING) ? OUT_ENCODING_URL : OUT_ENCODING;
+	std::size_t done = 0;
+	if (useAVX2)
+		done = decodeAVX2(in, length, out, alphabet);
+	else if (useSSSE3)
+		done = decodeSSSE3(in, length, out, alphabet);
+	in += done;
+	out += done/4*3;
+#endif
+
+	while (in < tail)
+	{
+		UInt32 v0 = table[in[0]];
+		UInt32 v1 = table[in[1]];
+		UInt32 v2 = table[in[2]];
+		UInt32 v3 = table[in[3]];
+		if ((v0 | v1 | v2 | v3) & 0x80) throw DataFormatException("Invalid Base64 character");
+		UInt32 v = (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+		out[0] = static_cast<UInt8>(v >> 16);
+		out[1] = static_cast<UInt8>(v >> 8);
+		out[2] = static_cast<UInt8>(v);
+		in += 4;
+		out += 3;
+	}
+	if (rem > 0)
+	{
+		UInt32 v0 = table[in[0]];
+		UInt32 v1 = table[in[1]];
+		UInt32 v2 = rem > 2 ? table[in[2]] : 0;
+		if ((v0 | v1 | v2) & 0x80) throw DataFormatException("Invalid Base64 character");
+		*out++ = static_cast<UInt8>((v0 << 2) | (v1 >> 4));
+		if (rem > 2) *out++ = static_cast<UInt8>((v1 << 4) | (v2 >> 2));
+	}
+	return out - reinterpret_cast<UInt8*>(buffer);
+}
+
+
+std::string Base64::decode(const std::string& encoded, int options)
+{
+	std::string result(decodedLength(encoded.size()), '\0');
+	if (!result.empty())
+	{
+		result.resize(decode(encoded.data(), encoded.size(), &result[0], options));
+	}
+	return result;
+}
+
+
+} // namespace Poco
@@ -13,66 +13,22 @@
 
 
 #include "Poco/Base64Decoder.h"
-#include "Poco/Base64Encoder.h"
+#include "Poco/Base64.h"
 #include "Poco/Exception.h"
-#include "Poco/Mutex.h"
+#include <cstring>
 
 
 namespace Poco {
 
 
-unsigned char Base64DecoderBuf::IN_ENCODING[256];
-bool Base64DecoderBuf::IN_ENCODING_INIT = false;
-unsigned char Base64DecoderBuf::IN_ENCODING_URL[256];
-bool Base64DecoderBuf::IN_ENCODING_URL_INIT = false;
-
-
-namespace
-{
-	static FastMutex mutex;
-}
-
-
 Base64DecoderBuf::Base64DecoderBuf(std::istream& istr, int options):
 	_options(options),
 	_groupLength(0),
 	_groupIndex(0),
-	_buf(*istr.rdbuf()),
-	_pInEncoding((options & BASE64_URL_ENCODING) ? IN_ENCODING_URL : IN_ENCODING)
+	_pendingPos(0),
+	_pendingEnd(0),
+	_buf(*istr.rdbuf())
 {
-	FastMutex::ScopedLock lock(mutex);
-	if (options & BASE64_URL_ENCODING)
-	{
-		if (!IN_ENCODING_URL_INIT)
-		{
-			for (unsigned i = 0; i < sizeof(IN_ENCODING_URL); i++)
-			{
-				IN_ENCODING_URL[i] = 0xFF;
-			}
-			for (unsigned i = 0; i < sizeof(Base64EncoderBuf::OUT_ENCODING_URL); i++)
-			{
-				IN_ENCODING_URL[Base64EncoderBuf::OUT_ENCODING_URL[i]] = static_cast<UInt8>(i);
-			}
-			IN_ENCODING_URL[static_cast<unsigned char>('=')] = '\0';
-			IN_ENCODING_URL_INIT = true;
-		}
-	}
-	else
-	{
-		if (!IN_ENCODING_INIT)
-		{
-			for (unsigned i = 0; i < sizeof(IN_ENCODING); i++)
-			{
-				IN_ENCODING[i] = 0xFF;
-			}
-			for (unsigned i = 0; i < sizeof(Base64EncoderBuf::OUT_ENCODING); i++)
-			{
-				IN_ENCODING[Base64EncoderBuf::OUT_ENCODING[i]] = static_cast<UInt8>(i);
-			}
-			IN_ENCODING[static_cast<unsigned char>('=')] = '\0';
-			IN_ENCODING_INIT = true;
-		}
-	}
 }
 
 
@@ -89,55 +45,78 @@ int Base64DecoderBuf::readFromDevice()
 	}
 	else
 	{
-		unsigned char buffer[4];
+		char buffer[4];
+		int n = 0;
 		int c;
-		if ((c = readOne()) == -1) return -1;
-		buffer[0] = static_cast<UInt8>(c);
-		if (_pInEncoding[buffer[0]] == 0xFF) throw DataFormatException();
-		if ((c = readOne()) == -1) return -1;
-		buffer[1] = static_cast<UInt8>(c);
-		if (_pInEncoding[buffer[1]] == 0xFF) throw DataFormatException();
-		if (_options & BASE64_NO_PADDING)
-		{
-			if ((c = readOne()) != -1)
-				buffer[2] = static_cast<UInt8>(c);
-			else
-				buffer[2] = '=';
-			if (_pInEncoding[buffer[2]] == 0xFF) throw DataFormatException();
-			if ((c = readOne()) != -1)
-				buffer[3] = static_cast<UInt8>(c);
-			else
-				buffer[3] = '=';
-			if (_pInEncoding[buffer[3]] == 0xFF) throw DataFormatException();
-		}
-		else
+		while (n < 4 && (c = readOne()) != -1)
 		{
-			if ((c = readOne()) == -1) throw DataFormatException();
-			buffer[2] = static_cast<UInt8>(c);
-			if (_pInEncoding[buffer[2]] == 0xFF) throw DataFormatException();
-			if ((c = readOne()) == -1) throw DataFormatException();
-			buffer[3] = static_cast<UInt8>(c);
-			if (_pInEncoding[buffer[3]] == 0xFF) throw DataFormatException();
+			buffer[n++] = static_cast<char>(c);
 		}
+		if (n < 2) return -1;
+		if (n < 4 && !(_options & BASE64_NO_PADDING)) throw DataFormatException();
+		if (n == 4 && buffer[2] == '=') buffer[3] = '=';
 
-		_group[0] = (_pInEncoding[buffer[0]] << 2) | (_pInEncoding[buffer[1]] >> 4);
-		_group[1] = ((_pInEncoding[buffer[1]] & 0x0F) << 4) | (_pInEncoding[buffer[2]] >> 2);
-		_group[2] = (_pInEncoding[buffer[2]] << 6) | _pInEncoding[buffer[3]];
-
-		if (buffer[2] == '=')
-			_groupLength = 1;
-		else if (buffer[3] == '=')
-			_groupLength = 2;
-		else
-			_groupLength = 3;
+		_groupLength = static_cast<int>(Base64::decode(buffer, n, _group, _options));
 		_groupIndex = 1;
 		return _group[0];
 	}
 }
 
 
+std::streamsize Base64DecoderBuf::xsgetn(char* p, std::streamsize count)
+{
+	if (count <= 0) return 0;
+	int c = uflow();
+	if (c == -1) return 0;
+	*p++ = static_cast<char>(c);
+	std::streamsize copied = 1;
+	while (copied < count && _groupIndex < _groupLength)
+	{
+		*p++ = static_cast<char>(_group[_groupIndex++]);
+		++copied;
+	}
+
+	// Decode whole groups of four characters directly into p. Anything
+	// else (padding, errors, the end of the data) is left to readFromDevice(),
+	// which also delivers the last byte, so that it can be put back.
+	while (count - copied > 3)
+	{
+		std::streamsize maxChars = 4*((count - copied - 1)/3);
+		int n = readChars(maxChars < BUFFER_SIZE ? static_cast<int>(maxChars) : BUFFER_SIZE);
+		const char* pPad = static_cast<const char*>(std::memchr(_pending, '=', n));
+		int length = pPad ? static_cast<int>(pPad - _pending) : n;
+		length -= length % 4;
+		if (length == 0) break;
+		std::size_t decoded;
+		try
+		{
+			decoded = Base64::decode(_pending, length, p, _options);
+		}
+		catch (DataFormatException&)
+		{
+			break;
+		}
+		_pendingPos = length;
+		p += decoded;
+		copied += decoded;
+	}
+
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == -1) break;
+		*p++ = static_cast<char>(c);
+		++copied;
+	}
+	return copied;
+}
+
+
 int Base64DecoderBuf::readOne()
 {
+	if (_pendingPos < _pendingEnd)
+		return static_cast<unsigned char>(_pending[_pendingPos++]);
+
 	int ch = _buf.sbumpc();
 	if (!(_options & BASE64_URL_ENCODING))
 	{
@@ -148,6 +127,32 @@ int Base64DecoderBuf::readOne()
 }
 
 
+int Base64DecoderBuf::readChars(int maxChars)
+{
+	int n = _pendingEnd - _pendingPos;
+	std::memmove(_pending, _pending + _pendingPos, n);
+	_pendingPos = 0;
+	if (n < maxChars)
+	{
+		int start = n;
+		n += static_cast<int>(_buf.sgetn(_pending + n, maxChars - n));
+		if (!(_options & BASE64_URL_ENCODING))
+		{
+			int end = start;
+			for (int i = start; i < n; i++)
+			{
+				char ch = _pending[i];
+				if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n')
+					_pending[end++] = ch;
+			}
+			n = end;
+		}
+	}
+	_pendingEnd = n;
+	return n < maxChars ? n : maxChars;
+}
+
+
 Base64DecoderIOS::Base64DecoderIOS(std::istream& istr, int options): _buf(istr, options)
 {
 	poco_ios_init(&_buf);
@@ -18,39 +18,12 @@
 namespace Poco {
 
 
-const unsigned char Base64EncoderBuf::OUT_ENCODING[64] =
-{
-	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-	'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-	'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-	'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
-	'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-	'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-	'w', 'x', 'y', 'z', '0', '1', '2', '3',
-	'4', '5', '6', '7', '8', '9', '+', '/'
-};
-
-
-const unsigned char Base64EncoderBuf::OUT_ENCODING_URL[64] =
-{
-	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-	'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-	'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-	'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
-	'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-	'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-	'w', 'x', 'y', 'z', '0', '1', '2', '3',
-	'4', '5', '6', '7', '8', '9', '-', '_'
-};
-
-
 Base64EncoderBuf::Base64EncoderBuf(std::ostream& ostr, int options):
 	_options(options),
 	_groupLength(0),
 	_pos(0),
 	_lineLength((options & BASE64_URL_ENCODING) ? 0 : 72),
-	_buf(*ostr.rdbuf()),
-	_pOutEncoding((options & BASE64_URL_ENCODING) ? OUT_ENCODING_URL : OUT_ENCODING)
+	_buf(*ostr.rdbuf())
 {
 }
 
@@ -86,15 +59,7 @@ int Base64EncoderBuf::writeToDevice(char c)
 	_group[_groupLength++] = (unsigned char) c;
 	if (_groupLength == 3)
 	{
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = ((_group[1] & 0x0F) << 2) | (_group[2] >> 6);
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = _group[2] & 0x3F;
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
+		if (writeGroup() == eof) return eof;
 		_pos += 4;
 		if (_lineLength > 0 && _pos >= _lineLength)
 		{
@@ -102,47 +67,85 @@ int Base64EncoderBuf::writeToDevice(char c)
 			if (_buf.sputc('\n') == eof) return eof;
 			_pos = 0;
 		}
-		_groupLength = 0;
 	}
 	return charToInt(c);
 }
 
 
-int Base64EncoderBuf::close()
+std::streamsize Base64EncoderBuf::xsputn(const char* s, std::streamsize n)
 {
 	static const int eof = std::char_traits<char>::eof();
 
-	if (sync() == eof) return eof;
-	if (_groupLength == 1)
+	std::streamsize written = 0;
+	while (_groupLength > 0 && written < n)
 	{
-		_group[1] = 0;
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		if (!(_options & BASE64_NO_PADDING))
-		{
-			if (_buf.sputc('=') == eof) return eof;
-			if (_buf.sputc('=') == eof) return eof;
-		}
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
 	}
-	else if (_groupLength == 2)
+
+	// Encode whole groups a buffer at a time, inserting
+	// line breaks where writeToDevice() would.
+	char buffer[BUFFER_SIZE];
+	while (n - written >= 3)
 	{
-		_group[2] = 0;
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		idx = ((_group[1] & 0x0F) << 2) | (_group[2] >> 6);
-		if (_buf.sputc(_pOutEncoding[idx]) == eof) return eof;
-		if (!(_options & BASE64_NO_PADDING))
+		std::streamsize consumed = written;
+		std::streamsize length = 0;
+		while (n - consumed >= 3 && length + 6 <= BUFFER_SIZE)
 		{
-			if (_buf.sputc('=') == eof) return eof;
+			std::streamsize groups = (n - consumed)/3;
+			std::streamsize maxGroups = (BUFFER_SIZE - length - 2)/4;
+			if (groups > maxGroups) groups = maxGroups;
+			if (_lineLength > 0)
+			{
+				std::streamsize lineGroups = (_lineLength - _pos + 3)/4;
+				if (lineGroups < 1) lineGroups = 1;
+				if (groups > lineGroups) groups = lineGroups;
+			}
+			std::size_t encoded = Base64::encode(s + consumed, static_cast<std::size_t>(3*groups), buffer + length, _options | BASE64_NO_PADDING);
+			consumed += 3*groups;
+			length += encoded;
+			_pos += static_cast<int>(encoded);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				buffer[length++] = '\r';
+				buffer[length++] = '\n';
+				_pos = 0;
+			}
 		}
+		if (_buf.sputn(buffer, length) != length) return written;
+		written = consumed;
+	}
+
+	while (written < n)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
 	}
+	return written;
+}
+
+
+int Base64EncoderBuf::writeGroup()
+{
+	char buffer[4];
+	std::streamsize length = static_cast<std::streamsize>(Base64::encode(_group, _groupLength, buffer, _options));
 	_groupLength = 0;
+	if (_buf.sputn(buffer, length) != length)
+		return std::char_traits<char>::eof();
+	else
+		return 0;
+}
+
+
+int Base64EncoderBuf::close()
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (sync() == eof) return eof;
+	if (_groupLength > 0)
+	{
+		if (writeGroup() == eof) return eof;
+	}
 	return _buf.pubsync();
 }
 
@@ -0,0 +1,139 @@
+//
+// CPUFeatures.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_HAVE_X86_SIMD)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	struct Features
+	{
+		Features():
+			ssse3(false),
+			sse41(false),
+			sse42(false),
+			pclmulqdq(false),
+			avx2(false),
+			sha(false)
+		{
+#if defined(POCO_HAVE_X86_SIMD)
+			unsigned regs[4] = {0, 0, 0, 0}; // eax, ebx, ecx, edx
+			cpuid(0, regs);
+			unsigned maxLeaf = regs[0];
+			if (maxLeaf < 1) return;
+
+			cpuid(1, regs);
+			ssse3     = (regs[2] & (1u << 9)) != 0;
+			sse41     = (regs[2] & (1u << 19)) != 0;
+			sse42     = (regs[2] & (1u << 20)) != 0;
+			pclmulqdq = (regs[2] & (1u << 1)) != 0;
+			bool osxsave = (regs[2] & (1u << 27)) != 0;
+			bool avx     = (regs[2] & (1u << 28)) != 0;
+			// The YMM registers must be saved by the operating system
+			bool avxState = osxsave && avx && (xgetbv() & 0x06) == 0x06;
+
+			if (maxLeaf < 7) return;
+			cpuid(7, regs);
+			avx2 = avxState && (regs[1] & (1u << 5)) != 0;
+			sha  = (regs[1] & (1u << 29)) != 0;
+#endif
+		}
+
+#if defined(POCO_HAVE_X86_SIMD)
+		static void cpuid(unsigned leaf, unsigned regs[4])
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuidex(info, static_cast<int>(leaf), 0);
+			for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(info[i]);
+#else
+			__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		}
+
+		static UInt64 xgetbv()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned eax, edx;
+			__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+			return (static_cast<UInt64>(edx) << 32) | eax;
+#endif
+		}
+#endif
+
+		bool ssse3;
+		bool sse41;
+		bool sse42;
+		bool pclmulqdq;
+		bool avx2;
+		bool sha;
+	};
+
+	const Features& features()
+	{
+		static const Features f;
+		return f;
+	}
+}
+
+
+bool CPUFeatures::hasSSSE3()
+{
+	return features().ssse3;
+}
+
+
+bool CPUFeatures::hasSSE41()
+{
+	return features().sse41;
+}
+
+
+bool CPUFeatures::hasSSE42()
+{
+	return features().sse42;
+}
+
+
+bool CPUFeatures::hasPCLMULQDQ()
+{
+	return features().pclmulqdq;
+}
+
+
+bool CPUFeatures::hasAVX2()
+{
+	return features().avx2;
+}
+
+
+bool CPUFeatures::hasSHA()
+{
+	return features().sha;
+}
+
+
+} // namespace Poco
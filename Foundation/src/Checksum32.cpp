@@ -13,16 +13,221 @@
 
 
 #include "Poco/Checksum32.h"
+#include "Poco/CPUFeatures.h"
 #if defined(POCO_UNBUNDLED)
 #include <zlib.h>
 #else
 #include "Poco/zlib.h"
 #endif
+#include <cstring>
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	class CRC32CTable
+		/// Lookup table for the portable CRC-32C implementation
+		/// (reflected polynomial 0x82F63B78).
+	{
+	public:
+		CRC32CTable()
+		{
+			for (UInt32 i = 0; i < 256; ++i)
+			{
+				UInt32 crc = i;
+				for (int k = 0; k < 8; ++k)
+				{
+					crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+				}
+				_table[i] = crc;
+			}
+		}
+
+		UInt32 operator [] (UInt8 i) const
+		{
+			return _table[i];
+		}
+
+	private:
+		UInt32 _table[256];
+	};
+
+
+	UInt32 crc32c(UInt32 crc, const UInt8* data, std::size_t length)
+	{
+		static const CRC32CTable table;
+
+		crc = ~crc;
+		while (length-- > 0)
+		{
+			crc = table[static_cast<UInt8>(crc ^ *data++)] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+
+#if defined(POCO_HAVE_X86_SIMD)
+
+
+	POCO_SIMD_TARGET("pclmul,sse4.1")
+	UInt32 crc32PCLMUL(const UInt8* buf, std::size_t len, UInt32 crc)
+		/// Computes the CRC-32 of len bytes (len >= 64, multiple of 16) by folding
+		/// 4 x 128 bits in parallel with carry-less multiplication, followed by
+		/// a Barrett reduction. See Intel's "Fast CRC Computation for Generic
+		/// Polynomials Using PCLMULQDQ Instruction" for the constants.
+		/// Takes and returns the CRC in inverted (non-finalized) form.
+	{
+		const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+		const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+		const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+		const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+		const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 16));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 32));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 48));
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+		buf += 64;
+		len -= 64;
+		while (len >= 64)
+		{
+			__m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+			__m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+			__m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+			__m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+			x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+			x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+			x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf)));
+			x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 16)));
+			x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 32)));
+			x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 48)));
+			buf += 64;
+			len -= 64;
+		}
+		__m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+		while (len >= 16)
+		{
+			x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+			x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+			buf += 16;
+			len -= 16;
+		}
+		x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_and_si128(x1, mask32);
+		x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+		x2 = _mm_and_si128(x1, mask32);
+		x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+		x2 = _mm_and_si128(x2, mask32);
+		x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+		return static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	UInt32 adler32AVX2(UInt32 adler, const UInt8* buf, std::size_t len)
+		/// Computes the Adler-32 of all complete 32-byte blocks in the buffer.
+		/// The weighted sums of each block are computed with a multiply-add
+		/// against the taps 32..1; the modulo reduction is deferred
+		/// for up to NMAX bytes, as in zlib.
+	{
+		const UInt32 BASE = 65521;
+		const std::size_t NMAX = 5552;
+		UInt32 s1 = adler & 0xFFFF;
+		UInt32 s2 = adler >> 16;
+		std::size_t blocks = len/32;
+		const __m256i taps = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+			16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i ones = _mm256_set1_epi16(1);
+		while (blocks > 0)
+		{
+			std::size_t n = NMAX/32;
+			if (n > blocks) n = blocks;
+			blocks -= n;
+			__m256i vps = _mm256_setr_epi32(static_cast<int>(s1*n), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vs2 = _mm256_setr_epi32(static_cast<int>(s2), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vs1 = zero;
+			do
+			{
+				__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf));
+				vps = _mm256_add_epi32(vps, vs1);
+				vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(bytes, zero));
+				vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, taps), ones));
+				buf += 32;
+			}
+			while (--n);
+			vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vps, 5));
+			__m128i t1 = _mm_add_epi32(_mm256_castsi256_si128(vs1), _mm256_extracti128_si256(vs1, 1));
+			t1 = _mm_add_epi32(t1, _mm_shuffle_epi32(t1, _MM_SHUFFLE(2, 3, 0, 1)));
+			t1 = _mm_add_epi32(t1, _mm_shuffle_epi32(t1, _MM_SHUFFLE(1, 0, 3, 2)));
+			__m128i t2 = _mm_add_epi32(_mm256_castsi256_si128(vs2), _mm256_extracti128_si256(vs2, 1));
+			t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, _MM_SHUFFLE(2, 3, 0, 1)));
+			t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, _MM_SHUFFLE(1, 0, 3, 2)));
+			s1 = (s1 + static_cast<UInt32>(_mm_cvtsi128_si32(t1))) % BASE;
+			s2 = static_cast<UInt32>(_mm_cvtsi128_si32(t2)) % BASE;
+		}
+		return s1 | (s2 << 16);
+	}
+
+
+	POCO_SIMD_TARGET("sse4.2")
+	UInt32 crc32cSSE42(UInt32 crc, const UInt8* data, std::size_t length)
+	{
+#if POCO_ARCH == POCO_ARCH_AMD64
+		UInt64 crc64 = ~crc;
+		while (length >= 8)
+		{
+			UInt64 word;
+			std::memcpy(&word, data, sizeof(word));
+			crc64 = _mm_crc32_u64(crc64, word);
+			data += 8;
+			length -= 8;
+		}
+		crc = static_cast<UInt32>(crc64);
+#else
+		crc = ~crc;
+		while (length >= 4)
+		{
+			UInt32 word;
+			std::memcpy(&word, data, sizeof(word));
+			crc = _mm_crc32_u32(crc, word);
+			data += 4;
+			length -= 4;
+		}
+#endif
+		while (length-- > 0)
+		{
+			crc = _mm_crc32_u8(crc, *data++);
+		}
+		return ~crc;
+	}
+
+
+#endif // POCO_HAVE_X86_SIMD
+
+
+	const bool useCRC32PCLMUL = CPUFeatures::hasPCLMULQDQ() && CPUFeatures::hasSSE41();
+	const bool useCRC32CSSE42 = CPUFeatures::hasSSE42();
+	const bool useAdler32AVX2 = CPUFeatures::hasAVX2();
+}
+
+
 Checksum32::Checksum32():
 	_type(TYPE_CRC32_IMPL),
 	_value(crc32(0L, Z_NULL, 0))
@@ -36,7 +241,7 @@ Checksum32::Checksum32(ChecksumImpl::Type t):
 {
 	if (t == TYPE_CRC32_IMPL)
 		_value = crc32(0L, Z_NULL, 0);
-	else
+	else if (t == TYPE_ADLER32_IMPL)
 		_value = adler32(0L, Z_NULL, 0);
 }
 
@@ -48,10 +253,46 @@ Checksum32::~Checksum32()
 
 void Checksum32::update(const char* data, unsigned length)
 {
-	if (_type == TYPE_ADLER32_IMPL)
-		_value = adler32(_value, reinterpret_cast<const Bytef*>(data), length);
-	else
-		_value = crc32(_value, reinterpret_cast<const Bytef*>(data), length);
+	const UInt8* p = reinterpret_cast<const UInt8*>(data);
+	switch (_type)
+	{
+	case TYPE_ADLER32_IMPL:
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAdler32AVX2 && length >= 32)
+		{
+			unsigned n = length & ~31u;
+			_value = adler32AVX2(_value, p, n);
+			p += n;
+			length -= n;
+		}
+#endif
+		_value = adler32(_value, p, length);
+		break;
+
+	case TYPE_CRC32C_IMPL:
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useCRC32CSSE42)
+		{
+			_value = crc32cSSE42(_value, p, length);
+			break;
+		}
+#endif
+		_value = crc32c(_value, p, length);
+		break;
+
+	default:
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useCRC32PCLMUL && length >= 64)
+		{
+			unsigned n = length & ~15u;
+			_value = ~crc32PCLMUL(p, n, ~_value);
+			p += n;
+			length -= n;
+		}
+#endif
+		_value = crc32(_value, p, length);
+		break;
+	}
 }
 
 
@@ -0,0 +1,31 @@
+//
+// DescriptorStreamBuf.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  DescriptorStreamBuf
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DescriptorStreamBuf.h"
+
+
+namespace Poco {
+
+
+DescriptorStreamBuf::DescriptorStreamBuf()
+{
+}
+
+
+DescriptorStreamBuf::~DescriptorStreamBuf()
+{
+}
+
+
+} // namespace Poco
@@ -0,0 +1,298 @@
+//
+// Executor.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Executor
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Executor.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Environment.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+
+
+struct Executor::Worker: public Runnable
+{
+	Worker(Executor& owner, int i):
+		executor(owner),
+		index(i),
+		thread(owner._name + "[#" + NumberFormatter::format(i) + "]")
+	{
+	}
+
+	void run()
+	{
+		executor.work(*this);
+	}
+
+	Executor&        executor;
+	int              index;
+	std::deque<Task> tasks;
+	FastMutex        mutex;
+	Thread           thread;
+};
+
+
+namespace
+{
+	thread_local Runnable* pCurrentWorker = 0;
+}
+
+
+Executor::Executor(int threads, std::size_t queueCapacity, int stackSize):
+	_name("Executor"),
+	_capacity(queueCapacity),
+	_pending(0),
+	_sleeping(0),
+	_stopped(false)
+{
+	start(threads, stackSize);
+}
+
+
+Executor::Executor(const std::string& name, int threads, std::size_t queueCapacity, int stackSize):
+	_name(name),
+	_capacity(queueCapacity),
+	_pending(0),
+	_sleeping(0),
+	_stopped(false)
+{
+	start(threads, stackSize);
+}
+
+
+Executor::~Executor()
+{
+	try
+	{
+		shutdown();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (std::vector<Worker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void Executor::start(int threads, int stackSize)
+{
+	poco_assert (threads >= 0);
+
+	if (threads == 0) threads = static_cast<int>(Environment::processorCount());
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; i++)
+	{
+		_workers.push_back(new Worker(*this, i));
+	}
+	for (std::vector<Worker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->thread.setStackSize(stackSize);
+		(*it)->thread.start(**it);
+	}
+}
+
+
+void Executor::execute(const Task& task)
+{
+	enqueue(task, true);
+}
+
+
+bool Executor::tryExecute(const Task& task)
+{
+	return enqueue(task, false);
+}
+
+
+void Executor::shutdown()
+{
+	{
+		// Setting _stopped under _queueMutex ensures that every task
+		// accepted by enqueue() is counted in _pending before workers
+		// can see _stopped and exit.
+		FastMutex::ScopedLock lock(_queueMutex);
+		_stopped = true;
+		_notFull.broadcast();
+	}
+	{
+		FastMutex::ScopedLock lock(_idleMutex);
+		_idle.broadcast();
+	}
+	for (std::vector<Worker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		if ((*it)->thread.isRunning()) (*it)->thread.join();
+	}
+}
+
+
+Executor* Executor::current()
+{
+	return pCurrentWorker ? &static_cast<Worker*>(pCurrentWorker)->executor : 0;
+}
+
+
+bool Executor::runPending()
+{
+	if (!pCurrentWorker) return false;
+
+	Worker& worker = *static_cast<Worker*>(pCurrentWorker);
+	Task task;
+	if (!worker.executor.take(worker, task)) return false;
+	run(task);
+	return true;
+}
+
+
+Executor& Executor::defaultExecutor()
+{
+	static Executor executor("default");
+	return executor;
+}
+
+
+bool Executor::enqueue(const Task& task, bool block)
+{
+	Worker* pWorker = static_cast<Worker*>(pCurrentWorker);
+	if (pWorker && &pWorker->executor == this)
+	{
+		// Subtasks go into the worker's own queue, which is not
+		// bounded, as blocking a worker could deadlock the Executor.
+		FastMutex::ScopedLock lock(pWorker->mutex);
+		++_pending;
+		pWorker->tasks.push_back(task);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		if (_stopped) throw IllegalStateException("Executor has been shut down", _name);
+		while (_capacity > 0 && _queue.size() >= _capacity)
+		{
+			if (!block) return false;
+			_notFull.wait(_queueMutex);
+			if (_stopped) throw IllegalStateException("Executor has been shut down", _name);
+		}
+		++_pending;
+		_queue.push_back(task);
+	}
+	wakeUp();
+	return true;
+}
+
+
+bool Executor::take(Worker& worker, Task& task)
+{
+	{
+		FastMutex::ScopedLock lock(worker.mutex);
+		if (!worker.tasks.empty())
+		{
+			task.swap(worker.tasks.back());
+			worker.tasks.pop_back();
+			--_pending;
+			return true;
+		}
+	}
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		if (!_queue.empty())
+		{
+			task.swap(_queue.front());
+			_queue.pop_front();
+			--_pending;
+			if (_capacity > 0) _notFull.signal();
+			return true;
+		}
+	}
+	std::size_t n = _workers.size();
+	for (std::size_t i = 1; i < n; i++)
+	{
+		Worker& victim = *_workers[(worker.index + i) % n];
+		FastMutex::ScopedLock lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task.swap(victim.tasks.front());
+			victim.tasks.pop_front();
+			--_pending;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void Executor::work(Worker& worker)
+{
+	pCurrentWorker = &worker;
+	Task task;
+	for (;;)
+	{
+		if (take(worker, task))
+		{
+			run(task);
+			task = Task();
+			continue;
+		}
+
+		FastMutex::ScopedLock lock(_idleMutex);
+		++_sleeping;
+		while (_pending == 0 && !_stopped)
+		{
+			_idle.wait(_idleMutex);
+		}
+		--_sleeping;
+		if (_stopped && _pending == 0) break;
+	}
+	pCurrentWorker = 0;
+}
+
+
+void Executor::wakeUp()
+{
+	// _pending has been incremented before _sleeping is checked here,
+	// while a worker increments _sleeping before checking _pending,
+	// so at least one of them sees the other's change.
+	if (_sleeping > 0)
+	{
+		FastMutex::ScopedLock lock(_idleMutex);
+		_idle.signal();
+	}
+}
+
+
+void Executor::run(Task& task)
+{
+	try
+	{
+		task();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+}
+
+
+} // namespace Poco
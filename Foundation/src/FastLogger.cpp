@@ -0,0 +1,671 @@
+//
+// FastLogger.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  FastLogger
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/FastLogger.h"
+#include "Poco/Format.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include <algorithm>
+
+
+namespace Poco {
+
+
+//
+// FastLogger::Format
+//
+
+
+FastLogger::Format::Format(Message::Priority prio, const char* fmt, const char* file, int line):
+	_prio(prio),
+	_format(fmt),
+	_file(file),
+	_line(line)
+{
+}
+
+
+FastLogger::Format::~Format()
+{
+}
+
+
+//
+// FastLogger::RingBuffer
+//
+
+
+class FastLogger::RingBuffer
+	/// A single-producer/single-consumer ring buffer holding
+	/// variable-sized records.
+	///
+	/// Every record is preceded by an 8 byte frame header holding the
+	/// frame size and a flag; frames are padded to a multiple of 8 bytes.
+	/// A record never wraps around the end of the buffer; if it does
+	/// not fit, the remainder of the buffer is filled with a padding
+	/// frame and the record is placed at the start.
+{
+public:
+	RingBuffer(std::size_t capacity, UInt32 loggerId):
+		_buffer(roundCapacity(capacity)),
+		_mask(_buffer.size() - 1),
+		_head(0),
+		_tail(0),
+		_cachedTail(0),
+		_pending(0),
+		_readPos(0),
+		_loggerId(loggerId),
+		_tid(0),
+		_osTid((IntPtr) Thread::currentTid()),
+		_abandoned(false),
+		_closed(false)
+	{
+		Thread* pThread = Thread::current();
+		if (pThread)
+		{
+			_tid = pThread->id();
+			_thread = pThread->name();
+		}
+	}
+
+	char* reserve(std::size_t size)
+		/// Reserves space for a record of the given size and
+		/// returns a pointer to it, or null if the buffer is full.
+		/// Called by the producer only.
+	{
+		if (!accepts(size)) return 0;
+
+		std::size_t frame = align(HEADER_SIZE + size);
+		std::size_t capacity = _buffer.size();
+
+		std::size_t head = _head.load(std::memory_order_relaxed);
+		std::size_t index = head & _mask;
+		std::size_t padding = (index + frame > capacity) ? capacity - index : 0;
+		std::size_t needed = padding + frame;
+		if (needed > capacity - (head - _cachedTail))
+		{
+			_cachedTail = _tail.load(std::memory_order_acquire);
+			if (needed > capacity - (head - _cachedTail)) return 0;
+		}
+		if (padding)
+		{
+			writeHeader(index, padding, FRAME_PADDING);
+			index = 0;
+		}
+		writeHeader(index, frame, FRAME_RECORD);
+		_pending = head + needed;
+		return _buffer.begin() + index + HEADER_SIZE;
+	}
+
+	bool accepts(std::size_t size) const
+		/// Returns true if a record of the given size fits into
+		/// the buffer. Records are limited to half the capacity,
+		/// so that a record that must be placed at the start of
+		/// the buffer always fits once the buffer has been drained.
+	{
+		return align(HEADER_SIZE + size) <= _buffer.size()/2;
+	}
+
+	void commit()
+		/// Publishes the record obtained from reserve().
+	{
+		_head.store(_pending, std::memory_order_release);
+	}
+
+	const char* next()
+		/// Returns the next record, or null if there is none.
+		/// The record stays valid until release() is called.
+		/// Called by the consumer only.
+	{
+		std::size_t head = _head.load(std::memory_order_acquire);
+		while (_readPos != head)
+		{
+			std::size_t index = _readPos & _mask;
+			UInt32 frame[2];
+			std::memcpy(frame, _buffer.begin() + index, sizeof(frame));
+			_readPos += frame[0];
+			if (frame[1] == FRAME_RECORD)
+				return _buffer.begin() + index + HEADER_SIZE;
+		}
+		return 0;
+	}
+
+	void release()
+		/// Releases all records returned by next().
+	{
+		_tail.store(_readPos, std::memory_order_release);
+	}
+
+	std::size_t head() const
+	{
+		return _head.load(std::memory_order_acquire);
+	}
+
+	std::size_t tail() const
+	{
+		return _tail.load(std::memory_order_acquire);
+	}
+
+	bool empty() const
+	{
+		return head() == tail();
+	}
+
+	UInt32 loggerId() const
+	{
+		return _loggerId;
+	}
+
+	const std::string& thread() const
+	{
+		return _thread;
+	}
+
+	long tid() const
+	{
+		return _tid;
+	}
+
+	IntPtr osTid() const
+	{
+		return _osTid;
+	}
+
+	void abandon()
+		/// Marks the buffer as abandoned by its thread.
+	{
+		_abandoned.store(true, std::memory_order_release);
+	}
+
+	bool abandoned() const
+	{
+		return _abandoned.load(std::memory_order_acquire);
+	}
+
+	void close()
+		/// Marks the buffer as no longer used by its logger.
+	{
+		_closed.store(true, std::memory_order_release);
+	}
+
+	bool closed() const
+	{
+		return _closed.load(std::memory_order_acquire);
+	}
+
+private:
+	enum
+	{
+		HEADER_SIZE = 8,
+		FRAME_RECORD = 0,
+		FRAME_PADDING = 1,
+		MIN_CAPACITY = 4096
+	};
+
+	static std::size_t roundCapacity(std::size_t capacity)
+	{
+		std::size_t size = MIN_CAPACITY;
+		while (size < capacity) size <<= 1;
+		return size;
+	}
+
+	static std::size_t align(std::size_t size)
+	{
+		return (size + 7) & ~std::size_t(7);
+	}
+
+	void writeHeader(std::size_t index, std::size_t frame, UInt32 flag)
+	{
+		UInt32 header[2] = { static_cast<UInt32>(frame), flag };
+		std::memcpy(_buffer.begin() + index, header, sizeof(header));
+	}
+
+	Buffer<char>             _buffer;
+	std::size_t              _mask;
+	std::atomic<std::size_t> _head;
+	std::atomic<std::size_t> _tail;
+	std::size_t              _cachedTail; // producer only
+	std::size_t              _pending;    // producer only
+	std::size_t              _readPos;    // consumer only
+	UInt32                   _loggerId;
+	std::string              _thread;
+	long                     _tid;
+	IntPtr                   _osTid;
+	std::atomic<bool>        _abandoned;
+	std::atomic<bool>        _closed;
+};
+
+
+//
+// FastLogger::ThreadBuffers
+//
+
+
+struct FastLogger::ThreadBuffers
+	/// The ring buffers of a thread, one per FastLogger.
+{
+	~ThreadBuffers()
+	{
+		for (RingBufferVec::iterator it = buffers.begin(); it != buffers.end(); ++it)
+			(*it)->abandon();
+	}
+
+	RingBufferVec buffers;
+};
+
+
+//
+// FastLogger
+//
+
+
+namespace
+{
+	std::atomic<UInt32> nextLoggerId(1);
+}
+
+
+FastLogger::FastLogger(const std::string& name, Channel::Ptr pChannel, int level, std::size_t bufferSize):
+	_name(name),
+	_pChannel(pChannel),
+	_level(level),
+	_blocking(true),
+	_stopped(false),
+	_dropped(0),
+	_bufferSize(bufferSize),
+	_id(nextLoggerId++),
+	_batchSize(0)
+{
+	start();
+}
+
+
+FastLogger::FastLogger(Logger& logger, std::size_t bufferSize):
+	_name(logger.name()),
+	_pChannel(logger.getChannel()),
+	_level(logger.getLevel()),
+	_blocking(true),
+	_stopped(false),
+	_dropped(0),
+	_bufferSize(bufferSize),
+	_id(nextLoggerId++),
+	_batchSize(0)
+{
+	start();
+}
+
+
+FastLogger::~FastLogger()
+{
+	try
+	{
+		_stopped = true;
+		_wakeUp.set();
+		_thread.join();
+
+		FastMutex::ScopedLock lock(_mutex);
+		for (RingBufferVec::iterator it = _rings.begin(); it != _rings.end(); ++it)
+			(*it)->close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void FastLogger::start()
+{
+	_batch.resize(MAX_BATCH);
+	_order.reserve(MAX_BATCH);
+	_thread.setName("FastLogger[" + _name + "]");
+	_thread.start(*this);
+}
+
+
+void FastLogger::setLevel(int level)
+{
+	_level.store(level, std::memory_order_relaxed);
+}
+
+
+void FastLogger::setBlocking(bool blocking)
+{
+	_blocking.store(blocking, std::memory_order_relaxed);
+}
+
+
+FastLogger::RingBuffer* FastLogger::threadBuffer()
+{
+	static thread_local ThreadBuffers threadBuffers;
+
+	RingBufferVec& buffers = threadBuffers.buffers;
+	for (RingBufferVec::iterator it = buffers.begin(); it != buffers.end(); ++it)
+	{
+		if ((*it)->loggerId() == _id) return it->get();
+	}
+
+	// drop the buffers of destroyed loggers
+	RingBufferVec::iterator it = buffers.begin();
+	while (it != buffers.end())
+	{
+		if ((*it)->closed()) it = buffers.erase(it);
+		else ++it;
+	}
+
+	RingBufferPtr pRing = std::make_shared<RingBuffer>(_bufferSize, _id);
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_rings.push_back(pRing);
+	}
+	buffers.push_back(pRing);
+	return pRing.get();
+}
+
+
+char* FastLogger::reserve(RingBuffer*& pRing, std::size_t size)
+{
+	pRing = threadBuffer();
+	char* p = pRing->reserve(size);
+	while (!p)
+	{
+		if (!_blocking.load(std::memory_order_relaxed) || !pRing->accepts(size) || _stopped.load(std::memory_order_relaxed))
+		{
+			++_dropped;
+			return 0;
+		}
+		_wakeUp.set();
+		Thread::yield();
+		p = pRing->reserve(size);
+	}
+	return p;
+}
+
+
+void FastLogger::commit(RingBuffer* pRing)
+{
+	pRing->commit();
+}
+
+
+void FastLogger::flush()
+{
+	std::vector<std::pair<RingBufferPtr, std::size_t> > marks;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		for (RingBufferVec::iterator it = _rings.begin(); it != _rings.end(); ++it)
+			marks.push_back(std::make_pair(*it, (*it)->head()));
+	}
+
+	for (std::vector<std::pair<RingBufferPtr, std::size_t> >::iterator it = marks.begin(); it != marks.end(); ++it)
+	{
+		while (static_cast<std::ptrdiff_t>(it->second - it->first->tail()) > 0 && _thread.isRunning())
+		{
+			_wakeUp.set();
+			_drained.tryWait(IDLE_WAIT);
+		}
+	}
+}
+
+
+void FastLogger::run()
+{
+	while (!_stopped.load(std::memory_order_acquire))
+	{
+		if (!drain()) _wakeUp.tryWait(IDLE_WAIT);
+	}
+	while (drain())
+	{
+	}
+}
+
+
+bool FastLogger::drain()
+{
+	RingBufferVec rings;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		RingBufferVec::iterator it = _rings.begin();
+		while (it != _rings.end())
+		{
+			if ((*it)->abandoned() && (*it)->empty())
+			{
+				(*it)->close();
+				it = _rings.erase(it);
+			}
+			else ++it;
+		}
+		rings = _rings;
+	}
+
+	bool processed = false;
+	std::size_t i = 0;
+	while (i < rings.size())
+	{
+		RingBuffer& ring = *rings[i];
+		const char* pRecord;
+		while (_batchSize < MAX_BATCH && (pRecord = ring.next()))
+		{
+			decode(pRecord, ring, _batch[_batchSize++]);
+		}
+		if (_batchSize == MAX_BATCH)
+		{
+			// all records read so far have been decoded;
+			// log them and continue with the same ring
+			logBatch();
+			for (std::size_t k = 0; k <= i; ++k) rings[k]->release();
+			processed = true;
+		}
+		else ++i;
+	}
+	if (_batchSize > 0)
+	{
+		logBatch();
+		processed = true;
+	}
+	for (RingBufferVec::iterator it = rings.begin(); it != rings.end(); ++it)
+		(*it)->release();
+
+	_drained.set();
+	return processed;
+}
+
+
+void FastLogger::decode(const char* pRecord, const RingBuffer& ring, Message& msg)
+{
+	RecordHeader header;
+	std::memcpy(&header, pRecord, sizeof(header));
+	const char* p = pRecord + sizeof(header);
+
+	_args.clear();
+	for (UInt32 i = 0; i < header.argc; ++i)
+	{
+		int type = *p++;
+		switch (type)
+		{
+		case Impl::FLA_BOOL:
+			{
+				bool value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_CHAR:
+			_args.push_back(*p++);
+			break;
+		case Impl::FLA_SCHAR:
+			_args.push_back(static_cast<signed char>(*p++));
+			break;
+		case Impl::FLA_UCHAR:
+			_args.push_back(static_cast<unsigned char>(*p++));
+			break;
+		case Impl::FLA_SHORT:
+			{
+				short value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_USHORT:
+			{
+				unsigned short value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_INT:
+			{
+				int value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_UINT:
+			{
+				unsigned value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_LONG:
+			{
+				long value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_ULONG:
+			{
+				unsigned long value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_LONGLONG:
+			{
+				long long value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_ULONGLONG:
+			{
+				unsigned long long value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_FLOAT:
+			{
+				float value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_DOUBLE:
+			{
+				double value;
+				std::memcpy(&value, p, sizeof(value));
+				p += sizeof(value);
+				_args.push_back(value);
+			}
+			break;
+		case Impl::FLA_STRING:
+			{
+				UInt32 length;
+				std::memcpy(&length, p, sizeof(length));
+				p += sizeof(length);
+				_args.push_back(std::string(p, length));
+				p += length;
+			}
+			break;
+		default:
+			poco_bugcheck_msg("invalid FastLogger record");
+		}
+	}
+
+	_text.clear();
+	Poco::format(_text, header.pFormat->format(), _args);
+
+	msg.setSource(_name);
+	msg.setText(_text);
+	msg.setPriority(header.pFormat->priority());
+	msg.setTime(Timestamp(header.time));
+	msg.setThread(ring.thread());
+	msg.setTid(ring.tid());
+	msg.setOsTid(ring.osTid());
+	msg.setSourceFile(header.pFormat->file());
+	msg.setSourceLine(header.pFormat->line());
+}
+
+
+void FastLogger::logBatch()
+{
+	_order.clear();
+	for (std::size_t i = 0; i < _batchSize; ++i) _order.push_back(i);
+
+	// records of different threads are interleaved by time
+	struct ByTime
+	{
+		ByTime(const std::vector<Message>& batch): _batch(batch)
+		{
+		}
+
+		bool operator () (std::size_t a, std::size_t b) const
+		{
+			return _batch[a].getTime() < _batch[b].getTime();
+		}
+
+		const std::vector<Message>& _batch;
+	};
+	std::stable_sort(_order.begin(), _order.end(), ByTime(_batch));
+
+	if (_pChannel)
+	{
+		for (std::vector<std::size_t>::const_iterator it = _order.begin(); it != _order.end(); ++it)
+		{
+			try
+			{
+				_pChannel->log(_batch[*it]);
+			}
+			catch (Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+		}
+	}
+	_batchSize = 0;
+}
+
+
+} // namespace Poco
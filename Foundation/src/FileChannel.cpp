@@ -17,12 +17,16 @@
 #include "Poco/RotateStrategy.h"
 #include "Poco/PurgeStrategy.h"
 #include "Poco/Message.h"
+#include "Poco/Logger.h"
+#include "Poco/Timer.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
 #include "Poco/LocalDateTime.h"
 #include "Poco/String.h"
 #include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
 #include "Poco/Ascii.h"
 
 
@@ -34,17 +38,28 @@ const std::string FileChannel::PROP_ROTATION     = "rotation";
 const std::string FileChannel::PROP_ARCHIVE      = "archive";
 const std::string FileChannel::PROP_TIMES        = "times";
 const std::string FileChannel::PROP_COMPRESS     = "compress";
+const std::string FileChannel::PROP_COMPRESSIONLEVEL = "compressionLevel";
 const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
+const std::string FileChannel::PROP_BUFFERSIZE   = "bufferSize";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string FileChannel::PROP_FLUSHPRIORITY = "flushPriority";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
 
 FileChannel::FileChannel():
 	_times("utc"),
 	_compress(false),
+	_compressionLevel("default"),
 	_flush(true),
+	_bufferSize("8 K"),
+	_bufferBytes(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
+	_flushPriority("none"),
+	_flushPrio(0),
 	_rotateOnOpen(false),
 	_pFile(0),
+	_pFlushTimer(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
 	_pPurgeStrategy(0)
@@ -56,9 +71,16 @@ FileChannel::FileChannel(const std::string& rPath):
 	_path(rPath),
 	_times("utc"),
 	_compress(false),
+	_compressionLevel("default"),
 	_flush(true),
+	_bufferSize("8 K"),
+	_bufferBytes(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
+	_flushPriority("none"),
+	_flushPrio(0),
 	_rotateOnOpen(false),
 	_pFile(0),
+	_pFlushTimer(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
 	_pPurgeStrategy(0)
@@ -101,12 +123,30 @@ void FileChannel::open()
 				_pFile = new LogFile(_path);
 			}
 		}
+		_pFile->setBufferSize(_bufferBytes);
+
+		if (!_flush && _flushInterval > 0 && !_pFlushTimer)
+		{
+			_pFlushTimer = new Timer(_flushInterval, _flushInterval);
+			_pFlushTimer->start(TimerCallback<FileChannel>(*this, &FileChannel::onFlush));
+		}
 	}
 }
 
 
 void FileChannel::close()
 {
+	Timer* pFlushTimer;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		pFlushTimer = _pFlushTimer;
+		_pFlushTimer = 0;
+	}
+	// the timer callback acquires the mutex, so
+	// the timer must be stopped without holding it
+	delete pFlushTimer;
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	delete _pFile;
@@ -131,12 +171,13 @@ void FileChannel::log(const Message& msg)
 		{
 			_pFile = new LogFile(_path);
 		}
+		_pFile->setBufferSize(_bufferBytes);
 		// we must call mustRotate() again to give the
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
+	_pFile->write(msg.getText(), _flush || msg.getPriority() <= _flushPrio);
 }
 
 	
@@ -162,12 +203,20 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setArchive(value);
 	else if (name == PROP_COMPRESS)
 		setCompress(value);
+	else if (name == PROP_COMPRESSIONLEVEL)
+		setCompressionLevel(value);
 	else if (name == PROP_PURGEAGE)
 		setPurgeAge(value);
 	else if (name == PROP_PURGECOUNT)
 		setPurgeCount(value);
 	else if (name == PROP_FLUSH)
 		setFlush(value);
+	else if (name == PROP_BUFFERSIZE)
+		setBufferSize(value);
+	else if (name == PROP_FLUSHINTERVAL)
+		setFlushInterval(value);
+	else if (name == PROP_FLUSHPRIORITY)
+		setFlushPriority(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
 	else
@@ -187,12 +236,20 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return _archive;
 	else if (name == PROP_COMPRESS)
 		return std::string(_compress ? "true" : "false");
+	else if (name == PROP_COMPRESSIONLEVEL)
+		return _compressionLevel;
 	else if (name == PROP_PURGEAGE)
 		return _purgeAge;
 	else if (name == PROP_PURGECOUNT)
 		return _purgeCount;
 	else if (name == PROP_FLUSH)
 		return std::string(_flush ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return _bufferSize;
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
+	else if (name == PROP_FLUSHPRIORITY)
+		return _flushPriority;
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
 	else
@@ -296,6 +353,7 @@ void FileChannel::setArchive(const std::string& archive)
 	else throw InvalidArgumentException("archive", archive);
 	delete _pArchiveStrategy;
 	pStrategy->compress(_compress);
+	pStrategy->compressionLevel(parseCompressionLevel(_compressionLevel));
 	_pArchiveStrategy = pStrategy;
 	_archive = archive;
 }
@@ -309,6 +367,15 @@ void FileChannel::setCompress(const std::string& compress)
 }
 
 
+void FileChannel::setCompressionLevel(const std::string& level)
+{
+	int n = parseCompressionLevel(level);
+	if (_pArchiveStrategy)
+		_pArchiveStrategy->compressionLevel(n);
+	_compressionLevel = level;
+}
+
+
 void FileChannel::setPurgeAge(const std::string& age)
 {
 	if (setNoPurge(age)) return;
@@ -337,6 +404,49 @@ void FileChannel::setFlush(const std::string& flush)
 }
 
 
+void FileChannel::setBufferSize(const std::string& size)
+{
+	std::string::const_iterator it  = size.begin();
+	std::string::const_iterator end = size.end();
+	std::size_t n = 0;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	if (it == end || !Ascii::isDigit(*it)) throw InvalidArgumentException("bufferSize", size);
+	while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	std::string unit;
+	while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+	if (unit == "K")
+		n *= 1024;
+	else if (unit == "M")
+		n *= 1024*1024;
+	else if (!unit.empty())
+		throw InvalidArgumentException("bufferSize", size);
+
+	_bufferBytes = n;
+	_bufferSize = size;
+	if (_pFile) _pFile->setBufferSize(_bufferBytes);
+}
+
+
+void FileChannel::setFlushInterval(const std::string& interval)
+{
+	int n = NumberParser::parse(trim(interval));
+	if (n < 0) throw InvalidArgumentException("flushInterval", interval);
+	_flushInterval = n;
+}
+
+
+void FileChannel::setFlushPriority(const std::string& priority)
+{
+	if (priority.empty() || icompare(priority, "none") == 0)
+		_flushPrio = 0;
+	else
+		_flushPrio = Logger::parseLevel(priority);
+	_flushPriority = priority;
+}
+
+
 void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 {
 	_rotateOnOpen = icompare(rotateOnOpen, "true") == 0;
@@ -349,7 +459,10 @@ void FileChannel::purge()
 	{
 		try
 		{
-			_pPurgeStrategy->purge(_path);
+			if (_pArchiveStrategy)
+				_pArchiveStrategy->purge(*_pPurgeStrategy, _path);
+			else
+				_pPurgeStrategy->purge(_path);
 		}
 		catch (...)
 		{
@@ -362,8 +475,7 @@ bool FileChannel::setNoPurge(const std::string& value)
 {
 	if (value.empty() || 0 == icompare(value, "none"))
 	{
-		delete _pPurgeStrategy;
-		_pPurgeStrategy = 0;
+		setPurgeStrategy(0);
 		_purgeAge = "none";
 		return true;
 	}
@@ -394,11 +506,49 @@ int FileChannel::extractDigit(const std::string& value, std::string::const_itera
 
 void FileChannel::setPurgeStrategy(PurgeStrategy* strategy)
 {
+	// the current strategy may still be used by the archive strategy
+	if (_pArchiveStrategy) _pArchiveStrategy->wait();
 	delete _pPurgeStrategy;
 	_pPurgeStrategy = strategy;
 }
 
 
+void FileChannel::onFlush(Timer& /*timer*/)
+{
+	// the lock is released before the ErrorHandler is called,
+	// as the handler may log to this channel
+	try
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_pFile) _pFile->flush();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+}
+
+
+int FileChannel::parseCompressionLevel(const std::string& level)
+{
+	if (level.empty() || icompare(level, "default") == 0)
+		return -1;
+
+	int n = NumberParser::parse(trim(level));
+	if (n < 1 || n > 9) throw InvalidArgumentException("compressionLevel", level);
+	return n;
+}
+
+
 Timespan::TimeDiff FileChannel::extractFactor(const std::string& value, std::string::const_iterator start) const
 {
 	while (start != value.end() && Ascii::isSpace(*start)) ++start;
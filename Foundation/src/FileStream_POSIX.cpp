@@ -121,6 +121,36 @@ bool FileStreamBuf::close()
 }
 
 
+int FileStreamBuf::readDescriptor()
+{
+	if (_fd == -1 || !(getMode() & std::ios::in) || gptr() != egptr())
+		return -1;
+
+	if (getMode() & std::ios::out)
+		sync();
+
+	return _fd;
+}
+
+
+int FileStreamBuf::writeDescriptor()
+{
+	if (_fd == -1 || !(getMode() & std::ios::out) || gptr() != egptr())
+		return -1;
+
+	if (sync() == -1)
+		return -1;
+
+	return _fd;
+}
+
+
+void FileStreamBuf::transferred(Poco::UInt64 count)
+{
+	_pos += static_cast<std::streamoff>(count);
+}
+
+
 std::streampos FileStreamBuf::seekoff(std::streamoff off, std::ios::seekdir dir, std::ios::openmode mode)
 {
 	if (_fd == -1 || !(getMode() & mode))
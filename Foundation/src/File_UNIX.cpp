@@ -33,6 +33,9 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <cstring>
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 #if (POCO_OS == POCO_OS_SOLARIS)
 #define STATFSFN statvfs
@@ -379,6 +382,26 @@ void FileImpl::copyToImpl(const std::string& path) const
 	Buffer<char> buffer(blockSize);
 	try
 	{
+#if POCO_OS == POCO_OS_LINUX
+		if (st.st_size > 0)
+		{
+			// Let the kernel copy the data. If this is not supported,
+			// the read/write loop below copies whatever is left.
+			const std::size_t chunkSize = 0x40000000;
+			ssize_t rc = -1;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+			while ((rc = copy_file_range(sd, NULL, dd, NULL, chunkSize, 0)) > 0)
+			{
+			}
+#endif
+			if (rc < 0)
+			{
+				while (sendfile(dd, sd, NULL, chunkSize) > 0)
+				{
+				}
+			}
+		}
+#endif
 		int n;
 		while ((n = read(sd, buffer.begin(), blockSize)) > 0)
 		{
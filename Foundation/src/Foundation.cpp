@@ -89,9 +89,9 @@ RefCountDiagnosticContext& RefCountDiagnosticContext::get()
 //
 
 // static Logger members
-Logger::LoggerMapPtr Logger::_pLoggerMap;
-Mutex                Logger::_mapMtx;
-const std::string    Logger::ROOT;
+std::atomic<Logger::Table*> Logger::_pTable(0);
+Mutex                       Logger::_mapMtx;
+const std::string           Logger::ROOT;
 
 
 class AutoLoggerShutdown
@@ -0,0 +1,133 @@
+//
+// Future.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Executor
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Future.h"
+#include "Poco/Executor.h"
+#include "Poco/ErrorHandler.h"
+
+
+namespace Poco {
+
+
+FutureHolderBase::FutureHolderBase(Executor* pExecutor):
+	_pExecutor(pExecutor),
+	_ready(false),
+	_event(Event::EVENT_MANUALRESET)
+{
+}
+
+
+FutureHolderBase::~FutureHolderBase()
+{
+}
+
+
+void FutureHolderBase::wait()
+{
+	if (Executor::current())
+	{
+		while (!ready())
+		{
+			if (!Executor::runPending()) _event.tryWait(1);
+		}
+	}
+	else _event.wait();
+}
+
+
+bool FutureHolderBase::tryWait(long milliseconds)
+{
+	return ready() || _event.tryWait(milliseconds);
+}
+
+
+void FutureHolderBase::setException(std::exception_ptr exc)
+{
+	_exception = exc;
+	complete();
+}
+
+
+void FutureHolderBase::rethrow() const
+{
+	if (_exception) std::rethrow_exception(_exception);
+}
+
+
+void FutureHolderBase::onReady(const Continuation& continuation)
+{
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (!ready())
+		{
+			_continuations.push_back(continuation);
+			return;
+		}
+	}
+	run(continuation);
+}
+
+
+void FutureHolderBase::complete()
+{
+	std::vector<Continuation> continuations;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		poco_assert (!ready());
+		_ready.store(true, std::memory_order_release);
+		continuations.swap(_continuations);
+	}
+	_event.set();
+	for (std::vector<Continuation>::const_iterator it = continuations.begin(); it != continuations.end(); ++it)
+	{
+		try
+		{
+			run(*it);
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+
+void FutureHolderBase::run(const Continuation& continuation)
+{
+	if (_pExecutor)
+	{
+		try
+		{
+			_pExecutor->execute(continuation);
+			return;
+		}
+		catch (IllegalStateException&)
+		{
+			// The Executor has been shut down; run the continuation
+			// here, so that the futures depending on it complete.
+		}
+	}
+	continuation();
+}
+
+
+} // namespace Poco
@@ -0,0 +1,274 @@
+//
+// Hex.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Hex
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Hex.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Exception.h"
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char DIGITS[] = "0123456789abcdef";
+	const char DIGITS_UPPER[] = "0123456789ABCDEF";
+
+
+	inline int digitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		else if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		else if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		else
+			return -1;
+	}
+
+
+#if defined(POCO_HAVE_X86_SIMD)
+
+
+	//
+	// Encoding looks up the digits for the high and low nibbles
+	// of 16 (32) bytes with a shuffle and interleaves them.
+	//
+	// Decoding maps digits to their values with range comparisons
+	// (after folding 'A'-'F' to lower case), checks that all
+	// characters are valid, and combines pairs of values with a
+	// multiply-add. A block containing an invalid character is left
+	// to the scalar code, which reports the error.
+	//
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t encodeSSSE3(const UInt8* in, std::size_t length, char* out, const char* digits)
+		/// Encodes 16 bytes at a time. Returns the number of bytes encoded.
+	{
+		const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+		const __m128i mask = _mm_set1_epi8(0x0F);
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(data, 4), mask));
+			const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(data, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+			done += 16;
+			out += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t encodeAVX2(const UInt8* in, std::size_t length, char* out, const char* digits)
+		/// Encodes 32 bytes at a time. Returns the number of bytes encoded.
+	{
+		const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+		const __m256i mask = _mm256_set1_epi8(0x0F);
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(data, 4), mask));
+			const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(data, mask));
+			const __m256i first = _mm256_unpacklo_epi8(hi, lo);  // bytes 0-7, 16-23
+			const __m256i second = _mm256_unpackhi_epi8(hi, lo); // bytes 8-15, 24-31
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(first, second, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(first, second, 0x31));
+			done += 32;
+			out += 64;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline bool decodeValues(__m128i in, __m128i& values)
+		/// Maps 16 hexadecimal digits to their values.
+		/// Returns false if any character is not a digit.
+	{
+		const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+		const __m128i lower = _mm_or_si128(in, _mm_set1_epi8(0x20));
+		const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+		if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xFFFF) return false;
+
+		values = _mm_or_si128(
+			_mm_and_si128(digit, _mm_sub_epi8(in, _mm_set1_epi8('0'))),
+			_mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+		return true;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t decodeSSSE3(const char* in, std::size_t length, UInt8* out)
+		/// Decodes 32 characters at a time. Returns the number of characters decoded.
+	{
+		const __m128i weights = _mm_set1_epi16(0x0110);
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m128i v0;
+			__m128i v1;
+			if (!decodeValues(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done)), v0)) break;
+			if (!decodeValues(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 16)), v1)) break;
+			const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(v0, weights), _mm_maddubs_epi16(v1, weights));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+			done += 32;
+			out += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	inline bool decodeValues(__m256i in, __m256i& values)
+		/// Maps 32 hexadecimal digits to their values.
+		/// Returns false if any character is not a digit.
+	{
+		const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+		const __m256i lower = _mm256_or_si256(in, _mm256_set1_epi8(0x20));
+		const __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+		if (_mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) != -1) return false;
+
+		values = _mm256_or_si256(
+			_mm256_and_si256(digit, _mm256_sub_epi8(in, _mm256_set1_epi8('0'))),
+			_mm256_and_si256(alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+		return true;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t decodeAVX2(const char* in, std::size_t length, UInt8* out)
+		/// Decodes 64 characters at a time. Returns the number of characters decoded.
+	{
+		const __m256i weights = _mm256_set1_epi16(0x0110);
+		std::size_t done = 0;
+		while (length - done >= 64)
+		{
+			__m256i v0;
+			__m256i v1;
+			if (!decodeValues(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done)), v0)) break;
+			if (!decodeValues(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done + 32)), v1)) break;
+			// packus works within 128-bit lanes; restore the order of the 64-bit quarters
+			__m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(v0, weights), _mm256_maddubs_epi16(v1, weights));
+			bytes = _mm256_permute4x64_epi64(bytes, 0xD8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+			done += 64;
+			out += 32;
+		}
+		return done;
+	}
+
+
+#endif // POCO_HAVE_X86_SIMD
+
+
+	const bool useAVX2 = CPUFeatures::hasAVX2();
+	const bool useSSSE3 = CPUFeatures::hasSSSE3();
+}
+
+
+std::size_t Hex::encode(const void* buffer, std::size_t length, char* encoded, bool uppercase)
+{
+	const char* digits = uppercase ? DIGITS_UPPER : DIGITS;
+	const UInt8* in = reinterpret_cast<const UInt8*>(buffer);
+	char* out = encoded;
+
+#if defined(POCO_HAVE_X86_SIMD)
+	std::size_t done = 0;
+	if (useAVX2)
+		done = encodeAVX2(in, length, out, digits);
+	else if (useSSSE3)
+		done = encodeSSSE3(in, length, out, digits);
+	in += done;
+	out += 2*done;
+	length -= done;
+#endif
+
+	while (length-- > 0)
+	{
+		*out++ = digits[*in >> 4];
+		*out++ = digits[*in & 0x0F];
+		++in;
+	}
+	return out - encoded;
+}
+
+
+std::string Hex::encode(const std::string& data, bool uppercase)
+{
+	std::string result(2*data.size(), '\0');
+	if (!result.empty())
+	{
+		encode(data.data(), data.size(), &result[0], uppercase);
+	}
+	return result;
+}
+
+
+std::size_t Hex::decode(const char* encoded, std::size_t length, void* buffer)
+{
+	if (length % 2 != 0) throw DataFormatException("Truncated hexadecimal data");
+
+	const char* in = encoded;
+	UInt8* out = reinterpret_cast<UInt8*>(buffer);
+
+#if defined(POCO_HAVE_X86_SIMD)
+	std::size_t done = 0;
+	if (useAVX2)
+		done = decodeAVX2(in, length, out);
+	else if (useSSSE3)
+		done = decodeSSSE3(in, length, out);
+	in += done;
+	out += done/2;
+	length -= done;
+#endif
+
+	while (length > 0)
+	{
+		int hi = digitValue(in[0]);
+		int lo = digitValue(in[1]);
+		if (hi < 0 || lo < 0) throw DataFormatException("Invalid hexadecimal digit");
+		*out++ = static_cast<UInt8>((hi << 4) | lo);
+		in += 2;
+		length -= 2;
+	}
+	return out - reinterpret_cast<UInt8*>(buffer);
+}
+
+
+std::string Hex::decode(const std::string& encoded)
+{
+	std::string result(encoded.size()/2, '\0');
+	if (!result.empty())
+	{
+		decode(encoded.data(), encoded.size(), &result[0]);
+	}
+	else if (!encoded.empty())
+	{
+		throw DataFormatException("Truncated hexadecimal data");
+	}
+	return result;
+}
+
+
+} // namespace Poco
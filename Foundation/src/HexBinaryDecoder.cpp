@@ -13,13 +13,17 @@
 
 
 #include "Poco/HexBinaryDecoder.h"
+#include "Poco/Hex.h"
 #include "Poco/Exception.h"
+#include <cstring>
 
 
 namespace Poco {
 
 
 HexBinaryDecoderBuf::HexBinaryDecoderBuf(std::istream& istr):
+	_pendingPos(0),
+	_pendingEnd(0),
 	_buf(*istr.rdbuf())
 {
 }
@@ -55,8 +59,53 @@ int HexBinaryDecoderBuf::readFromDevice()
 }
 
 
+std::streamsize HexBinaryDecoderBuf::xsgetn(char* p, std::streamsize count)
+{
+	if (count <= 0) return 0;
+	int c = uflow();
+	if (c == -1) return 0;
+	*p++ = static_cast<char>(c);
+	std::streamsize copied = 1;
+
+	// Decode pairs of digits directly into p. Errors and the end
+	// of the data are left to readFromDevice(), which also delivers
+	// the last byte, so that it can be put back.
+	while (count - copied > 1)
+	{
+		std::streamsize maxChars = 2*(count - copied - 1);
+		int n = readChars(maxChars < BUFFER_SIZE ? static_cast<int>(maxChars) : BUFFER_SIZE);
+		int length = n - n % 2;
+		if (length == 0) break;
+		std::size_t decoded;
+		try
+		{
+			decoded = Hex::decode(_pending, length, p);
+		}
+		catch (DataFormatException&)
+		{
+			break;
+		}
+		_pendingPos = length;
+		p += decoded;
+		copied += decoded;
+	}
+
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == -1) break;
+		*p++ = static_cast<char>(c);
+		++copied;
+	}
+	return copied;
+}
+
+
 int HexBinaryDecoderBuf::readOne()
 {
+	if (_pendingPos < _pendingEnd)
+		return static_cast<unsigned char>(_pending[_pendingPos++]);
+
 	int ch = _buf.sbumpc();
 	while (ch == ' ' || ch == '\r' || ch == '\t' || ch == '\n')
 		ch = _buf.sbumpc();
@@ -64,6 +113,28 @@ int HexBinaryDecoderBuf::readOne()
 }
 
 
+int HexBinaryDecoderBuf::readChars(int maxChars)
+{
+	int n = _pendingEnd - _pendingPos;
+	std::memmove(_pending, _pending + _pendingPos, n);
+	_pendingPos = 0;
+	if (n < maxChars)
+	{
+		int end = n;
+		n += static_cast<int>(_buf.sgetn(_pending + n, maxChars - n));
+		for (int i = end; i < n; i++)
+		{
+			char ch = _pending[i];
+			if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n')
+				_pending[end++] = ch;
+		}
+		n = end;
+	}
+	_pendingEnd = n;
+	return n < maxChars ? n : maxChars;
+}
+
+
 HexBinaryDecoderIOS::HexBinaryDecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -13,6 +13,7 @@
 
 
 #include "Poco/HexBinaryEncoder.h"
+#include "Poco/Hex.h"
 
 
 namespace Poco {
@@ -74,6 +75,44 @@ int HexBinaryEncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize HexBinaryEncoderBuf::xsputn(const char* s, std::streamsize n)
+{
+	// Encode a buffer at a time, inserting line
+	// breaks where writeToDevice() would.
+	char buffer[BUFFER_SIZE];
+	std::streamsize written = 0;
+	while (written < n)
+	{
+		std::streamsize consumed = written;
+		std::streamsize length = 0;
+		while (consumed < n && length + 3 <= BUFFER_SIZE)
+		{
+			std::streamsize count = n - consumed;
+			std::streamsize maxCount = (BUFFER_SIZE - length - 1)/2;
+			if (count > maxCount) count = maxCount;
+			if (_lineLength > 0)
+			{
+				std::streamsize lineCount = (_lineLength - _pos + 1)/2;
+				if (lineCount < 1) lineCount = 1;
+				if (count > lineCount) count = lineCount;
+			}
+			std::size_t encoded = Hex::encode(s + consumed, static_cast<std::size_t>(count), buffer + length, _uppercase != 0);
+			consumed += count;
+			length += encoded;
+			_pos += static_cast<int>(encoded);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				buffer[length++] = '\n';
+				_pos = 0;
+			}
+		}
+		if (_buf.sputn(buffer, length) != length) return written;
+		written = consumed;
+	}
+	return written;
+}
+
+
 int HexBinaryEncoderBuf::close()
 {
 	sync();
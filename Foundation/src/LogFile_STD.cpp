@@ -15,6 +15,12 @@
 #include "Poco/LogFile_STD.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
 
 
 namespace Poco {
@@ -22,9 +28,11 @@ namespace Poco {
 
 LogFileImpl::LogFileImpl(const std::string& path):
 	_path(path),
-	_str(_path, std::ios::app),
-	_size((UInt64) _str.tellp())
+	_fd(-1),
+	_bufferSize(DEFAULT_BUFFER_SIZE),
+	_size(0)
 {
+	openFile();
 	if (_size == 0)
 		_creationDate = File(path).getLastModified();
 	else
@@ -34,24 +42,61 @@ LogFileImpl::LogFileImpl(const std::string& path):
 
 LogFileImpl::~LogFileImpl()
 {
+	try
+	{
+		flushImpl();
+	}
+	catch (...)
+	{
+	}
+	if (_fd != -1) ::close(_fd);
 }
 
 
 void LogFileImpl::writeImpl(const std::string& text, bool flush)
 {
-	if (!_str.good())
+	static const char newline = '\n';
+
+	if (_buffer.size() + text.size() + 1 > _bufferSize || (flush && !_buffer.empty()))
 	{
-		_str.close();
-		_str.open(_path, std::ios::app);
+		// write the buffer and the message in one go
+		writeFile(_buffer.data(), _buffer.size(), text.data(), text.size(), &newline, 1);
+		_buffer.clear();
+	}
+	else if (flush)
+	{
+		writeFile(text.data(), text.size(), &newline, 1, 0, 0);
 	}
-	if (!_str.good()) throw WriteFileException(_path);
-	_str << text;
-	if (flush)
-		_str << std::endl;
 	else
-		_str << "\n";
-	if (!_str.good()) throw WriteFileException(_path);
-	_size = (UInt64) _str.tellp();
+	{
+		_buffer.append(text);
+		_buffer += newline;
+	}
+	_size += text.size() + 1;
+}
+
+
+void LogFileImpl::flushImpl()
+{
+	if (!_buffer.empty())
+	{
+		writeFile(_buffer.data(), _buffer.size(), 0, 0, 0, 0);
+		_buffer.clear();
+	}
+}
+
+
+void LogFileImpl::setBufferSizeImpl(std::size_t size)
+{
+	if (size < _buffer.size()) flushImpl();
+	_bufferSize = size;
+	_buffer.reserve(size);
+}
+
+
+std::size_t LogFileImpl::getBufferSizeImpl() const
+{
+	return _bufferSize;
 }
 
 
@@ -73,4 +118,54 @@ const std::string& LogFileImpl::pathImpl() const
 }
 
 
+void LogFileImpl::openFile()
+{
+	_fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+	if (_fd == -1) File::handleLastError(_path);
+	struct stat st;
+	if (::fstat(_fd, &st) == 0)
+		_size = st.st_size;
+}
+
+
+void LogFileImpl::writeFile(const char* pData1, std::size_t size1, const char* pData2, std::size_t size2, const char* pData3, std::size_t size3)
+{
+	if (_fd == -1) openFile();
+
+	struct iovec iov[3];
+	iov[0].iov_base = const_cast<char*>(pData1);
+	iov[0].iov_len  = size1;
+	iov[1].iov_base = const_cast<char*>(pData2);
+	iov[1].iov_len  = size2;
+	iov[2].iov_base = const_cast<char*>(pData3);
+	iov[2].iov_len  = size3;
+	struct iovec* pIov = iov;
+	int count = 3;
+	while (count > 0)
+	{
+		ssize_t n = ::writev(_fd, pIov, count);
+		if (n < 0)
+		{
+			if (errno == EINTR) continue;
+			::close(_fd);
+			_fd = -1;
+			throw WriteFileException(_path);
+		}
+		// skip what has been written, in case of a partial write
+		std::size_t written = static_cast<std::size_t>(n);
+		while (count > 0 && written >= pIov->iov_len)
+		{
+			written -= pIov->iov_len;
+			++pIov;
+			--count;
+		}
+		if (count > 0)
+		{
+			pIov->iov_base = static_cast<char*>(pIov->iov_base) + written;
+			pIov->iov_len -= written;
+		}
+	}
+}
+
+
 } // namespace Poco
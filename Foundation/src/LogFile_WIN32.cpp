@@ -21,7 +21,10 @@
 namespace Poco {
 
 
-LogFileImpl::LogFileImpl(const std::string& path): _path(path), _hFile(INVALID_HANDLE_VALUE)
+LogFileImpl::LogFileImpl(const std::string& path):
+	_path(path),
+	_hFile(INVALID_HANDLE_VALUE),
+	_bufferSize(DEFAULT_BUFFER_SIZE)
 {
 	File file(path);
 	if (file.exists())
@@ -36,27 +39,55 @@ LogFileImpl::LogFileImpl(const std::string& path): _path(path), _hFile(INVALID_H
 
 LogFileImpl::~LogFileImpl()
 {
+	try
+	{
+		writeBuffer();
+	}
+	catch (...)
+	{
+	}
 	CloseHandle(_hFile);
 }
 
 
 void LogFileImpl::writeImpl(const std::string& text, bool flush)
 {
-	if (INVALID_HANDLE_VALUE == _hFile)	createFile();
+	if (_buffer.size() + text.size() + 2 > _bufferSize) writeBuffer();
 
-	DWORD bytesWritten;
-	BOOL res = WriteFile(_hFile, text.data(), (DWORD) text.size(), &bytesWritten, NULL);
-	if (!res) throw WriteFileException(_path);
-	res = WriteFile(_hFile, "\r\n", 2, &bytesWritten, NULL);
-	if (!res) throw WriteFileException(_path);
-	if (flush)
+	_buffer.append(text);
+	_buffer.append("\r\n");
+	if (flush || _buffer.size() > _bufferSize)
 	{
-		res = FlushFileBuffers(_hFile);
-		if (!res) throw WriteFileException(_path);
+		writeBuffer();
+		if (flush)
+		{
+			BOOL res = FlushFileBuffers(_hFile);
+			if (!res) throw WriteFileException(_path);
+		}
 	}
 }
 
 
+void LogFileImpl::flushImpl()
+{
+	writeBuffer();
+}
+
+
+void LogFileImpl::setBufferSizeImpl(std::size_t size)
+{
+	if (size < _buffer.size()) writeBuffer();
+	_bufferSize = size;
+	_buffer.reserve(size);
+}
+
+
+std::size_t LogFileImpl::getBufferSizeImpl() const
+{
+	return _bufferSize;
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	if (INVALID_HANDLE_VALUE == _hFile)
@@ -69,7 +100,7 @@ UInt64 LogFileImpl::sizeImpl() const
 	LARGE_INTEGER li;
 	li.HighPart = 0;
 	li.LowPart  = SetFilePointer(_hFile, 0, &li.HighPart, FILE_CURRENT);
-	return li.QuadPart;
+	return li.QuadPart + _buffer.size();
 }
 
 
@@ -113,4 +144,16 @@ void LogFileImpl::createFile()
 }
 
 
+void LogFileImpl::writeBuffer()
+{
+	if (_buffer.empty()) return;
+	if (INVALID_HANDLE_VALUE == _hFile) createFile();
+
+	DWORD bytesWritten;
+	BOOL res = WriteFile(_hFile, _buffer.data(), (DWORD) _buffer.size(), &bytesWritten, NULL);
+	_buffer.clear();
+	if (!res) throw WriteFileException(_path);
+}
+
+
 } // namespace Poco
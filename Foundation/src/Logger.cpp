@@ -19,11 +19,266 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include "Poco/Thread.h"
+#include <algorithm>
 
 
 namespace Poco {
 
 
+struct Logger::Entry
+	/// An entry in a hash table of loggers. Entries are
+	/// immutable, except for the link to the next entry.
+{
+	Entry(const std::string& n, std::size_t h, Logger* p):
+		name(n),
+		hash(h),
+		pLogger(p),
+		pNext(0)
+	{
+	}
+
+	const std::string   name;
+	const std::size_t   hash;
+	Logger* const       pLogger;
+	std::atomic<Entry*> pNext;
+};
+
+
+struct Logger::Table
+	/// The hash table of all loggers.
+	///
+	/// Lookups do not acquire a lock, but mark their thread
+	/// as a reader with a ReadGuard. Insertions and removals are made under
+	/// _mapMtx and are published with release semantics, so that
+	/// readers always see a consistent chain of entries. Entries
+	/// that are removed, and tables that have been replaced by a
+	/// larger one, are deleted only after waitForReaders() has
+	/// returned.
+	///
+	/// Only the entries reachable from the current table hold
+	/// a reference to their Logger.
+{
+	explicit Table(std::size_t size):
+		mask(size - 1),
+		count(0),
+		buckets(new std::atomic<Entry*>[size])
+	{
+		for (std::size_t i = 0; i < size; ++i) buckets[i].store(0, std::memory_order_relaxed);
+	}
+
+	~Table()
+	{
+		for (std::size_t i = 0; i <= mask; ++i)
+		{
+			Entry* pEntry = buckets[i].load(std::memory_order_relaxed);
+			while (pEntry)
+			{
+				Entry* pNext = pEntry->pNext.load(std::memory_order_relaxed);
+				delete pEntry;
+				pEntry = pNext;
+			}
+		}
+		delete [] buckets;
+	}
+
+	Logger* find(const std::string& name, std::size_t hash) const
+	{
+		Entry* pEntry = buckets[hash & mask].load(std::memory_order_acquire);
+		while (pEntry)
+		{
+			if (pEntry->hash == hash && pEntry->name == name) return pEntry->pLogger;
+			pEntry = pEntry->pNext.load(std::memory_order_acquire);
+		}
+		return 0;
+	}
+
+	void insert(Entry* pEntry)
+	{
+		std::atomic<Entry*>& bucket = buckets[pEntry->hash & mask];
+		pEntry->pNext.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		bucket.store(pEntry, std::memory_order_release);
+		++count;
+	}
+
+	Entry* remove(const std::string& name, std::size_t hash)
+	{
+		std::atomic<Entry*>* pLink = &buckets[hash & mask];
+		Entry* pEntry = pLink->load(std::memory_order_relaxed);
+		while (pEntry)
+		{
+			if (pEntry->hash == hash && pEntry->name == name)
+			{
+				pLink->store(pEntry->pNext.load(std::memory_order_relaxed), std::memory_order_release);
+				--count;
+				return pEntry;
+			}
+			pLink = &pEntry->pNext;
+			pEntry = pLink->load(std::memory_order_relaxed);
+		}
+		return 0;
+	}
+
+	template <class F>
+	void forEach(F f) const
+	{
+		for (std::size_t i = 0; i <= mask; ++i)
+		{
+			for (Entry* pEntry = buckets[i].load(std::memory_order_relaxed); pEntry; pEntry = pEntry->pNext.load(std::memory_order_relaxed))
+			{
+				f(*pEntry);
+			}
+		}
+	}
+
+	const std::size_t    mask;
+	std::size_t          count;
+	std::atomic<Entry*>* buckets;
+};
+
+
+namespace
+{
+	const std::size_t INITIAL_TABLE_SIZE = 64;
+
+	struct ReaderSlot
+		/// The state of a thread looking up loggers. Every thread
+		/// has a slot of its own, padded to a cache line, so that
+		/// readers do not write to memory shared with other threads.
+		/// Slots are reused by later threads, but never freed.
+	{
+		ReaderSlot():
+			sequence(0),
+			depth(0),
+			inUse(true),
+			pNext(0)
+		{
+		}
+
+		char                    padding1[64];
+		std::atomic<unsigned>   sequence; // odd while reading
+		unsigned                depth;
+		std::atomic<bool>       inUse;
+		ReaderSlot*             pNext;
+		char                    padding2[64];
+	};
+
+	std::atomic<ReaderSlot*> readerSlots(0);
+
+	ReaderSlot* acquireSlot()
+	{
+		for (ReaderSlot* pSlot = readerSlots.load(std::memory_order_acquire); pSlot; pSlot = pSlot->pNext)
+		{
+			bool inUse = false;
+			if (!pSlot->inUse.load(std::memory_order_relaxed) && pSlot->inUse.compare_exchange_strong(inUse, true))
+				return pSlot;
+		}
+		ReaderSlot* pSlot = new ReaderSlot;
+		ReaderSlot* pHead = readerSlots.load(std::memory_order_relaxed);
+		do
+		{
+			pSlot->pNext = pHead;
+		}
+		while (!readerSlots.compare_exchange_weak(pHead, pSlot, std::memory_order_release, std::memory_order_relaxed));
+		return pSlot;
+	}
+
+	class ThreadReader
+		/// Holds the ReaderSlot of the current thread.
+	{
+	public:
+		ThreadReader(): _pSlot(acquireSlot())
+		{
+		}
+
+		~ThreadReader()
+		{
+			_pSlot->inUse.store(false, std::memory_order_release);
+		}
+
+		ReaderSlot& slot()
+		{
+			return *_pSlot;
+		}
+
+	private:
+		ReaderSlot* _pSlot;
+	};
+
+	class ReadGuard
+		/// Marks the current thread as a reader of the
+		/// logger table for the lifetime of the guard.
+	{
+	public:
+		ReadGuard(): _slot(threadReader().slot())
+		{
+			if (_slot.depth++ == 0)
+			{
+				_slot.sequence.store(_slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+			}
+		}
+
+		~ReadGuard()
+		{
+			if (--_slot.depth == 0)
+			{
+				_slot.sequence.store(_slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+		}
+
+	private:
+		static ThreadReader& threadReader()
+		{
+			static thread_local ThreadReader reader;
+			return reader;
+		}
+
+		ReaderSlot& _slot;
+	};
+
+	void waitForReaders()
+		/// Waits until all readers that may still see an entry
+		/// or table unlinked before the call have left it.
+		/// Readers that start later only see the current table.
+		///
+		/// Must be called with _mapMtx held.
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (ReaderSlot* pSlot = readerSlots.load(std::memory_order_acquire); pSlot; pSlot = pSlot->pNext)
+		{
+			unsigned sequence = pSlot->sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+			{
+				while (pSlot->sequence.load(std::memory_order_acquire) == sequence)
+				{
+					Thread::yield();
+				}
+			}
+		}
+	}
+
+	std::size_t hashName(const std::string& name)
+	{
+		// FNV-1a
+		std::size_t h = 2166136261U;
+		for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+		{
+			h ^= static_cast<unsigned char>(*it);
+			h *= 16777619U;
+		}
+		return h;
+	}
+
+	bool isDescendant(const std::string& name, const std::string& ancestor)
+	{
+		std::string::size_type len = ancestor.length();
+		return len == 0 ||
+			(name.compare(0, len, ancestor) == 0 && (name.length() == len || name[len] == '.'));
+	}
+}
+
+
 Logger::Logger(const std::string& name, Channel::Ptr pChannel, int level): _name(name), _pChannel(pChannel), _level(level)
 {
 }
@@ -48,7 +303,7 @@ Channel::Ptr Logger::getChannel() const
 
 void Logger::setLevel(int level)
 {
-	_level = level;
+	_level.store(level, std::memory_order_relaxed);
 }
 
 
@@ -71,7 +326,7 @@ void Logger::setProperty(const std::string& rName, const std::string& rValue)
 
 void Logger::log(const Message& msg)
 {
-	if (_level >= msg.getPriority() && _pChannel)
+	if (getLevel() >= msg.getPriority() && _pChannel)
 	{
 		_pChannel->log(msg);
 	}
@@ -92,7 +347,7 @@ void Logger::log(const Exception& exc, const char* file, int line)
 
 void Logger::dump(const std::string& msg, const void* buffer, std::size_t length, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		std::string text(msg);
 		formatDump(text, buffer, length);
@@ -105,17 +360,13 @@ void Logger::setLevel(const std::string& name, int level)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (pTable)
 	{
-		std::string::size_type len = name.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
-		{
-			if (len == 0 ||
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+		pTable->forEach([&](const Entry& entry)
 			{
-				it->second->setLevel(level);
-			}
-		}
+				if (isDescendant(entry.name, name)) entry.pLogger->setLevel(level);
+			});
 	}
 }
 
@@ -124,17 +375,13 @@ void Logger::setChannel(const std::string& name, Channel::Ptr pChannel)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (pTable)
 	{
-		std::string::size_type len = name.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
-		{
-			if (len == 0 ||
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+		pTable->forEach([&](const Entry& entry)
 			{
-				it->second->setChannel(pChannel);
-			}
-		}
+				if (isDescendant(entry.name, name)) entry.pLogger->setChannel(pChannel);
+			});
 	}
 }
 
@@ -143,17 +390,13 @@ void Logger::setProperty(const std::string& loggerName, const std::string& prope
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (pTable)
 	{
-		std::string::size_type len = loggerName.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
-		{
-			if (len == 0 ||
-				(it->first.compare(0, len, loggerName) == 0 && (it->first.length() == len || it->first[len] == '.')))
+		pTable->forEach([&](const Entry& entry)
 			{
-				it->second->setProperty(propertyName, value);
-			}
-		}
+				if (isDescendant(entry.name, loggerName)) entry.pLogger->setProperty(propertyName, value);
+			});
 	}
 }
 
@@ -273,6 +516,9 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	Logger* pLogger = lookup(name);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -312,6 +558,9 @@ Logger& Logger::create(const std::string& name, Channel::Ptr pChannel, int level
 
 Logger& Logger::root()
 {
+	Logger* pLogger = lookup(ROOT);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(ROOT);
@@ -320,9 +569,10 @@ Logger& Logger::root()
 
 Logger::Ptr Logger::has(const std::string& name)
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
-	return find(name);
+	// The table holds a reference to the logger until
+	// all readers have left, so it can be duplicated here.
+	ReadGuard guard;
+	return Ptr(lookup(name), true);
 }
 
 
@@ -330,18 +580,30 @@ void Logger::shutdown()
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	_pLoggerMap.reset();
+	Table* pTable = _pTable.exchange(0);
+	if (pTable)
+	{
+		waitForReaders();
+		pTable->forEach([](const Entry& entry)
+			{
+				entry.pLogger->release();
+			});
+		delete pTable;
+	}
+}
+
+
+Logger* Logger::lookup(const std::string& name)
+{
+	ReadGuard guard;
+	Table* pTable = _pTable.load(std::memory_order_acquire);
+	return pTable ? pTable->find(name, hashName(name)) : 0;
 }
 
 
 Logger::Ptr Logger::find(const std::string& name)
 {
-	if (_pLoggerMap)
-	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) return it->second;
-	}
-	return 0;
+	return Ptr(lookup(name), true);
 }
 
 
@@ -349,10 +611,16 @@ void Logger::destroy(const std::string& name)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (pTable)
 	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) _pLoggerMap->erase(it);
+		Entry* pEntry = pTable->remove(name, hashName(name));
+		if (pEntry)
+		{
+			waitForReaders();
+			pEntry->pLogger->release();
+			delete pEntry;
+		}
 	}
 }
 
@@ -362,13 +630,15 @@ void Logger::names(std::vector<std::string>& names)
 	Mutex::ScopedLock lock(_mapMtx);
 
 	names.clear();
-	if (_pLoggerMap)
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (pTable)
 	{
-		for (LoggerMap::const_iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
-		{
-			names.push_back(it->first);
-		}
+		pTable->forEach([&names](const Entry& entry)
+			{
+				names.push_back(entry.name);
+			});
 	}
+	std::sort(names.begin(), names.end());
 }
 
 
@@ -426,8 +696,28 @@ int Logger::parseLevel(const std::string& level)
 
 void Logger::add(Ptr pLogger)
 {
-	if (!_pLoggerMap) _pLoggerMap.reset(new LoggerMap);
-	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	Table* pTable = _pTable.load(std::memory_order_relaxed);
+	if (!pTable)
+	{
+		pTable = new Table(INITIAL_TABLE_SIZE);
+		_pTable.store(pTable, std::memory_order_release);
+	}
+	else if (pTable->count > pTable->mask)
+	{
+		// Grow the table. The entries of the old table are
+		// copied, as readers may still be traversing them;
+		// the references to the loggers move to the copies.
+		Table* pNewTable = new Table(2*(pTable->mask + 1));
+		pTable->forEach([pNewTable](const Entry& entry)
+			{
+				pNewTable->insert(new Entry(entry.name, entry.hash, entry.pLogger));
+			});
+		_pTable.store(pNewTable, std::memory_order_release);
+		waitForReaders();
+		delete pTable;
+		pTable = pNewTable;
+	}
+	pTable->insert(new Entry(pLogger->name(), hashName(pLogger->name()), pLogger.duplicate()));
 }
 
 
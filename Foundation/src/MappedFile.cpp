@@ -0,0 +1,344 @@
+//
+// MappedFile.cpp
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFile.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnicodeConverter.h"
+#include "Poco/UnWindows.h"
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <limits>
+
+
+namespace Poco {
+
+
+MappedFile::MappedFile():
+	_mode(AM_READ),
+	_options(0),
+	_advice(ADV_NORMAL),
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	_hFile(INVALID_HANDLE_VALUE),
+	_hMapping(0),
+#else
+	_fd(-1),
+#endif
+	_fileSize(0),
+	_pMapping(0),
+	_mappingSize(0),
+	_pBegin(0),
+	_size(0),
+	_offset(0)
+{
+}
+
+
+MappedFile::MappedFile(const std::string& path, AccessMode mode, int options):
+	_mode(AM_READ),
+	_options(0),
+	_advice(ADV_NORMAL),
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	_hFile(INVALID_HANDLE_VALUE),
+	_hMapping(0),
+#else
+	_fd(-1),
+#endif
+	_fileSize(0),
+	_pMapping(0),
+	_mappingSize(0),
+	_pBegin(0),
+	_size(0),
+	_offset(0)
+{
+	open(path, mode, options);
+	try
+	{
+		map();
+	}
+	catch (...)
+	{
+		close();
+		throw;
+	}
+}
+
+
+MappedFile::~MappedFile()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+
+
+void MappedFile::open(const std::string& path, AccessMode mode, int options)
+{
+	poco_assert (!isOpen());
+
+	std::wstring utf16Path;
+	UnicodeConverter::toUTF16(path, utf16Path);
+	DWORD access = GENERIC_READ;
+	if (mode == AM_WRITE)
+		access |= GENERIC_WRITE;
+	HANDLE hFile = CreateFileW(utf16Path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		File::handleLastError(path);
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size))
+	{
+		CloseHandle(hFile);
+		File::handleLastError(path);
+	}
+
+	HANDLE hMapping = 0;
+	if (size.QuadPart > 0)
+	{
+		hMapping = CreateFileMappingW(hFile, NULL, mode == AM_WRITE ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+		if (!hMapping)
+		{
+			CloseHandle(hFile);
+			throw SystemException("Cannot create file mapping", path);
+		}
+	}
+
+	_path     = path;
+	_mode     = mode;
+	_options  = options;
+	_advice   = ADV_NORMAL;
+	_hFile    = hFile;
+	_hMapping = hMapping;
+	_fileSize = static_cast<Poco::UInt64>(size.QuadPart);
+	_offset   = 0;
+}
+
+
+void MappedFile::close()
+{
+	unmap();
+	if (_hMapping)
+	{
+		CloseHandle(_hMapping);
+		_hMapping = 0;
+	}
+	if (_hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_hFile);
+		_hFile = INVALID_HANDLE_VALUE;
+	}
+	_fileSize = 0;
+	_offset = 0;
+}
+
+
+bool MappedFile::isOpen() const
+{
+	return _hFile != INVALID_HANDLE_VALUE;
+}
+
+
+#else
+
+
+void MappedFile::open(const std::string& path, AccessMode mode, int options)
+{
+	poco_assert (!isOpen());
+
+	int fd = ::open(path.c_str(), mode == AM_WRITE ? O_RDWR : O_RDONLY);
+	if (fd == -1)
+		File::handleLastError(path);
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		File::handleLastError(path);
+	}
+
+	_path     = path;
+	_mode     = mode;
+	_options  = options;
+	_advice   = ADV_NORMAL;
+	_fd       = fd;
+	_fileSize = static_cast<Poco::UInt64>(st.st_size);
+	_offset   = 0;
+}
+
+
+void MappedFile::close()
+{
+	unmap();
+	if (_fd != -1)
+	{
+		::close(_fd);
+		_fd = -1;
+	}
+	_fileSize = 0;
+	_offset = 0;
+}
+
+
+bool MappedFile::isOpen() const
+{
+	return _fd != -1;
+}
+
+
+#endif
+
+
+void MappedFile::map(Poco::UInt64 offset, std::size_t length)
+{
+	poco_assert (isOpen());
+
+	if (offset > _fileSize)
+		throw InvalidArgumentException("Offset beyond end of file", _path);
+	if (length == 0 || length > _fileSize - offset)
+	{
+		if (_fileSize - offset > std::numeric_limits<std::size_t>::max())
+			throw RangeException("File too large to be mapped as a whole", _path);
+		length = static_cast<std::size_t>(_fileSize - offset);
+	}
+
+	unmap();
+	_offset = offset;
+	if (length == 0) return;
+
+	Poco::UInt64 alignedOffset = offset - offset % granularity();
+	std::size_t mappingSize = length + static_cast<std::size_t>(offset - alignedOffset);
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	DWORD access = _mode == AM_WRITE ? FILE_MAP_WRITE : FILE_MAP_READ;
+	void* addr = MapViewOfFile(_hMapping, access, static_cast<DWORD>(alignedOffset >> 32), static_cast<DWORD>(alignedOffset & 0xFFFFFFFF), mappingSize);
+	if (!addr)
+		throw SystemException("Cannot map file", _path);
+#else
+	int prot = PROT_READ;
+	if (_mode == AM_WRITE)
+		prot |= PROT_WRITE;
+	int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+	if (_options & OPT_POPULATE)
+		flags |= MAP_POPULATE;
+#endif
+	void* addr = ::mmap(0, mappingSize, prot, flags, _fd, static_cast<off_t>(alignedOffset));
+	if (addr == MAP_FAILED)
+		throw SystemException("Cannot map file", _path);
+#if defined(MADV_HUGEPAGE)
+	if (_options & OPT_HUGE_PAGES)
+		::madvise(addr, mappingSize, MADV_HUGEPAGE);
+#endif
+#endif
+
+	_pMapping    = static_cast<char*>(addr);
+	_mappingSize = mappingSize;
+	_pBegin      = _pMapping + (offset - alignedOffset);
+	_size        = length;
+	if (_advice != ADV_NORMAL)
+		applyAdvice();
+}
+
+
+void MappedFile::unmap()
+{
+	if (_pMapping)
+	{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		UnmapViewOfFile(_pMapping);
+#else
+		::munmap(_pMapping, _mappingSize);
+#endif
+		_pMapping = 0;
+		_mappingSize = 0;
+		_pBegin = 0;
+		_size = 0;
+	}
+}
+
+
+void MappedFile::advise(Advice advice)
+{
+	_advice = advice;
+	applyAdvice();
+}
+
+
+void MappedFile::applyAdvice()
+{
+#if !defined(POCO_OS_FAMILY_WINDOWS)
+	if (!_pMapping) return;
+
+	int advice = MADV_NORMAL;
+	switch (_advice)
+	{
+	case ADV_SEQUENTIAL:
+		advice = MADV_SEQUENTIAL;
+		break;
+	case ADV_RANDOM:
+		advice = MADV_RANDOM;
+		break;
+	case ADV_WILLNEED:
+		advice = MADV_WILLNEED;
+		break;
+	default:
+		break;
+	}
+	::madvise(_pMapping, _mappingSize, advice);
+#endif
+}
+
+
+void MappedFile::flush()
+{
+	if (!_pMapping || _mode != AM_WRITE) return;
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	if (!FlushViewOfFile(_pMapping, _mappingSize) || !FlushFileBuffers(_hFile))
+		throw SystemException("Cannot flush mapped file", _path);
+#else
+	if (::msync(_pMapping, _mappingSize, MS_SYNC) != 0)
+		throw SystemException("Cannot flush mapped file", _path);
+#endif
+}
+
+
+std::size_t MappedFile::granularity()
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwAllocationGranularity;
+#else
+	static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	return pageSize;
+#endif
+}
+
+
+} // namespace Poco
@@ -0,0 +1,148 @@
+//
+// MappedFileStream.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedFileStream
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFileStream.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+//
+// MappedFileStreamBuf
+//
+
+
+MappedFileStreamBuf::MappedFileStreamBuf(const std::string& path, std::size_t windowSize):
+	_windowSize(windowSize)
+{
+	_file.open(path);
+	_file.advise(MappedFile::ADV_SEQUENTIAL);
+	setg(0, 0, 0);
+}
+
+
+MappedFileStreamBuf::~MappedFileStreamBuf()
+{
+}
+
+
+MappedFileStreamBuf::int_type MappedFileStreamBuf::underflow()
+{
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+
+	Poco::UInt64 pos = position();
+	if (pos >= _file.fileSize())
+		return traits_type::eof();
+
+	moveTo(pos);
+	return traits_type::to_int_type(*gptr());
+}
+
+
+std::streamsize MappedFileStreamBuf::showmanyc()
+{
+	Poco::UInt64 remaining = _file.fileSize() - position();
+	if (remaining == 0)
+		return -1;
+	else if (remaining > static_cast<Poco::UInt64>(std::numeric_limits<std::streamsize>::max()))
+		return std::numeric_limits<std::streamsize>::max();
+	else
+		return static_cast<std::streamsize>(remaining);
+}
+
+
+MappedFileStreamBuf::pos_type MappedFileStreamBuf::seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode mode)
+{
+	const pos_type fail = off_type(-1);
+
+	if (!(mode & std::ios::in))
+		return fail;
+
+	Poco::Int64 base;
+	if (dir == std::ios::beg)
+		base = 0;
+	else if (dir == std::ios::cur)
+		base = static_cast<Poco::Int64>(position());
+	else
+		base = static_cast<Poco::Int64>(_file.fileSize());
+
+	Poco::Int64 target = base + off;
+	if (target < 0 || static_cast<Poco::UInt64>(target) > _file.fileSize())
+		return fail;
+
+	Poco::UInt64 pos = static_cast<Poco::UInt64>(target);
+	if (eback() && pos >= _file.offset() && pos <= _file.offset() + _file.size())
+		setg(eback(), eback() + static_cast<std::size_t>(pos - _file.offset()), egptr());
+	else
+		moveTo(pos);
+	return pos_type(target);
+}
+
+
+MappedFileStreamBuf::pos_type MappedFileStreamBuf::seekpos(pos_type pos, std::ios::openmode mode)
+{
+	return seekoff(off_type(pos), std::ios::beg, mode);
+}
+
+
+Poco::UInt64 MappedFileStreamBuf::position() const
+{
+	return _file.offset() + static_cast<Poco::UInt64>(gptr() - eback());
+}
+
+
+void MappedFileStreamBuf::moveTo(Poco::UInt64 pos)
+{
+	_file.map(pos, _windowSize);
+	setg(_file.begin(), _file.begin(), _file.end());
+}
+
+
+//
+// MappedFileIOS
+//
+
+
+MappedFileIOS::MappedFileIOS(const std::string& path, std::size_t windowSize):
+	_buf(path, windowSize)
+{
+	poco_ios_init(&_buf);
+}
+
+
+MappedFileIOS::~MappedFileIOS()
+{
+}
+
+
+//
+// MappedFileInputStream
+//
+
+
+MappedFileInputStream::MappedFileInputStream(const std::string& path, std::size_t windowSize):
+	MappedFileIOS(path, windowSize),
+	std::istream(&_buf)
+{
+}
+
+
+MappedFileInputStream::~MappedFileInputStream()
+{
+}
+
+
+} // namespace Poco
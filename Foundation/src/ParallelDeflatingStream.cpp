@@ -0,0 +1,368 @@
+//
+// ParallelDeflatingStream.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ParallelDeflatingStream.h"
+#include "Poco/Checksum.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const unsigned char GZIP_ID1    = 0x1f;
+	const unsigned char GZIP_ID2    = 0x8b;
+	const unsigned char GZIP_CM     = 8;
+	const unsigned char GZIP_FEXTRA = 0x04;
+	const unsigned char GZIP_OS     = 0xff;
+
+	unsigned char extraFlags(int level)
+	{
+		if (level == Z_BEST_COMPRESSION) return 2;
+		else if (level == Z_BEST_SPEED) return 4;
+		else return 0;
+	}
+
+	void putUInt16(std::string& out, Poco::UInt16 value)
+	{
+		out += static_cast<char>(value & 0xff);
+		out += static_cast<char>(value >> 8);
+	}
+
+	void putUInt32(std::string& out, Poco::UInt32 value)
+	{
+		out += static_cast<char>(value & 0xff);
+		out += static_cast<char>((value >> 8) & 0xff);
+		out += static_cast<char>((value >> 16) & 0xff);
+		out += static_cast<char>(value >> 24);
+	}
+
+	void setUInt32(std::string& out, std::size_t pos, Poco::UInt32 value)
+	{
+		out[pos]     = static_cast<char>(value & 0xff);
+		out[pos + 1] = static_cast<char>((value >> 8) & 0xff);
+		out[pos + 2] = static_cast<char>((value >> 16) & 0xff);
+		out[pos + 3] = static_cast<char>(value >> 24);
+	}
+
+	Poco::UInt32 checksumCRC32(const std::string& data)
+	{
+		Checksum checksum(Checksum::TYPE_CRC32);
+		checksum.update(data.data(), static_cast<unsigned>(data.size()));
+		return static_cast<Poco::UInt32>(checksum.checksum());
+	}
+
+	void deflateRaw(const std::string& input, const std::string* pDictionary, int level, bool last, std::string& output)
+		/// Compresses input into a raw deflate stream and appends
+		/// the result to output. If last is false, the output ends
+		/// with a sync flush marker, so that another raw deflate
+		/// stream can follow.
+	{
+		z_stream zstr;
+		zstr.zalloc = Z_NULL;
+		zstr.zfree  = Z_NULL;
+		zstr.opaque = Z_NULL;
+		int rc = deflateInit2(&zstr, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+		if (rc != Z_OK) throw IOException(zError(rc));
+
+		if (pDictionary && !pDictionary->empty())
+		{
+			rc = deflateSetDictionary(&zstr, reinterpret_cast<const Bytef*>(pDictionary->data()), static_cast<uInt>(pDictionary->size()));
+			if (rc != Z_OK)
+			{
+				deflateEnd(&zstr);
+				throw IOException(zError(rc));
+			}
+		}
+
+		std::size_t start = output.size();
+		std::size_t bound = deflateBound(&zstr, static_cast<uLong>(input.size())) + 16;
+		output.resize(start + bound);
+		zstr.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+		zstr.avail_in  = static_cast<uInt>(input.size());
+		zstr.next_out  = reinterpret_cast<Bytef*>(&output[start]);
+		zstr.avail_out = static_cast<uInt>(bound);
+		int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+		for (;;)
+		{
+			rc = deflate(&zstr, flush);
+			if (rc == Z_STREAM_END) break;
+			if (rc != Z_OK && rc != Z_BUF_ERROR)
+			{
+				deflateEnd(&zstr);
+				throw IOException(zError(rc));
+			}
+			if (!last && zstr.avail_in == 0 && zstr.avail_out > 0) break;
+			if (zstr.avail_out == 0)
+			{
+				std::size_t used = output.size();
+				output.resize(used + bound);
+				zstr.next_out  = reinterpret_cast<Bytef*>(&output[used]);
+				zstr.avail_out = static_cast<uInt>(bound);
+			}
+		}
+		output.resize(output.size() - zstr.avail_out);
+		deflateEnd(&zstr);
+	}
+}
+
+
+ParallelDeflatingStreamBuf::ParallelDeflatingStreamBuf(std::ostream& ostr, int level, Format format, std::size_t blockSize, Executor& executor):
+	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
+	_pOstr(&ostr),
+	_level(level),
+	_format(format),
+	_blockSize(blockSize),
+	_executor(executor),
+	_maxPending(2*std::max(executor.threads(), 1)),
+	_pInput(std::make_shared<std::string>()),
+	_crc(0),
+	_size(0),
+	_started(false)
+{
+	poco_assert (blockSize > 0 && blockSize <= 0x7fffffff);
+
+	if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+		throw InvalidArgumentException("Invalid compression level");
+
+	_pInput->reserve(_blockSize);
+}
+
+
+ParallelDeflatingStreamBuf::~ParallelDeflatingStreamBuf()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+int ParallelDeflatingStreamBuf::close()
+{
+	BufferedStreamBuf::sync();
+	if (_pOstr)
+	{
+		if (_format == FORMAT_SINGLE_MEMBER)
+		{
+			submitBlock(true);
+			writeBlocks(0);
+			writeTrailer();
+		}
+		else
+		{
+			if (!_pInput->empty() || !_started) submitBlock(true);
+			writeBlocks(0);
+		}
+		_pOstr->flush();
+		_pOstr = 0;
+	}
+	return 0;
+}
+
+
+int ParallelDeflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	if (length == 0 || !_pOstr) return 0;
+
+	std::size_t remaining = static_cast<std::size_t>(length);
+	while (remaining > 0)
+	{
+		std::size_t n = std::min(remaining, _blockSize - _pInput->size());
+		_pInput->append(buffer, n);
+		buffer    += n;
+		remaining -= n;
+		if (_pInput->size() == _blockSize) submitBlock(false);
+	}
+	return static_cast<int>(length);
+}
+
+
+void ParallelDeflatingStreamBuf::submitBlock(bool last)
+{
+	if (!_started)
+	{
+		if (_format == FORMAT_SINGLE_MEMBER) writeHeader();
+		_started = true;
+	}
+
+	InputPtr pInput = _pInput;
+	int level = _level;
+	if (_format == FORMAT_SINGLE_MEMBER)
+	{
+		InputPtr pPrevious = _pPrevious;
+		_pending.push_back(_executor.submit([pInput, pPrevious, level, last]()
+		{
+			return compressBlock(pInput, pPrevious, level, last);
+		}));
+		_pPrevious = pInput;
+	}
+	else
+	{
+		_pending.push_back(_executor.submit([pInput, level]()
+		{
+			return compressMember(pInput, level);
+		}));
+	}
+	_pInput = std::make_shared<std::string>();
+	if (!last) _pInput->reserve(_blockSize);
+
+	writeBlocks(_maxPending);
+}
+
+
+void ParallelDeflatingStreamBuf::writeBlocks(std::size_t maxPending)
+{
+	while (_pending.size() > maxPending)
+	{
+		const Block& block = _pending.front().get();
+		_pOstr->write(block.data.data(), block.data.size());
+		if (!_pOstr->good()) throw IOException("Failed to write compressed data");
+		_crc  = static_cast<Poco::UInt32>(crc32_combine(_crc, block.crc, block.size));
+		_size += block.size;
+		_pending.pop_front();
+	}
+}
+
+
+void ParallelDeflatingStreamBuf::writeHeader()
+{
+	std::string header;
+	header += static_cast<char>(GZIP_ID1);
+	header += static_cast<char>(GZIP_ID2);
+	header += static_cast<char>(GZIP_CM);
+	header += '\0'; // FLG
+	putUInt32(header, 0); // MTIME
+	header += static_cast<char>(extraFlags(_level));
+	header += static_cast<char>(GZIP_OS);
+	_pOstr->write(header.data(), header.size());
+	if (!_pOstr->good()) throw IOException("Failed to write gzip header");
+}
+
+
+void ParallelDeflatingStreamBuf::writeTrailer()
+{
+	std::string trailer;
+	putUInt32(trailer, _crc);
+	putUInt32(trailer, _size);
+	_pOstr->write(trailer.data(), trailer.size());
+	if (!_pOstr->good()) throw IOException("Failed to write gzip trailer");
+}
+
+
+ParallelDeflatingStreamBuf::Block ParallelDeflatingStreamBuf::compressBlock(InputPtr pInput, InputPtr pPrevious, int level, bool last)
+{
+	Block block;
+	if (pPrevious)
+	{
+		std::size_t dictSize = std::min<std::size_t>(pPrevious->size(), DICTIONARY_SIZE);
+		std::string dictionary(pPrevious->data() + pPrevious->size() - dictSize, dictSize);
+		deflateRaw(*pInput, &dictionary, level, last, block.data);
+	}
+	else
+	{
+		deflateRaw(*pInput, 0, level, last, block.data);
+	}
+	block.crc  = checksumCRC32(*pInput);
+	block.size = static_cast<Poco::UInt32>(pInput->size());
+	return block;
+}
+
+
+ParallelDeflatingStreamBuf::Block ParallelDeflatingStreamBuf::compressMember(InputPtr pInput, int level)
+{
+	Block block;
+	std::string& out = block.data;
+	out += static_cast<char>(GZIP_ID1);
+	out += static_cast<char>(GZIP_ID2);
+	out += static_cast<char>(GZIP_CM);
+	out += static_cast<char>(GZIP_FEXTRA);
+	putUInt32(out, 0); // MTIME
+	out += static_cast<char>(extraFlags(level));
+	out += static_cast<char>(GZIP_OS);
+	putUInt16(out, 8); // XLEN
+	out += 'P';
+	out += 'Z';
+	putUInt16(out, 4);
+	std::size_t sizePos = out.size();
+	putUInt32(out, 0); // member size, set below
+
+	deflateRaw(*pInput, 0, level, true, out);
+
+	Poco::UInt32 crc = checksumCRC32(*pInput);
+	putUInt32(out, crc);
+	putUInt32(out, static_cast<Poco::UInt32>(pInput->size()));
+	setUInt32(out, sizePos, static_cast<Poco::UInt32>(out.size()));
+
+	block.crc  = crc;
+	block.size = static_cast<Poco::UInt32>(pInput->size());
+	return block;
+}
+
+
+ParallelDeflatingIOS::ParallelDeflatingIOS(std::ostream& ostr, int level, ParallelDeflatingStreamBuf::Format format, std::size_t blockSize, Executor& executor):
+	_buf(ostr, level, format, blockSize, executor)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ParallelDeflatingIOS::~ParallelDeflatingIOS()
+{
+}
+
+
+ParallelDeflatingStreamBuf* ParallelDeflatingIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+ParallelDeflatingOutputStream::ParallelDeflatingOutputStream(std::ostream& ostr, int level, ParallelDeflatingStreamBuf::Format format, std::size_t blockSize):
+	std::ostream(&_buf),
+	ParallelDeflatingIOS(ostr, level, format, blockSize, Executor::defaultExecutor())
+{
+}
+
+
+ParallelDeflatingOutputStream::ParallelDeflatingOutputStream(std::ostream& ostr, Executor& executor, int level, ParallelDeflatingStreamBuf::Format format, std::size_t blockSize):
+	std::ostream(&_buf),
+	ParallelDeflatingIOS(ostr, level, format, blockSize, executor)
+{
+}
+
+
+ParallelDeflatingOutputStream::~ParallelDeflatingOutputStream()
+{
+}
+
+
+int ParallelDeflatingOutputStream::close()
+{
+	return _buf.close();
+}
+
+
+int ParallelDeflatingOutputStream::sync()
+{
+	return _buf.pubsync();
+}
+
+
+} // namespace Poco
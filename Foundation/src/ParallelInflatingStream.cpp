@@ -0,0 +1,277 @@
+//
+// ParallelInflatingStream.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ParallelInflatingStream.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	Poco::UInt16 getUInt16(const unsigned char* p)
+	{
+		return static_cast<Poco::UInt16>(p[0] | (p[1] << 8));
+	}
+
+	Poco::UInt32 getUInt32(const unsigned char* p)
+	{
+		return static_cast<Poco::UInt32>(p[0]) | (static_cast<Poco::UInt32>(p[1]) << 8) | (static_cast<Poco::UInt32>(p[2]) << 16) | (static_cast<Poco::UInt32>(p[3]) << 24);
+	}
+
+	bool isGzipMember(const unsigned char* p)
+	{
+		return p[0] == 0x1f && p[1] == 0x8b;
+	}
+
+	bool isParallelMember(const unsigned char* p)
+		/// Checks for the header written by ParallelDeflatingStreamBuf
+		/// in FORMAT_MULTI_MEMBER: FEXTRA only, with a single "PZ"
+		/// subfield holding the size of the member.
+	{
+		return p[2] == 8 && p[3] == 0x04
+			&& getUInt16(p + 10) == 8
+			&& p[12] == 'P' && p[13] == 'Z'
+			&& getUInt16(p + 14) == 4;
+	}
+}
+
+
+ParallelInflatingStreamBuf::ParallelInflatingStreamBuf(std::istream& istr, Executor& executor):
+	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
+	_pIstr(&istr),
+	_executor(executor),
+	_maxPending(2*std::max(executor.threads(), 1)),
+	_inputPos(0),
+	_outputPos(0),
+	_sequential(false),
+	_firstMember(true),
+	_eof(false)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = inflateInit2(&_zstr, 16 + MAX_WBITS);
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+ParallelInflatingStreamBuf::~ParallelInflatingStreamBuf()
+{
+	inflateEnd(&_zstr);
+}
+
+
+int ParallelInflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
+{
+	for (;;)
+	{
+		if (_outputPos < _output.size())
+		{
+			std::size_t n = std::min(static_cast<std::size_t>(length), _output.size() - _outputPos);
+			std::memcpy(buffer, _output.data() + _outputPos, n);
+			_outputPos += n;
+			return static_cast<int>(n);
+		}
+		if (_sequential)
+		{
+			int n = inflateSequential(buffer, length);
+			if (n > 0) return n;
+		}
+		else if (_eof || _pending.size() >= _maxPending || !startMember())
+		{
+			if (_pending.empty()) return 0;
+
+			_output = _pending.front().get();
+			_outputPos = 0;
+			_pending.pop_front();
+		}
+	}
+}
+
+
+bool ParallelInflatingStreamBuf::fillInput(std::size_t size)
+{
+	if (_input.size() - _inputPos >= size) return true;
+
+	if (_inputPos > 0)
+	{
+		_input.erase(0, _inputPos);
+		_inputPos = 0;
+	}
+	while (_input.size() < size && _pIstr->good())
+	{
+		// The size may come from an untrusted header field, so
+		// the buffer grows only with the data actually received.
+		std::size_t used = _input.size();
+		_input.resize(used + std::max<std::size_t>(std::min(size - used, used), INPUT_BUFFER_SIZE));
+		_pIstr->read(&_input[used], _input.size() - used);
+		_input.resize(used + static_cast<std::size_t>(_pIstr->gcount()));
+	}
+	return _input.size() >= size;
+}
+
+
+bool ParallelInflatingStreamBuf::startMember()
+{
+	bool haveHeader = fillInput(2) && isGzipMember(reinterpret_cast<const unsigned char*>(_input.data() + _inputPos));
+	if (!haveHeader)
+	{
+		if (_firstMember && _inputPos < _input.size())
+			throw DataFormatException("Not a gzip stream");
+		_eof = true;
+		return false;
+	}
+	_firstMember = false;
+
+	if (fillInput(HEADER_SIZE) && isParallelMember(reinterpret_cast<const unsigned char*>(_input.data() + _inputPos)))
+	{
+		Poco::UInt32 size = getUInt32(reinterpret_cast<const unsigned char*>(_input.data() + _inputPos + 16));
+		if (size < HEADER_SIZE + 8)
+			throw DataFormatException("Invalid gzip member size");
+		if (!fillInput(size))
+			throw DataFormatException("Unexpected end of gzip stream");
+
+		MemberPtr pMember = std::make_shared<std::string>(_input, _inputPos, size);
+		_inputPos += size;
+		_pending.push_back(_executor.submit([pMember]()
+		{
+			return inflateMember(pMember);
+		}));
+		return true;
+	}
+
+	// A member of unknown size must be decompressed on this thread,
+	// after all preceding members have been delivered.
+	if (!_pending.empty()) return false;
+
+	int rc = inflateReset(&_zstr);
+	if (rc != Z_OK) throw IOException(zError(rc));
+	_sequential = true;
+	return true;
+}
+
+
+int ParallelInflatingStreamBuf::inflateSequential(char* buffer, std::streamsize length)
+{
+	if (_inputPos == _input.size() && !fillInput(1))
+		throw DataFormatException("Unexpected end of gzip stream");
+
+	_zstr.next_in   = reinterpret_cast<Bytef*>(&_input[_inputPos]);
+	_zstr.avail_in  = static_cast<uInt>(_input.size() - _inputPos);
+	_zstr.next_out  = reinterpret_cast<Bytef*>(buffer);
+	_zstr.avail_out = static_cast<uInt>(length);
+	int rc = inflate(&_zstr, Z_NO_FLUSH);
+	_inputPos = _input.size() - _zstr.avail_in;
+	if (rc == Z_STREAM_END)
+		_sequential = false;
+	else if (rc != Z_OK && rc != Z_BUF_ERROR)
+		throw DataFormatException(zError(rc));
+	return static_cast<int>(length) - static_cast<int>(_zstr.avail_out);
+}
+
+
+std::string ParallelInflatingStreamBuf::inflateMember(MemberPtr pMember)
+{
+	const std::string& member = *pMember;
+	std::string output;
+	// ISIZE is not trusted either, but deflate cannot expand data
+	// by more than a factor of 1032.
+	std::size_t size = getUInt32(reinterpret_cast<const unsigned char*>(member.data() + member.size() - 4));
+	output.resize(std::min(size, MAX_INFLATE_RATIO*member.size()));
+
+	z_stream zstr;
+	zstr.zalloc = Z_NULL;
+	zstr.zfree  = Z_NULL;
+	zstr.opaque = Z_NULL;
+	int rc = inflateInit2(&zstr, 16 + MAX_WBITS);
+	if (rc != Z_OK) throw IOException(zError(rc));
+
+	zstr.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(member.data()));
+	zstr.avail_in  = static_cast<uInt>(member.size());
+	zstr.next_out  = reinterpret_cast<Bytef*>(&output[0]);
+	zstr.avail_out = static_cast<uInt>(output.size());
+	for (;;)
+	{
+		rc = inflate(&zstr, Z_NO_FLUSH);
+		if (rc == Z_STREAM_END) break;
+		if ((rc == Z_OK || rc == Z_BUF_ERROR) && zstr.avail_out == 0)
+		{
+			// ISIZE is the size modulo 2^32, so it may be too small
+			std::size_t used = output.size();
+			output.resize(2*used + INPUT_BUFFER_SIZE);
+			zstr.next_out  = reinterpret_cast<Bytef*>(&output[used]);
+			zstr.avail_out = static_cast<uInt>(output.size() - used);
+			continue;
+		}
+		inflateEnd(&zstr);
+		if (rc == Z_OK || rc == Z_BUF_ERROR)
+			throw DataFormatException("Unexpected end of gzip member");
+		else
+			throw DataFormatException(zError(rc));
+	}
+	bool complete = zstr.avail_in == 0;
+	output.resize(output.size() - zstr.avail_out);
+	inflateEnd(&zstr);
+	if (!complete) throw DataFormatException("Invalid gzip member size");
+	return output;
+}
+
+
+ParallelInflatingIOS::ParallelInflatingIOS(std::istream& istr, Executor& executor):
+	_buf(istr, executor)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ParallelInflatingIOS::~ParallelInflatingIOS()
+{
+}
+
+
+ParallelInflatingStreamBuf* ParallelInflatingIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+ParallelInflatingInputStream::ParallelInflatingInputStream(std::istream& istr):
+	std::istream(&_buf),
+	ParallelInflatingIOS(istr, Executor::defaultExecutor())
+{
+}
+
+
+ParallelInflatingInputStream::ParallelInflatingInputStream(std::istream& istr, Executor& executor):
+	std::istream(&_buf),
+	ParallelInflatingIOS(istr, executor)
+{
+}
+
+
+ParallelInflatingInputStream::~ParallelInflatingInputStream()
+{
+}
+
+
+} // namespace Poco
@@ -16,6 +16,7 @@
 #include "Poco/Path.h"
 #include "Poco/DirectoryIterator.h"
 #include "Poco/Timestamp.h"
+#include <algorithm>
 
 
 namespace Poco {
@@ -48,7 +49,9 @@ void PurgeStrategy::list(const std::string& path, std::vector<File>& files)
 	DirectoryIterator end;
 	while (it != end)
 	{
-		if (it.name().compare(0, baseName.size(), baseName) == 0)
+		// Skip log files waiting to be archived in the
+		// background, which have a ".~" suffix.
+		if (it.name().compare(0, baseName.size(), baseName) == 0 && it.name().compare(baseName.size(), 1, "~") != 0)
 		{
 			files.push_back(*it);
 		}
@@ -106,24 +109,23 @@ void PurgeByCountStrategy::purge(const std::string& path)
 {
 	std::vector<File> files;
 	list(path, files);
-	while (files.size() > _count)
+	std::size_t count = static_cast<std::size_t>(_count);
+	if (files.size() <= count) return;
+
+	// get every file's modification date only once
+	typedef std::pair<Timestamp, std::size_t> Entry;
+	std::vector<Entry> entries;
+	entries.reserve(files.size());
+	for (std::size_t i = 0; i < files.size(); ++i)
 	{
-		std::vector<File>::iterator it = files.begin();
-		std::vector<File>::iterator purgeIt = it;
-		Timestamp purgeTS = purgeIt->getLastModified();
-		++it;
-		while (it != files.end())
-		{
-			Timestamp md(it->getLastModified());
-			if (md <= purgeTS)
-			{
-				purgeTS = md;
-				purgeIt = it;
-			}
-			++it;
-		}
-		purgeIt->remove();
-		files.erase(purgeIt);
+		entries.push_back(Entry(files[i].getLastModified(), i));
+	}
+	std::sort(entries.begin(), entries.end());
+
+	std::size_t excess = files.size() - count;
+	for (std::size_t i = 0; i < excess; ++i)
+	{
+		files[entries[i].second].remove();
 	}
 }
 
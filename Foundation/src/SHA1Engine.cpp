@@ -17,7 +17,11 @@
 
 #include "Poco/SHA1Engine.h"
 #include "Poco/ByteOrder.h"
+#include "Poco/CPUFeatures.h"
 #include <cstring>
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
 
 
 #ifdef POCO_ARCH_LITTLE_ENDIAN
@@ -30,6 +34,76 @@
 namespace Poco {
 
 
+namespace
+{
+#if defined(POCO_HAVE_X86_SIMD)
+
+
+#define SHA1_ROUNDS(EA, EB, M, F) \
+	EA = _mm_sha1nexte_epu32(EA, M); EB = ABCD; ABCD = _mm_sha1rnds4_epu32(ABCD, EA, F)
+#define SHA1_SCHEDULE(MA, MB, MC, MD) \
+	MA = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(MA, MB), MC), MD)
+
+
+	POCO_SIMD_TARGET("sha,sse4.1,ssse3")
+	void transformSHANI(UInt32 state[5], const UInt8* data, std::size_t blocks)
+		/// Processes complete blocks using the SHA extensions. Each sha1rnds4
+		/// performs four rounds; the message schedule is computed four words
+		/// at a time with sha1msg1/sha1msg2, rotating through M0..M3.
+	{
+		const __m128i MASK = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+		__m128i ABCD = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+		__m128i E0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+		__m128i E1;
+		while (blocks-- > 0)
+		{
+			const __m128i ABCD_SAVE = ABCD;
+			const __m128i E0_SAVE = E0;
+			__m128i M0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), MASK);
+			__m128i M1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), MASK);
+			__m128i M2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), MASK);
+			__m128i M3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), MASK);
+
+			E0 = _mm_add_epi32(E0, M0); E1 = ABCD; ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+			SHA1_ROUNDS(E1, E0, M1, 0);
+			SHA1_ROUNDS(E0, E1, M2, 0);
+			SHA1_ROUNDS(E1, E0, M3, 0);
+			SHA1_SCHEDULE(M0, M1, M2, M3); SHA1_ROUNDS(E0, E1, M0, 0);
+			SHA1_SCHEDULE(M1, M2, M3, M0); SHA1_ROUNDS(E1, E0, M1, 1);
+			SHA1_SCHEDULE(M2, M3, M0, M1); SHA1_ROUNDS(E0, E1, M2, 1);
+			SHA1_SCHEDULE(M3, M0, M1, M2); SHA1_ROUNDS(E1, E0, M3, 1);
+			SHA1_SCHEDULE(M0, M1, M2, M3); SHA1_ROUNDS(E0, E1, M0, 1);
+			SHA1_SCHEDULE(M1, M2, M3, M0); SHA1_ROUNDS(E1, E0, M1, 1);
+			SHA1_SCHEDULE(M2, M3, M0, M1); SHA1_ROUNDS(E0, E1, M2, 2);
+			SHA1_SCHEDULE(M3, M0, M1, M2); SHA1_ROUNDS(E1, E0, M3, 2);
+			SHA1_SCHEDULE(M0, M1, M2, M3); SHA1_ROUNDS(E0, E1, M0, 2);
+			SHA1_SCHEDULE(M1, M2, M3, M0); SHA1_ROUNDS(E1, E0, M1, 2);
+			SHA1_SCHEDULE(M2, M3, M0, M1); SHA1_ROUNDS(E0, E1, M2, 2);
+			SHA1_SCHEDULE(M3, M0, M1, M2); SHA1_ROUNDS(E1, E0, M3, 3);
+			SHA1_SCHEDULE(M0, M1, M2, M3); SHA1_ROUNDS(E0, E1, M0, 3);
+			SHA1_SCHEDULE(M1, M2, M3, M0); SHA1_ROUNDS(E1, E0, M1, 3);
+			SHA1_SCHEDULE(M2, M3, M0, M1); SHA1_ROUNDS(E0, E1, M2, 3);
+			SHA1_SCHEDULE(M3, M0, M1, M2); SHA1_ROUNDS(E1, E0, M3, 3);
+
+			E0 = _mm_sha1nexte_epu32(E0, E0_SAVE);
+			ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+			data += 64;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(ABCD, 0x1B));
+		state[4] = static_cast<UInt32>(_mm_extract_epi32(E0, 3));
+	}
+
+
+#undef SHA1_ROUNDS
+#undef SHA1_SCHEDULE
+
+#endif // POCO_HAVE_X86_SIMD
+
+
+	const bool useSHANI = CPUFeatures::hasSHA() && CPUFeatures::hasSSE41() && CPUFeatures::hasSSSE3();
+}
+
+
 SHA1Engine::SHA1Engine()
 {
 	_digest.reserve(16);
@@ -66,17 +140,52 @@ void SHA1Engine::updateImpl(const void* buffer_, std::size_t count)
 	_context.countLo += ((UInt32) count << 3);
 	_context.countHi += ((UInt32 ) count >> 29);
 
-	/* Process data in BLOCK_SIZE chunks */
-	while (count-- > 0)
+	/* Complete a partially filled block */
+	if (_context.slop > 0)
 	{
-		db[_context.slop++] = *(buffer++);
-		if (_context.slop == BLOCK_SIZE)
-		{
-			/* transform this one block */
-			SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
-			transform();
-			_context.slop = 0 ;	/* no slop left */
-		}
+		std::size_t n = BLOCK_SIZE - _context.slop;
+		if (n > count) n = count;
+		std::memcpy(db + _context.slop, buffer, n);
+		_context.slop += (UInt32) n;
+		buffer += n;
+		count  -= n;
+		if (_context.slop < BLOCK_SIZE) return;
+
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		_context.slop = 0;	/* no slop left */
+	}
+
+	/* Process complete blocks directly from the buffer */
+	std::size_t blocks = count/BLOCK_SIZE;
+	if (blocks > 0)
+	{
+		transform(buffer, blocks);
+		buffer += blocks*BLOCK_SIZE;
+		count  -= blocks*BLOCK_SIZE;
+	}
+
+	/* Save the remaining bytes */
+	std::memcpy(db, buffer, count);
+	_context.slop = (UInt32) count;
+}
+
+
+void SHA1Engine::transform(const BYTE* data, std::size_t blocks)
+{
+#if defined(POCO_HAVE_X86_SIMD)
+	if (useSHANI)
+	{
+		transformSHANI(_context.digest, data, blocks);
+		return;
+	}
+#endif
+	while (blocks-- > 0)
+	{
+		std::memcpy(_context.data, data, BLOCK_SIZE);
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		data += BLOCK_SIZE;
 	}
 }
 
@@ -20,7 +20,11 @@
 //
 
 #include "Poco/SHA2Engine.h"
+#include "Poco/CPUFeatures.h"
 #include <string.h>
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
 
 namespace Poco {
 
@@ -273,6 +277,65 @@ void _sha256_process(HASHCONTEXT* pContext, const unsigned char data[64])
 	for (i = 0; i < 8; i++) pContext->state.state32[i] += temp3[i];
 }
 
+#if defined(POCO_HAVE_X86_SIMD)
+
+POCO_SIMD_TARGET("sha,sse4.1,ssse3")
+static void _sha256_process_shani(Poco::UInt32 state[8], const unsigned char* data, size_t blocks)
+	/// SHA-256 compression using the SHA extensions. The state is kept
+	/// as ABEF/CDGH, as required by sha256rnds2, and each group of four
+	/// message words is scheduled with sha256msg1/sha256msg2.
+{
+	const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+	while (blocks-- > 0)
+	{
+		const __m128i abefSave = state0;
+		const __m128i cdghSave = state1;
+		__m128i m[4];
+		for (int k = 0; k < 16; ++k)
+		{
+			__m128i& w = m[k & 3];
+			if (k < 4)
+				w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*k)), MASK);
+			else
+				w = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w, m[(k + 1) & 3]), _mm_alignr_epi8(m[(k + 3) & 3], m[(k + 2) & 3], 4)), m[(k + 3) & 3]);
+			__m128i msg = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K32 + 4*k)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+		}
+		state0 = _mm_add_epi32(state0, abefSave);
+		state1 = _mm_add_epi32(state1, cdghSave);
+		data += 64;
+	}
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(tmp, state1, 0xF0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#endif
+
+static const bool useSHANI = CPUFeatures::hasSHA() && CPUFeatures::hasSSE41() && CPUFeatures::hasSSSE3();
+
+static void _sha256_process_blocks(HASHCONTEXT* pContext, const unsigned char* data, size_t blocks)
+{
+#if defined(POCO_HAVE_X86_SIMD)
+	if (useSHANI)
+	{
+		_sha256_process_shani(pContext->state.state32, data, blocks);
+		return;
+	}
+#endif
+	while (blocks-- > 0)
+	{
+		_sha256_process(pContext, data);
+		data += 64;
+	}
+}
+
 void _sha512_process(HASHCONTEXT* pContext, const unsigned char data[128])
 {
 	int i;
@@ -332,16 +395,17 @@ void SHA2Engine::updateImpl(const void* buffer_, std::size_t count)
 		if (left && count >= fill)
 		{
 			memcpy((void *)(pContext->buffer + left), data, fill);
-			_sha256_process(pContext, pContext->buffer);
+			_sha256_process_blocks(pContext, pContext->buffer, 1);
 			data += fill;
 			count -= fill;
 			left = 0;
 		}
-		while (count >= 64)
+		if (count >= 64)
 		{
-			_sha256_process(pContext, data);
-			data += 64;
-			count -= 64;
+			size_t blocks = count / 64;
+			_sha256_process_blocks(pContext, data, blocks);
+			data += blocks * 64;
+			count -= blocks * 64;
 		}
 	}
 	if (count > 0) memcpy((void *)(pContext->buffer + left), data, count);
@@ -354,8 +418,10 @@ std::size_t SHA2Engine::digestLength() const
 
 void SHA2Engine::reset()
 {
-	if (_context != NULL) free(_context);
-	_context = calloc(1, sizeof(HASHCONTEXT));
+	if (_context == NULL)
+		_context = calloc(1, sizeof(HASHCONTEXT));
+	else
+		memset(_context, 0, sizeof(HASHCONTEXT));
 	HASHCONTEXT* pContext = (HASHCONTEXT*)_context;
 	pContext->size = _algorithm;
 	if (_algorithm == SHA_224)
@@ -14,103 +14,237 @@
 
 #include "Poco/StreamCopier.h"
 #include "Poco/Buffer.h"
+#if POCO_OS == POCO_OS_LINUX
+#include "Poco/DescriptorStreamBuf.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
 
 
 namespace Poco {
 
 
-std::streamsize StreamCopier::copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
+namespace
 {
-	poco_assert (bufferSize > 0);
+	const std::size_t MAX_BUFFER_SIZE = 256*1024;
+		// The buffer used for copying grows up to this size
+		// as long as reads fill the buffer completely.
 
-	Buffer<char> buffer(bufferSize);
-	std::streamsize len = 0;
-	istr.read(buffer.begin(), bufferSize);
-	std::streamsize n = istr.gcount();
-	while (n > 0)
+	void growBuffer(Buffer<char>& buffer, std::size_t& bufferSize, std::streamsize n)
 	{
-		len += n;
-		ostr.write(buffer.begin(), n);
-		if (istr && ostr)
+		if (static_cast<std::size_t>(n) == bufferSize && bufferSize < MAX_BUFFER_SIZE)
 		{
-			istr.read(buffer.begin(), bufferSize);
-			n = istr.gcount();
+			bufferSize = std::min(2*bufferSize, MAX_BUFFER_SIZE);
+			buffer.resize(bufferSize, false);
 		}
-		else n = 0;
 	}
-	return len;
-}
 
+#if POCO_OS == POCO_OS_LINUX
 
-#if defined(POCO_HAVE_INT64)
-Poco::UInt64 StreamCopier::copyStream64(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
-{
-	poco_assert (bufferSize > 0);
+	const std::size_t MAX_TRANSFER_SIZE = 0x40000000;
 
-	Buffer<char> buffer(bufferSize);
-	Poco::UInt64 len = 0;
-	istr.read(buffer.begin(), bufferSize);
-	std::streamsize n = istr.gcount();
-	while (n > 0)
+	bool transferFile(int in, int out, Poco::UInt64& count)
+		// Copies from a regular file, using copy_file_range() if both
+		// descriptors refer to files, and sendfile() otherwise.
+		// Returns true if the end of the file has been reached.
 	{
-		len += n;
-		ostr.write(buffer.begin(), n);
-		if (istr && ostr)
+		ssize_t n = -1;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+		while ((n = copy_file_range(in, NULL, out, NULL, MAX_TRANSFER_SIZE, 0)) > 0)
 		{
-			istr.read(buffer.begin(), bufferSize);
-			n = istr.gcount();
+			count += n;
 		}
-		else n = 0;
-	}
-	return len;
-}
+		if (n == 0) return true;
 #endif
+		while ((n = sendfile(out, in, NULL, MAX_TRANSFER_SIZE)) > 0)
+		{
+			count += n;
+		}
+		return n == 0;
+	}
 
+	bool transferPipe(int in, int out, std::ostream& ostr, Poco::UInt64& inCount, Poco::UInt64& outCount)
+		// Copies from a socket or pipe, using splice() through a pipe.
+		// Data left in the pipe after an error is written to ostr.
+		// Returns true if the end of the input has been reached.
+	{
+		int fds[2];
+		if (pipe2(fds, O_CLOEXEC) != 0) return false;
 
-std::streamsize StreamCopier::copyToString(std::istream& istr, std::string& str, std::size_t bufferSize)
-{
-	poco_assert (bufferSize > 0);
+		int pipeSize = fcntl(fds[1], F_SETPIPE_SZ, static_cast<int>(MAX_BUFFER_SIZE));
+		if (pipeSize <= 0) pipeSize = 65536;
 
-	Buffer<char> buffer(bufferSize);
-	std::streamsize len = 0;
-	istr.read(buffer.begin(), bufferSize);
-	std::streamsize n = istr.gcount();
-	while (n > 0)
+		bool eof = false;
+		for (;;)
+		{
+			ssize_t n = splice(in, NULL, fds[1], NULL, pipeSize, SPLICE_F_MOVE);
+			if (n <= 0)
+			{
+				eof = (n == 0);
+				break;
+			}
+			inCount += n;
+			while (outCount < inCount)
+			{
+				n = splice(fds[0], NULL, out, NULL, static_cast<std::size_t>(inCount - outCount), SPLICE_F_MOVE);
+				if (n <= 0) break;
+				outCount += n;
+			}
+			if (outCount < inCount) break;
+		}
+		if (outCount < inCount)
+		{
+			std::size_t size = static_cast<std::size_t>(inCount - outCount);
+			Buffer<char> buffer(size);
+			std::size_t pending = 0;
+			while (pending < size)
+			{
+				ssize_t n = read(fds[0], buffer.begin() + pending, size - pending);
+				if (n <= 0) break;
+				pending += n;
+			}
+			ostr.write(buffer.begin(), pending);
+			eof = false;
+		}
+		close(fds[0]);
+		close(fds[1]);
+		return eof;
+	}
+
+	bool copyDirect(std::istream& istr, std::ostream& ostr, Poco::UInt64& count)
+		// Lets the kernel move the data from istr to ostr if both
+		// stream buffers are backed by a descriptor. Returns true if
+		// the end of the input has been reached, or false if the
+		// remaining data must be copied through a buffer.
 	{
-		len += n;
-		str.append(buffer.begin(), static_cast<std::string::size_type>(n));
-		if (istr)
+		DescriptorStreamBuf* pIn = dynamic_cast<DescriptorStreamBuf*>(istr.rdbuf());
+		DescriptorStreamBuf* pOut = dynamic_cast<DescriptorStreamBuf*>(ostr.rdbuf());
+		if (!pIn || !pOut || !istr || !ostr) return false;
+
+		std::streamsize avail = istr.rdbuf()->in_avail();
+		if (avail > 0)
 		{
-			istr.read(buffer.begin(), bufferSize);
-			n = istr.gcount();
+			Buffer<char> buffer(static_cast<std::size_t>(avail));
+			istr.read(buffer.begin(), avail);
+			std::streamsize n = istr.gcount();
+			count += n;
+			ostr.write(buffer.begin(), n);
+			if (!istr || !ostr) return false;
 		}
-		else n = 0;
+
+		int in = pIn->readDescriptor();
+		if (in == -1) return false;
+		int out = pOut->writeDescriptor();
+		if (out == -1) return false;
+
+		struct stat st;
+		if (fstat(in, &st) != 0) return false;
+		// Files in /proc or /sys report a size of 0 and
+		// cannot be copied by the kernel.
+		if (S_ISREG(st.st_mode) && st.st_size == 0) return false;
+
+		Poco::UInt64 inCount = 0;
+		Poco::UInt64 outCount = 0;
+		bool eof;
+		if (S_ISREG(st.st_mode))
+		{
+			eof = transferFile(in, out, inCount);
+			outCount = inCount;
+		}
+		else eof = transferPipe(in, out, ostr, inCount, outCount);
+		pIn->transferred(inCount);
+		pOut->transferred(outCount);
+		count += inCount;
+		if (eof) istr.setstate(std::ios::eofbit | std::ios::failbit);
+		return eof;
 	}
-	return len;
-}
 
+#endif // POCO_OS == POCO_OS_LINUX
 
-#if defined(POCO_HAVE_INT64)
-Poco::UInt64 StreamCopier::copyToString64(std::istream& istr, std::string& str, std::size_t bufferSize)
-{
-	poco_assert (bufferSize > 0);
+	template <typename T>
+	T copyStreamImpl(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
+	{
+		poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
-	Poco::UInt64 len = 0;
-	istr.read(buffer.begin(), bufferSize);
-	std::streamsize n = istr.gcount();
-	while (n > 0)
+		T len = 0;
+#if POCO_OS == POCO_OS_LINUX
+		Poco::UInt64 count = 0;
+		bool eof = copyDirect(istr, ostr, count);
+		len = static_cast<T>(count);
+		if (eof) return len;
+#endif
+		Buffer<char> buffer(bufferSize);
+		istr.read(buffer.begin(), bufferSize);
+		std::streamsize n = istr.gcount();
+		while (n > 0)
+		{
+			len += n;
+			ostr.write(buffer.begin(), n);
+			if (istr && ostr)
+			{
+				growBuffer(buffer, bufferSize, n);
+				istr.read(buffer.begin(), bufferSize);
+				n = istr.gcount();
+			}
+			else n = 0;
+		}
+		return len;
+	}
+
+	template <typename T>
+	T copyToStringImpl(std::istream& istr, std::string& str, std::size_t bufferSize)
 	{
-		len += n;
-		str.append(buffer.begin(), static_cast<std::string::size_type>(n));
-		if (istr)
+		poco_assert (bufferSize > 0);
+
+		Buffer<char> buffer(bufferSize);
+		T len = 0;
+		istr.read(buffer.begin(), bufferSize);
+		std::streamsize n = istr.gcount();
+		while (n > 0)
 		{
-			istr.read(buffer.begin(), bufferSize);
-			n = istr.gcount();
+			len += n;
+			str.append(buffer.begin(), static_cast<std::string::size_type>(n));
+			if (istr)
+			{
+				growBuffer(buffer, bufferSize, n);
+				istr.read(buffer.begin(), bufferSize);
+				n = istr.gcount();
+			}
+			else n = 0;
 		}
-		else n = 0;
+		return len;
 	}
-	return len;
+}
+
+
+std::streamsize StreamCopier::copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
+{
+	return copyStreamImpl<std::streamsize>(istr, ostr, bufferSize);
+}
+
+
+#if defined(POCO_HAVE_INT64)
+Poco::UInt64 StreamCopier::copyStream64(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
+{
+	return copyStreamImpl<Poco::UInt64>(istr, ostr, bufferSize);
+}
+#endif
+
+
+std::streamsize StreamCopier::copyToString(std::istream& istr, std::string& str, std::size_t bufferSize)
+{
+	return copyToStringImpl<std::streamsize>(istr, str, bufferSize);
+}
+
+
+#if defined(POCO_HAVE_INT64)
+Poco::UInt64 StreamCopier::copyToString64(std::istream& istr, std::string& str, std::size_t bufferSize)
+{
+	return copyToStringImpl<Poco::UInt64>(istr, str, bufferSize);
 }
 #endif
 
@@ -15,6 +15,13 @@
 #include "Poco/TextConverter.h"
 #include "Poco/TextIterator.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/UTF32Encoding.h"
+#include "Poco/Latin1Encoding.h"
+#include "Poco/UTFTranscoder.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
 
 
 namespace {
@@ -22,6 +29,115 @@ namespace {
 	{
 		return ch;
 	}
+
+
+	enum TranscoderEncoding
+	{
+		ENC_OTHER,
+		ENC_UTF8,
+		ENC_UTF16,
+		ENC_UTF32,
+		ENC_LATIN1
+	};
+
+
+	TranscoderEncoding transcoderEncoding(const Poco::TextEncoding& encoding)
+		/// Returns the encoding if it is supported by UTFTranscoder.
+	{
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		const Poco::UTF16Encoding::ByteOrderType utf16Native = Poco::UTF16Encoding::BIG_ENDIAN_BYTE_ORDER;
+		const Poco::UTF32Encoding::ByteOrderType utf32Native = Poco::UTF32Encoding::BIG_ENDIAN_BYTE_ORDER;
+#else
+		const Poco::UTF16Encoding::ByteOrderType utf16Native = Poco::UTF16Encoding::LITTLE_ENDIAN_BYTE_ORDER;
+		const Poco::UTF32Encoding::ByteOrderType utf32Native = Poco::UTF32Encoding::LITTLE_ENDIAN_BYTE_ORDER;
+#endif
+
+		if (dynamic_cast<const Poco::UTF8Encoding*>(&encoding))
+			return ENC_UTF8;
+		if (dynamic_cast<const Poco::Latin1Encoding*>(&encoding))
+			return ENC_LATIN1;
+		const Poco::UTF16Encoding* pUTF16 = dynamic_cast<const Poco::UTF16Encoding*>(&encoding);
+		if (pUTF16 && pUTF16->getByteOrder() == utf16Native)
+			return ENC_UTF16;
+		const Poco::UTF32Encoding* pUTF32 = dynamic_cast<const Poco::UTF32Encoding*>(&encoding);
+		if (pUTF32 && pUTF32->getByteOrder() == utf32Native)
+			return ENC_UTF32;
+		return ENC_OTHER;
+	}
+
+
+	template <typename Char>
+	bool isAligned(const char* source, std::size_t length)
+	{
+		return length % sizeof(Char) == 0 && reinterpret_cast<Poco::UIntPtr>(source) % sizeof(Char) == 0;
+	}
+
+
+	bool transcode(const Poco::TextEncoding& inEncoding, const Poco::TextEncoding& outEncoding, const char* source, std::size_t length, std::string& destination)
+		/// Converts the source with UTFTranscoder, if it supports both encodings.
+		/// Returns false, and leaves destination unchanged, if the encodings are
+		/// not supported, or if the source contains invalid sequences or characters
+		/// that cannot be represented in outEncoding. These are left to the
+		/// character-by-character conversion, which substitutes the default character.
+	{
+		using Poco::UTFTranscoder;
+
+		TranscoderEncoding in = transcoderEncoding(inEncoding);
+		TranscoderEncoding out = in == ENC_OTHER ? ENC_OTHER : transcoderEncoding(outEncoding);
+		if (out == ENC_OTHER) return false;
+		if (length == 0) return true;
+
+		std::string::size_type offset = destination.size();
+		try
+		{
+			if (in == ENC_UTF8 && out == ENC_UTF8)
+			{
+				if (!UTFTranscoder::isValidUTF8(source, length)) return false;
+				destination.append(source, length);
+			}
+			else if (in == ENC_UTF8 && out == ENC_UTF16)
+			{
+				Poco::Buffer<Poco::UTF16Char> utf16(length);
+				std::size_t n = UTFTranscoder::utf8ToUTF16(source, length, utf16.begin());
+				destination.append(reinterpret_cast<const char*>(utf16.begin()), n*sizeof(Poco::UTF16Char));
+			}
+			else if (in == ENC_UTF8 && out == ENC_UTF32)
+			{
+				Poco::Buffer<Poco::UTF32Char> utf32(length);
+				std::size_t n = UTFTranscoder::utf8ToUTF32(source, length, utf32.begin());
+				destination.append(reinterpret_cast<const char*>(utf32.begin()), n*sizeof(Poco::UTF32Char));
+			}
+			else if (in == ENC_UTF8 && out == ENC_LATIN1)
+			{
+				destination.resize(offset + length);
+				destination.resize(offset + UTFTranscoder::utf8ToLatin1(source, length, &destination[0] + offset));
+			}
+			else if (in == ENC_UTF16 && out == ENC_UTF8 && isAligned<Poco::UTF16Char>(source, length))
+			{
+				std::size_t n = length/sizeof(Poco::UTF16Char);
+				destination.resize(offset + 3*n);
+				destination.resize(offset + UTFTranscoder::utf16ToUTF8(reinterpret_cast<const Poco::UTF16Char*>(source), n, &destination[0] + offset));
+			}
+			else if (in == ENC_UTF32 && out == ENC_UTF8 && isAligned<Poco::UTF32Char>(source, length))
+			{
+				std::size_t n = length/sizeof(Poco::UTF32Char);
+				destination.resize(offset + 4*n);
+				destination.resize(offset + UTFTranscoder::utf32ToUTF8(reinterpret_cast<const Poco::UTF32Char*>(source), n, &destination[0] + offset));
+			}
+			else if (in == ENC_LATIN1 && out == ENC_UTF8)
+			{
+				destination.resize(offset + 2*length);
+				destination.resize(offset + UTFTranscoder::latin1ToUTF8(source, length, &destination[0] + offset));
+			}
+			else return false;
+		}
+		catch (Poco::DataFormatException&)
+		{
+			destination.resize(offset);
+			return false;
+		}
+		return true;
+	}
 }
 
 
@@ -115,13 +231,21 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 
 int TextConverter::convert(const std::string& source, std::string& destination)
 {
-	return convert(source, destination, nullTransform);
+	if (transcode(_inEncoding, _outEncoding, source.data(), source.size(), destination))
+		return 0;
+	else
+		return convert(source, destination, nullTransform);
 }
 
 
 int TextConverter::convert(const void* source, int length, std::string& destination)
 {
-	return convert(source, length, destination, nullTransform);
+	poco_check_ptr (source);
+
+	if (length >= 0 && transcode(_inEncoding, _outEncoding, static_cast<const char*>(source), length, destination))
+		return 0;
+	else
+		return convert(source, length, destination, nullTransform);
 }
 
 
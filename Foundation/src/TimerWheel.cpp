@@ -0,0 +1,432 @@
+//
+// TimerWheel.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  TimerWheel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TimerWheel.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const int    SLOT_BITS = 8;
+	const UInt64 SLOT_MASK = TimerWheel::SLOTS - 1;
+	const UInt64 MAX_DELTA = 0xFFFFFFFFULL;
+	const std::size_t MIN_BATCH_SIZE = 16;
+
+	void invoke(std::vector<TimerWheel::Callback>& callbacks)
+	{
+		for (std::vector<TimerWheel::Callback>::iterator it = callbacks.begin(); it != callbacks.end(); ++it)
+		{
+			try
+			{
+				(*it)();
+			}
+			catch (Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+		}
+	}
+
+	class CallbackBatch: public Runnable
+		/// Calls a batch of expired callbacks in a pooled thread
+		/// and deletes itself afterwards.
+	{
+	public:
+		CallbackBatch(std::vector<TimerWheel::Callback>::iterator begin, std::vector<TimerWheel::Callback>::iterator end):
+			_callbacks(std::make_move_iterator(begin), std::make_move_iterator(end))
+		{
+		}
+
+		void run()
+		{
+			invoke(_callbacks);
+			delete this;
+		}
+
+	private:
+		std::vector<TimerWheel::Callback> _callbacks;
+	};
+}
+
+
+TimerWheel::TimerWheel(long tick):
+	_tickMicroseconds(static_cast<UInt64>(tick)*1000),
+	_now(0),
+	_free(-1),
+	_count(0),
+	_wakeTick(0),
+	_pPool(0),
+	_thread("TimerWheel"),
+	_stopped(false)
+{
+	poco_assert (tick > 0);
+
+	std::fill(_slots, _slots + LEVELS*SLOTS, -1);
+}
+
+
+TimerWheel::~TimerWheel()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void TimerWheel::start()
+{
+	poco_assert (!_thread.isRunning());
+
+	_pPool = 0;
+	_stopped = false;
+	_thread.start(*this);
+}
+
+
+void TimerWheel::start(ThreadPool& pool)
+{
+	poco_assert (!_thread.isRunning());
+
+	_pPool = &pool;
+	_stopped = false;
+	_thread.start(*this);
+}
+
+
+void TimerWheel::stop()
+{
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_stopped = true;
+		_wakeTick = 0;
+	}
+	_wakeUp.set();
+	if (_thread.isRunning()) _thread.join();
+}
+
+
+TimerWheel::Handle TimerWheel::schedule(const Callback& callback, long delay)
+{
+	return schedule(callback, delay, 0);
+}
+
+
+TimerWheel::Handle TimerWheel::schedule(const Callback& callback, long delay, long interval)
+{
+	poco_assert (interval >= 0);
+
+	if (delay < 0) delay = 0;
+	UInt64 intervalTicks = (static_cast<UInt64>(interval)*1000 + _tickMicroseconds - 1)/_tickMicroseconds;
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	Int32 index = allocate();
+	Node& node = _nodes[index];
+	node.callback = callback;
+	node.expiry = expiryTick(delay);
+	node.interval = intervalTicks;
+	link(index);
+	if (node.expiry < _wakeTick) _wakeUp.set();
+	return (static_cast<UInt64>(node.generation) << 32) | static_cast<UInt32>(index);
+}
+
+
+bool TimerWheel::cancel(Handle handle)
+{
+	UInt32 index = static_cast<UInt32>(handle);
+	UInt32 generation = static_cast<UInt32>(handle >> 32);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (index >= _nodes.size()) return false;
+	Node& node = _nodes[index];
+	if (node.generation != generation || node.slot < 0) return false;
+	unlink(index);
+	release(index);
+	return true;
+}
+
+
+std::size_t TimerWheel::process()
+{
+	Batch batch;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		advance(currentTick(), batch);
+	}
+	invoke(batch);
+	return batch.size();
+}
+
+
+long TimerWheel::nextTimeout() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_count == 0) return -1;
+	return millisecondsUntil(nextTick());
+}
+
+
+std::size_t TimerWheel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _count;
+}
+
+
+void TimerWheel::run()
+{
+	Batch batch;
+	for (;;)
+	{
+		UInt64 wakeTick;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_stopped) break;
+			advance(currentTick(), batch);
+			wakeTick = _count ? nextTick() : std::numeric_limits<UInt64>::max();
+			_wakeTick = wakeTick;
+		}
+		dispatch(batch);
+		batch.clear();
+
+		if (wakeTick == std::numeric_limits<UInt64>::max())
+		{
+			_wakeUp.wait();
+		}
+		else
+		{
+			long timeout = millisecondsUntil(wakeTick);
+			if (timeout > 0) _wakeUp.tryWait(timeout);
+		}
+	}
+}
+
+
+UInt64 TimerWheel::currentTick() const
+{
+	return static_cast<UInt64>(_start.elapsed())/_tickMicroseconds;
+}
+
+
+UInt64 TimerWheel::expiryTick(long delay) const
+{
+	UInt64 expiry = (static_cast<UInt64>(_start.elapsed()) + static_cast<UInt64>(delay)*1000 + _tickMicroseconds - 1)/_tickMicroseconds;
+	return std::max(expiry, _now);
+}
+
+
+void TimerWheel::link(Int32 index)
+{
+	Node& node = _nodes[index];
+	UInt64 expiry = std::max(node.expiry, _now);
+	UInt64 delta = expiry - _now;
+	int level = 0;
+	if (delta > MAX_DELTA)
+	{
+		// Timers beyond the range of the wheel are parked in the
+		// last level and placed again when cascaded.
+		expiry = _now + MAX_DELTA;
+		level = LEVELS - 1;
+	}
+	else
+	{
+		while (level < LEVELS - 1 && delta >= (UInt64(1) << (SLOT_BITS*(level + 1)))) ++level;
+	}
+	Int32 slot = level*SLOTS + static_cast<Int32>((expiry >> (SLOT_BITS*level)) & SLOT_MASK);
+
+	node.slot = slot;
+	node.prev = -1;
+	node.next = _slots[slot];
+	if (node.next >= 0) _nodes[node.next].prev = index;
+	_slots[slot] = index;
+}
+
+
+void TimerWheel::unlink(Int32 index)
+{
+	Node& node = _nodes[index];
+	if (node.prev >= 0)
+		_nodes[node.prev].next = node.next;
+	else
+		_slots[node.slot] = node.next;
+	if (node.next >= 0) _nodes[node.next].prev = node.prev;
+	node.slot = -1;
+}
+
+
+Int32 TimerWheel::allocate()
+{
+	Int32 index = _free;
+	if (index >= 0)
+	{
+		_free = _nodes[index].next;
+	}
+	else
+	{
+		if (_nodes.size() >= static_cast<std::size_t>(std::numeric_limits<Int32>::max()))
+			throw OutOfMemoryException("Too many timers");
+		index = static_cast<Int32>(_nodes.size());
+		_nodes.push_back(Node());
+		_nodes.back().generation = 1;
+	}
+	++_count;
+	return index;
+}
+
+
+void TimerWheel::release(Int32 index)
+{
+	Node& node = _nodes[index];
+	node.callback = Callback();
+	node.slot = -1;
+	if (++node.generation == 0) node.generation = 1;
+	node.next = _free;
+	_free = index;
+	--_count;
+}
+
+
+void TimerWheel::cascade(int level)
+{
+	Int32 slot = level*SLOTS + static_cast<Int32>((_now >> (SLOT_BITS*level)) & SLOT_MASK);
+	Int32 index = _slots[slot];
+	_slots[slot] = -1;
+	while (index >= 0)
+	{
+		Int32 next = _nodes[index].next;
+		link(index);
+		index = next;
+	}
+}
+
+
+void TimerWheel::advance(UInt64 target, Batch& batch)
+{
+	while (_now <= target)
+	{
+		if (_count == 0)
+		{
+			_now = target + 1;
+			break;
+		}
+
+		Int32 slot = static_cast<Int32>(_now & SLOT_MASK);
+		for (int level = 1; level < LEVELS && ((_now >> (SLOT_BITS*(level - 1))) & SLOT_MASK) == 0; ++level)
+		{
+			cascade(level);
+		}
+
+		Int32 index = _slots[slot];
+		_slots[slot] = -1;
+		while (index >= 0)
+		{
+			Node& node = _nodes[index];
+			Int32 next = node.next;
+			if (node.expiry > _now)
+			{
+				link(index);
+			}
+			else if (node.interval)
+			{
+				batch.push_back(node.callback);
+				node.expiry += node.interval;
+				if (node.expiry <= _now) node.expiry = _now + 1;
+				link(index);
+			}
+			else
+			{
+				batch.push_back(std::move(node.callback));
+				release(index);
+			}
+			index = next;
+		}
+		++_now;
+	}
+}
+
+
+UInt64 TimerWheel::nextTick() const
+{
+	// Find the next non-empty slot in the first level, but stop
+	// where the first level wraps around, as timers from the upper
+	// levels may be cascaded down there.
+	UInt64 tick = _now;
+	while ((tick & SLOT_MASK) != 0 && _slots[tick & SLOT_MASK] < 0) ++tick;
+	return tick;
+}
+
+
+long TimerWheel::millisecondsUntil(UInt64 tick) const
+{
+	Int64 elapsed = _start.elapsed();
+	Int64 due = static_cast<Int64>(tick*_tickMicroseconds);
+	if (due <= elapsed) return 0;
+	return static_cast<long>((due - elapsed + 999)/1000);
+}
+
+
+void TimerWheel::dispatch(Batch& batch)
+{
+	if (batch.empty()) return;
+
+	int threads = _pPool ? _pPool->available() : 0;
+	if (threads == 0)
+	{
+		invoke(batch);
+		return;
+	}
+
+	std::size_t chunks = std::min<std::size_t>(threads, (batch.size() + MIN_BATCH_SIZE - 1)/MIN_BATCH_SIZE);
+	std::size_t chunkSize = (batch.size() + chunks - 1)/chunks;
+	for (Batch::iterator it = batch.begin(); it != batch.end();)
+	{
+		Batch::iterator end = it + std::min<std::size_t>(chunkSize, batch.end() - it);
+		CallbackBatch* pBatch = new CallbackBatch(it, end);
+		try
+		{
+			_pPool->start(*pBatch);
+		}
+		catch (NoThreadAvailableException&)
+		{
+			pBatch->run();
+		}
+		it = end;
+	}
+}
+
+
+} // namespace Poco
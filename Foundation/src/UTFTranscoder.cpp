@@ -0,0 +1,782 @@
+//
+// UTFTranscoder.cpp
+//
+// Library: Foundation
+// Package: Text
+// Module:  UTFTranscoder
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/UTFTranscoder.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Exception.h"
+#include <cstring>
+#if defined(POCO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const std::size_t SCALAR_BLOCK = 32;
+		// Number of input characters converted one at a time
+		// before trying the block conversion of ASCII text again.
+
+
+	inline bool isContinuation(UInt8 c)
+	{
+		return (c & 0xC0) == 0x80;
+	}
+
+
+	bool isValidUTF8Scalar(const UInt8* p, std::size_t length)
+	{
+		std::size_t i = 0;
+		while (i < length)
+		{
+			UInt8 c = p[i];
+			if (c < 0x80)
+			{
+				++i;
+				continue;
+			}
+			std::size_t n;
+			if (c < 0xC2)
+				return false;
+			else if (c < 0xE0)
+				n = 1;
+			else if (c < 0xF0)
+				n = 2;
+			else if (c < 0xF5)
+				n = 3;
+			else
+				return false;
+			if (length - i <= n) return false;
+
+			UInt8 c1 = p[i + 1];
+			if (!isContinuation(c1)) return false;
+			if (c == 0xE0 && c1 < 0xA0) return false; // overlong
+			if (c == 0xED && c1 > 0x9F) return false; // surrogate
+			if (c == 0xF0 && c1 < 0x90) return false; // overlong
+			if (c == 0xF4 && c1 > 0x8F) return false; // above U+10FFFF
+			for (std::size_t k = 2; k <= n; ++k)
+			{
+				if (!isContinuation(p[i + k])) return false;
+			}
+			i += n + 1;
+		}
+		return true;
+	}
+
+
+	inline UInt32 decodeUTF8(const UInt8*& p)
+		/// Decodes the character at p, which must be valid UTF-8,
+		/// and advances p.
+	{
+		UInt32 c = *p++;
+		if (c < 0x80)
+		{
+			return c;
+		}
+		else if (c < 0xE0)
+		{
+			c = ((c & 0x1F) << 6) | (p[0] & 0x3F);
+			p += 1;
+		}
+		else if (c < 0xF0)
+		{
+			c = ((c & 0x0F) << 12) | ((p[0] & 0x3F) << 6) | (p[1] & 0x3F);
+			p += 2;
+		}
+		else
+		{
+			c = ((c & 0x07) << 18) | ((p[0] & 0x3F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+			p += 3;
+		}
+		return c;
+	}
+
+
+	inline void encodeUTF8(UInt32 c, char*& p)
+	{
+		if (c < 0x80)
+		{
+			*p++ = static_cast<char>(c);
+		}
+		else if (c < 0x800)
+		{
+			*p++ = static_cast<char>(0xC0 | (c >> 6));
+			*p++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000)
+		{
+			*p++ = static_cast<char>(0xE0 | (c >> 12));
+			*p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*p++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+		else
+		{
+			*p++ = static_cast<char>(0xF0 | (c >> 18));
+			*p++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+			*p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*p++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+	}
+
+
+#if defined(POCO_HAVE_X86_SIMD)
+
+
+	//
+	// UTF-8 validation follows J. Keiser and D. Lemire, "Validating UTF-8
+	// In Less Than One Instruction Per Byte" (2021). Three table lookups,
+	// indexed by the high and low nibble of each byte's predecessor and the
+	// high nibble of the byte itself, find every error visible in a pair of
+	// bytes. Missing or excess continuation bytes of three and four byte
+	// sequences are found by looking at the bytes two and three positions
+	// back. Blocks consisting of ASCII characters only are skipped.
+	//
+
+
+	enum UTF8Error
+	{
+		TOO_SHORT      = 1 << 0, // lead byte not followed by a continuation byte
+		TOO_LONG       = 1 << 1, // ASCII character followed by a continuation byte
+		OVERLONG_3     = 1 << 2, // E0 80..9F
+		TOO_LARGE      = 1 << 3, // F4 90..BF, or F5..FF
+		SURROGATE      = 1 << 4, // ED A0..BF
+		OVERLONG_2     = 1 << 5, // C0..C1
+		TOO_LARGE_1000 = 1 << 6, // F5..FF 80..8F
+		OVERLONG_4     = 1 << 6, // F0 80..8F
+		TWO_CONTS      = 1 << 7, // continuation byte following a continuation byte
+		CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS
+	};
+
+
+	const UInt8 BYTE1_HIGH[16] =
+		// indexed by the high nibble of the first byte
+	{
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+	};
+
+
+	const UInt8 BYTE1_LOW[16] =
+		// indexed by the low nibble of the first byte
+	{
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000
+	};
+
+
+	const UInt8 BYTE2_HIGH[16] =
+		// indexed by the high nibble of the second byte
+	{
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+	};
+
+
+	const UInt8 MAX_COMPLETE[32] =
+		// the largest byte values that do not start a sequence
+		// extending past the end of a block
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+	};
+
+
+	POCO_SIMD_TARGET("ssse3")
+	inline __m128i checkUTF8(__m128i input, __m128i prevInput)
+		/// Returns the errors in the 16 bytes of input,
+		/// given the 16 bytes preceding them.
+	{
+		const __m128i byte1HighTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE1_HIGH));
+		const __m128i byte1LowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE1_LOW));
+		const __m128i byte2HighTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE2_HIGH));
+		const __m128i lowNibble = _mm_set1_epi8(0x0F);
+
+		__m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+		__m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibble));
+		__m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibble));
+		__m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+		__m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+		__m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+		__m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+		__m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+		__m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+		__m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+		return _mm_xor_si128(must23, special);
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	bool isValidUTF8SSSE3(const UInt8* p, std::size_t length)
+	{
+		const __m128i maxValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(MAX_COMPLETE + 16));
+		__m128i error = _mm_setzero_si128();
+		__m128i prevInput = _mm_setzero_si128();
+		__m128i prevIncomplete = _mm_setzero_si128();
+		std::size_t i = 0;
+		for (;;)
+		{
+			// the last block is padded with zeros, which also
+			// reveals a sequence truncated at the end
+			__m128i input;
+			bool last = length - i < 16;
+			if (last)
+			{
+				UInt8 block[16] = {0};
+				std::memcpy(block, p + i, length - i);
+				input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+			}
+			else input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+
+			if (_mm_movemask_epi8(input) == 0)
+			{
+				error = _mm_or_si128(error, prevIncomplete);
+				prevIncomplete = _mm_setzero_si128();
+			}
+			else
+			{
+				error = _mm_or_si128(error, checkUTF8(input, prevInput));
+				prevIncomplete = _mm_subs_epu8(input, maxValue);
+			}
+			prevInput = input;
+			if (last) break;
+			i += 16;
+		}
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	inline __m256i checkUTF8(__m256i input, __m256i prevInput)
+		/// Returns the errors in the 32 bytes of input,
+		/// given the 32 bytes preceding them.
+	{
+		const __m256i byte1HighTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE1_HIGH)));
+		const __m256i byte1LowTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE1_LOW)));
+		const __m256i byte2HighTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE2_HIGH)));
+		const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+
+		// alignr works within 128-bit lanes; shifted holds the bytes preceding each lane
+		__m256i shifted = _mm256_permute2x128_si256(prevInput, input, 0x21);
+		__m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+		__m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble));
+		__m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, lowNibble));
+		__m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble));
+		__m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+		__m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+		__m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+		__m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+		__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+		__m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+		return _mm256_xor_si256(must23, special);
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	bool isValidUTF8AVX2(const UInt8* p, std::size_t length)
+	{
+		const __m256i maxValue = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(MAX_COMPLETE));
+		__m256i error = _mm256_setzero_si256();
+		__m256i prevInput = _mm256_setzero_si256();
+		__m256i prevIncomplete = _mm256_setzero_si256();
+		std::size_t i = 0;
+		for (;;)
+		{
+			__m256i input;
+			bool last = length - i < 32;
+			if (last)
+			{
+				UInt8 block[32] = {0};
+				std::memcpy(block, p + i, length - i);
+				input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+			}
+			else input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+
+			if (_mm256_movemask_epi8(input) == 0)
+			{
+				error = _mm256_or_si256(error, prevIncomplete);
+				prevIncomplete = _mm256_setzero_si256();
+			}
+			else
+			{
+				error = _mm256_or_si256(error, checkUTF8(input, prevInput));
+				prevIncomplete = _mm256_subs_epu8(input, maxValue);
+			}
+			prevInput = input;
+			if (last) break;
+			i += 32;
+		}
+		return _mm256_testz_si256(error, error) != 0;
+	}
+
+
+	//
+	// The conversion kernels convert blocks of ASCII characters
+	// and stop at the first block containing other characters.
+	// They return the number of characters converted.
+	//
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t copyASCIISSSE3(const UInt8* in, std::size_t length, char* out)
+	{
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			if (_mm_movemask_epi8(data) != 0) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), data);
+			done += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t copyASCIIAVX2(const UInt8* in, std::size_t length, char* out)
+	{
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			if (_mm256_movemask_epi8(data) != 0) break;
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done), data);
+			done += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t asciiToUTF16SSSE3(const UInt8* in, std::size_t length, UTF16Char* out)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			if (_mm_movemask_epi8(data) != 0) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_unpacklo_epi8(data, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 8), _mm_unpackhi_epi8(data, zero));
+			done += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t asciiToUTF16AVX2(const UInt8* in, std::size_t length, UTF16Char* out)
+	{
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			if (_mm256_movemask_epi8(data) != 0) break;
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(data)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(data, 1)));
+			done += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t asciiToUTF32SSSE3(const UInt8* in, std::size_t length, UTF32Char* out)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			if (_mm_movemask_epi8(data) != 0) break;
+			__m128i lo = _mm_unpacklo_epi8(data, zero);
+			__m128i hi = _mm_unpackhi_epi8(data, zero);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_unpacklo_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 4), _mm_unpackhi_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 8), _mm_unpacklo_epi16(hi, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 12), _mm_unpackhi_epi16(hi, zero));
+			done += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t asciiToUTF32AVX2(const UInt8* in, std::size_t length, UTF32Char* out)
+	{
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			if (_mm256_movemask_epi8(data) != 0) break;
+			for (int k = 0; k < 32; k += 8)
+			{
+				__m128i chars = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + done + k));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done + k), _mm256_cvtepu8_epi32(chars));
+			}
+			done += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t utf16ToASCIISSSE3(const UTF16Char* in, std::size_t length, char* out)
+	{
+		const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 8));
+			__m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_packus_epi16(a, b));
+			done += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t utf16ToASCIIAVX2(const UTF16Char* in, std::size_t length, char* out)
+	{
+		const __m256i mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done + 16));
+			if (!_mm256_testz_si256(_mm256_or_si256(a, b), mask)) break;
+			// packus works within 128-bit lanes; restore the order of the 64-bit quarters
+			__m256i chars = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done), chars);
+			done += 32;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t utf32ToASCIISSSE3(const UTF32Char* in, std::size_t length, char* out)
+	{
+		const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t done = 0;
+		while (length - done >= 16)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 4));
+			__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 8));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 12));
+			__m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), mask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF) break;
+			__m128i chars = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), chars);
+			done += 16;
+		}
+		return done;
+	}
+
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t utf32ToASCIIAVX2(const UTF32Char* in, std::size_t length, char* out)
+	{
+		const __m256i mask = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+		const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+		std::size_t done = 0;
+		while (length - done >= 32)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done + 8));
+			__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done + 16));
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done + 24));
+			if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), mask)) break;
+			// the packs work within 128-bit lanes; restore the order of the 32-bit groups
+			__m256i chars = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+			chars = _mm256_permutevar8x32_epi32(chars, order);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done), chars);
+			done += 32;
+		}
+		return done;
+	}
+
+
+#endif // POCO_HAVE_X86_SIMD
+
+
+	const bool useAVX2 = CPUFeatures::hasAVX2();
+	const bool useSSSE3 = CPUFeatures::hasSSSE3();
+
+
+	inline std::size_t copyASCII(const UInt8* in, std::size_t length, char* out)
+	{
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAVX2)
+			return copyASCIIAVX2(in, length, out);
+		else if (useSSSE3)
+			return copyASCIISSSE3(in, length, out);
+#endif
+		return 0;
+	}
+
+
+	inline std::size_t asciiToUTF16(const UInt8* in, std::size_t length, UTF16Char* out)
+	{
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAVX2)
+			return asciiToUTF16AVX2(in, length, out);
+		else if (useSSSE3)
+			return asciiToUTF16SSSE3(in, length, out);
+#endif
+		return 0;
+	}
+
+
+	inline std::size_t asciiToUTF32(const UInt8* in, std::size_t length, UTF32Char* out)
+	{
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAVX2)
+			return asciiToUTF32AVX2(in, length, out);
+		else if (useSSSE3)
+			return asciiToUTF32SSSE3(in, length, out);
+#endif
+		return 0;
+	}
+
+
+	inline std::size_t utf16ToASCII(const UTF16Char* in, std::size_t length, char* out)
+	{
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAVX2)
+			return utf16ToASCIIAVX2(in, length, out);
+		else if (useSSSE3)
+			return utf16ToASCIISSSE3(in, length, out);
+#endif
+		return 0;
+	}
+
+
+	inline std::size_t utf32ToASCII(const UTF32Char* in, std::size_t length, char* out)
+	{
+#if defined(POCO_HAVE_X86_SIMD)
+		if (useAVX2)
+			return utf32ToASCIIAVX2(in, length, out);
+		else if (useSSSE3)
+			return utf32ToASCIISSSE3(in, length, out);
+#endif
+		return 0;
+	}
+
+
+	template <typename T>
+	inline const T* blockEnd(const T* p, const T* end)
+	{
+		return static_cast<std::size_t>(end - p) > SCALAR_BLOCK ? p + SCALAR_BLOCK : end;
+	}
+}
+
+
+bool UTFTranscoder::isValidUTF8(const char* utf8, std::size_t length)
+{
+	const UInt8* p = reinterpret_cast<const UInt8*>(utf8);
+#if defined(POCO_HAVE_X86_SIMD)
+	if (useAVX2)
+		return isValidUTF8AVX2(p, length);
+	else if (useSSSE3)
+		return isValidUTF8SSSE3(p, length);
+#endif
+	return isValidUTF8Scalar(p, length);
+}
+
+
+std::size_t UTFTranscoder::utf8ToUTF16(const char* utf8, std::size_t length, UTF16Char* utf16)
+{
+	if (!isValidUTF8(utf8, length)) throw DataFormatException("Invalid UTF-8 sequence");
+
+	const UInt8* in = reinterpret_cast<const UInt8*>(utf8);
+	const UInt8* end = in + length;
+	UTF16Char* out = utf16;
+	while (in < end)
+	{
+		std::size_t n = asciiToUTF16(in, end - in, out);
+		in += n;
+		out += n;
+		const UInt8* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			UInt32 c = decodeUTF8(in);
+			if (c < 0x10000)
+			{
+				*out++ = static_cast<UTF16Char>(c);
+			}
+			else
+			{
+				c -= 0x10000;
+				*out++ = static_cast<UTF16Char>(0xD800 | (c >> 10));
+				*out++ = static_cast<UTF16Char>(0xDC00 | (c & 0x3FF));
+			}
+		}
+	}
+	return out - utf16;
+}
+
+
+std::size_t UTFTranscoder::utf8ToUTF32(const char* utf8, std::size_t length, UTF32Char* utf32)
+{
+	if (!isValidUTF8(utf8, length)) throw DataFormatException("Invalid UTF-8 sequence");
+
+	const UInt8* in = reinterpret_cast<const UInt8*>(utf8);
+	const UInt8* end = in + length;
+	UTF32Char* out = utf32;
+	while (in < end)
+	{
+		std::size_t n = asciiToUTF32(in, end - in, out);
+		in += n;
+		out += n;
+		const UInt8* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			*out++ = static_cast<UTF32Char>(decodeUTF8(in));
+		}
+	}
+	return out - utf32;
+}
+
+
+std::size_t UTFTranscoder::utf8ToLatin1(const char* utf8, std::size_t length, char* latin1)
+{
+	if (!isValidUTF8(utf8, length)) throw DataFormatException("Invalid UTF-8 sequence");
+
+	const UInt8* in = reinterpret_cast<const UInt8*>(utf8);
+	const UInt8* end = in + length;
+	char* out = latin1;
+	while (in < end)
+	{
+		std::size_t n = copyASCII(in, end - in, out);
+		in += n;
+		out += n;
+		const UInt8* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			UInt32 c = decodeUTF8(in);
+			if (c > 0xFF) throw DataFormatException("Character cannot be represented in Latin-1");
+			*out++ = static_cast<char>(c);
+		}
+	}
+	return out - latin1;
+}
+
+
+std::size_t UTFTranscoder::utf16ToUTF8(const UTF16Char* utf16, std::size_t length, char* utf8)
+{
+	const UTF16Char* in = utf16;
+	const UTF16Char* end = in + length;
+	char* out = utf8;
+	while (in < end)
+	{
+		std::size_t n = utf16ToASCII(in, end - in, out);
+		in += n;
+		out += n;
+		const UTF16Char* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			UInt32 c = *in++;
+			if (c >= 0xD800 && c < 0xE000)
+			{
+				if (c >= 0xDC00 || in == end || *in < 0xDC00 || *in >= 0xE000)
+					throw DataFormatException("Unpaired UTF-16 surrogate");
+				c = 0x10000 + ((c & 0x3FF) << 10) + (*in++ & 0x3FF);
+			}
+			encodeUTF8(c, out);
+		}
+	}
+	return out - utf8;
+}
+
+
+std::size_t UTFTranscoder::utf32ToUTF8(const UTF32Char* utf32, std::size_t length, char* utf8)
+{
+	const UTF32Char* in = utf32;
+	const UTF32Char* end = in + length;
+	char* out = utf8;
+	while (in < end)
+	{
+		std::size_t n = utf32ToASCII(in, end - in, out);
+		in += n;
+		out += n;
+		const UTF32Char* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			UInt32 c = *in++;
+			if (c > 0x10FFFF || (c >= 0xD800 && c < 0xE000))
+				throw DataFormatException("Invalid UTF-32 character");
+			encodeUTF8(c, out);
+		}
+	}
+	return out - utf8;
+}
+
+
+std::size_t UTFTranscoder::latin1ToUTF8(const char* latin1, std::size_t length, char* utf8)
+{
+	const UInt8* in = reinterpret_cast<const UInt8*>(latin1);
+	const UInt8* end = in + length;
+	char* out = utf8;
+	while (in < end)
+	{
+		std::size_t n = copyASCII(in, end - in, out);
+		in += n;
+		out += n;
+		const UInt8* stop = blockEnd(in, end);
+		while (in < stop)
+		{
+			encodeUTF8(*in++, out);
+		}
+	}
+	return out - utf8;
+}
+
+
+} // namespace Poco
@@ -18,6 +18,8 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/UTF16Encoding.h"
 #include "Poco/UTF32Encoding.h"
+#include "Poco/UTFTranscoder.h"
+#include "Poco/Exception.h"
 #include <cstring>
 
 
@@ -27,8 +29,33 @@
 namespace Poco {
 
 
+namespace
+{
+	template <typename S, typename F>
+	bool transcode(const char* utf8String, std::size_t length, S& result, F convert)
+		/// Converts the UTF-8 input with the given UTFTranscoder function.
+		/// Returns false if the input is not valid UTF-8, which is
+		/// then left to TextIterator to convert.
+	{
+		try
+		{
+			result.resize(length);
+			if (length > 0) result.resize(convert(utf8String, length, &result[0]));
+			return true;
+		}
+		catch (DataFormatException&)
+		{
+			result.clear();
+			return false;
+		}
+	}
+}
+
+
 void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
 {
+	if (transcode(utf8String.data(), utf8String.size(), utf32String, UTFTranscoder::utf8ToUTF32)) return;
+
 	utf32String.clear();
 	UTF8Encoding utf8Encoding;
 	TextIterator it(utf8String, utf8Encoding);
@@ -50,6 +77,7 @@ void UnicodeConverter::convert(const char* utf8String, std::size_t length, UTF32
 		return;
 	}
 
+	if (transcode(utf8String, length, utf32String, UTFTranscoder::utf8ToUTF32)) return;
 	convert(std::string(utf8String, utf8String + length), utf32String);
 }
 
@@ -68,6 +96,8 @@ void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
 
 void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
 {
+	if (transcode(utf8String.data(), utf8String.size(), utf16String, UTFTranscoder::utf8ToUTF16)) return;
+
 	utf16String.clear();
 	UTF8Encoding utf8Encoding;
 	TextIterator it(utf8String, utf8Encoding);
@@ -97,6 +127,7 @@ void UnicodeConverter::convert(const char* utf8String,  std::size_t length, UTF1
 		return;
 	}
 
+	if (transcode(utf8String, length, utf16String, UTFTranscoder::utf8ToUTF16)) return;
 	convert(std::string(utf8String, utf8String + length), utf16String);
 }
 
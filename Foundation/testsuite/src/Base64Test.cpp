@@ -13,10 +13,13 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Base64Encoder.h"
 #include "Poco/Base64Decoder.h"
+#include "Poco/Base64.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <algorithm>
 
 
+using Poco::Base64;
 using Poco::Base64Encoder;
 using Poco::Base64Decoder;
 using Poco::DataFormatException;
@@ -343,6 +346,163 @@ void Base64Test::testEncodeDecode()
 }
 
 
+void Base64Test::testBuffer()
+{
+	assertTrue (Base64::encode("") == "");
+	assertTrue (Base64::encode("f") == "Zg==");
+	assertTrue (Base64::encode("fo") == "Zm8=");
+	assertTrue (Base64::encode("foo") == "Zm9v");
+	assertTrue (Base64::encode("foob") == "Zm9vYg==");
+	assertTrue (Base64::encode("fooba") == "Zm9vYmE=");
+	assertTrue (Base64::encode("foobar") == "Zm9vYmFy");
+	assertTrue (Base64::encode("foob", Poco::BASE64_NO_PADDING) == "Zm9vYg");
+	assertTrue (Base64::encode("\xfb\xff\xbf", Poco::BASE64_URL_ENCODING) == "-_-_");
+	assertTrue (Base64::encode("\xfb\xff\xbf") == "+/+/");
+
+	assertTrue (Base64::decode("") == "");
+	assertTrue (Base64::decode("Zg==") == "f");
+	assertTrue (Base64::decode("Zm8=") == "fo");
+	assertTrue (Base64::decode("Zm9vYmFy") == "foobar");
+	assertTrue (Base64::decode("Zm9vYg", Poco::BASE64_NO_PADDING) == "foob");
+	assertTrue (Base64::decode("Zm9vYmE", Poco::BASE64_NO_PADDING) == "fooba");
+	assertTrue (Base64::decode("Zm9vYmE=", Poco::BASE64_NO_PADDING) == "fooba");
+	assertTrue (Base64::decode("-_-_", Poco::BASE64_URL_ENCODING) == "\xfb\xff\xbf");
+
+	std::string data;
+	for (int i = 0; i < 1000; ++i) data += char((i*7919) >> 3);
+
+	// compare with the encoder stream, writing one character at a time
+	for (std::size_t length = 0; length <= data.size(); length += (length < 100 ? 1 : 97))
+	{
+		for (int options = 0; options < 4; ++options)
+		{
+			std::ostringstream ostr;
+			Base64Encoder encoder(ostr, options);
+			encoder.rdbuf()->setLineLength(0);
+			for (std::size_t i = 0; i < length; ++i) encoder.put(data[i]);
+			encoder.close();
+
+			std::string encoded = Base64::encode(data.substr(0, length), options);
+			assertTrue (encoded == ostr.str());
+			assertTrue (encoded.size() == Base64::encodedLength(length, options));
+			assertTrue (Base64::decode(encoded, options) == data.substr(0, length));
+		}
+	}
+
+	// invalid characters must be detected anywhere in the input
+	std::string encoded = Base64::encode(data.substr(0, 300));
+	for (std::size_t i = 0; i < encoded.size(); i += 7)
+	{
+		std::string invalid(encoded);
+		invalid[i] = (i % 2) ? '#' : '\x80';
+		try
+		{
+			Base64::decode(invalid);
+			fail("invalid character - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+	try
+	{
+		Base64::decode("Zm9vYg");
+		fail("missing padding - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		Base64::decode("Zm9vY", Poco::BASE64_NO_PADDING);
+		fail("truncated - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base64Test::testBlocks()
+{
+	std::string data;
+	for (int i = 0; i < 20000; ++i) data += char((i*7919) >> 5);
+
+	int lineLengths[] = {72, 10, 0};
+	for (int k = 0; k < 3; ++k)
+	{
+		std::ostringstream charStr;
+		Base64Encoder charEncoder(charStr);
+		charEncoder.rdbuf()->setLineLength(lineLengths[k]);
+		for (std::size_t i = 0; i < data.size(); ++i) charEncoder.put(data[i]);
+		charEncoder.close();
+
+		// odd block sizes, so that blocks begin and end within groups and lines
+		std::ostringstream blockStr;
+		Base64Encoder blockEncoder(blockStr);
+		blockEncoder.rdbuf()->setLineLength(lineLengths[k]);
+		std::size_t pos = 0;
+		std::size_t blockSize = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(blockSize, data.size() - pos);
+			blockEncoder.write(data.data() + pos, n);
+			pos += n;
+			blockSize = blockSize*3 + 1;
+			if (blockSize > 10000) blockSize = 2;
+		}
+		blockEncoder.close();
+		assertTrue (blockStr.str() == charStr.str());
+
+		std::istringstream istr(charStr.str());
+		Base64Decoder decoder(istr);
+		std::string decoded;
+		char buffer[1000];
+		blockSize = 1;
+		while (decoder.read(buffer, blockSize) || decoder.gcount() > 0)
+		{
+			decoded.append(buffer, static_cast<std::size_t>(decoder.gcount()));
+			blockSize = blockSize*3 + 1;
+			if (blockSize > sizeof(buffer)) blockSize = 2;
+		}
+		assertTrue (decoded == data);
+	}
+
+	{
+		// a block read must not consume more input than it needs
+		std::istringstream istr("QUJD REVG\r\nR0hJ!");
+		Base64Decoder decoder(istr);
+		char buffer[9];
+		decoder.read(buffer, 9);
+		assertTrue (decoder.gcount() == 9);
+		assertTrue (std::string(buffer, 9) == "ABCDEFGHI");
+		assertTrue (istr.get() == '!');
+	}
+	{
+		std::istringstream istr("QUJDREVGR0hJ\nSktM\nTU5P\nUA==\nUVJT");
+		Base64Decoder decoder(istr);
+		char buffer[32];
+		decoder.read(buffer, sizeof(buffer));
+		assertTrue (decoder.gcount() == 19);
+		assertTrue (std::string(buffer, 19) == "ABCDEFGHIJKLMNOPQRS");
+		assertTrue (decoder.eof());
+	}
+	{
+		std::istringstream istr("QUJDREVGR0hJSktMTU5PUFFSU1RV#ldYWVo=");
+		Base64Decoder decoder(istr);
+		char buffer[32];
+		try
+		{
+			decoder.read(buffer, sizeof(buffer));
+			assertTrue (decoder.bad());
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+}
+
+
 void Base64Test::setUp()
 {
 }
@@ -364,6 +524,8 @@ CppUnit::Test* Base64Test::suite()
 	CppUnit_addTest(pSuite, Base64Test, testDecoderURL);
 	CppUnit_addTest(pSuite, Base64Test, testDecoderNoPadding);
 	CppUnit_addTest(pSuite, Base64Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base64Test, testBuffer);
+	CppUnit_addTest(pSuite, Base64Test, testBlocks);
 
 	return pSuite;
 }
@@ -31,6 +31,8 @@ public:
 	void testDecoderURL();
 	void testDecoderNoPadding();
 	void testEncodeDecode();
+	void testBuffer();
+	void testBlocks();
 
 	void setUp();
 	void tearDown();
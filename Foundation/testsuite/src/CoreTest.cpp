@@ -30,6 +30,7 @@
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 #include <cstring>
 
 
@@ -652,6 +653,93 @@ void CoreTest::testChecksum64()
 }
 
 
+void CoreTest::testChecksum32()
+{
+	Poco::Checksum crc32(Checksum::TYPE_CRC32);
+	crc32.update("123456789");
+	assertTrue (crc32.checksum() == 0xCBF43926);
+
+	Poco::Checksum adler32(Checksum::TYPE_ADLER32);
+	adler32.update("Wikipedia");
+	assertTrue (adler32.checksum() == 0x11E60398);
+
+	// Large buffers are processed by the SIMD implementations (if available),
+	// single bytes always by the portable ones; the results must match.
+	std::vector<char> data(100000);
+	Poco::UInt32 x = 12345;
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		x = x*1103515245 + 12345;
+		data[i] = static_cast<char>(x >> 16);
+	}
+	// all bytes 0xFF at the end to test the deferred modulo in Adler-32
+	std::fill(data.end() - 20000, data.end(), static_cast<char>(0xFF));
+
+	const unsigned lengths[] = {0, 1, 31, 32, 33, 63, 64, 65, 127, 1000, 5552, 5553, 65536, 99000};
+	for (std::size_t l = 0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+	{
+		for (unsigned offset = 0; offset < 3; ++offset)
+		{
+			const char* p = &data[0] + offset + (lengths[l] > 1000 ? data.size() - lengths[l] - 3 : 0);
+			Poco::Checksum crcBulk(Checksum::TYPE_CRC32);
+			Poco::Checksum crcBytes(Checksum::TYPE_CRC32);
+			Poco::Checksum adlerBulk(Checksum::TYPE_ADLER32);
+			Poco::Checksum adlerBytes(Checksum::TYPE_ADLER32);
+			crcBulk.update("abc", 3);
+			crcBytes.update("abc", 3);
+			adlerBulk.update("abc", 3);
+			adlerBytes.update("abc", 3);
+			crcBulk.update(p, lengths[l]);
+			adlerBulk.update(p, lengths[l]);
+			for (unsigned i = 0; i < lengths[l]; ++i)
+			{
+				crcBytes.update(p[i]);
+				adlerBytes.update(p[i]);
+			}
+			assertTrue (crcBulk.checksum() == crcBytes.checksum());
+			assertTrue (adlerBulk.checksum() == adlerBytes.checksum());
+		}
+	}
+}
+
+
+void CoreTest::testChecksum32C()
+{
+	Poco::Checksum crc32c(Checksum::TYPE_CRC32C);
+	assertTrue (crc32c.type() == Checksum::TYPE_CRC32C);
+	assertTrue (crc32c.checksum() == 0);
+	crc32c.update("123456789");
+	assertTrue (crc32c.checksum() == 0xE3069283);
+
+	// test vectors from RFC 3720, B.4
+	char data[32];
+	std::memset(data, 0, sizeof(data));
+	Poco::Checksum zeros(Checksum::TYPE_CRC32C);
+	zeros.update(data, sizeof(data));
+	assertTrue (zeros.checksum() == 0x8A9136AA);
+
+	std::memset(data, 0xFF, sizeof(data));
+	Poco::Checksum ones(Checksum::TYPE_CRC32C);
+	ones.update(data, sizeof(data));
+	assertTrue (ones.checksum() == 0x62A8AB43);
+
+	for (int i = 0; i < 32; ++i) data[i] = static_cast<char>(i);
+	Poco::Checksum incrementing(Checksum::TYPE_CRC32C);
+	incrementing.update(data, sizeof(data));
+	assertTrue (incrementing.checksum() == 0x46DD794E);
+
+	Poco::Checksum incremental(Checksum::TYPE_CRC32C);
+	incremental.update(data, 5);
+	incremental.update(data + 5, 27);
+	assertTrue (incremental.checksum() == 0x46DD794E);
+
+	for (int i = 0; i < 32; ++i) data[i] = static_cast<char>(31 - i);
+	Poco::Checksum decrementing(Checksum::TYPE_CRC32C);
+	decrementing.update(data, sizeof(data));
+	assertTrue (decrementing.checksum() == 0x113FDB5C);
+}
+
+
 void CoreTest::testMakeUnique()
 {
 	assertTrue (*makeUnique<int>() == 0);
@@ -694,6 +782,8 @@ CppUnit::Test* CoreTest::suite()
 	CppUnit_addTest(pSuite, CoreTest, testAtomicFlag);
 	CppUnit_addTest(pSuite, CoreTest, testNullable);
 	CppUnit_addTest(pSuite, CoreTest, testAscii);
+	CppUnit_addTest(pSuite, CoreTest, testChecksum32);
+	CppUnit_addTest(pSuite, CoreTest, testChecksum32C);
 	CppUnit_addTest(pSuite, CoreTest, testChecksum64);
 	CppUnit_addTest(pSuite, CoreTest, testMakeUnique);
 
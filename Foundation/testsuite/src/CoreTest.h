@@ -34,6 +34,8 @@ public:
 	void testAtomicFlag();
 	void testNullable();
 	void testAscii();
+	void testChecksum32();
+	void testChecksum32C();
 	void testChecksum64();
 	void testMakeUnique();
 
@@ -17,6 +17,7 @@
 #include "ByteOrderTest.h"
 #include "StringTest.h"
 #include "StringTokenizerTest.h"
+#include "StringRefTest.h"
 #ifndef POCO_VXWORKS
 #include "FPETest.h"
 #endif
@@ -51,6 +52,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(ByteOrderTest::suite());
 	pSuite->addTest(StringTest::suite());
 	pSuite->addTest(StringTokenizerTest::suite());
+	pSuite->addTest(StringRefTest::suite());
 #ifndef POCO_VXWORKS
 	pSuite->addTest(FPETest::suite());
 #endif
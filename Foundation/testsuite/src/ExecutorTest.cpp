@@ -0,0 +1,248 @@
+//
+// ExecutorTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ExecutorTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Executor.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/Event.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+using Poco::Executor;
+using Poco::ExecutorStarter;
+using Poco::Future;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::Event;
+using Poco::AtomicCounter;
+
+
+namespace
+{
+	long fibonacci(Executor& executor, int n)
+	{
+		if (n < 2) return n;
+		if (n < 10) return fibonacci(executor, n - 1) + fibonacci(executor, n - 2);
+
+		Future<long> f = executor.submit([&executor, n]() { return fibonacci(executor, n - 1); });
+		long r = fibonacci(executor, n - 2);
+		return r + f.get();
+	}
+
+	class ActiveObject
+	{
+	public:
+		ActiveObject():
+			square(this, &ActiveObject::squareImpl)
+		{
+		}
+
+		ActiveMethod<int, int, ActiveObject, ExecutorStarter<ActiveObject> > square;
+
+	protected:
+		int squareImpl(const int& n)
+		{
+			if (n < 0) throw Poco::InvalidArgumentException("negative");
+			return n*n;
+		}
+	};
+}
+
+
+ExecutorTest::ExecutorTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ExecutorTest::~ExecutorTest()
+{
+}
+
+
+void ExecutorTest::testSubmit()
+{
+	Executor executor("test", 4);
+	assertTrue (executor.threads() == 4);
+	assertTrue (executor.name() == "test");
+
+	std::vector<Future<int> > results;
+	for (int i = 0; i < 1000; i++)
+	{
+		results.push_back(executor.submit([i]() { return i*2; }));
+	}
+	for (int i = 0; i < 1000; i++)
+	{
+		assertTrue (results[i].get() == i*2);
+	}
+
+	AtomicCounter count;
+	Future<void> f = executor.submit([&count]() { ++count; });
+	f.get();
+	assertTrue (f.ready());
+	assertTrue (count.value() == 1);
+}
+
+
+void ExecutorTest::testException()
+{
+	Executor executor(2);
+	Future<int> f = executor.submit([]() -> int { throw Poco::InvalidArgumentException("test"); });
+	try
+	{
+		f.get();
+		fail("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	Future<int> g = f.then([](int n) { return n + 1; });
+	try
+	{
+		g.get();
+		fail("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ExecutorTest::testThen()
+{
+	Executor executor(2);
+	Event event;
+	Future<int> f = executor.submit([&event]()
+		{
+			event.wait();
+			return 20;
+		});
+	Future<std::string> g = f
+		.then([](int n) { return n + 1; })
+		.then([](int n) { return std::to_string(n*2); });
+	assertTrue (!g.tryWait(10));
+	event.set();
+	assertTrue (g.get() == "42");
+
+	// continuation attached after completion
+	Future<void> h = f.then([](int) {});
+	h.wait();
+	assertTrue (h.ready());
+}
+
+
+void ExecutorTest::testNested()
+{
+	Executor executor(2);
+	Future<long> f = executor.submit([&executor]() { return fibonacci(executor, 25); });
+	assertTrue (f.get() == 75025);
+}
+
+
+void ExecutorTest::testBounded()
+{
+	Executor executor("bounded", 1, 2);
+	assertTrue (executor.queueCapacity() == 2);
+
+	Event started;
+	Event release;
+	AtomicCounter count;
+	executor.execute([&]()
+		{
+			started.set();
+			release.wait();
+			++count;
+		});
+	started.wait();
+	assertTrue (executor.tryExecute([&count]() { ++count; }));
+	assertTrue (executor.tryExecute([&count]() { ++count; }));
+	assertTrue (!executor.tryExecute([&count]() { ++count; }));
+	assertTrue (executor.pending() == 2);
+	release.set();
+	executor.execute([&count]() { ++count; });
+	executor.shutdown();
+	assertTrue (count.value() == 4);
+}
+
+
+void ExecutorTest::testShutdown()
+{
+	Executor executor(2);
+	AtomicCounter count;
+	for (int i = 0; i < 100; i++)
+	{
+		executor.execute([&count]() { ++count; });
+	}
+	executor.shutdown();
+	assertTrue (count.value() == 100);
+	try
+	{
+		executor.execute([&count]() { ++count; });
+		fail("shut down - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void ExecutorTest::testThenAfterShutdown()
+{
+	Executor executor(1);
+	Future<int> future = executor.submit([]() { return 6; });
+	future.wait();
+	executor.shutdown();
+	Future<int> next = future.then([](int n) { return n*7; });
+	assertTrue (next.get() == 42);
+}
+
+
+void ExecutorTest::testActiveMethod()
+{
+	ActiveObject obj;
+	ActiveResult<int> result = obj.square(7);
+	result.wait();
+	assertTrue (result.data() == 49);
+
+	result = obj.square(-1);
+	result.wait();
+	assertTrue (result.failed());
+}
+
+
+void ExecutorTest::setUp()
+{
+}
+
+
+void ExecutorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ExecutorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ExecutorTest");
+
+	CppUnit_addTest(pSuite, ExecutorTest, testSubmit);
+	CppUnit_addTest(pSuite, ExecutorTest, testException);
+	CppUnit_addTest(pSuite, ExecutorTest, testThen);
+	CppUnit_addTest(pSuite, ExecutorTest, testNested);
+	CppUnit_addTest(pSuite, ExecutorTest, testBounded);
+	CppUnit_addTest(pSuite, ExecutorTest, testShutdown);
+	CppUnit_addTest(pSuite, ExecutorTest, testThenAfterShutdown);
+	CppUnit_addTest(pSuite, ExecutorTest, testActiveMethod);
+
+	return pSuite;
+}
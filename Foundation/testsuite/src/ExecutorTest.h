@@ -0,0 +1,43 @@
+//
+// ExecutorTest.h
+//
+// Definition of the ExecutorTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ExecutorTest_INCLUDED
+#define ExecutorTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ExecutorTest: public CppUnit::TestCase
+{
+public:
+	ExecutorTest(const std::string& name);
+	~ExecutorTest();
+
+	void testSubmit();
+	void testException();
+	void testThen();
+	void testNested();
+	void testBounded();
+	void testShutdown();
+	void testThenAfterShutdown();
+	void testActiveMethod();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ExecutorTest_INCLUDED
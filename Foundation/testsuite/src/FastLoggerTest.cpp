@@ -0,0 +1,282 @@
+//
+// FastLoggerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FastLoggerTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/FastLogger.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NumberParser.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include "TestChannel.h"
+#include <map>
+
+
+using Poco::FastLogger;
+using Poco::Message;
+using Poco::Thread;
+using Poco::AutoPtr;
+
+
+namespace
+{
+	class LogRunnable: public Poco::Runnable
+	{
+	public:
+		LogRunnable(FastLogger& logger, int id, int count):
+			_logger(logger),
+			_id(id),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				poco_fast_information(_logger, "%d %d", _id, i);
+			}
+		}
+
+	private:
+		FastLogger& _logger;
+		int _id;
+		int _count;
+	};
+
+	class FailingChannel: public TestChannel
+	{
+	public:
+		void log(const Message& msg)
+		{
+			if (msg.getText() == "fail") throw Poco::IOException("channel failure");
+			TestChannel::log(msg);
+		}
+	};
+
+	class CountingErrorHandler: public Poco::ErrorHandler
+	{
+	public:
+		CountingErrorHandler(): _count(0)
+		{
+		}
+
+		void exception(const Poco::Exception&)
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		int _count;
+	};
+}
+
+
+FastLoggerTest::FastLoggerTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+FastLoggerTest::~FastLoggerTest()
+{
+}
+
+
+void FastLoggerTest::testFormat()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	FastLogger logger("fast", pChannel, Message::PRIO_TRACE);
+
+	std::string str("string");
+	const char* cstr = "cstring";
+	poco_fast_information(logger, "no arguments");
+	poco_fast_warning(logger, "%d %u %ld %lu %b", -1, 2U, -3L, 4UL, true);
+	poco_fast_error(logger, "%s %s %s %c", str, cstr, "literal", 'x');
+	poco_fast_critical(logger, "%.2f %.1hf %?d %?d", 1.5, 2.5f, (short) -7, (unsigned char) 200);
+	poco_fast_log(logger, Message::PRIO_NOTICE, "%[1]s %[0]d", 42, str);
+	logger.flush();
+
+	assertTrue (pChannel->list().size() == 5);
+	TestChannel::MsgList::const_iterator it = pChannel->list().begin();
+	assertTrue (it->getText() == "no arguments");
+	assertTrue (it->getPriority() == Message::PRIO_INFORMATION);
+	assertTrue (it->getSource() == "fast");
+	assertTrue (it->getSourceFile() != 0);
+	assertTrue (it->getSourceLine() > 0);
+	++it;
+	assertTrue (it->getText() == "-1 2 -3 4 1");
+	assertTrue (it->getPriority() == Message::PRIO_WARNING);
+	++it;
+	assertTrue (it->getText() == "string cstring literal x");
+	assertTrue (it->getPriority() == Message::PRIO_ERROR);
+	++it;
+	assertTrue (it->getText() == "1.50 2.5 -7 200");
+	++it;
+	assertTrue (it->getText() == "string 42");
+	assertTrue (it->getPriority() == Message::PRIO_NOTICE);
+	assertTrue (logger.dropped() == 0);
+}
+
+
+void FastLoggerTest::testLevel()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	FastLogger logger("fast", pChannel, Message::PRIO_WARNING);
+
+	poco_fast_information(logger, "information");
+	poco_fast_warning(logger, "warning");
+	logger.flush();
+	assertTrue (pChannel->list().size() == 1);
+	assertTrue (pChannel->list().front().getText() == "warning");
+
+	logger.setLevel(Message::PRIO_INFORMATION);
+	assertTrue (logger.is(Message::PRIO_INFORMATION));
+	assertTrue (!logger.is(Message::PRIO_DEBUG));
+	poco_fast_information(logger, "information");
+	logger.flush();
+	assertTrue (pChannel->list().size() == 2);
+	assertTrue (pChannel->list().back().getText() == "information");
+}
+
+
+void FastLoggerTest::testThreads()
+{
+	const int THREADS = 4;
+	const int COUNT = 5000;
+
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	FastLogger logger("fast", pChannel, Message::PRIO_INFORMATION, 4096);
+
+	Thread threads[THREADS];
+	std::vector<LogRunnable*> runnables;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		runnables.push_back(new LogRunnable(logger, i, COUNT));
+		threads[i].start(*runnables.back());
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].join();
+		delete runnables[i];
+	}
+	logger.flush();
+
+	assertTrue (logger.dropped() == 0);
+	assertTrue (pChannel->list().size() == THREADS*COUNT);
+
+	// the messages of each thread arrive in order
+	std::map<int, int> next;
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it)
+	{
+		std::string::size_type pos = it->getText().find(' ');
+		int id = Poco::NumberParser::parse(it->getText().substr(0, pos));
+		int n = Poco::NumberParser::parse(it->getText().substr(pos + 1));
+		assertTrue (next[id] == n);
+		next[id] = n + 1;
+	}
+}
+
+
+void FastLoggerTest::testOversized()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	FastLogger logger("fast", pChannel, Message::PRIO_INFORMATION, 4096);
+
+	std::string big(8192, 'x');
+	poco_fast_information(logger, "%s", big);
+	poco_fast_information(logger, "small");
+	logger.flush();
+
+	assertTrue (logger.dropped() == 1);
+	assertTrue (pChannel->list().size() == 1);
+	assertTrue (pChannel->list().front().getText() == "small");
+}
+
+
+void FastLoggerTest::testDestroy()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	{
+		FastLogger logger("fast", pChannel);
+		for (int i = 0; i < 100; ++i)
+		{
+			poco_fast_information(logger, "message %d", i);
+		}
+	}
+	assertTrue (pChannel->list().size() == 100);
+	assertTrue (pChannel->list().back().getText() == "message 99");
+
+	// a new logger in the same thread gets a new ring buffer
+	FastLogger logger("fast", pChannel);
+	poco_fast_information(logger, "again");
+	logger.flush();
+	assertTrue (pChannel->list().size() == 101);
+	assertTrue (pChannel->list().back().getText() == "again");
+}
+
+
+void FastLoggerTest::testChannelError()
+{
+	AutoPtr<FailingChannel> pChannel = new FailingChannel;
+	CountingErrorHandler eh;
+	Poco::ErrorHandler* pOldEH = Poco::ErrorHandler::set(&eh);
+	try
+	{
+		FastLogger logger("fast", pChannel);
+		poco_fast_information(logger, "before");
+		poco_fast_information(logger, "fail");
+		poco_fast_information(logger, "after");
+		logger.flush();
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::set(pOldEH);
+		throw;
+	}
+	Poco::ErrorHandler::set(pOldEH);
+
+	assertTrue (eh.count() == 1);
+	assertTrue (pChannel->list().size() == 2);
+	assertTrue (pChannel->list().front().getText() == "before");
+	assertTrue (pChannel->list().back().getText() == "after");
+}
+
+
+void FastLoggerTest::setUp()
+{
+}
+
+
+void FastLoggerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FastLoggerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FastLoggerTest");
+
+	CppUnit_addTest(pSuite, FastLoggerTest, testFormat);
+	CppUnit_addTest(pSuite, FastLoggerTest, testLevel);
+	CppUnit_addTest(pSuite, FastLoggerTest, testThreads);
+	CppUnit_addTest(pSuite, FastLoggerTest, testOversized);
+	CppUnit_addTest(pSuite, FastLoggerTest, testDestroy);
+	CppUnit_addTest(pSuite, FastLoggerTest, testChannelError);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// FastLoggerTest.h
+//
+// Definition of the FastLoggerTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FastLoggerTest_INCLUDED
+#define FastLoggerTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class FastLoggerTest: public CppUnit::TestCase
+{
+public:
+	FastLoggerTest(const std::string& name);
+	~FastLoggerTest();
+
+	void testFormat();
+	void testLevel();
+	void testThreads();
+	void testOversized();
+	void testDestroy();
+	void testChannelError();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // FastLoggerTest_INCLUDED
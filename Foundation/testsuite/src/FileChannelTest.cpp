@@ -25,7 +25,12 @@
 #include "Poco/DateTimeFormat.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
+#include "Poco/FileStream.h"
+#include "Poco/InflatingStream.h"
+#include "Poco/NumberParser.h"
 #include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include <atomic>
 #include <vector>
 
 
@@ -46,6 +51,46 @@ using Poco::DirectoryIterator;
 using Poco::InvalidArgumentException;
 
 
+namespace
+{
+	class CountingErrorHandler: public Poco::ErrorHandler
+	{
+	public:
+		CountingErrorHandler(): _count(0)
+		{
+		}
+
+		void exception(const Poco::Exception&)
+		{
+			++_count;
+		}
+
+		void exception(const std::exception&)
+		{
+			++_count;
+		}
+
+		void exception()
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		std::atomic<int> _count;
+	};
+
+	int entryNumber(const std::string& line)
+	{
+		return Poco::NumberParser::parse(line.substr(line.size() - 5));
+	}
+}
+
+
 FileChannelTest::FileChannelTest(const std::string& rName): CppUnit::TestCase(rName)
 {
 }
@@ -343,6 +388,275 @@ void FileChannelTest::testCompress()
 }
 
 
+void FileChannelTest::testCompressRotations()
+{
+	std::string name = filename();
+	try
+	{
+		{
+			AutoPtr<FileChannel> pChannel = new FileChannel(name);
+			pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+			pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+			pChannel->setProperty(FileChannel::PROP_COMPRESS, "true");
+			pChannel->open();
+			for (int i = 0; i < 400; ++i)
+			{
+				Message msg("source", "This is log file entry " + NumberFormatter::format0(i, 5), Message::PRIO_INFORMATION);
+				pChannel->log(msg);
+			}
+			// destroying the channel waits for all archiving jobs
+		}
+
+		// every rotation must have produced an archive, numbered
+		// from the most recent one, without temporary files left
+		int count = 0;
+		int last = 400;
+		while (File(name + "." + NumberFormatter::format(count) + ".gz").exists())
+		{
+			assertTrue (!File(name + "." + NumberFormatter::format(count)).exists());
+			Poco::FileInputStream istr(name + "." + NumberFormatter::format(count) + ".gz");
+			Poco::InflatingInputStream inflater(istr, Poco::InflatingStreamBuf::STREAM_GZIP);
+			std::string line;
+			int first = -1;
+			while (std::getline(inflater, line))
+			{
+				int i = entryNumber(line);
+				if (first < 0) first = i;
+			}
+			assertTrue (first >= 0 && first < last);
+			last = first;
+			++count;
+		}
+		assertTrue (count >= 10);
+		assertTrue (last == 0);
+
+		DirectoryIterator it(Path::current());
+		DirectoryIterator end;
+		for (; it != end; ++it)
+		{
+			assertTrue (it.name().find(name + ".~") != 0);
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testCompressPurge()
+{
+	std::string name = filename();
+	CountingErrorHandler errorHandler;
+	Poco::ErrorHandler* pOldErrorHandler = Poco::ErrorHandler::set(&errorHandler);
+	try
+	{
+		{
+			AutoPtr<FileChannel> pChannel = new FileChannel(name);
+			pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+			pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+			pChannel->setProperty(FileChannel::PROP_COMPRESS, "true");
+			pChannel->setProperty(FileChannel::PROP_PURGECOUNT, "3");
+			pChannel->open();
+			for (int i = 0; i < 2000; ++i)
+			{
+				Message msg("source", "This is log file entry " + NumberFormatter::format0(i, 5), Message::PRIO_INFORMATION);
+				pChannel->log(msg);
+			}
+		}
+		Poco::ErrorHandler::set(pOldErrorHandler);
+		assertTrue (errorHandler.count() == 0);
+
+		// purging must neither remove pending archives nor count
+		// them, so the kept archives and the log file are contiguous
+		Poco::FileInputStream logStream(name);
+		std::string line;
+		std::getline(logStream, line);
+		int next = entryNumber(line);
+		for (int n = 0; n < 3; ++n)
+		{
+			std::string archive = name + "." + NumberFormatter::format(n) + ".gz";
+			assertTrue (File(archive).exists());
+			Poco::FileInputStream istr(archive);
+			Poco::InflatingInputStream inflater(istr, Poco::InflatingStreamBuf::STREAM_GZIP);
+			int first = -1;
+			int last = -1;
+			while (std::getline(inflater, line))
+			{
+				last = entryNumber(line);
+				if (first < 0) first = last;
+			}
+			assertTrue (last + 1 == next);
+			next = first;
+		}
+		assertTrue (!File(name + ".3.gz").exists());
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::set(pOldErrorHandler);
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testCompressParallel()
+{
+	std::string name = filename();
+	try
+	{
+		{
+			AutoPtr<FileChannel> pChannel = new FileChannel(name);
+			pChannel->setProperty(FileChannel::PROP_ROTATION, "1 M");
+			pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+			pChannel->setProperty(FileChannel::PROP_COMPRESS, "true");
+			pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "1");
+			pChannel->setProperty(FileChannel::PROP_PURGECOUNT, "1");
+			assertTrue (pChannel->getProperty(FileChannel::PROP_COMPRESSIONLEVEL) == "1");
+			pChannel->open();
+			for (int i = 0; i < 90000; ++i)
+			{
+				Message msg("source", "This is log file entry " + NumberFormatter::format0(i, 5), Message::PRIO_INFORMATION);
+				pChannel->log(msg);
+			}
+			// destroying the channel waits for compression and purging
+		}
+		File f0(name + ".0.gz");
+		assertTrue (f0.exists());
+		File f1(name + ".1.gz");
+		assertTrue (!f1.exists());
+
+		// the archive is a single gzip stream spanning several blocks
+		Poco::FileInputStream istr(name + ".0.gz");
+		Poco::InflatingInputStream inflater(istr, Poco::InflatingStreamBuf::STREAM_GZIP);
+		std::string line;
+		int n = 0;
+		int first = -1;
+		while (std::getline(inflater, line))
+		{
+			int i = Poco::NumberParser::parse(line.substr(line.size() - 5));
+			if (first < 0) first = i;
+			assertTrue (i == first + n);
+			++n;
+		}
+		assertTrue (n*30 >= 1024*1024);
+		assertTrue (first + n < 90000);
+
+		try
+		{
+			AutoPtr<FileChannel> pChannel = new FileChannel(name);
+			pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "10");
+			fail("must fail");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testBuffered()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 K");
+		pChannel->setProperty(FileChannel::PROP_FLUSHPRIORITY, "error");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_BUFFERSIZE) == "1 K");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_FLUSHPRIORITY) == "error");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assertTrue (pChannel->size() == 250);
+		File f(name);
+		assertTrue (f.getSize() == 0);
+
+		msg.setPriority(Message::PRIO_ERROR);
+		pChannel->log(msg);
+		assertTrue (f.getSize() == 275);
+
+		msg.setPriority(Message::PRIO_INFORMATION);
+		for (int i = 0; i < 50; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assertTrue (f.getSize() >= 275 + 1000);
+		assertTrue (pChannel->size() == 275 + 50*25);
+		pChannel->close();
+		assertTrue (f.getSize() == 275 + 50*25);
+
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 X");
+			fail("must fail");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testFlushInterval()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 M");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "100");
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+		File f(name);
+		assertTrue (f.getSize() == 0);
+		Thread::sleep(1000);
+		assertTrue (f.getSize() == 25);
+
+		// rotation takes the buffered messages into account
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f0(name + ".0");
+		assertTrue (f0.exists());
+		assertTrue (f0.getSize() == 41*25);
+		File f1(name + ".1");
+		assertTrue (f1.exists());
+		pChannel->close();
+		assertTrue (f.getSize() == 19*25);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::purgeAge(const std::string& pa)
 {
 	std::string name = filename();
@@ -644,6 +958,11 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testRotateAtTimeMinLocal);
 	CppUnit_addTest(pSuite, FileChannelTest, testArchive);
 	CppUnit_addTest(pSuite, FileChannelTest, testCompress);
+	CppUnit_addTest(pSuite, FileChannelTest, testCompressParallel);
+	CppUnit_addTest(pSuite, FileChannelTest, testCompressRotations);
+	CppUnit_addTest(pSuite, FileChannelTest, testCompressPurge);
+	CppUnit_addTest(pSuite, FileChannelTest, testBuffered);
+	CppUnit_addTest(pSuite, FileChannelTest, testFlushInterval);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
 	CppUnit_addTest(pSuite, FileChannelTest, testWrongPurgeOption);
@@ -41,6 +41,11 @@ public:
 	void testRotateAtTimeMinLocal();
 	void testArchive();
 	void testCompress();
+	void testCompressParallel();
+	void testCompressRotations();
+	void testCompressPurge();
+	void testBuffered();
+	void testFlushInterval();
 	void testPurgeAge();
 	void testPurgeCount();
 	void testWrongPurgeOption();
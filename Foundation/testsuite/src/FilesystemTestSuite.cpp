@@ -14,6 +14,7 @@
 #include "GlobTest.h"
 #include "DirectoryWatcherTest.h"
 #include "DirectoryIteratorsTest.h"
+#include "MappedFileTest.h"
 
 
 CppUnit::Test* FilesystemTestSuite::suite()
@@ -27,6 +28,7 @@ CppUnit::Test* FilesystemTestSuite::suite()
 	pSuite->addTest(DirectoryWatcherTest::suite());
 #endif // POCO_NO_INOTIFY
 	pSuite->addTest(DirectoryIteratorsTest::suite());
+	pSuite->addTest(MappedFileTest::suite());
 	
 	return pSuite;
 }
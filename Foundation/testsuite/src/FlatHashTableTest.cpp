@@ -0,0 +1,376 @@
+//
+// FlatHashTableTest.cpp
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FlatHashTableTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/FlatHashTable.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/FlatHashSet.h"
+#include "Poco/NumberFormatter.h"
+#include <set>
+
+
+using Poco::FlatHashTable;
+using Poco::FlatHashMap;
+using Poco::FlatHashSet;
+using Poco::Hash;
+using Poco::NumberFormatter;
+
+
+FlatHashTableTest::FlatHashTableTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+FlatHashTableTest::~FlatHashTableTest()
+{
+}
+
+
+void FlatHashTableTest::testInsert()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	assertTrue (ht.empty());
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<FlatHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assertTrue (*res.first == i);
+		assertTrue (res.second);
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it != ht.end());
+		assertTrue (*it == i);
+		assertTrue (ht.size() == static_cast<std::size_t>(i + 1));
+	}
+	assertTrue (ht.buckets() == 2048);
+
+	assertTrue (!ht.empty());
+
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it != ht.end());
+		assertTrue (*it == i);
+		assertTrue (ht.count(i) == 1);
+	}
+	assertTrue (ht.find(N) == ht.end());
+	assertTrue (ht.count(N) == 0);
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<FlatHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assertTrue (*res.first == i);
+		assertTrue (!res.second);
+		assertTrue (ht.size() == N);
+	}
+	assertTrue (ht.buckets() == 2048);
+}
+
+
+void FlatHashTableTest::testErase()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+	assertTrue (ht.size() == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.erase(i);
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it == ht.end());
+	}
+	assertTrue (ht.size() == N/2);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it == ht.end());
+	}
+
+	for (int i = 1; i < N; i += 2)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it != ht.end());
+		assertTrue (*it == i);
+	}
+
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.insert(i);
+	}
+
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assertTrue (it != ht.end());
+		assertTrue (*it == i);
+	}
+
+	FlatHashTable<int, Hash<int> >::Iterator it = ht.begin();
+	while (it != ht.end())
+	{
+		FlatHashTable<int, Hash<int> >::Iterator next = it;
+		++next;
+		ht.erase(it);
+		it = next;
+	}
+	assertTrue (ht.empty());
+	assertTrue (ht.begin() == ht.end());
+}
+
+
+void FlatHashTableTest::testIterator()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+
+	std::set<int> values;
+	FlatHashTable<int, Hash<int> >::Iterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assertTrue (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+
+	assertTrue (values.size() == N);
+}
+
+
+void FlatHashTableTest::testConstIterator()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+
+	std::set<int> values;
+	FlatHashTable<int, Hash<int> >::ConstIterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assertTrue (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+
+	assertTrue (values.size() == N);
+
+	values.clear();
+	const FlatHashTable<int, Hash<int> > cht(ht);
+
+	FlatHashTable<int, Hash<int> >::ConstIterator cit = cht.begin();
+	while (cit != cht.end())
+	{
+		assertTrue (values.find(*cit) == values.end());
+		values.insert(*cit);
+		++cit;
+	}
+
+	assertTrue (values.size() == N);
+	assertTrue (cht.find(N/2) != cht.end());
+}
+
+
+void FlatHashTableTest::testCopy()
+{
+	const int N = 100;
+
+	FlatHashTable<int, Hash<int> > ht1;
+	for (int i = 0; i < N; ++i)
+	{
+		ht1.insert(i);
+	}
+
+	FlatHashTable<int, Hash<int> > ht2(ht1);
+	assertTrue (ht2.size() == N);
+	ht1.clear();
+	assertTrue (ht1.empty());
+	assertTrue (ht2.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assertTrue (ht2.find(i) != ht2.end());
+	}
+
+	ht1 = ht2;
+	ht2.clear();
+	assertTrue (ht1.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assertTrue (ht1.find(i) != ht1.end());
+	}
+
+	ht1.swap(ht2);
+	assertTrue (ht1.empty());
+	assertTrue (ht2.size() == N);
+}
+
+
+void FlatHashTableTest::testDeleted()
+{
+	const int N = 10000;
+
+	FlatHashTable<int, Hash<int> > ht(16);
+	std::size_t buckets = ht.buckets();
+
+	// Keep inserting and erasing elements, so that the table fills up
+	// with deleted slots. The table must be rehashed without growing.
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+		if (i >= 4)
+		{
+			ht.erase(i - 4);
+			assertTrue (ht.find(i - 4) == ht.end());
+		}
+		assertTrue (ht.find(i) != ht.end());
+	}
+	assertTrue (ht.size() == 4);
+	assertTrue (ht.buckets() == buckets);
+	for (int i = N - 4; i < N; ++i)
+	{
+		assertTrue (ht.find(i) != ht.end());
+	}
+}
+
+
+void FlatHashTableTest::testString()
+{
+	const int N = 5000;
+
+	FlatHashTable<std::string, Hash<std::string> > ht;
+	for (int i = 0; i < N; ++i)
+	{
+		assertTrue (ht.insert(NumberFormatter::format0(i, 8)).second);
+	}
+	assertTrue (ht.size() == N);
+	for (int i = 0; i < N; i += 3)
+	{
+		ht.erase(NumberFormatter::format0(i, 8));
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<std::string, Hash<std::string> >::ConstIterator it = ht.find(NumberFormatter::format0(i, 8));
+		if (i % 3 == 0)
+		{
+			assertTrue (it == ht.end());
+		}
+		else
+		{
+			assertTrue (it != ht.end());
+			assertTrue (*it == NumberFormatter::format0(i, 8));
+		}
+	}
+}
+
+
+void FlatHashTableTest::testFlatHashMap()
+{
+	typedef FlatHashMap<int, std::string> IntMap;
+	IntMap hm;
+
+	assertTrue (hm.empty());
+
+	for (int i = 0; i < 100; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::PairType(i, NumberFormatter::format(i)));
+		assertTrue (res.first->first == i);
+		assertTrue (res.first->second == NumberFormatter::format(i));
+		assertTrue (res.second);
+	}
+	assertTrue (hm.size() == 100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assertTrue (it != hm.end());
+		assertTrue (it->second == NumberFormatter::format(i));
+		assertTrue (hm[i] == NumberFormatter::format(i));
+	}
+
+	hm[200] = "200";
+	assertTrue (hm.size() == 101);
+	hm.erase(200);
+	assertTrue (hm.size() == 100);
+	assertTrue (hm.count(200) == 0);
+
+	const IntMap& chm = hm;
+	assertTrue (chm[50] == "50");
+	try
+	{
+		chm[200];
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void FlatHashTableTest::testFlatHashSet()
+{
+	FlatHashSet<std::string> hs;
+	assertTrue (hs.insert("foo").second);
+	assertTrue (hs.insert("bar").second);
+	assertTrue (!hs.insert("foo").second);
+	assertTrue (hs.size() == 2);
+	assertTrue (hs.count("foo") == 1);
+	hs.erase("foo");
+	assertTrue (hs.count("foo") == 0);
+	assertTrue (hs.find("bar") != hs.end());
+	assertTrue (hs.size() == 1);
+}
+
+
+void FlatHashTableTest::setUp()
+{
+}
+
+
+void FlatHashTableTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FlatHashTableTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FlatHashTableTest");
+
+	CppUnit_addTest(pSuite, FlatHashTableTest, testInsert);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testErase);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testIterator);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testConstIterator);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testCopy);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testDeleted);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testString);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testFlatHashMap);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testFlatHashSet);
+
+	return pSuite;
+}
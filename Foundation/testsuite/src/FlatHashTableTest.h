@@ -0,0 +1,46 @@
+//
+// FlatHashTableTest.h
+//
+// Definition of the FlatHashTableTest class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FlatHashTableTest_INCLUDED
+#define FlatHashTableTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class FlatHashTableTest: public CppUnit::TestCase
+{
+public:
+	FlatHashTableTest(const std::string& name);
+	~FlatHashTableTest();
+
+	void testInsert();
+	void testErase();
+	void testIterator();
+	void testConstIterator();
+	void testCopy();
+	void testDeleted();
+	void testString();
+	void testFlatHashMap();
+	void testFlatHashSet();
+	
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // FlatHashTableTest_INCLUDED
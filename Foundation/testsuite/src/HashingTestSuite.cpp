@@ -12,6 +12,7 @@
 #include "HashTableTest.h"
 #include "SimpleHashTableTest.h"
 #include "LinearHashTableTest.h"
+#include "FlatHashTableTest.h"
 #include "HashSetTest.h"
 #include "HashMapTest.h"
 
@@ -23,6 +24,7 @@ CppUnit::Test* HashingTestSuite::suite()
 	pSuite->addTest(HashTableTest::suite());
 	pSuite->addTest(SimpleHashTableTest::suite());
 	pSuite->addTest(LinearHashTableTest::suite());
+	pSuite->addTest(FlatHashTableTest::suite());
 	pSuite->addTest(HashSetTest::suite());
 	pSuite->addTest(HashMapTest::suite());
 
@@ -13,10 +13,13 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/HexBinaryEncoder.h"
 #include "Poco/HexBinaryDecoder.h"
+#include "Poco/Hex.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <algorithm>
 
 
+using Poco::Hex;
 using Poco::HexBinaryEncoder;
 using Poco::HexBinaryDecoder;
 using Poco::DataFormatException;
@@ -183,6 +186,132 @@ void HexBinaryTest::testEncodeDecode()
 }
 
 
+void HexBinaryTest::testBuffer()
+{
+	assertTrue (Hex::encode("") == "");
+	assertTrue (Hex::encode(std::string("\x00\x01\xab\xff", 4)) == "0001abff");
+	assertTrue (Hex::encode(std::string("\x00\x01\xab\xff", 4), true) == "0001ABFF");
+	assertTrue (Hex::decode("") == "");
+	assertTrue (Hex::decode("0001abff") == std::string("\x00\x01\xab\xff", 4));
+	assertTrue (Hex::decode("0001ABfF") == std::string("\x00\x01\xab\xff", 4));
+
+	std::string data;
+	for (int i = 0; i < 1000; ++i) data += char((i*7919) >> 3);
+
+	for (std::size_t length = 0; length <= data.size(); length += (length < 100 ? 1 : 97))
+	{
+		for (int uppercase = 0; uppercase < 2; ++uppercase)
+		{
+			std::ostringstream ostr;
+			HexBinaryEncoder encoder(ostr);
+			encoder.rdbuf()->setLineLength(0);
+			encoder.rdbuf()->setUppercase(uppercase != 0);
+			for (std::size_t i = 0; i < length; ++i) encoder.put(data[i]);
+			encoder.close();
+
+			std::string encoded = Hex::encode(data.substr(0, length), uppercase != 0);
+			assertTrue (encoded == ostr.str());
+			assertTrue (Hex::decode(encoded) == data.substr(0, length));
+		}
+	}
+
+	// invalid characters must be detected anywhere in the input
+	const char invalid[] = {'g', 'G', '/', ':', '@', '`', ' ', '\x80'};
+	std::string encoded = Hex::encode(data.substr(0, 200));
+	for (std::size_t i = 0; i < encoded.size(); i += 3)
+	{
+		std::string bad(encoded);
+		bad[i] = invalid[i % sizeof(invalid)];
+		try
+		{
+			Hex::decode(bad);
+			fail("invalid character - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+	try
+	{
+		Hex::decode("abc");
+		fail("odd length - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void HexBinaryTest::testBlocks()
+{
+	std::string data;
+	for (int i = 0; i < 20000; ++i) data += char((i*7919) >> 5);
+
+	int lineLengths[] = {72, 9, 0};
+	for (int k = 0; k < 3; ++k)
+	{
+		std::ostringstream charStr;
+		HexBinaryEncoder charEncoder(charStr);
+		charEncoder.rdbuf()->setLineLength(lineLengths[k]);
+		for (std::size_t i = 0; i < data.size(); ++i) charEncoder.put(data[i]);
+		charEncoder.close();
+
+		std::ostringstream blockStr;
+		HexBinaryEncoder blockEncoder(blockStr);
+		blockEncoder.rdbuf()->setLineLength(lineLengths[k]);
+		std::size_t pos = 0;
+		std::size_t blockSize = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(blockSize, data.size() - pos);
+			blockEncoder.write(data.data() + pos, n);
+			pos += n;
+			blockSize = blockSize*3 + 1;
+			if (blockSize > 10000) blockSize = 2;
+		}
+		blockEncoder.close();
+		assertTrue (blockStr.str() == charStr.str());
+
+		std::istringstream istr(charStr.str());
+		HexBinaryDecoder decoder(istr);
+		std::string decoded;
+		char buffer[1000];
+		blockSize = 1;
+		while (decoder.read(buffer, blockSize) || decoder.gcount() > 0)
+		{
+			decoded.append(buffer, static_cast<std::size_t>(decoder.gcount()));
+			blockSize = blockSize*3 + 1;
+			if (blockSize > sizeof(buffer)) blockSize = 2;
+		}
+		assertTrue (decoded == data);
+	}
+
+	{
+		// a block read must not consume more input than it needs
+		std::istringstream istr("4142 4344\n4546!");
+		HexBinaryDecoder decoder(istr);
+		char buffer[6];
+		decoder.read(buffer, 6);
+		assertTrue (decoder.gcount() == 6);
+		assertTrue (std::string(buffer, 6) == "ABCDEF");
+		assertTrue (istr.get() == '!');
+	}
+	{
+		std::istringstream istr("4142434445464748494a4b4c4d4e4f50#5152");
+		HexBinaryDecoder decoder(istr);
+		char buffer[32];
+		try
+		{
+			decoder.read(buffer, sizeof(buffer));
+			assertTrue (decoder.bad());
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+}
+
+
 void HexBinaryTest::setUp()
 {
 }
@@ -200,6 +329,8 @@ CppUnit::Test* HexBinaryTest::suite()
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testDecoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncodeDecode);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBuffer);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBlocks);
 
 	return pSuite;
 }
@@ -27,6 +27,8 @@ public:
 	void testEncoder();
 	void testDecoder();
 	void testEncodeDecode();
+	void testBuffer();
+	void testBlocks();
 
 	void setUp();
 	void tearDown();
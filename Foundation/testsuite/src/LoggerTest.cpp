@@ -13,13 +13,18 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/NumberFormatter.h"
 #include "TestChannel.h"
+#include <atomic>
 
 
 using Poco::Logger;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::NumberFormatter;
 
 
 LoggerTest::LoggerTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -289,6 +294,110 @@ void LoggerTest::testDump()
 }
 
 
+void LoggerTest::testConcurrentGet()
+{
+	const int THREADS = 4;
+	const int LOGGERS = 1000;
+
+	Logger& root = Logger::root();
+	root.setLevel(Message::PRIO_WARNING);
+
+	std::vector<std::string> names;
+	for (int i = 0; i < LOGGERS; ++i)
+	{
+		names.push_back("Concurrent." + NumberFormatter::format(i % 10) + "." + NumberFormatter::format(i));
+	}
+
+	bool ok[THREADS];
+	Thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		ok[t] = true;
+		threads[t].startFunc([&names, &ok, t]()
+			{
+				for (int i = 0; i < LOGGERS; ++i)
+				{
+					const std::string& name = names[(i*(t + 1)) % LOGGERS];
+					Logger& logger = Logger::get(name);
+					if (logger.name() != name || logger.getLevel() != Message::PRIO_WARNING) ok[t] = false;
+					if (!Logger::has(name)) ok[t] = false;
+				}
+			});
+	}
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].join();
+		assertTrue (ok[t]);
+	}
+
+	for (int i = 0; i < LOGGERS; ++i)
+	{
+		assertTrue (Logger::has(names[i]));
+	}
+	std::vector<std::string> all;
+	Logger::names(all);
+	assertTrue (all.size() == LOGGERS + 1);
+
+	Logger::setLevel("Concurrent.3", Message::PRIO_DEBUG);
+	assertTrue (Logger::get("Concurrent.3.3").getLevel() == Message::PRIO_DEBUG);
+	assertTrue (Logger::get("Concurrent.3.13").getLevel() == Message::PRIO_DEBUG);
+	assertTrue (Logger::get("Concurrent.4.4").getLevel() == Message::PRIO_WARNING);
+
+	Logger::destroy("Concurrent.5.5");
+	assertTrue (!Logger::has("Concurrent.5.5"));
+	assertTrue (Logger::has("Concurrent.5.15"));
+}
+
+
+void LoggerTest::testConcurrentDestroy()
+{
+	const int THREADS = 4;
+	const int LOGGERS = 100;
+
+	std::vector<std::string> names;
+	for (int i = 0; i < LOGGERS; ++i)
+	{
+		names.push_back("Churn." + NumberFormatter::format(i));
+		Logger::get(names.back());
+	}
+
+	std::atomic<bool> stop(false);
+	bool ok[THREADS];
+	Thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		ok[t] = true;
+		threads[t].startFunc([&names, &ok, &stop, t]()
+			{
+				int i = t;
+				while (!stop)
+				{
+					const std::string& name = names[i++ % LOGGERS];
+					if (Logger::get(name).name() != name) ok[t] = false;
+					Logger::Ptr pLogger = Logger::has("Temp." + name);
+					if (pLogger && pLogger->name() != "Temp." + name) ok[t] = false;
+				}
+			});
+	}
+
+	// create and destroy loggers, growing the table on the way
+	for (int round = 0; round < 20; ++round)
+	{
+		for (int i = 0; i < LOGGERS; ++i) Logger::get("Temp." + names[i] + "." + NumberFormatter::format(round));
+		for (int i = 0; i < LOGGERS; ++i) Logger::get("Temp." + names[i]);
+		for (int i = 0; i < LOGGERS; ++i) Logger::destroy("Temp." + names[i]);
+	}
+	stop = true;
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].join();
+		assertTrue (ok[t]);
+	}
+	assertTrue (!Logger::has("Temp." + names[0]));
+	assertTrue (Logger::has("Temp." + names[0] + ".19"));
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -297,6 +406,7 @@ void LoggerTest::setUp()
 
 void LoggerTest::tearDown()
 {
+	Logger::shutdown();
 }
 
 
@@ -308,6 +418,8 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentDestroy);
 
 	return pSuite;
 }
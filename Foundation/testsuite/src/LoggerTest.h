@@ -28,6 +28,8 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testConcurrentGet();
+	void testConcurrentDestroy();
 
 	void setUp();
 	void tearDown();
@@ -17,6 +17,7 @@
 #include "LoggingFactoryTest.h"
 #include "LoggingRegistryTest.h"
 #include "LogStreamTest.h"
+#include "FastLoggerTest.h"
 
 
 CppUnit::Test* LoggingTestSuite::suite()
@@ -31,6 +32,7 @@ CppUnit::Test* LoggingTestSuite::suite()
 	pSuite->addTest(LoggingFactoryTest::suite());
 	pSuite->addTest(LoggingRegistryTest::suite());
 	pSuite->addTest(LogStreamTest::suite());
+	pSuite->addTest(FastLoggerTest::suite());
 
 	return pSuite;
 }
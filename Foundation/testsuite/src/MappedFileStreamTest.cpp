@@ -0,0 +1,168 @@
+//
+// MappedFileStreamTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MappedFileStreamTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/MappedFileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NumberFormatter.h"
+
+
+using Poco::MappedFileInputStream;
+using Poco::MappedFile;
+using Poco::TemporaryFile;
+using Poco::FileOutputStream;
+using Poco::StreamCopier;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	std::string makeLines(int count)
+	{
+		std::string data;
+		for (int i = 0; i < count; ++i)
+		{
+			data += "line ";
+			data += NumberFormatter::format(i);
+			data += '\n';
+		}
+		return data;
+	}
+
+	void writeFile(const std::string& path, const std::string& data)
+	{
+		FileOutputStream ostr(path);
+		ostr.write(data.data(), data.size());
+	}
+}
+
+
+MappedFileStreamTest::MappedFileStreamTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MappedFileStreamTest::~MappedFileStreamTest()
+{
+}
+
+
+void MappedFileStreamTest::testRead()
+{
+	std::string data = makeLines(10000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFileInputStream istr(file.path());
+	std::string result;
+	StreamCopier::copyToString(istr, result);
+	assertTrue (result == data);
+	assertTrue (istr.eof());
+}
+
+
+void MappedFileStreamTest::testWindows()
+{
+	std::string data = makeLines(10000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	const std::size_t windowSizes[] = {0, MappedFile::granularity(), 3*MappedFile::granularity() + 5};
+	for (std::size_t w = 0; w < sizeof(windowSizes)/sizeof(windowSizes[0]); ++w)
+	{
+		MappedFileInputStream istr(file.path(), windowSizes[w]);
+		std::string line;
+		int n = 0;
+		while (std::getline(istr, line))
+		{
+			assertTrue (line == "line " + NumberFormatter::format(n));
+			++n;
+		}
+		assertTrue (n == 10000);
+	}
+}
+
+
+void MappedFileStreamTest::testSeek()
+{
+	std::string data = makeLines(10000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFileInputStream istr(file.path(), MappedFile::granularity());
+	char buffer[10];
+
+	istr.seekg(50000);
+	assertTrue (istr.tellg() == std::streampos(50000));
+	istr.read(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, sizeof(buffer)) == data.substr(50000, sizeof(buffer)));
+	assertTrue (istr.tellg() == std::streampos(50010));
+
+	istr.seekg(-20, std::ios::cur);
+	istr.read(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, sizeof(buffer)) == data.substr(49990, sizeof(buffer)));
+
+	istr.seekg(10);
+	istr.read(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, sizeof(buffer)) == data.substr(10, sizeof(buffer)));
+
+	istr.seekg(-5, std::ios::end);
+	istr.read(buffer, sizeof(buffer));
+	assertTrue (istr.gcount() == 5);
+	assertTrue (std::string(buffer, 5) == data.substr(data.size() - 5));
+	assertTrue (istr.eof());
+
+	istr.clear();
+	istr.seekg(0, std::ios::end);
+	assertTrue (istr.tellg() == std::streampos(data.size()));
+	assertTrue (istr.get() == EOF);
+
+	istr.clear();
+	istr.seekg(data.size() + 1);
+	assertTrue (istr.fail());
+}
+
+
+void MappedFileStreamTest::testEmptyFile()
+{
+	TemporaryFile file;
+	writeFile(file.path(), "");
+
+	MappedFileInputStream istr(file.path());
+	assertTrue (istr.get() == EOF);
+	assertTrue (istr.eof());
+}
+
+
+void MappedFileStreamTest::setUp()
+{
+}
+
+
+void MappedFileStreamTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MappedFileStreamTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MappedFileStreamTest");
+
+	CppUnit_addTest(pSuite, MappedFileStreamTest, testRead);
+	CppUnit_addTest(pSuite, MappedFileStreamTest, testWindows);
+	CppUnit_addTest(pSuite, MappedFileStreamTest, testSeek);
+	CppUnit_addTest(pSuite, MappedFileStreamTest, testEmptyFile);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// MappedFileStreamTest.h
+//
+// Definition of the MappedFileStreamTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MappedFileStreamTest_INCLUDED
+#define MappedFileStreamTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class MappedFileStreamTest: public CppUnit::TestCase
+{
+public:
+	MappedFileStreamTest(const std::string& name);
+	~MappedFileStreamTest();
+
+	void testRead();
+	void testWindows();
+	void testSeek();
+	void testEmptyFile();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MappedFileStreamTest_INCLUDED
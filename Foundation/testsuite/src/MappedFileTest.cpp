@@ -0,0 +1,218 @@
+//
+// MappedFileTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MappedFileTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/MappedFile.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+using Poco::MappedFile;
+using Poco::TemporaryFile;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::StreamCopier;
+
+
+namespace
+{
+	std::string makeData(std::size_t size)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < size; ++i) data += char('a' + (i*7 + i/100) % 26);
+		return data;
+	}
+
+	void writeFile(const std::string& path, const std::string& data)
+	{
+		FileOutputStream ostr(path);
+		ostr.write(data.data(), data.size());
+	}
+}
+
+
+MappedFileTest::MappedFileTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MappedFileTest::~MappedFileTest()
+{
+}
+
+
+void MappedFileTest::testMapFile()
+{
+	std::string data = makeData(100000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf(file.path());
+	assertTrue (mf.isOpen());
+	assertTrue (mf.fileSize() == data.size());
+	assertTrue (mf.offset() == 0);
+	assertTrue (mf.size() == data.size());
+	assertTrue (static_cast<std::size_t>(mf.end() - mf.begin()) == data.size());
+	assertTrue (std::string(mf.begin(), mf.end()) == data);
+
+	mf.close();
+	assertTrue (!mf.isOpen());
+	assertTrue (mf.begin() == 0);
+	assertTrue (mf.size() == 0);
+}
+
+
+void MappedFileTest::testMapWindow()
+{
+	std::string data = makeData(5*MappedFile::granularity() + 1234);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf;
+	mf.open(file.path());
+	assertTrue (mf.begin() == 0);
+	assertTrue (mf.fileSize() == data.size());
+
+	mf.map(0, 1000);
+	assertTrue (mf.offset() == 0);
+	assertTrue (mf.size() == 1000);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(0, 1000));
+
+	// unaligned offset
+	mf.map(3*MappedFile::granularity() - 17, 5000);
+	assertTrue (mf.offset() == 3*MappedFile::granularity() - 17);
+	assertTrue (mf.size() == 5000);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(3*MappedFile::granularity() - 17, 5000));
+
+	// window extending beyond the end of the file
+	mf.map(data.size() - 100, 5000);
+	assertTrue (mf.size() == 100);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(data.size() - 100));
+
+	// window up to the end of the file
+	mf.map(12345);
+	assertTrue (mf.size() == data.size() - 12345);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(12345));
+
+	// empty window at the end of the file
+	mf.map(data.size());
+	assertTrue (mf.offset() == data.size());
+	assertTrue (mf.size() == 0);
+	assertTrue (mf.begin() == 0);
+
+	try
+	{
+		mf.map(data.size() + 1);
+		fail("offset beyond end of file - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	mf.unmap();
+	assertTrue (mf.begin() == 0);
+	assertTrue (mf.isOpen());
+}
+
+
+void MappedFileTest::testEmptyFile()
+{
+	TemporaryFile file;
+	writeFile(file.path(), "");
+
+	MappedFile mf(file.path());
+	assertTrue (mf.fileSize() == 0);
+	assertTrue (mf.size() == 0);
+	assertTrue (mf.begin() == mf.end());
+}
+
+
+void MappedFileTest::testWrite()
+{
+	std::string data = makeData(3*MappedFile::granularity());
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf(file.path(), MappedFile::AM_WRITE);
+	mf.map(MappedFile::granularity() + 10, 5);
+	std::string hello("HELLO");
+	std::copy(hello.begin(), hello.end(), mf.begin());
+	mf.flush();
+	mf.close();
+
+	data.replace(MappedFile::granularity() + 10, 5, "HELLO");
+	FileInputStream istr(file.path());
+	std::string result;
+	StreamCopier::copyToString(istr, result);
+	assertTrue (result == data);
+}
+
+
+void MappedFileTest::testAdvice()
+{
+	std::string data = makeData(100000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf(file.path(), MappedFile::AM_READ, MappedFile::OPT_HUGE_PAGES | MappedFile::OPT_POPULATE);
+	assertTrue (std::string(mf.begin(), mf.end()) == data);
+	mf.advise(MappedFile::ADV_SEQUENTIAL);
+	mf.advise(MappedFile::ADV_RANDOM);
+	mf.advise(MappedFile::ADV_WILLNEED);
+	mf.map(50000, 1000);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(50000, 1000));
+	mf.unmap();
+	mf.advise(MappedFile::ADV_NORMAL);
+	mf.map(60000, 1000);
+	assertTrue (std::string(mf.begin(), mf.end()) == data.substr(60000, 1000));
+}
+
+
+void MappedFileTest::testFileNotFound()
+{
+	try
+	{
+		MappedFile mf("nonexistent.dat");
+		fail("file does not exist - must throw");
+	}
+	catch (Poco::FileNotFoundException&)
+	{
+	}
+}
+
+
+void MappedFileTest::setUp()
+{
+}
+
+
+void MappedFileTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MappedFileTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MappedFileTest");
+
+	CppUnit_addTest(pSuite, MappedFileTest, testMapFile);
+	CppUnit_addTest(pSuite, MappedFileTest, testMapWindow);
+	CppUnit_addTest(pSuite, MappedFileTest, testEmptyFile);
+	CppUnit_addTest(pSuite, MappedFileTest, testWrite);
+	CppUnit_addTest(pSuite, MappedFileTest, testAdvice);
+	CppUnit_addTest(pSuite, MappedFileTest, testFileNotFound);
+
+	return pSuite;
+}
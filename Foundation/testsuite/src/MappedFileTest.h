@@ -0,0 +1,43 @@
+//
+// MappedFileTest.h
+//
+// Definition of the MappedFileTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MappedFileTest_INCLUDED
+#define MappedFileTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class MappedFileTest: public CppUnit::TestCase
+{
+public:
+	MappedFileTest(const std::string& name);
+	~MappedFileTest();
+
+	void testMapFile();
+	void testMapWindow();
+	void testEmptyFile();
+	void testWrite();
+	void testAdvice();
+	void testFileNotFound();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MappedFileTest_INCLUDED
@@ -0,0 +1,193 @@
+//
+// ParallelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ParallelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Parallel.h"
+#include "Poco/Executor.h"
+#include "Poco/Thread.h"
+#include "Poco/Random.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+using Poco::parallelFor;
+using Poco::parallelReduce;
+using Poco::parallelTransform;
+using Poco::parallelSort;
+using Poco::ParallelPolicy;
+using Poco::Executor;
+using Poco::Thread;
+using Poco::AtomicCounter;
+
+
+ParallelTest::ParallelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ParallelTest::~ParallelTest()
+{
+}
+
+
+void ParallelTest::testFor()
+{
+	Executor executor(4);
+	ParallelPolicy policy(executor, 16);
+	std::vector<int> v(10000, 0);
+	parallelFor(0, static_cast<int>(v.size()), [&v](int i) { v[i] += i; }, policy);
+	for (int i = 0; i < static_cast<int>(v.size()); i++)
+	{
+		assertTrue (v[i] == i);
+	}
+
+	AtomicCounter count;
+	parallelFor(5, 5, [&count](int) { ++count; });
+	parallelFor(5, 3, [&count](int) { ++count; });
+	assertTrue (count.value() == 0);
+}
+
+
+void ParallelTest::testSerial()
+{
+	ParallelPolicy policy(100);
+	Thread* pThread = Thread::current();
+	bool sameThread = true;
+	parallelFor(0, 100, [&](int) { if (Thread::current() != pThread) sameThread = false; }, policy);
+	assertTrue (sameThread);
+}
+
+
+void ParallelTest::testReduce()
+{
+	std::vector<long> v(100000);
+	for (std::size_t i = 0; i < v.size(); i++) v[i] = static_cast<long>(i);
+	assertTrue (parallelReduce(v.begin(), v.end(), 0L) == 4999950000L);
+
+	std::vector<std::string> s;
+	std::string expected;
+	for (int i = 0; i < 5000; i++)
+	{
+		s.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+		expected += s.back();
+	}
+	Executor executor(4);
+	ParallelPolicy policy(executor, 10);
+	// concatenation is not commutative
+	std::string result = parallelReduce(s.begin(), s.end(), std::string(">"), std::plus<std::string>(), policy);
+	assertTrue (result == ">" + expected);
+
+	std::vector<long> empty;
+	assertTrue (parallelReduce(empty.begin(), empty.end(), 42L) == 42);
+}
+
+
+void ParallelTest::testTransform()
+{
+	std::vector<int> in(50000);
+	for (std::size_t i = 0; i < in.size(); i++) in[i] = static_cast<int>(i);
+	std::vector<double> out(in.size());
+	std::vector<double>::iterator end = parallelTransform(in.begin(), in.end(), out.begin(), [](int n) { return n*0.5; });
+	assertTrue (end == out.end());
+	for (std::size_t i = 0; i < in.size(); i++)
+	{
+		assertTrue (out[i] == in[i]*0.5);
+	}
+}
+
+
+void ParallelTest::testSort()
+{
+	Poco::Random rnd;
+	Executor executor(3);
+	for (std::size_t size: { std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(12345), std::size_t(200000) })
+	{
+		std::vector<Poco::UInt32> v(size);
+		for (std::size_t i = 0; i < size; i++) v[i] = rnd.next() % 1000;
+		std::vector<Poco::UInt32> expected(v);
+		std::sort(expected.begin(), expected.end());
+
+		ParallelPolicy policy(executor, 100);
+		parallelSort(v.begin(), v.end(), policy);
+		assertTrue (v == expected);
+
+		parallelSort(v.begin(), v.end(), std::greater<Poco::UInt32>());
+		std::reverse(expected.begin(), expected.end());
+		assertTrue (v == expected);
+	}
+}
+
+
+void ParallelTest::testException()
+{
+	Executor executor(4);
+	ParallelPolicy policy(executor, 1);
+	AtomicCounter count;
+	try
+	{
+		parallelFor(0, 10000, [&count](int i)
+			{
+				++count;
+				if (i == 10) throw Poco::InvalidArgumentException("i");
+				Thread::yield();
+			}, policy);
+		fail("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assertTrue (count.value() < 10000);
+}
+
+
+void ParallelTest::testCancel()
+{
+	Executor executor(2);
+	ParallelPolicy policy(executor, 1);
+	AtomicCounter count;
+	parallelFor(0, 10000, [&](int i)
+		{
+			if (++count == 100) policy.cancel();
+		}, policy);
+	assertTrue (policy.isCancelled());
+	assertTrue (count.value() >= 100 && count.value() < 10000);
+}
+
+
+void ParallelTest::setUp()
+{
+}
+
+
+void ParallelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ParallelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ParallelTest");
+
+	CppUnit_addTest(pSuite, ParallelTest, testFor);
+	CppUnit_addTest(pSuite, ParallelTest, testSerial);
+	CppUnit_addTest(pSuite, ParallelTest, testReduce);
+	CppUnit_addTest(pSuite, ParallelTest, testTransform);
+	CppUnit_addTest(pSuite, ParallelTest, testSort);
+	CppUnit_addTest(pSuite, ParallelTest, testException);
+	CppUnit_addTest(pSuite, ParallelTest, testCancel);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// ParallelTest.h
+//
+// Definition of the ParallelTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ParallelTest_INCLUDED
+#define ParallelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ParallelTest: public CppUnit::TestCase
+{
+public:
+	ParallelTest(const std::string& name);
+	~ParallelTest();
+
+	void testFor();
+	void testSerial();
+	void testReduce();
+	void testTransform();
+	void testSort();
+	void testException();
+	void testCancel();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ParallelTest_INCLUDED
@@ -12,6 +12,7 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/SHA1Engine.h"
+#include <algorithm>
 
 
 using Poco::SHA1Engine;
@@ -46,6 +47,31 @@ void SHA1EngineTest::testSHA1()
 }
 
 
+void SHA1EngineTest::testBlocks()
+{
+	SHA1Engine engine;
+
+	// one million 'a', as a single block, and split into pieces that
+	// do not line up with the block size
+	std::string data(1000000, 'a');
+	engine.update(data);
+	assertTrue (DigestEngine::digestToHex(engine.digest()) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+	const std::size_t pieces[] = {1, 63, 64, 65, 200, 4096};
+	for (std::size_t i = 0; i < sizeof(pieces)/sizeof(pieces[0]); ++i)
+	{
+		std::size_t pos = 0;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(pieces[i], data.size() - pos);
+			engine.update(data.data() + pos, n);
+			pos += n;
+		}
+		assertTrue (DigestEngine::digestToHex(engine.digest()) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+	}
+}
+
+
 void SHA1EngineTest::setUp()
 {
 }
@@ -61,6 +87,7 @@ CppUnit::Test* SHA1EngineTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SHA1EngineTest");
 
 	CppUnit_addTest(pSuite, SHA1EngineTest, testSHA1);
+	CppUnit_addTest(pSuite, SHA1EngineTest, testBlocks);
 
 	return pSuite;
 }
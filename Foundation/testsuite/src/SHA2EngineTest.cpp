@@ -15,6 +15,7 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/SHA2Engine.h"
+#include <algorithm>
 
 using Poco::SHA2Engine;
 using Poco::DigestEngine;
@@ -99,6 +100,30 @@ void SHA2EngineTest::testSHA512()
 	assertTrue (DigestEngine::digestToHex(engine.digest()) == "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
 }
 
+void SHA2EngineTest::testBlocks()
+{
+	SHA2Engine engine(SHA2Engine::SHA_256);
+
+	// one million 'a', as a single block, and split into pieces that
+	// do not line up with the block size
+	std::string data(1000000, 'a');
+	engine.update(data);
+	assertTrue (DigestEngine::digestToHex(engine.digest()) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+	const std::size_t pieces[] = {1, 63, 64, 65, 200, 4096};
+	for (std::size_t i = 0; i < sizeof(pieces)/sizeof(pieces[0]); ++i)
+	{
+		std::size_t pos = 0;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(pieces[i], data.size() - pos);
+			engine.update(data.data() + pos, n);
+			pos += n;
+		}
+		assertTrue (DigestEngine::digestToHex(engine.digest()) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+	}
+}
+
 void SHA2EngineTest::setUp()
 {
 }
@@ -115,6 +140,7 @@ CppUnit::Test* SHA2EngineTest::suite()
 	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA256);
 	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA384);
 	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA512);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testBlocks);
 
 	return pSuite;
 }
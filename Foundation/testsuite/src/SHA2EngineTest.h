@@ -25,6 +25,7 @@ public:
 	void testSHA256();
 	void testSHA384();
 	void testSHA512();
+	void testBlocks();
 
 	void setUp();
 	void tearDown();
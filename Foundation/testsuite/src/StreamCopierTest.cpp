@@ -12,10 +12,35 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
 #include <sstream>
 
 
 using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
+
+
+namespace
+{
+	std::string makeData(std::size_t size)
+	{
+		std::string data;
+		data.reserve(size);
+		for (std::size_t i = 0; i < size; ++i) data += char((i*7 + i/256) % 256);
+		return data;
+	}
+
+	std::string readFile(const std::string& path)
+	{
+		FileInputStream istr(path);
+		std::string data;
+		StreamCopier::copyToString(istr, data);
+		return data;
+	}
+}
 
 
 StreamCopierTest::StreamCopierTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -160,6 +185,82 @@ void StreamCopierTest::testCopyToString64()
 #endif
 
 
+void StreamCopierTest::testLargeCopy()
+{
+	std::string src = makeData(1000000);
+	{
+		std::istringstream istr(src);
+		std::ostringstream ostr;
+		std::streamsize n = StreamCopier::copyStream(istr, ostr, 100);
+		assertTrue (ostr.str() == src);
+		assertTrue (n == static_cast<std::streamsize>(src.size()));
+		assertTrue (istr.eof());
+	}
+	{
+		std::istringstream istr(src);
+		std::string dest;
+		std::streamsize n = StreamCopier::copyToString(istr, dest, 100);
+		assertTrue (dest == src);
+		assertTrue (n == static_cast<std::streamsize>(src.size()));
+	}
+}
+
+
+void StreamCopierTest::testFileCopy()
+{
+	std::string src = makeData(1000000);
+	TemporaryFile srcFile;
+	TemporaryFile destFile;
+	{
+		FileOutputStream ostr(srcFile.path());
+		ostr.write(src.data(), src.size());
+	}
+	{
+		FileInputStream istr(srcFile.path());
+		FileOutputStream ostr(destFile.path());
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assertTrue (n == static_cast<std::streamsize>(src.size()));
+		assertTrue (istr.eof());
+		assertTrue (ostr.good());
+		ostr.close();
+		assertTrue (readFile(destFile.path()) == src);
+	}
+	{
+		// data already buffered in the streams must be copied first
+		FileInputStream istr(srcFile.path());
+		FileOutputStream ostr(destFile.path());
+		char buffer[10];
+		istr.read(buffer, sizeof(buffer));
+		ostr << "header";
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assertTrue (n == static_cast<std::streamsize>(src.size() - sizeof(buffer)));
+		ostr << "trailer";
+		ostr.close();
+		assertTrue (readFile(destFile.path()) == "header" + src.substr(sizeof(buffer)) + "trailer");
+	}
+	{
+		// copy to a string stream
+		FileInputStream istr(srcFile.path());
+		std::ostringstream ostr;
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assertTrue (n == static_cast<std::streamsize>(src.size()));
+		assertTrue (ostr.str() == src);
+	}
+	{
+		// copy an empty file
+		TemporaryFile emptyFile;
+		FileOutputStream(emptyFile.path()).close();
+		FileInputStream istr(emptyFile.path());
+		FileOutputStream ostr(destFile.path());
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assertTrue (n == 0);
+		assertTrue (istr.eof());
+		ostr.close();
+		assertTrue (readFile(destFile.path()).empty());
+	}
+}
+
+
 void StreamCopierTest::setUp()
 {
 }
@@ -177,6 +278,8 @@ CppUnit::Test* StreamCopierTest::suite()
 	CppUnit_addTest(pSuite, StreamCopierTest, testBufferedCopy);
 	CppUnit_addTest(pSuite, StreamCopierTest, testUnbufferedCopy);
 	CppUnit_addTest(pSuite, StreamCopierTest, testCopyToString);
+	CppUnit_addTest(pSuite, StreamCopierTest, testLargeCopy);
+	CppUnit_addTest(pSuite, StreamCopierTest, testFileCopy);
 
 #if defined(POCO_HAVE_INT64)
 	CppUnit_addTest(pSuite, StreamCopierTest, testBufferedCopy64);
@@ -27,6 +27,8 @@ public:
 	void testBufferedCopy();
 	void testUnbufferedCopy();
 	void testCopyToString();
+	void testLargeCopy();
+	void testFileCopy();
 #if defined(POCO_HAVE_INT64)
 	void testBufferedCopy64();
 	void testUnbufferedCopy64();
@@ -21,6 +21,7 @@
 #include "LineEndingConverterTest.h"
 #include "TeeStreamTest.h"
 #include "FileStreamTest.h"
+#include "MappedFileStreamTest.h"
 #include "MemoryStreamTest.h"
 #include "FIFOBufferStreamTest.h"
 
@@ -41,6 +42,7 @@ CppUnit::Test* StreamsTestSuite::suite()
 	pSuite->addTest(LineEndingConverterTest::suite());
 	pSuite->addTest(TeeStreamTest::suite());
 	pSuite->addTest(FileStreamTest::suite());
+	pSuite->addTest(MappedFileStreamTest::suite());
 	pSuite->addTest(MemoryStreamTest::suite());
 	pSuite->addTest(FIFOBufferStreamTest::suite());
 
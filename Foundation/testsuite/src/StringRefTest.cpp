@@ -0,0 +1,120 @@
+//
+// StringRefTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "StringRefTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/StringRef.h"
+#include <sstream>
+
+
+using Poco::StringRef;
+
+
+StringRefTest::StringRefTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+StringRefTest::~StringRefTest()
+{
+}
+
+
+void StringRefTest::testConstruct()
+{
+	StringRef empty;
+	assertTrue (empty.empty());
+	assertTrue (empty.size() == 0);
+	assertTrue (empty.begin() == empty.end());
+
+	StringRef lit("hello");
+	assertTrue (lit.size() == 5);
+	assertTrue (lit[0] == 'h' && lit[4] == 'o');
+
+	std::string str("hello, world");
+	StringRef ref(str);
+	assertTrue (ref.data() == str.data());
+	assertTrue (ref.length() == str.length());
+	assertTrue (ref.toString() == str);
+
+	StringRef part(str.data() + 7, 5);
+	assertTrue (part.toString() == "world");
+
+	std::string copy;
+	part.assignTo(copy);
+	assertTrue (copy == "world");
+}
+
+
+void StringRefTest::testCompare()
+{
+	StringRef a("abc");
+	StringRef b("abd");
+	StringRef ab("ab");
+	std::string abc("abc");
+
+	assertTrue (a == StringRef(abc));
+	assertTrue (a != b);
+	assertTrue (a < b);
+	assertTrue (ab < a);
+	assertTrue (!(a < ab));
+	assertTrue (a.compare(a) == 0);
+	assertTrue (a.compare(b) < 0);
+	assertTrue (b.compare(a) > 0);
+	assertTrue (StringRef() == StringRef(""));
+	assertTrue (StringRef() < a);
+}
+
+
+void StringRefTest::testSubstr()
+{
+	StringRef ref("key=value");
+	StringRef::SizeType pos = ref.find('=');
+	assertTrue (pos == 3);
+	assertTrue (ref.substr(0, pos) == StringRef("key"));
+	assertTrue (ref.substr(pos + 1) == StringRef("value"));
+	assertTrue (ref.substr(100).empty());
+	assertTrue (ref.find('x') == StringRef::NPOS);
+	assertTrue (ref.find('e', 2) == 8);
+}
+
+
+void StringRefTest::testStream()
+{
+	std::string str("abcdef");
+	StringRef ref(str.data() + 1, 3);
+	std::ostringstream ostr;
+	ostr << '[' << ref << ']';
+	assertTrue (ostr.str() == "[bcd]");
+}
+
+
+void StringRefTest::setUp()
+{
+}
+
+
+void StringRefTest::tearDown()
+{
+}
+
+
+CppUnit::Test* StringRefTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("StringRefTest");
+
+	CppUnit_addTest(pSuite, StringRefTest, testConstruct);
+	CppUnit_addTest(pSuite, StringRefTest, testCompare);
+	CppUnit_addTest(pSuite, StringRefTest, testSubstr);
+	CppUnit_addTest(pSuite, StringRefTest, testStream);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// StringRefTest.h
+//
+// Definition of the StringRefTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef StringRefTest_INCLUDED
+#define StringRefTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class StringRefTest: public CppUnit::TestCase
+{
+public:
+	StringRefTest(const std::string& name);
+	~StringRefTest();
+
+	void testConstruct();
+	void testCompare();
+	void testSubstr();
+	void testStream();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // StringRefTest_INCLUDED
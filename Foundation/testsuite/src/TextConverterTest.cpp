@@ -20,6 +20,8 @@
 #include "Poco/Windows1251Encoding.h"
 #include "Poco/Windows1252Encoding.h"
 #include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/UTF32Encoding.h"
 
 #ifdef POCO_COMPILER_MSVC
 #pragma warning(push)
@@ -29,6 +31,43 @@
 using namespace Poco;
 
 
+namespace
+{
+	int identity(int ch)
+	{
+		return ch;
+	}
+
+
+	std::string convertGeneric(TextEncoding& source, TextEncoding& target, const std::string& text, int& errors)
+		/// Converts character by character, bypassing the UTFTranscoder fast path.
+	{
+		TextConverter converter(source, target);
+		std::string result;
+		errors = converter.convert(text, result, identity);
+		return result;
+	}
+
+
+	bool sameAsGeneric(TextEncoding& source, TextEncoding& target, const std::string& text)
+		/// Returns true if the default conversion gives the same result
+		/// and error count as the character by character conversion.
+	{
+		int expectedErrors;
+		std::string expected = convertGeneric(source, target, text, expectedErrors);
+
+		TextConverter converter(source, target);
+		std::string result;
+		int errors = converter.convert(text, result);
+		if (result != expected || errors != expectedErrors) return false;
+
+		result = "prefix";
+		errors = converter.convert(text.data(), static_cast<int>(text.size()), result);
+		return result == "prefix" + expected && errors == expectedErrors;
+	}
+}
+
+
 TextConverterTest::TextConverterTest(const std::string& rName): CppUnit::TestCase(rName)
 {
 }
@@ -330,6 +369,50 @@ void TextConverterTest::testErrors()
 }
 
 
+void TextConverterTest::testTranscoder()
+{
+	UTF8Encoding utf8Encoding;
+	UTF16Encoding utf16Encoding;
+	UTF32Encoding utf32Encoding;
+	Latin1Encoding latin1Encoding;
+
+	std::string ascii;
+	for (int i = 0; i < 200; ++i) ascii += static_cast<char>('a' + i % 26);
+	const std::string utf8[] = {
+		"",
+		ascii,
+		ascii + "\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80" + ascii,
+		"\xC3\xA4\xC3\xB6\xC3\xBC" + ascii + "\xC3\x9F",
+		ascii + "\xFF" + ascii,
+		ascii + "\xED\xA0\x80" + ascii,
+		ascii + "\xE2\x82",
+		ascii + "\xC0\x80"
+	};
+	for (const auto& text: utf8)
+	{
+		assertTrue (sameAsGeneric(utf8Encoding, utf8Encoding, text));
+		assertTrue (sameAsGeneric(utf8Encoding, utf16Encoding, text));
+		assertTrue (sameAsGeneric(utf8Encoding, utf32Encoding, text));
+		assertTrue (sameAsGeneric(utf8Encoding, latin1Encoding, text));
+
+		int errors;
+		std::string utf16 = convertGeneric(utf8Encoding, utf16Encoding, text, errors);
+		assertTrue (sameAsGeneric(utf16Encoding, utf8Encoding, utf16));
+		std::string utf32 = convertGeneric(utf8Encoding, utf32Encoding, text, errors);
+		assertTrue (sameAsGeneric(utf32Encoding, utf8Encoding, utf32));
+	}
+
+	std::string latin1;
+	for (int i = 0; i < 512; ++i) latin1 += static_cast<char>(i % 3 ? 'a' + i % 26 : i % 256);
+	assertTrue (sameAsGeneric(latin1Encoding, utf8Encoding, latin1));
+
+	const UInt16 unpaired[] = {'a', 'b', 0xD800, 'c'};
+	assertTrue (sameAsGeneric(utf16Encoding, utf8Encoding, std::string(reinterpret_cast<const char*>(unpaired), sizeof(unpaired))));
+	const UInt32 invalid[] = {'a', 'b', 0x110000, 'c'};
+	assertTrue (sameAsGeneric(utf32Encoding, utf8Encoding, std::string(reinterpret_cast<const char*>(invalid), sizeof(invalid))));
+}
+
+
 void TextConverterTest::setUp()
 {
 }
@@ -354,6 +437,7 @@ CppUnit::Test* TextConverterTest::suite()
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1251toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1252toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testErrors);
+	CppUnit_addTest(pSuite, TextConverterTest, testTranscoder);
 
 	return pSuite;
 }
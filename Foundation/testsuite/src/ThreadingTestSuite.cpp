@@ -15,6 +15,9 @@
 #include "RWLockTest.h"
 #include "ThreadPoolTest.h"
 #include "TimerTest.h"
+#include "TimerWheelTest.h"
+#include "ExecutorTest.h"
+#include "ParallelTest.h"
 #include "ThreadLocalTest.h"
 #include "ActivityTest.h"
 #include "ActiveMethodTest.h"
@@ -32,6 +35,9 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(RWLockTest::suite());
 	pSuite->addTest(ThreadPoolTest::suite());
 	pSuite->addTest(TimerTest::suite());
+	pSuite->addTest(TimerWheelTest::suite());
+	pSuite->addTest(ExecutorTest::suite());
+	pSuite->addTest(ParallelTest::suite());
 	pSuite->addTest(ThreadLocalTest::suite());
 	pSuite->addTest(ActivityTest::suite());
 	pSuite->addTest(ActiveMethodTest::suite());
@@ -0,0 +1,224 @@
+//
+// TimerWheelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "TimerWheelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/TimerWheel.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+
+
+using Poco::TimerWheel;
+using Poco::ThreadPool;
+using Poco::Thread;
+using Poco::Event;
+using Poco::Stopwatch;
+using Poco::AtomicCounter;
+
+
+TimerWheelTest::TimerWheelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+TimerWheelTest::~TimerWheelTest()
+{
+}
+
+
+void TimerWheelTest::testSchedule()
+{
+	TimerWheel wheel;
+	wheel.start();
+
+	Event event;
+	Stopwatch sw;
+	sw.start();
+	wheel.schedule([&event]() { event.set(); }, 100);
+	assertTrue (wheel.size() == 1);
+	event.wait();
+	sw.stop();
+	assertTrue (sw.elapsed() >= 100000 && sw.elapsed() < 200000);
+
+	Thread::sleep(10);
+	assertTrue (wheel.size() == 0);
+	wheel.stop();
+}
+
+
+void TimerWheelTest::testCancel()
+{
+	TimerWheel wheel;
+
+	AtomicCounter count;
+	std::vector<TimerWheel::Handle> handles;
+	for (int i = 0; i < 1000; i++)
+	{
+		handles.push_back(wheel.schedule([&count]() { ++count; }, 50 + i % 100));
+	}
+	assertTrue (wheel.size() == 1000);
+	for (std::size_t i = 0; i < handles.size(); i += 2)
+	{
+		assertTrue (wheel.cancel(handles[i]));
+	}
+	assertTrue (!wheel.cancel(handles[0]));
+	assertTrue (!wheel.cancel(0));
+	assertTrue (wheel.size() == 500);
+
+	// released handles must not cancel timers reusing their slots
+	TimerWheel::Handle reused = wheel.schedule([&count]() { ++count; }, 50);
+	assertTrue (!wheel.cancel(handles[0]));
+	assertTrue (wheel.size() == 501);
+
+	wheel.start();
+	Thread::sleep(300);
+	wheel.stop();
+	assertTrue (count.value() == 501);
+	assertTrue (wheel.size() == 0);
+	assertTrue (!wheel.cancel(reused));
+}
+
+
+void TimerWheelTest::testPeriodic()
+{
+	TimerWheel wheel(10);
+	assertTrue (wheel.tick() == 10);
+	wheel.start();
+
+	AtomicCounter count;
+	Event event;
+	TimerWheel::Handle handle = wheel.schedule([&]()
+		{
+			if (++count == 5) event.set();
+		}, 0, 50);
+	Stopwatch sw;
+	sw.start();
+	event.wait();
+	sw.stop();
+	assertTrue (sw.elapsed() >= 180000 && sw.elapsed() < 400000);
+	assertTrue (wheel.cancel(handle));
+	int n = count.value();
+	Thread::sleep(100);
+	assertTrue (count.value() <= n + 1);
+	assertTrue (wheel.size() == 0);
+	wheel.stop();
+}
+
+
+void TimerWheelTest::testCascade()
+{
+	// with a tick of 1 ms, timers beyond 256 ms are kept
+	// in the upper levels of the wheel and must be moved down
+	// in time
+	TimerWheel wheel;
+	wheel.start();
+
+	Event event;
+	std::vector<int> order;
+	std::vector<Poco::Timestamp::TimeDiff> elapsed;
+	Poco::FastMutex mutex;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 5; i >= 1; i--)
+	{
+		wheel.schedule([&, i]()
+			{
+				Poco::FastMutex::ScopedLock lock(mutex);
+				order.push_back(i);
+				elapsed.push_back(sw.elapsed());
+				if (order.size() == 5) event.set();
+			}, 200*i + 50);
+	}
+	event.wait();
+	for (int i = 0; i < 5; i++)
+	{
+		assertTrue (order[i] == i + 1);
+		assertTrue (elapsed[i] >= 200000*(i + 1) + 50000 && elapsed[i] < 200000*(i + 1) + 150000);
+	}
+	wheel.stop();
+}
+
+
+void TimerWheelTest::testProcess()
+{
+	TimerWheel wheel(5);
+	assertTrue (wheel.nextTimeout() == -1);
+
+	int count = 0;
+	wheel.schedule([&count]() { ++count; }, 20);
+	wheel.schedule([&count]() { ++count; }, 40);
+
+	Stopwatch sw;
+	sw.start();
+	while (count < 2)
+	{
+		long timeout = wheel.nextTimeout();
+		assertTrue (timeout >= 0 && timeout <= 45);
+		if (timeout > 0) Thread::sleep(timeout);
+		wheel.process();
+	}
+	sw.stop();
+	assertTrue (sw.elapsed() >= 40000 && sw.elapsed() < 150000);
+	assertTrue (wheel.nextTimeout() == -1);
+	assertTrue (wheel.process() == 0);
+}
+
+
+void TimerWheelTest::testThreadPool()
+{
+	ThreadPool pool(2, 4);
+	TimerWheel wheel(10);
+	wheel.start(pool);
+
+	AtomicCounter count;
+	Event event;
+	const int timers = 200;
+	for (int i = 0; i < timers; i++)
+	{
+		wheel.schedule([&]()
+			{
+				if (++count == timers) event.set();
+			}, 50);
+	}
+	event.wait();
+	wheel.stop();
+	pool.joinAll();
+	assertTrue (count.value() == timers);
+}
+
+
+void TimerWheelTest::setUp()
+{
+}
+
+
+void TimerWheelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimerWheelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimerWheelTest");
+
+	CppUnit_addTest(pSuite, TimerWheelTest, testSchedule);
+	CppUnit_addTest(pSuite, TimerWheelTest, testCancel);
+	CppUnit_addTest(pSuite, TimerWheelTest, testPeriodic);
+	CppUnit_addTest(pSuite, TimerWheelTest, testCascade);
+	CppUnit_addTest(pSuite, TimerWheelTest, testProcess);
+	CppUnit_addTest(pSuite, TimerWheelTest, testThreadPool);
+
+	return pSuite;
+}
@@ -0,0 +1,340 @@
+//
+// UTFTranscoderTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "UTFTranscoderTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/UTFTranscoder.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+using Poco::UTFTranscoder;
+using Poco::UTF16Char;
+using Poco::UTF32Char;
+using Poco::UTF16String;
+using Poco::UTF32String;
+using Poco::UInt32;
+using Poco::DataFormatException;
+
+
+namespace
+{
+	bool isValid(const std::string& s)
+		/// Straightforward reference implementation.
+	{
+		std::size_t i = 0;
+		while (i < s.size())
+		{
+			unsigned char c = s[i];
+			std::size_t n;
+			UInt32 ch;
+			UInt32 min;
+			if (c < 0x80)
+			{
+				++i;
+				continue;
+			}
+			else if ((c & 0xE0) == 0xC0)
+			{
+				n = 1; ch = c & 0x1F; min = 0x80;
+			}
+			else if ((c & 0xF0) == 0xE0)
+			{
+				n = 2; ch = c & 0x0F; min = 0x800;
+			}
+			else if ((c & 0xF8) == 0xF0)
+			{
+				n = 3; ch = c & 0x07; min = 0x10000;
+			}
+			else return false;
+			if (i + n >= s.size()) return false;
+			for (std::size_t k = 1; k <= n; ++k)
+			{
+				unsigned char cc = s[i + k];
+				if ((cc & 0xC0) != 0x80) return false;
+				ch = (ch << 6) | (cc & 0x3F);
+			}
+			if (ch < min || ch > 0x10FFFF || (ch >= 0xD800 && ch < 0xE000)) return false;
+			i += n + 1;
+		}
+		return true;
+	}
+
+
+	bool isValid(const char* s)
+	{
+		return UTFTranscoder::isValidUTF8(s, std::strlen(s));
+	}
+
+
+	class Generator
+		/// Generates reproducible pseudo-random text.
+	{
+	public:
+		Generator(): _state(12345)
+		{
+		}
+
+		UInt32 next(UInt32 range)
+		{
+			_state = _state*1103515245 + 12345;
+			return (_state >> 8) % range;
+		}
+
+		std::string text(std::size_t length)
+			/// Returns valid UTF-8 text with long ASCII runs
+			/// and characters of all lengths.
+		{
+			static const char* chars[] = {"\xC3\xA4", "\xD0\x96", "\xE2\x82\xAC", "\xEF\xBF\xBD", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF", "\xC2\x80", "\xED\x9F\xBF"};
+			std::string result;
+			while (result.size() < length)
+			{
+				if (next(4) == 0)
+					result += chars[next(8)];
+				else
+					result.append(next(40), static_cast<char>(' ' + next(90)));
+			}
+			return result;
+		}
+
+	private:
+		UInt32 _state;
+	};
+}
+
+
+UTFTranscoderTest::UTFTranscoderTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+UTFTranscoderTest::~UTFTranscoderTest()
+{
+}
+
+
+void UTFTranscoderTest::testValidateUTF8()
+{
+	assertTrue (isValid(""));
+	assertTrue (isValid("abc"));
+	assertTrue (isValid("\xC3\xA4\xC3\xB6\xC3\xBC"));
+	assertTrue (isValid("\xE2\x82\xAC"));
+	assertTrue (isValid("\xF0\x9F\x98\x80"));
+	assertTrue (isValid("\xF4\x8F\xBF\xBF"));
+	assertTrue (isValid("\xED\x9F\xBF"));
+	assertTrue (isValid("\xEE\x80\x80"));
+
+	assertTrue (!isValid("\x80"));
+	assertTrue (!isValid("\xBF"));
+	assertTrue (!isValid("\xC0\x80"));         // overlong
+	assertTrue (!isValid("\xC1\xBF"));         // overlong
+	assertTrue (!isValid("\xE0\x9F\xBF"));     // overlong
+	assertTrue (!isValid("\xF0\x8F\xBF\xBF")); // overlong
+	assertTrue (!isValid("\xED\xA0\x80"));     // surrogate
+	assertTrue (!isValid("\xED\xBF\xBF"));     // surrogate
+	assertTrue (!isValid("\xF4\x90\x80\x80")); // above U+10FFFF
+	assertTrue (!isValid("\xF5\x80\x80\x80"));
+	assertTrue (!isValid("\xFF"));
+	assertTrue (!isValid("\xC3"));             // truncated
+	assertTrue (!isValid("\xE2\x82"));
+	assertTrue (!isValid("\xF0\x9F\x98"));
+	assertTrue (!isValid("\xC3\xA4\xA4"));     // extra continuation
+	assertTrue (!isValid("\xE2\x82\xAC\x80"));
+	assertTrue (!isValid("\xE2\x82" "a"));
+
+	// each case at every position, crossing block boundaries
+	static const char* cases[] = {
+		"\xC3\xA4", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+		"\x80", "\xC0\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+		"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\xA4\xA4", "\xF8\x88\x80\x80\x80"
+	};
+	for (std::size_t k = 0; k < sizeof(cases)/sizeof(cases[0]); ++k)
+	{
+		for (std::size_t pos = 0; pos < 70; ++pos)
+		{
+			std::string s(pos, 'x');
+			s += cases[k];
+			assertTrue (UTFTranscoder::isValidUTF8(s.data(), s.size()) == isValid(s));
+			s.append(70 - pos, 'y');
+			assertTrue (UTFTranscoder::isValidUTF8(s.data(), s.size()) == isValid(s));
+			s += "\xC3\xA4\xE2\x82\xAC";
+			assertTrue (UTFTranscoder::isValidUTF8(s.data(), s.size()) == isValid(s));
+		}
+	}
+}
+
+
+void UTFTranscoderTest::testValidateRandom()
+{
+	Generator gen;
+	for (int i = 0; i < 5000; ++i)
+	{
+		std::string s = gen.text(gen.next(200));
+		assertTrue (UTFTranscoder::isValidUTF8(s.data(), s.size()));
+		if (!s.empty())
+		{
+			// corrupt one or two bytes
+			s[gen.next(static_cast<UInt32>(s.size()))] = static_cast<char>(gen.next(256));
+			if (gen.next(2)) s[gen.next(static_cast<UInt32>(s.size()))] = static_cast<char>(0x80 + gen.next(128));
+			assertTrue (UTFTranscoder::isValidUTF8(s.data(), s.size()) == isValid(s));
+		}
+	}
+}
+
+
+void UTFTranscoderTest::testUTF16()
+{
+	std::string utf8("a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80z");
+	UTF16Char utf16[16];
+	std::size_t n = UTFTranscoder::utf8ToUTF16(utf8.data(), utf8.size(), utf16);
+	assertTrue (n == 6);
+	assertTrue (utf16[0] == 'a');
+	assertTrue (utf16[1] == 0xE4);
+	assertTrue (utf16[2] == 0x20AC);
+	assertTrue (utf16[3] == 0xD83D);
+	assertTrue (utf16[4] == 0xDE00);
+	assertTrue (utf16[5] == 'z');
+
+	char back[64];
+	assertTrue (UTFTranscoder::utf16ToUTF8(utf16, n, back) == utf8.size());
+	assertTrue (std::string(back, utf8.size()) == utf8);
+
+	Generator gen;
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::string s = gen.text(gen.next(300));
+		UTF16String u16(s.size(), 0);
+		u16.resize(UTFTranscoder::utf8ToUTF16(s.data(), s.size(), &u16[0]));
+		std::string s2(3*u16.size(), '\0');
+		s2.resize(UTFTranscoder::utf16ToUTF8(u16.data(), u16.size(), &s2[0]));
+		assertTrue (s2 == s);
+	}
+
+	try
+	{
+		UTFTranscoder::utf8ToUTF16("\xC3", 1, utf16);
+		fail("invalid UTF-8 - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	const UTF16Char unpaired[][3] = {{'a', 0xD800, 'b'}, {'a', 0xDC00, 'b'}, {'a', 'b', 0xD800}};
+	for (int k = 0; k < 3; ++k)
+	{
+		try
+		{
+			UTFTranscoder::utf16ToUTF8(unpaired[k], 3, back);
+			fail("unpaired surrogate - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+}
+
+
+void UTFTranscoderTest::testUTF32()
+{
+	std::string utf8("a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80z");
+	UTF32Char utf32[16];
+	std::size_t n = UTFTranscoder::utf8ToUTF32(utf8.data(), utf8.size(), utf32);
+	assertTrue (n == 5);
+	assertTrue (utf32[0] == 'a');
+	assertTrue (utf32[1] == 0xE4);
+	assertTrue (utf32[2] == 0x20AC);
+	assertTrue (utf32[3] == 0x1F600);
+	assertTrue (utf32[4] == 'z');
+
+	char back[64];
+	assertTrue (UTFTranscoder::utf32ToUTF8(utf32, n, back) == utf8.size());
+	assertTrue (std::string(back, utf8.size()) == utf8);
+
+	Generator gen;
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::string s = gen.text(gen.next(300));
+		UTF32String u32(s.size(), 0);
+		u32.resize(UTFTranscoder::utf8ToUTF32(s.data(), s.size(), &u32[0]));
+		std::string s2(4*u32.size(), '\0');
+		s2.resize(UTFTranscoder::utf32ToUTF8(u32.data(), u32.size(), &s2[0]));
+		assertTrue (s2 == s);
+	}
+
+	const UTF32Char invalid[][2] = {{'a', 0xD800}, {'a', 0x110000}};
+	for (int k = 0; k < 2; ++k)
+	{
+		try
+		{
+			UTFTranscoder::utf32ToUTF8(invalid[k], 2, back);
+			fail("invalid character - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+}
+
+
+void UTFTranscoderTest::testLatin1()
+{
+	std::string latin1;
+	for (int i = 0; i < 1000; ++i) latin1 += static_cast<char>(i % 7 ? 'a' + i % 26 : i % 256);
+
+	std::string utf8(2*latin1.size(), '\0');
+	utf8.resize(UTFTranscoder::latin1ToUTF8(latin1.data(), latin1.size(), &utf8[0]));
+	assertTrue (UTFTranscoder::isValidUTF8(utf8.data(), utf8.size()));
+
+	UTF32String utf32(utf8.size(), 0);
+	utf32.resize(UTFTranscoder::utf8ToUTF32(utf8.data(), utf8.size(), &utf32[0]));
+	assertTrue (utf32.size() == latin1.size());
+	for (std::size_t i = 0; i < latin1.size(); ++i)
+	{
+		assertTrue (utf32[i] == static_cast<unsigned char>(latin1[i]));
+	}
+
+	std::string back(utf8.size(), '\0');
+	back.resize(UTFTranscoder::utf8ToLatin1(utf8.data(), utf8.size(), &back[0]));
+	assertTrue (back == latin1);
+
+	try
+	{
+		UTFTranscoder::utf8ToLatin1("a\xE2\x82\xAC", 4, &back[0]);
+		fail("not representable - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void UTFTranscoderTest::setUp()
+{
+}
+
+
+void UTFTranscoderTest::tearDown()
+{
+}
+
+
+CppUnit::Test* UTFTranscoderTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("UTFTranscoderTest");
+
+	CppUnit_addTest(pSuite, UTFTranscoderTest, testValidateUTF8);
+	CppUnit_addTest(pSuite, UTFTranscoderTest, testValidateRandom);
+	CppUnit_addTest(pSuite, UTFTranscoderTest, testUTF16);
+	CppUnit_addTest(pSuite, UTFTranscoderTest, testUTF32);
+	CppUnit_addTest(pSuite, UTFTranscoderTest, testLatin1);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// UTFTranscoderTest.h
+//
+// Definition of the UTFTranscoderTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef UTFTranscoderTest_INCLUDED
+#define UTFTranscoderTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class UTFTranscoderTest: public CppUnit::TestCase
+{
+public:
+	UTFTranscoderTest(const std::string& name);
+	~UTFTranscoderTest();
+
+	void testValidateUTF8();
+	void testValidateRandom();
+	void testUTF16();
+	void testUTF32();
+	void testLatin1();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // UTFTranscoderTest_INCLUDED
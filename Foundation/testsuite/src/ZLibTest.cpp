@@ -13,9 +13,14 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/InflatingStream.h"
 #include "Poco/DeflatingStream.h"
+#include "Poco/ParallelDeflatingStream.h"
+#include "Poco/ParallelInflatingStream.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/Buffer.h"
+#include "Poco/Executor.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
 #include <sstream>
 
 
@@ -25,7 +30,55 @@ using Poco::DeflatingOutputStream;
 using Poco::DeflatingInputStream;
 using Poco::InflatingStreamBuf;
 using Poco::DeflatingStreamBuf;
+using Poco::ParallelDeflatingOutputStream;
+using Poco::ParallelDeflatingStreamBuf;
+using Poco::ParallelInflatingInputStream;
+using Poco::Executor;
 using Poco::StreamCopier;
+using Poco::DataFormatException;
+
+
+namespace
+{
+	std::string makeText(int lines)
+	{
+		std::string text;
+		for (int i = 0; i < lines; ++i)
+		{
+			text += "This is line ";
+			text += Poco::NumberFormatter::format(i);
+			text += " of the text to be compressed.\n";
+		}
+		return text;
+	}
+
+	std::string parallelDeflate(const std::string& text, Executor& executor, ParallelDeflatingStreamBuf::Format format, std::size_t blockSize)
+	{
+		std::stringstream buffer;
+		ParallelDeflatingOutputStream deflater(buffer, executor, Z_DEFAULT_COMPRESSION, format, blockSize);
+		deflater.write(text.data(), text.size());
+		deflater.close();
+		return buffer.str();
+	}
+
+	std::string inflate(const std::string& data)
+	{
+		std::istringstream istr(data);
+		InflatingInputStream inflater(istr, InflatingStreamBuf::STREAM_GZIP);
+		std::string result;
+		StreamCopier::copyToString(inflater, result);
+		return result;
+	}
+
+	std::string parallelInflate(const std::string& data, Executor& executor)
+	{
+		std::istringstream istr(data);
+		ParallelInflatingInputStream inflater(istr, executor);
+		std::string result;
+		StreamCopier::copyToString(inflater, result);
+		return result;
+	}
+}
 
 
 ZLibTest::ZLibTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -175,6 +228,144 @@ void ZLibTest::testGzip3()
 }
 
 
+void ZLibTest::testParallelGzip1()
+{
+	Executor executor(4);
+	std::string text = makeText(20000);
+
+	const std::size_t blockSizes[] = {1000, 32768, 65536 + 17, 1024*1024};
+	for (std::size_t i = 0; i < sizeof(blockSizes)/sizeof(blockSizes[0]); ++i)
+	{
+		std::string data = parallelDeflate(text, executor, ParallelDeflatingStreamBuf::FORMAT_SINGLE_MEMBER, blockSizes[i]);
+		assertTrue (data.size() < text.size()/4);
+		assertTrue (inflate(data) == text);
+		assertTrue (parallelInflate(data, executor) == text);
+	}
+}
+
+
+void ZLibTest::testParallelGzip2()
+{
+	Executor executor(2);
+
+	std::string data = parallelDeflate("", executor, ParallelDeflatingStreamBuf::FORMAT_SINGLE_MEMBER, 1000);
+	assertTrue (inflate(data).empty());
+	assertTrue (parallelInflate(data, executor).empty());
+
+	std::stringstream buffer;
+	ParallelDeflatingOutputStream deflater(buffer, executor);
+	deflater << "abcdefabcdefabcdefabcdefabcdefabcdef" << std::endl;
+	deflater << "abcdefabcdefabcdefabcdefabcdefabcdef" << std::endl;
+	deflater.close();
+	InflatingInputStream inflater(buffer, InflatingStreamBuf::STREAM_GZIP);
+	std::string line;
+	inflater >> line;
+	assertTrue (line == "abcdefabcdefabcdefabcdefabcdefabcdef");
+	inflater >> line;
+	assertTrue (line == "abcdefabcdefabcdefabcdefabcdefabcdef");
+}
+
+
+void ZLibTest::testParallelGzipMultiMember()
+{
+	Executor executor(4);
+	std::string text = makeText(20000);
+
+	std::string data = parallelDeflate(text, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 10000);
+	assertTrue (parallelInflate(data, executor) == text);
+
+	// the first member can also be read by InflatingInputStream
+	assertTrue (inflate(data) == text.substr(0, 10000));
+
+	data = parallelDeflate("", executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 10000);
+	assertTrue (!data.empty());
+	assertTrue (inflate(data).empty());
+	assertTrue (parallelInflate(data, executor).empty());
+}
+
+
+void ZLibTest::testParallelGzipConcat()
+{
+	Executor executor(4);
+	std::string text1 = makeText(1000);
+	std::string text2 = makeText(5000);
+	std::string text3 = makeText(2000);
+
+	std::stringstream buffer;
+	DeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_GZIP);
+	deflater.write(text1.data(), text1.size());
+	deflater.close();
+	std::string data = buffer.str();
+	data += parallelDeflate(text2, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 4096);
+	data += parallelDeflate(text3, executor, ParallelDeflatingStreamBuf::FORMAT_SINGLE_MEMBER, 4096);
+	data += parallelDeflate(text1, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 4096);
+
+	assertTrue (parallelInflate(data, executor) == text1 + text2 + text3 + text1);
+
+	// trailing data that is not a gzip member is ignored
+	data.append(512, '\0');
+	assertTrue (parallelInflate(data, executor) == text1 + text2 + text3 + text1);
+}
+
+
+void ZLibTest::testParallelGzipCorrupt()
+{
+	Executor executor(2);
+	std::string text = makeText(1000);
+
+	std::string data = parallelDeflate(text, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 4096);
+	data[100] ^= 0x55;
+	std::istringstream istr1(data);
+	ParallelInflatingInputStream inflater1(istr1, executor);
+	std::string result;
+	StreamCopier::copyToString(inflater1, result);
+	assertTrue (inflater1.bad());
+
+	std::istringstream istr2(text);
+	ParallelInflatingInputStream inflater2(istr2, executor);
+	inflater2.get();
+	assertTrue (inflater2.bad());
+}
+
+
+void ZLibTest::testParallelGzipLyingSize()
+{
+	Executor executor(2);
+	std::string text = makeText(10000);
+
+	std::string data = parallelDeflate(text, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 100000);
+	// claim a member size of 0xFFFFFFF0
+	data.replace(16, 4, "\xf0\xff\xff\xff");
+	std::istringstream istr1(data);
+	ParallelInflatingInputStream inflater1(istr1, executor);
+	inflater1.exceptions(std::ios::badbit);
+	try
+	{
+		inflater1.get();
+		fail("lying member size - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	data = parallelDeflate(text, executor, ParallelDeflatingStreamBuf::FORMAT_MULTI_MEMBER, 100000);
+	std::size_t size = static_cast<unsigned char>(data[16]) | (static_cast<unsigned char>(data[17]) << 8) | (static_cast<unsigned char>(data[18]) << 16);
+	// claim an uncompressed size of 0xFFFFFFFF in the first member
+	data.replace(size - 4, 4, "\xff\xff\xff\xff");
+	std::istringstream istr2(data);
+	ParallelInflatingInputStream inflater2(istr2, executor);
+	inflater2.exceptions(std::ios::badbit);
+	try
+	{
+		inflater2.get();
+		fail("lying uncompressed size - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
 void ZLibTest::setUp()
 {
 }
@@ -196,6 +387,12 @@ CppUnit::Test* ZLibTest::suite()
 	CppUnit_addTest(pSuite, ZLibTest, testGzip1);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip2);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip3);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzip1);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzip2);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzipMultiMember);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzipConcat);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzipCorrupt);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzipLyingSize);
 
 	return pSuite;
 }
@@ -31,6 +31,12 @@ public:
 	void testGzip1();
 	void testGzip2();
 	void testGzip3();
+	void testParallelGzip1();
+	void testParallelGzip2();
+	void testParallelGzipMultiMember();
+	void testParallelGzipConcat();
+	void testParallelGzipCorrupt();
+	void testParallelGzipLyingSize();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,117 @@
+//
+// Document.h
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Definition of the Document class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef JSON_Document_INCLUDED
+#define JSON_Document_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/JSON/Value.h"
+#include "Poco/SharedPtr.h"
+#include <istream>
+#include <vector>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API Document
+	/// Document is an immutable, compact in-memory representation
+	/// of a parsed JSON document.
+	///
+	/// As opposed to Object and Array, which hold every value in a
+	/// Dynamic::Var and every container in its own heap object, all
+	/// values, strings and containers of a Document are stored in a
+	/// few large memory blocks (an arena), which are released together
+	/// when the Document is destroyed:
+	///
+	///   - every value is a 16 byte tagged node,
+	///   - array elements and object members are stored in
+	///     contiguous arrays,
+	///   - objects with more than INDEX_THRESHOLD members get
+	///     a hash index for key lookups; smaller objects are
+	///     searched linearly.
+	///
+	/// Values are accessed through the Value handle returned by root():
+	///
+	///     Document doc(istr);
+	///     Value name = doc.root().get("person").get("name");
+	///     if (name.isString()) std::cout << name.getString() << std::endl;
+	///
+	/// A Document::Ptr (or a Value) held in a Dynamic::Var can be used
+	/// with Query and Stringifier.
+{
+public:
+	typedef SharedPtr<Document> Ptr;
+
+	static const std::size_t INDEX_THRESHOLD = 8;
+	static const std::size_t BLOCK_SIZE = 65536;
+
+	explicit Document(const std::string& json);
+		/// Creates the Document by parsing the given string.
+		/// Throws a JSONException if the string is not valid JSON.
+
+	explicit Document(std::istream& istr);
+		/// Creates the Document by parsing the given stream.
+		/// Throws a JSONException if the stream content is not valid JSON.
+
+	~Document();
+		/// Destroys the Document and releases all memory held by it.
+
+	Value root() const;
+		/// Returns the top-level value of the document.
+
+	std::size_t memoryUsage() const;
+		/// Returns the number of bytes allocated for the document.
+
+private:
+	Document(const Document&);
+	Document& operator = (const Document&);
+
+	class Builder;
+
+	void parse(std::istream& istr);
+	void* allocate(std::size_t size);
+	const char* copyString(const StringRef& str);
+
+	std::vector<char*> _blocks;
+	char*              _pFree;
+	std::size_t        _available;
+	std::size_t        _allocated;
+	Value::Node*       _pRoot;
+};
+
+
+//
+// inlines
+//
+inline Value Document::root() const
+{
+	return Value(_pRoot);
+}
+
+
+inline std::size_t Document::memoryUsage() const
+{
+	return _allocated;
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_Document_INCLUDED
@@ -80,6 +80,10 @@ protected:
 
 	Dynamic::Var parseImpl(std::istream& in);
 		/// Parses JSON from an input stream.
+		///
+		/// Unless comments are allowed, the stream is parsed
+		/// incrementally, reading chunks of the buffer size
+		/// given in the constructor.
 
 	void setHandlerImpl(const Handler::Ptr& pHandler);
 		/// Set the Handler.
@@ -106,6 +110,7 @@ private:
 
 	json_stream*  _pJSON;
 	Handler::Ptr _pHandler;
+	std::size_t  _bufSize;
 	int          _depth;
 	char         _decimalPoint;
 	bool         _allowNullByte;
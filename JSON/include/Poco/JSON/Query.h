@@ -21,6 +21,7 @@
 #include "Poco/JSON/JSON.h"
 #include "Poco/JSON/Object.h"
 #include "Poco/JSON/Array.h"
+#include "Poco/JSON/Document.h"
 
 
 namespace Poco {
@@ -35,8 +36,11 @@ public:
 		/// Creates a Query/
 		///
 		/// Source must be JSON Object, Array, Object::Ptr,
-		/// Array::Ptr or empty Var. Any other type will trigger throwing of
-		/// InvalidArgumentException.
+		/// Array::Ptr, Document::Ptr, Value or empty Var. Any other type
+		/// will trigger throwing of InvalidArgumentException.
+		///
+		/// When querying a Document, the Document must outlive the Query
+		/// and the values found, unless the source is a Document::Ptr.
 		///
 		/// Creating Query holding Ptr will typically result in faster
 		/// performance.
@@ -52,7 +56,8 @@ public:
 		/// is returned.
 		/// If object (as opposed to a pointer to object) is held
 		/// internally, a shared pointer to new (heap-allocated) Object is
-		/// returned; this may be expensive operation.
+		/// returned; this may be expensive operation. The same applies
+		/// to objects found in a Document.
 
 	Object& findObject(const std::string& path, Object& obj) const;
 		/// Search for an object.
@@ -69,7 +74,8 @@ public:
 		/// is returned.
 		/// If array (as opposed to a pointer to array) is held
 		/// internally, a shared pointer to new (heap-allocated) Object is
-		/// returned; this may be expensive operation.
+		/// returned; this may be expensive operation. The same applies
+		/// to arrays found in a Document.
 
 	Array& findArray(const std::string& path, Array& obj) const;
 		/// Search for an array.
@@ -84,6 +90,11 @@ public:
 		/// Example: "person.children[0].name" will return the
 		/// the name of the first child. When the value can't be found
 		/// an empty value is returned.
+		///
+		/// When querying a Document, objects and arrays are returned
+		/// as Value, and all other values as the corresponding scalar
+		/// type (Int64, UInt64, double, bool or std::string); null is
+		/// returned as an empty value.
 
 	template<typename T>
 	T findValue(const std::string& path, const T& def) const
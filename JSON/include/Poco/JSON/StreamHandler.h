@@ -0,0 +1,93 @@
+//
+// StreamHandler.h
+//
+// Library: JSON
+// Package: JSON
+// Module:  StreamParser
+//
+// Definition of the StreamHandler class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef JSON_StreamHandler_INCLUDED
+#define JSON_StreamHandler_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/StringRef.h"
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API StreamHandler
+	/// Interface for handling parsing events generated by the StreamParser.
+	///
+	/// Unlike Handler, keys and string values are passed as StringRef
+	/// referring to the parser's internal buffer, and numbers are passed
+	/// already converted. A StringRef is only valid for the duration of
+	/// the callback; a handler that needs to keep the value must copy it.
+{
+public:
+	StreamHandler();
+		/// Creates the StreamHandler.
+
+	virtual ~StreamHandler();
+		/// Destroys the StreamHandler.
+
+	virtual void startDocument();
+		/// The parser is about to read a new top-level value.
+		///
+		/// The default implementation does nothing.
+
+	virtual void endDocument();
+		/// The parser has completely read a top-level value.
+		///
+		/// The default implementation does nothing.
+
+	virtual void startObject() = 0;
+		/// The parser has read a {, meaning a new object will be read.
+
+	virtual void endObject() = 0;
+		/// The parser has read a }, meaning the object is read.
+
+	virtual void startArray() = 0;
+		/// The parser has read a [, meaning a new array will be read.
+
+	virtual void endArray() = 0;
+		/// The parser has read a ], meaning the array is read.
+
+	virtual void key(const StringRef& k) = 0;
+		/// A key of an object is read.
+
+	virtual void null() = 0;
+		/// A null value is read.
+
+	virtual void value(Int64 v) = 0;
+		/// An integer value is read.
+
+	virtual void value(UInt64 v) = 0;
+		/// An unsigned integer value is read. This will only be
+		/// triggered if the value cannot fit into a signed 64-bit integer.
+
+	virtual void value(double d) = 0;
+		/// A floating point value is read.
+
+	virtual void value(bool b) = 0;
+		/// A boolean value is read.
+
+	virtual void value(const StringRef& s) = 0;
+		/// A string value is read. Escape sequences are already decoded.
+};
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_StreamHandler_INCLUDED
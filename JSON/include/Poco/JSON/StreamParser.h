@@ -0,0 +1,192 @@
+//
+// StreamParser.h
+//
+// Library: JSON
+// Package: JSON
+// Module:  StreamParser
+//
+// Definition of the StreamParser class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef JSON_StreamParser_INCLUDED
+#define JSON_StreamParser_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/JSON/StreamHandler.h"
+#include "Poco/StringRef.h"
+#include "Poco/Buffer.h"
+#include <istream>
+#include <vector>
+
+
+struct json_stream;
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API StreamParser
+	/// StreamParser is an incremental JSON parser reading from an
+	/// input stream in chunks of a fixed size.
+	///
+	/// The parser never holds more than one chunk of input and the
+	/// current token in memory, so it can be used for documents of
+	/// arbitrary size, as well as for a sequence of concatenated or
+	/// newline-delimited documents (NDJSON), e.g. log files:
+	///
+	///     std::ifstream istr("events.ndjson");
+	///     StreamParser parser(istr);
+	///     EventHandler handler;
+	///     parser.parse(handler);
+	///
+	/// Tokens can either be pushed to a StreamHandler (parse(),
+	/// parseDocument()), or pulled one by one (next()):
+	///
+	///     StreamParser::Token token;
+	///     while ((token = parser.next()) != StreamParser::TOKEN_END)
+	///     {
+	///         if (token == StreamParser::TOKEN_KEY && parser.text() == "level")
+	///             ...
+	///     }
+	///
+	/// Keys and strings are delivered as StringRef into the parser's
+	/// token buffer, without copying; they stay valid until the next
+	/// token is read.
+	///
+	/// Comments are not supported.
+{
+public:
+	enum Token
+	{
+		TOKEN_OBJECT_START,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_START,
+		TOKEN_ARRAY_END,
+		TOKEN_KEY,
+		TOKEN_STRING,
+		TOKEN_NUMBER,
+		TOKEN_TRUE,
+		TOKEN_FALSE,
+		TOKEN_NULL,
+		TOKEN_DOCUMENT_END,
+			/// A top-level value has been completely read.
+		TOKEN_END
+			/// The end of the input stream has been reached.
+	};
+
+	static const std::size_t DEFAULT_BUFFER_SIZE = 65536;
+
+	explicit StreamParser(std::istream& istr, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the StreamParser, reading from istr in chunks of bufferSize bytes.
+
+	~StreamParser();
+		/// Destroys the StreamParser.
+
+	Token next();
+		/// Reads and returns the next token.
+		///
+		/// Returns TOKEN_DOCUMENT_END after each top-level value, and
+		/// TOKEN_END once the input is exhausted. Throws a JSONException
+		/// if the input is not valid JSON.
+
+	StringRef text() const;
+		/// Returns the text of the current key, string or number token.
+		/// For other tokens, an empty reference is returned.
+		///
+		/// The reference is valid until the next token is read.
+
+	Int64 asInt64() const;
+		/// Returns the current number token as Int64.
+		/// Throws a SyntaxException if the number is not an integer
+		/// or does not fit into an Int64.
+
+	UInt64 asUInt64() const;
+		/// Returns the current number token as UInt64.
+		/// Throws a SyntaxException if the number is not a non-negative
+		/// integer or does not fit into an UInt64.
+
+	double asDouble() const;
+		/// Returns the current number token as double.
+		/// Throws a SyntaxException if the number is out of range.
+
+	void skip();
+		/// If the current token is TOKEN_OBJECT_START or TOKEN_ARRAY_START,
+		/// skips the tokens up to and including the matching end token.
+		/// If the current token is TOKEN_KEY, skips the key's value.
+		/// Otherwise, does nothing.
+
+	bool parseDocument(StreamHandler& handler);
+		/// Reads the next top-level value and passes its tokens to
+		/// the handler. Returns false if the input is exhausted.
+
+	std::size_t parse(StreamHandler& handler);
+		/// Reads all remaining top-level values, passing their tokens
+		/// to the handler, and returns the number of values read.
+
+	std::size_t documentCount() const;
+		/// Returns the number of completely read top-level values.
+
+	std::size_t lineNumber() const;
+		/// Returns the current line number in the input.
+
+private:
+	StreamParser(const StreamParser&);
+	StreamParser& operator = (const StreamParser&);
+
+	enum State
+	{
+		ST_START,
+		ST_DOCUMENT,
+		ST_DOCUMENT_END,
+		ST_END
+	};
+
+	static int get(void* pUser);
+	static int peek(void* pUser);
+	bool fill();
+	bool skipWhitespace();
+	void valueRead();
+	void dispatch(Token token, StreamHandler& handler);
+	void checkNumber() const;
+
+	std::istream&     _istr;
+	Buffer<char>      _buffer;
+	const char*       _pCur;
+	const char*       _pEnd;
+	json_stream*      _pJSON;
+	State             _state;
+	Token             _token;
+	std::vector<bool> _containers;
+	bool              _expectKey;
+	std::size_t       _documentCount;
+	std::size_t       _lineNumber;
+};
+
+
+//
+// inlines
+//
+inline std::size_t StreamParser::documentCount() const
+{
+	return _documentCount;
+}
+
+
+inline std::size_t StreamParser::lineNumber() const
+{
+	return _lineNumber;
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_StreamParser_INCLUDED
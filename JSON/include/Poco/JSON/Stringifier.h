@@ -52,6 +52,9 @@ public:
 		///
 		/// If JSON_ESCAPE_UNICODE is in options, all unicode characters will be escaped, otherwise
 		/// only the compulsory ones.
+		///
+		/// Besides JSON Object, Array and pointers thereof, the value can also be
+		/// a Document::Ptr or a Value.
 
 	static void formatString(const std::string& value, std::ostream& out, int options = Poco::JSON_WRAP_STRINGS);
 		/// Formats the JSON string and streams it into ostream.
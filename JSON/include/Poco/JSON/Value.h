@@ -0,0 +1,310 @@
+//
+// Value.h
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Definition of the Value class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef JSON_Value_INCLUDED
+#define JSON_Value_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/StringRef.h"
+#include "Poco/JSONString.h"
+#include "Poco/Dynamic/Var.h"
+#include <ostream>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class Document;
+
+
+class JSON_API Value
+	/// Value is a lightweight, read-only handle to a value
+	/// in a Document.
+	///
+	/// A Value consists of a single pointer and can be freely copied;
+	/// it (and all strings obtained from it) is only valid as long as
+	/// the Document it belongs to exists.
+	///
+	/// A default-constructed Value, as well as the result of a lookup
+	/// that did not find anything, is empty. All accessors can be
+	/// safely called on an empty Value; isEmpty() returns true,
+	/// size() returns 0 and lookups return empty Values.
+{
+public:
+	enum Type
+	{
+		VALUE_NULL,
+		VALUE_BOOLEAN,
+		VALUE_INTEGER,
+		VALUE_UNSIGNED,
+			/// An integer too large for an Int64.
+		VALUE_DOUBLE,
+		VALUE_STRING,
+		VALUE_ARRAY,
+		VALUE_OBJECT
+	};
+
+	Value();
+		/// Creates an empty Value.
+
+	bool isEmpty() const;
+		/// Returns true if the Value does not refer to a value.
+
+	Type type() const;
+		/// Returns the type of the value.
+		/// Throws an InvalidAccessException if the Value is empty.
+
+	bool isNull() const;
+		/// Returns true if the value is a JSON null.
+
+	bool isBoolean() const;
+		/// Returns true if the value is true or false.
+
+	bool isInteger() const;
+		/// Returns true if the value is an integral number.
+
+	bool isNumeric() const;
+		/// Returns true if the value is a number.
+
+	bool isString() const;
+		/// Returns true if the value is a string.
+
+	bool isArray() const;
+		/// Returns true if the value is an array.
+
+	bool isObject() const;
+		/// Returns true if the value is an object.
+
+	bool getBool() const;
+		/// Returns the value of a boolean.
+		/// Throws a BadCastException if the value is not a boolean.
+
+	Int64 getInt64() const;
+		/// Returns the value of a number as Int64.
+		/// Throws a BadCastException if the value is not a number,
+		/// or a RangeException if it does not fit into an Int64.
+
+	UInt64 getUInt64() const;
+		/// Returns the value of a number as UInt64.
+		/// Throws a BadCastException if the value is not a number,
+		/// or a RangeException if it does not fit into an UInt64.
+
+	double getDouble() const;
+		/// Returns the value of a number as double.
+		/// Throws a BadCastException if the value is not a number.
+
+	StringRef getString() const;
+		/// Returns the value of a string.
+		/// Throws a BadCastException if the value is not a string.
+
+	std::size_t size() const;
+		/// Returns the number of elements of an array, the number
+		/// of members of an object, or zero for all other values.
+
+	Value operator [] (std::size_t index) const;
+		/// Returns the array element at the given index, or an empty
+		/// Value if the index is out of range or the value is not an array.
+
+	Value get(const StringRef& key) const;
+		/// Returns the value of the object member with the given key,
+		/// or an empty Value if there is no such member or the value
+		/// is not an object.
+		///
+		/// Objects with few members are searched linearly; larger
+		/// objects are indexed by a hash table built at parse time.
+		/// If a key occurs more than once, the last value is returned.
+
+	bool has(const StringRef& key) const;
+		/// Returns true if the value is an object having
+		/// a member with the given key.
+
+	StringRef keyAt(std::size_t index) const;
+		/// Returns the key of the object member at the given index
+		/// (in document order). Throws a RangeException if the index
+		/// is out of range or the value is not an object.
+
+	Value valueAt(std::size_t index) const;
+		/// Returns the value of the object member at the given index
+		/// (in document order), or an empty Value if the index is out
+		/// of range or the value is not an object.
+
+	Dynamic::Var toVar() const;
+		/// Converts the value into a Dynamic::Var, creating
+		/// (insertion order preserving) Object::Ptr and Array::Ptr
+		/// for objects and arrays, respectively. Empty and null
+		/// values are converted to an empty Var.
+
+	void stringify(std::ostream& out, unsigned int indent = 0, int step = -1, int options = Poco::JSON_WRAP_STRINGS) const;
+		/// Writes the value to the output stream, formatted the same
+		/// way as Object and Array do. An empty Value is written as null.
+
+	bool operator == (const Value& other) const;
+		/// Returns true if both Values refer to the same value.
+
+	bool operator != (const Value& other) const;
+		/// Returns true if the Values refer to different values.
+
+private:
+	struct Member;
+	struct ObjectData;
+
+	struct Node
+	{
+		UInt32 type;
+		UInt32 size;
+		union
+		{
+			bool              b;
+			Int64             i;
+			UInt64            u;
+			double            d;
+			const char*       s;
+			const Node*       elements;
+			const ObjectData* object;
+		} data;
+	};
+
+	struct Member
+	{
+		const char* key;
+		UInt32      keySize;
+		UInt32      hash;
+		Node        value;
+	};
+
+	struct ObjectData
+	{
+		const Member* members;
+		const UInt32* index;
+			/// Hash index (member position + 1, 0 for empty slots),
+			/// or null for small objects.
+		UInt32        indexMask;
+	};
+
+	explicit Value(const Node* pNode);
+
+	static UInt32 hash(const char* key, std::size_t size);
+	const Node& node() const;
+	void checkType(Type type) const;
+	void stringifyImpl(std::ostream& out, unsigned int indent, int step, int options, std::string& buffer) const;
+
+	const Node* _pNode;
+
+	friend class Document;
+};
+
+
+//
+// inlines
+//
+inline Value::Value():
+	_pNode(0)
+{
+}
+
+
+inline Value::Value(const Node* pNode):
+	_pNode(pNode)
+{
+}
+
+
+inline bool Value::isEmpty() const
+{
+	return _pNode == 0;
+}
+
+
+inline bool Value::isNull() const
+{
+	return _pNode && _pNode->type == VALUE_NULL;
+}
+
+
+inline bool Value::isBoolean() const
+{
+	return _pNode && _pNode->type == VALUE_BOOLEAN;
+}
+
+
+inline bool Value::isInteger() const
+{
+	return _pNode && (_pNode->type == VALUE_INTEGER || _pNode->type == VALUE_UNSIGNED);
+}
+
+
+inline bool Value::isNumeric() const
+{
+	return _pNode && (_pNode->type == VALUE_INTEGER || _pNode->type == VALUE_UNSIGNED || _pNode->type == VALUE_DOUBLE);
+}
+
+
+inline bool Value::isString() const
+{
+	return _pNode && _pNode->type == VALUE_STRING;
+}
+
+
+inline bool Value::isArray() const
+{
+	return _pNode && _pNode->type == VALUE_ARRAY;
+}
+
+
+inline bool Value::isObject() const
+{
+	return _pNode && _pNode->type == VALUE_OBJECT;
+}
+
+
+inline std::size_t Value::size() const
+{
+	return (isArray() || isObject()) ? _pNode->size : 0;
+}
+
+
+inline Value Value::operator [] (std::size_t index) const
+{
+	if (isArray() && index < _pNode->size)
+		return Value(_pNode->data.elements + index);
+	return Value();
+}
+
+
+inline bool Value::has(const StringRef& key) const
+{
+	return !get(key).isEmpty();
+}
+
+
+inline bool Value::operator == (const Value& other) const
+{
+	return _pNode == other._pNode;
+}
+
+
+inline bool Value::operator != (const Value& other) const
+{
+	return _pNode != other._pNode;
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_Value_INCLUDED
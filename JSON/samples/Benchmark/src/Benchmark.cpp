@@ -13,6 +13,8 @@
 #include "Poco/JSON/Parser.h"
 #include "Poco/JSON/ParseHandler.h"
 #include "Poco/JSON/JSONException.h"
+#include "Poco/JSON/Document.h"
+#include "Poco/JSON/Query.h"
 #include "Poco/Environment.h"
 #include "Poco/Path.h"
 #include "Poco/File.h"
@@ -114,5 +116,76 @@ int main(int argc, char** argv)
 		std::cout << jsone.message() << std::endl;
 	}
 
+	std::cout << "POCO JSON Object vs. Document" << std::endl;
+	try
+	{
+		Poco::JSON::Parser parser;
+		sw.restart();
+		Poco::Dynamic::Var result = parser.parse(jsonStr);
+		sw.stop();
+		std::cout << "-----------------------------------------" << std::endl;
+		std::cout << "[Object] parsed/handled in " << sw.elapsed() << " [us]" << std::endl;
+
+		sw.restart();
+		Poco::JSON::Document::Ptr pDoc = new Poco::JSON::Document(jsonStr);
+		sw.stop();
+		std::cout << "[Document] parsed in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << "[Document] uses " << pDoc->memoryUsage() << " bytes" << std::endl;
+		std::cout << "-----------------------------------------" << std::endl;
+
+		// look up a member of every element of the "result" array
+		Poco::JSON::Object::Ptr pObject = result.extract<Poco::JSON::Object::Ptr>();
+		Poco::JSON::Array::Ptr pResult = pObject->getArray("result");
+		Poco::Int64 objectSum = 0;
+		sw.restart();
+		if (pResult)
+		{
+			for (std::size_t i = 0; i < pResult->size(); ++i)
+				objectSum += pResult->getObject(static_cast<unsigned>(i))->getValue<Poco::Int64>("age");
+		}
+		sw.stop();
+		std::cout << "[Object] " << (pResult ? pResult->size() : 0) << " lookups in " << sw.elapsed() << " [us] (sum " << objectSum << ")" << std::endl;
+
+		Poco::JSON::Value docResult = pDoc->root().get("result");
+		Poco::Int64 documentSum = 0;
+		sw.restart();
+		for (std::size_t i = 0; i < docResult.size(); ++i)
+			documentSum += docResult[i].get("age").getInt64();
+		sw.stop();
+		std::cout << "[Document] " << docResult.size() << " lookups in " << sw.elapsed() << " [us] (sum " << documentSum << ")" << std::endl;
+		std::cout << "-----------------------------------------" << std::endl;
+
+		Poco::JSON::Query objectQuery(pObject);
+		sw.restart();
+		Poco::Dynamic::Var objectName = objectQuery.find("result[9999].name");
+		sw.stop();
+		std::cout << "[Object] queried in " << sw.elapsed() << " [us]" << std::endl;
+
+		Poco::JSON::Query documentQuery(pDoc);
+		sw.restart();
+		Poco::Dynamic::Var documentName = documentQuery.find("result[9999].name");
+		sw.stop();
+		std::cout << "[Document] queried in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << "-----------------------------------------" << std::endl;
+
+		std::ostringstream objectOut;
+		sw.restart();
+		pObject->stringify(objectOut);
+		sw.stop();
+		std::cout << "[Object] stringified in " << sw.elapsed() << " [us]" << std::endl;
+
+		std::ostringstream documentOut;
+		sw.restart();
+		pDoc->root().stringify(documentOut);
+		sw.stop();
+		std::cout << "[Document] stringified in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << "-----------------------------------------" << std::endl;
+		std::cout << std::endl;
+	}
+	catch(Poco::Exception& exc)
+	{
+		std::cout << exc.displayText() << std::endl;
+	}
+
 	return 0;
 }
@@ -0,0 +1,339 @@
+//
+// Document.cpp
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/JSON/Document.h"
+#include "Poco/JSON/StreamParser.h"
+#include "Poco/JSON/StreamHandler.h"
+#include "Poco/JSON/JSONException.h"
+#include "Poco/MemoryStream.h"
+#undef min
+#undef max
+#include <limits>
+#include <cstring>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class Document::Builder: public StreamHandler
+	/// Builds the nodes of a Document from the events of a StreamParser.
+	///
+	/// The values of all open containers are collected on a single
+	/// stack; when a container is closed, its values are moved into
+	/// the document's arena in one contiguous array.
+{
+public:
+	Builder(Document& document):
+		_document(document),
+		_pKey(0),
+		_keySize(0),
+		_hash(0)
+	{
+	}
+
+	void startObject()
+	{
+		start(true);
+	}
+
+	void endObject()
+	{
+		end();
+	}
+
+	void startArray()
+	{
+		start(false);
+	}
+
+	void endArray()
+	{
+		end();
+	}
+
+	void key(const StringRef& k)
+	{
+		_pKey = _document.copyString(k);
+		_keySize = size32(k.size());
+		_hash = Value::hash(k.data(), k.size());
+	}
+
+	void null()
+	{
+		Value::Node node;
+		node.type = Value::VALUE_NULL;
+		node.size = 0;
+		node.data.u = 0;
+		add(node);
+	}
+
+	void value(Int64 v)
+	{
+		Value::Node node;
+		node.type = Value::VALUE_INTEGER;
+		node.size = 0;
+		node.data.i = v;
+		add(node);
+	}
+
+	void value(UInt64 v)
+	{
+		Value::Node node;
+		node.type = Value::VALUE_UNSIGNED;
+		node.size = 0;
+		node.data.u = v;
+		add(node);
+	}
+
+	void value(double d)
+	{
+		Value::Node node;
+		node.type = Value::VALUE_DOUBLE;
+		node.size = 0;
+		node.data.d = d;
+		add(node);
+	}
+
+	void value(bool b)
+	{
+		Value::Node node;
+		node.type = Value::VALUE_BOOLEAN;
+		node.size = 0;
+		node.data.u = 0;
+		node.data.b = b;
+		add(node);
+	}
+
+	void value(const StringRef& s)
+	{
+		Value::Node node;
+		node.type = Value::VALUE_STRING;
+		node.size = size32(s.size());
+		node.data.s = _document.copyString(s);
+		add(node);
+	}
+
+	const Value::Node& result() const
+	{
+		poco_assert (_values.size() == 1 && _frames.empty());
+
+		return _values.front().value;
+	}
+
+private:
+	struct Frame
+	{
+		std::size_t start;
+		bool        object;
+		const char* pKey;
+		UInt32      keySize;
+		UInt32      hash;
+	};
+
+	static UInt32 size32(std::size_t size)
+	{
+		if (size > std::numeric_limits<UInt32>::max())
+			throw JSONException("JSON value too large.");
+		return static_cast<UInt32>(size);
+	}
+
+	void start(bool object)
+	{
+		Frame frame = { _values.size(), object, _pKey, _keySize, _hash };
+		_frames.push_back(frame);
+	}
+
+	void end()
+	{
+		Frame frame = _frames.back();
+		_frames.pop_back();
+
+		std::size_t count = _values.size() - frame.start;
+		const Value::Member* pFirst = count ? &_values[frame.start] : 0;
+
+		Value::Node node;
+		node.size = size32(count);
+		if (frame.object)
+		{
+			node.type = Value::VALUE_OBJECT;
+			node.data.object = makeObject(pFirst, count);
+		}
+		else
+		{
+			node.type = Value::VALUE_ARRAY;
+			Value::Node* pElements = 0;
+			if (count)
+			{
+				pElements = static_cast<Value::Node*>(_document.allocate(count*sizeof(Value::Node)));
+				for (std::size_t i = 0; i < count; ++i)
+					pElements[i] = pFirst[i].value;
+			}
+			node.data.elements = pElements;
+		}
+		_values.resize(frame.start);
+
+		_pKey = frame.pKey;
+		_keySize = frame.keySize;
+		_hash = frame.hash;
+		add(node);
+	}
+
+	const Value::ObjectData* makeObject(const Value::Member* pFirst, std::size_t count)
+	{
+		Value::ObjectData* pObject = static_cast<Value::ObjectData*>(_document.allocate(sizeof(Value::ObjectData)));
+		Value::Member* pMembers = 0;
+		if (count)
+		{
+			pMembers = static_cast<Value::Member*>(_document.allocate(count*sizeof(Value::Member)));
+			std::memcpy(pMembers, pFirst, count*sizeof(Value::Member));
+		}
+		pObject->members = pMembers;
+		pObject->index = 0;
+		pObject->indexMask = 0;
+
+		if (count > INDEX_THRESHOLD)
+		{
+			std::size_t slots = 1;
+			while (slots < 2*count) slots <<= 1;
+			UInt32* pIndex = static_cast<UInt32*>(_document.allocate(slots*sizeof(UInt32)));
+			std::memset(pIndex, 0, slots*sizeof(UInt32));
+			UInt32 mask = static_cast<UInt32>(slots - 1);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Value::Member& member = pMembers[i];
+				UInt32 slot = member.hash & mask;
+				while (pIndex[slot])
+				{
+					const Value::Member& other = pMembers[pIndex[slot] - 1];
+					if (other.hash == member.hash && other.keySize == member.keySize &&
+						std::memcmp(other.key, member.key, member.keySize) == 0)
+						break; // duplicate key, last one wins
+					slot = (slot + 1) & mask;
+				}
+				pIndex[slot] = static_cast<UInt32>(i + 1);
+			}
+			pObject->index = pIndex;
+			pObject->indexMask = mask;
+		}
+		return pObject;
+	}
+
+	void add(const Value::Node& node)
+	{
+		Value::Member member;
+		member.key = _pKey;
+		member.keySize = _keySize;
+		member.hash = _hash;
+		member.value = node;
+		_values.push_back(member);
+	}
+
+	Document&                  _document;
+	std::vector<Value::Member> _values;
+	std::vector<Frame>         _frames;
+	const char*                _pKey;
+	UInt32                     _keySize;
+	UInt32                     _hash;
+};
+
+
+Document::Document(const std::string& json):
+	_pFree(0),
+	_available(0),
+	_allocated(0),
+	_pRoot(0)
+{
+	MemoryInputStream istr(json.data(), json.size());
+	parse(istr);
+}
+
+
+Document::Document(std::istream& istr):
+	_pFree(0),
+	_available(0),
+	_allocated(0),
+	_pRoot(0)
+{
+	parse(istr);
+}
+
+
+Document::~Document()
+{
+	for (std::vector<char*>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+		delete [] *it;
+}
+
+
+void Document::parse(std::istream& istr)
+{
+	try
+	{
+		StreamParser parser(istr);
+		Builder builder(*this);
+		if (!parser.parseDocument(builder))
+			throw JSONException("No JSON found.");
+		if (parser.next() != StreamParser::TOKEN_END)
+			throw JSONException("Excess characters found after JSON end.");
+
+		_pRoot = static_cast<Value::Node*>(allocate(sizeof(Value::Node)));
+		*_pRoot = builder.result();
+	}
+	catch (...)
+	{
+		for (std::vector<char*>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+			delete [] *it;
+		throw;
+	}
+}
+
+
+void* Document::allocate(std::size_t size)
+{
+	const std::size_t ALIGNMENT = 8;
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (size > _available)
+	{
+		if (size > BLOCK_SIZE/4)
+		{
+			// large arrays get a block of their own, so that
+			// the remainder of the current block is not wasted
+			char* pBlock = new char[size];
+			_blocks.push_back(pBlock);
+			_allocated += size;
+			return pBlock;
+		}
+		_pFree = new char[BLOCK_SIZE];
+		_blocks.push_back(_pFree);
+		_available = BLOCK_SIZE;
+		_allocated += BLOCK_SIZE;
+	}
+	void* p = _pFree;
+	_pFree += size;
+	_available -= size;
+	return p;
+}
+
+
+const char* Document::copyString(const StringRef& str)
+{
+	char* p = static_cast<char*>(allocate(str.size() + 1));
+	std::memcpy(p, str.data(), str.size());
+	p[str.size()] = '\0';
+	return p;
+}
+
+
+} } // namespace Poco::JSON
@@ -14,6 +14,7 @@
 
 #include "Poco/JSON/Parser.h"
 #include "Poco/JSON/JSONException.h"
+#include "Poco/JSON/StreamParser.h"
 #include "Poco/Ascii.h"
 #include "Poco/Token.h"
 #include "Poco/UTF8Encoding.h"
@@ -24,6 +25,7 @@
 #include <limits>
 #include <clocale>
 #include <istream>
+#include <cstring>
 #include "pdjson.h"
 
 
@@ -31,9 +33,92 @@ namespace Poco {
 namespace JSON {
 
 
-ParserImpl::ParserImpl(const Handler::Ptr& pHandler, std::size_t /*bufSize*/):
+namespace
+{
+	class HandlerAdapter: public StreamHandler
+		/// Forwards the events of a StreamParser to a Handler.
+	{
+	public:
+		HandlerAdapter(const Handler::Ptr& pHandler, bool allowNullByte):
+			_pHandler(pHandler),
+			_allowNullByte(allowNullByte)
+		{
+		}
+
+		void startObject()
+		{
+			if (_pHandler) _pHandler->startObject();
+		}
+
+		void endObject()
+		{
+			if (_pHandler) _pHandler->endObject();
+		}
+
+		void startArray()
+		{
+			if (_pHandler) _pHandler->startArray();
+		}
+
+		void endArray()
+		{
+			if (_pHandler) _pHandler->endArray();
+		}
+
+		void key(const StringRef& k)
+		{
+			checkNullByte(k);
+			if (_pHandler) _pHandler->key(k.toString());
+		}
+
+		void null()
+		{
+			if (_pHandler) _pHandler->null();
+		}
+
+		void value(Int64 v)
+		{
+			if (_pHandler) _pHandler->value(v);
+		}
+
+		void value(UInt64 v)
+		{
+			if (_pHandler) _pHandler->value(v);
+		}
+
+		void value(double d)
+		{
+			if (_pHandler) _pHandler->value(d);
+		}
+
+		void value(bool b)
+		{
+			if (_pHandler) _pHandler->value(b);
+		}
+
+		void value(const StringRef& s)
+		{
+			checkNullByte(s);
+			if (_pHandler) _pHandler->value(s.toString());
+		}
+
+	private:
+		void checkNullByte(const StringRef& s) const
+		{
+			if (!_allowNullByte && std::memchr(s.data(), 0, s.size()))
+				throw JSONException("Null bytes in strings not allowed.");
+		}
+
+		Handler::Ptr _pHandler;
+		bool _allowNullByte;
+	};
+}
+
+
+ParserImpl::ParserImpl(const Handler::Ptr& pHandler, std::size_t bufSize):
 	_pJSON(new json_stream),
 	_pHandler(pHandler),
+	_bufSize(bufSize),
 	_depth(JSON_UNLIMITED_DEPTH),
 	_decimalPoint('.'),
 	_allowNullByte(true),
@@ -94,9 +179,21 @@ Dynamic::Var ParserImpl::parseImpl(const std::string& json)
 
 Dynamic::Var ParserImpl::parseImpl(std::istream& in)
 {
-	std::ostringstream os;
-	StreamCopier::copyStream(in, os);
-	return parseImpl(os.str());
+	if (_allowComments)
+	{
+		std::string json;
+		StreamCopier::copyToString(in, json);
+		return parseImpl(json);
+	}
+
+	StreamParser parser(in, _bufSize ? _bufSize : JSON_PARSE_BUFFER_SIZE);
+	HandlerAdapter adapter(_pHandler, _allowNullByte);
+	if (!parser.parseDocument(adapter))
+		throw JSONException("No JSON found.");
+	if (parser.next() != StreamParser::TOKEN_END)
+		throw JSONException("Excess characters found after JSON end.");
+
+	return asVarImpl();
 }
 
 
@@ -32,8 +32,10 @@ Query::Query(const Var& source): _source(source)
 		source.type() != typeid(Object) &&
 		source.type() != typeid(Object::Ptr) &&
 		source.type() != typeid(Array) &&
-		source.type() != typeid(Array::Ptr))
-		throw InvalidArgumentException("Only JSON Object, Array or pointers thereof allowed.");
+		source.type() != typeid(Array::Ptr) &&
+		source.type() != typeid(Document::Ptr) &&
+		source.type() != typeid(Value))
+		throw InvalidArgumentException("Only JSON Object, Array, Document, Value or pointers thereof allowed.");
 }
 
 
@@ -45,6 +47,8 @@ Query::~Query()
 Object::Ptr Query::findObject(const std::string& path) const
 {
 	Var result = find(path);
+	if (result.type() == typeid(Value))
+		result = result.extract<Value>().toVar();
 
 	if (result.type() == typeid(Object::Ptr))
 		return result.extract<Object::Ptr>();
@@ -60,6 +64,8 @@ Object& Query::findObject(const std::string& path, Object& obj) const
 	obj.clear();
 
 	Var result = find(path);
+	if (result.type() == typeid(Value))
+		result = result.extract<Value>().toVar();
 
 	if (result.type() == typeid(Object::Ptr))
 		obj = *result.extract<Object::Ptr>();
@@ -73,6 +79,8 @@ Object& Query::findObject(const std::string& path, Object& obj) const
 Array::Ptr Query::findArray(const std::string& path) const
 {
 	Var result = find(path);
+	if (result.type() == typeid(Value))
+		result = result.extract<Value>().toVar();
 
 	if (result.type() == typeid(Array::Ptr))
 		return result.extract<Array::Ptr>();
@@ -88,6 +96,8 @@ Array& Query::findArray(const std::string& path, Array& arr) const
 	arr.clear();
 
 	Var result = find(path);
+	if (result.type() == typeid(Value))
+		result = result.extract<Value>().toVar();
 
 	if (result.type() == typeid(Array::Ptr))
 		arr = *result.extract<Array::Ptr>();
@@ -101,6 +111,8 @@ Array& Query::findArray(const std::string& path, Array& arr) const
 Var Query::find(const std::string& path) const
 {
 	Var result = _source;
+	if (result.type() == typeid(Document::Ptr))
+		result = result.extract<Document::Ptr>()->root();
 	StringTokenizer tokenizer(path, ".");
 	for (StringTokenizer::Iterator token = tokenizer.begin(); token != tokenizer.end(); token++)
 	{
@@ -140,6 +152,12 @@ Var Query::find(const std::string& path) const
 					Object o = result.extract<Object>();
 					result = o.get(name);
 				}
+				else if (result.type() == typeid(Value))
+				{
+					Value v = result.extract<Value>().get(name);
+					if (v.isEmpty()) result.empty();
+					else result = v;
+				}
 				else
 					result.empty();
 
@@ -161,10 +179,25 @@ Var Query::find(const std::string& path) const
 						result = array.get(*it);
 						if (result.isEmpty()) break;
 					}
+					else if (result.type() == typeid(Value))
+					{
+						Value v = result.extract<Value>()[*it];
+						if (v.isEmpty())
+						{
+							result.empty();
+							break;
+						}
+						result = v;
+					}
 				}
 			}
 		}
 	}
+	if (result.type() == typeid(Value))
+	{
+		const Value& v = result.extract<Value>();
+		if (!v.isArray() && !v.isObject()) result = v.toVar();
+	}
 	return result;
 }
 
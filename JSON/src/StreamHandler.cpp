@@ -0,0 +1,42 @@
+//
+// StreamHandler.cpp
+//
+// Library: JSON
+// Package: JSON
+// Module:  StreamParser
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/JSON/StreamHandler.h"
+
+
+namespace Poco {
+namespace JSON {
+
+
+StreamHandler::StreamHandler()
+{
+}
+
+
+StreamHandler::~StreamHandler()
+{
+}
+
+
+void StreamHandler::startDocument()
+{
+}
+
+
+void StreamHandler::endDocument()
+{
+}
+
+
+} } // namespace Poco::JSON
@@ -0,0 +1,380 @@
+//
+// StreamParser.cpp
+//
+// Library: JSON
+// Package: JSON
+// Module:  StreamParser
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/JSON/StreamParser.h"
+#include "Poco/JSON/JSONException.h"
+#include "Poco/NumericString.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#undef min
+#undef max
+#include <limits>
+#include <cmath>
+#include <cstdio>
+#include "pdjson.h"
+
+
+namespace Poco {
+namespace JSON {
+
+
+namespace
+{
+	bool parseInteger(const char* p, bool& negative, UInt64& value)
+		/// Parses a JSON number consisting of an optional minus sign
+		/// and digits only. Returns false if the number has a fraction
+		/// or exponent. Throws a SyntaxException if the magnitude of the
+		/// number does not fit into an UInt64.
+	{
+		const char* pNum = p;
+		negative = (*p == '-');
+		if (negative) ++p;
+		value = 0;
+		for (; *p; ++p)
+		{
+			if (*p < '0' || *p > '9') return false;
+			UInt64 digit = static_cast<UInt64>(*p - '0');
+			if (value > (std::numeric_limits<UInt64>::max() - digit)/10)
+			{
+				for (; *p; ++p)
+				{
+					if (*p == '.' || *p == 'e' || *p == 'E') return false;
+				}
+				throw SyntaxException("Integer out of range", pNum);
+			}
+			value = value*10 + digit;
+		}
+		return true;
+	}
+
+
+	double parseDouble(const char* p)
+		/// Parses a JSON number as double. Throws a SyntaxException
+		/// if the number is out of range.
+	{
+		double value = strToDouble(p);
+		if (std::isinf(value))
+			throw SyntaxException("Number out of range", p);
+		return value;
+	}
+
+
+	const UInt64 INT64_MAX_MAGNITUDE = static_cast<UInt64>(std::numeric_limits<Int64>::max());
+}
+
+
+StreamParser::StreamParser(std::istream& istr, std::size_t bufferSize):
+	_istr(istr),
+	_buffer(bufferSize),
+	_pCur(0),
+	_pEnd(0),
+	_pJSON(new json_stream),
+	_state(ST_START),
+	_token(TOKEN_END),
+	_expectKey(false),
+	_documentCount(0),
+	_lineNumber(1)
+{
+	if (bufferSize == 0)
+	{
+		delete _pJSON;
+		throw InvalidArgumentException("StreamParser buffer size must be greater than zero.");
+	}
+	json_open_user(_pJSON, &StreamParser::get, &StreamParser::peek, this);
+	// must be set after opening, as json_open_user() resets all flags
+	json_set_streaming(_pJSON, true);
+}
+
+
+StreamParser::~StreamParser()
+{
+	json_close(_pJSON);
+	delete _pJSON;
+}
+
+
+int StreamParser::get(void* pUser)
+{
+	StreamParser* pParser = static_cast<StreamParser*>(pUser);
+	if (pParser->_pCur == pParser->_pEnd && !pParser->fill()) return EOF;
+	int c = static_cast<unsigned char>(*pParser->_pCur++);
+	if (c == '\n') ++pParser->_lineNumber;
+	return c;
+}
+
+
+int StreamParser::peek(void* pUser)
+{
+	StreamParser* pParser = static_cast<StreamParser*>(pUser);
+	if (pParser->_pCur == pParser->_pEnd && !pParser->fill()) return EOF;
+	return static_cast<unsigned char>(*pParser->_pCur);
+}
+
+
+bool StreamParser::fill()
+{
+	if (!_istr.good()) return false;
+	_istr.read(_buffer.begin(), static_cast<std::streamsize>(_buffer.size()));
+	_pCur = _buffer.begin();
+	_pEnd = _pCur + _istr.gcount();
+	return _pCur != _pEnd;
+}
+
+
+bool StreamParser::skipWhitespace()
+{
+	int c = peek(this);
+	while (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+	{
+		get(this);
+		c = peek(this);
+	}
+	return c != EOF;
+}
+
+
+void StreamParser::valueRead()
+{
+	_expectKey = !_containers.empty() && _containers.back();
+}
+
+
+StreamParser::Token StreamParser::next()
+{
+	switch (_state)
+	{
+	case ST_END:
+		return _token = TOKEN_END;
+	case ST_DOCUMENT_END:
+		json_reset(_pJSON);
+		// fallthrough
+	case ST_START:
+		if (!skipWhitespace())
+		{
+			_state = ST_END;
+			return _token = TOKEN_END;
+		}
+		_state = ST_DOCUMENT;
+		break;
+	case ST_DOCUMENT:
+		break;
+	}
+
+	switch (json_next(_pJSON))
+	{
+	case JSON_DONE:
+		_state = ST_DOCUMENT_END;
+		++_documentCount;
+		return _token = TOKEN_DOCUMENT_END;
+	case JSON_OBJECT:
+		_containers.push_back(true);
+		_expectKey = true;
+		return _token = TOKEN_OBJECT_START;
+	case JSON_OBJECT_END:
+		_containers.pop_back();
+		valueRead();
+		return _token = TOKEN_OBJECT_END;
+	case JSON_ARRAY:
+		_containers.push_back(false);
+		_expectKey = false;
+		return _token = TOKEN_ARRAY_START;
+	case JSON_ARRAY_END:
+		_containers.pop_back();
+		valueRead();
+		return _token = TOKEN_ARRAY_END;
+	case JSON_STRING:
+		if (_expectKey)
+		{
+			_expectKey = false;
+			return _token = TOKEN_KEY;
+		}
+		valueRead();
+		return _token = TOKEN_STRING;
+	case JSON_NUMBER:
+		valueRead();
+		return _token = TOKEN_NUMBER;
+	case JSON_TRUE:
+		valueRead();
+		return _token = TOKEN_TRUE;
+	case JSON_FALSE:
+		valueRead();
+		return _token = TOKEN_FALSE;
+	case JSON_NULL:
+		valueRead();
+		return _token = TOKEN_NULL;
+	case JSON_ERROR:
+	default:
+		{
+			const char* pErr = json_get_error(_pJSON);
+			std::string err(pErr ? pErr : "JSON parser error.");
+			err.append(" (line ");
+			NumberFormatter::append(err, _lineNumber);
+			err.append(")");
+			throw JSONException(err);
+		}
+	}
+}
+
+
+StringRef StreamParser::text() const
+{
+	if (_token != TOKEN_KEY && _token != TOKEN_STRING && _token != TOKEN_NUMBER)
+		return StringRef();
+
+	std::size_t length = 0;
+	const char* pText = json_get_string(_pJSON, &length);
+	// the length includes the terminating null character
+	return StringRef(pText, length ? length - 1 : 0);
+}
+
+
+void StreamParser::checkNumber() const
+{
+	if (_token != TOKEN_NUMBER)
+		throw InvalidAccessException("Current token is not a number.");
+}
+
+
+Int64 StreamParser::asInt64() const
+{
+	checkNumber();
+	const char* pText = json_get_string(_pJSON, 0);
+	bool negative;
+	UInt64 value;
+	if (parseInteger(pText, negative, value))
+	{
+		if (!negative && value <= INT64_MAX_MAGNITUDE)
+			return static_cast<Int64>(value);
+		if (negative && value <= INT64_MAX_MAGNITUDE + 1)
+			return static_cast<Int64>(0 - value);
+	}
+	throw SyntaxException("Not a valid Int64 value", pText);
+}
+
+
+UInt64 StreamParser::asUInt64() const
+{
+	checkNumber();
+	const char* pText = json_get_string(_pJSON, 0);
+	bool negative;
+	UInt64 value;
+	if (parseInteger(pText, negative, value) && (!negative || value == 0))
+		return value;
+	throw SyntaxException("Not a valid UInt64 value", pText);
+}
+
+
+double StreamParser::asDouble() const
+{
+	checkNumber();
+	return parseDouble(json_get_string(_pJSON, 0));
+}
+
+
+void StreamParser::skip()
+{
+	if (_token == TOKEN_KEY)
+	{
+		Token token = next();
+		if (token == TOKEN_OBJECT_START || token == TOKEN_ARRAY_START) skip();
+	}
+	else if (_token == TOKEN_OBJECT_START || _token == TOKEN_ARRAY_START)
+	{
+		std::size_t depth = _containers.size();
+		while (_containers.size() >= depth && next() != TOKEN_END)
+		{
+		}
+	}
+}
+
+
+void StreamParser::dispatch(Token token, StreamHandler& handler)
+{
+	switch (token)
+	{
+	case TOKEN_OBJECT_START:
+		handler.startObject();
+		break;
+	case TOKEN_OBJECT_END:
+		handler.endObject();
+		break;
+	case TOKEN_ARRAY_START:
+		handler.startArray();
+		break;
+	case TOKEN_ARRAY_END:
+		handler.endArray();
+		break;
+	case TOKEN_KEY:
+		handler.key(text());
+		break;
+	case TOKEN_STRING:
+		handler.value(text());
+		break;
+	case TOKEN_NUMBER:
+		{
+			const char* pText = json_get_string(_pJSON, 0);
+			bool negative;
+			UInt64 value;
+			if (!parseInteger(pText, negative, value))
+				handler.value(parseDouble(pText));
+			else if (!negative && value <= INT64_MAX_MAGNITUDE)
+				handler.value(static_cast<Int64>(value));
+			else if (!negative)
+				handler.value(value);
+			else if (value <= INT64_MAX_MAGNITUDE + 1)
+				handler.value(static_cast<Int64>(0 - value));
+			else
+				throw SyntaxException("Integer out of range", pText);
+		}
+		break;
+	case TOKEN_TRUE:
+		handler.value(true);
+		break;
+	case TOKEN_FALSE:
+		handler.value(false);
+		break;
+	case TOKEN_NULL:
+		handler.null();
+		break;
+	default:
+		break;
+	}
+}
+
+
+bool StreamParser::parseDocument(StreamHandler& handler)
+{
+	Token token = next();
+	if (token == TOKEN_END) return false;
+
+	handler.startDocument();
+	while (token != TOKEN_DOCUMENT_END)
+	{
+		dispatch(token, handler);
+		token = next();
+	}
+	handler.endDocument();
+	return true;
+}
+
+
+std::size_t StreamParser::parse(StreamHandler& handler)
+{
+	std::size_t count = 0;
+	while (parseDocument(handler)) ++count;
+	return count;
+}
+
+
+} } // namespace Poco::JSON
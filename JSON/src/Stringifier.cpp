@@ -15,6 +15,7 @@
 #include "Poco/JSON/Stringifier.h"
 #include "Poco/JSON/Array.h"
 #include "Poco/JSON/Object.h"
+#include "Poco/JSON/Document.h"
 #include <iomanip>
 
 
@@ -55,6 +56,14 @@ void Stringifier::stringify(const Var& any, std::ostream& out, unsigned int inde
 		a->setEscapeUnicode(escapeUnicode);
 		a->stringify(out, indent == 0 ? 0 : indent, step);
 	}
+	else if (any.type() == typeid(Value))
+	{
+		any.extract<Value>().stringify(out, indent == 0 ? 0 : indent, step, options);
+	}
+	else if (any.type() == typeid(Document::Ptr))
+	{
+		any.extract<Document::Ptr>()->root().stringify(out, indent == 0 ? 0 : indent, step, options);
+	}
 	else if (any.isEmpty())
 	{
 		out << "null";
@@ -0,0 +1,303 @@
+//
+// Value.cpp
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/JSON/Value.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/JSON/Array.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#undef min
+#undef max
+#include <limits>
+#include <cstring>
+
+
+namespace Poco {
+namespace JSON {
+
+
+UInt32 Value::hash(const char* key, std::size_t size)
+{
+	// FNV-1a
+	UInt32 h = 2166136261U;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		h ^= static_cast<unsigned char>(key[i]);
+		h *= 16777619U;
+	}
+	return h;
+}
+
+
+const Value::Node& Value::node() const
+{
+	if (!_pNode) throw InvalidAccessException("Empty JSON value");
+	return *_pNode;
+}
+
+
+void Value::checkType(Type type) const
+{
+	if (node().type != type) throw BadCastException("JSON value type mismatch");
+}
+
+
+Value::Type Value::type() const
+{
+	return static_cast<Type>(node().type);
+}
+
+
+bool Value::getBool() const
+{
+	checkType(VALUE_BOOLEAN);
+	return _pNode->data.b;
+}
+
+
+Int64 Value::getInt64() const
+{
+	switch (node().type)
+	{
+	case VALUE_INTEGER:
+		return _pNode->data.i;
+	case VALUE_UNSIGNED:
+		throw RangeException("JSON value out of Int64 range");
+	case VALUE_DOUBLE:
+		if (_pNode->data.d < static_cast<double>(std::numeric_limits<Int64>::min()) ||
+			_pNode->data.d >= static_cast<double>(std::numeric_limits<Int64>::max()))
+			throw RangeException("JSON value out of Int64 range");
+		return static_cast<Int64>(_pNode->data.d);
+	default:
+		throw BadCastException("JSON value is not a number");
+	}
+}
+
+
+UInt64 Value::getUInt64() const
+{
+	switch (node().type)
+	{
+	case VALUE_INTEGER:
+		if (_pNode->data.i < 0) throw RangeException("JSON value out of UInt64 range");
+		return static_cast<UInt64>(_pNode->data.i);
+	case VALUE_UNSIGNED:
+		return _pNode->data.u;
+	case VALUE_DOUBLE:
+		if (_pNode->data.d < 0 || _pNode->data.d >= static_cast<double>(std::numeric_limits<UInt64>::max()))
+			throw RangeException("JSON value out of UInt64 range");
+		return static_cast<UInt64>(_pNode->data.d);
+	default:
+		throw BadCastException("JSON value is not a number");
+	}
+}
+
+
+double Value::getDouble() const
+{
+	switch (node().type)
+	{
+	case VALUE_INTEGER:
+		return static_cast<double>(_pNode->data.i);
+	case VALUE_UNSIGNED:
+		return static_cast<double>(_pNode->data.u);
+	case VALUE_DOUBLE:
+		return _pNode->data.d;
+	default:
+		throw BadCastException("JSON value is not a number");
+	}
+}
+
+
+StringRef Value::getString() const
+{
+	checkType(VALUE_STRING);
+	return StringRef(_pNode->data.s, _pNode->size);
+}
+
+
+Value Value::get(const StringRef& key) const
+{
+	if (!isObject()) return Value();
+
+	const ObjectData* pObject = _pNode->data.object;
+	const Member* pMembers = pObject->members;
+	UInt32 keySize = static_cast<UInt32>(key.size());
+	if (pObject->index)
+	{
+		UInt32 h = hash(key.data(), key.size());
+		UInt32 slot = h & pObject->indexMask;
+		while (UInt32 pos = pObject->index[slot])
+		{
+			const Member& member = pMembers[pos - 1];
+			if (member.hash == h && member.keySize == keySize && std::memcmp(member.key, key.data(), keySize) == 0)
+				return Value(&member.value);
+			slot = (slot + 1) & pObject->indexMask;
+		}
+	}
+	else
+	{
+		for (std::size_t i = _pNode->size; i > 0; --i)
+		{
+			const Member& member = pMembers[i - 1];
+			if (member.keySize == keySize && std::memcmp(member.key, key.data(), keySize) == 0)
+				return Value(&member.value);
+		}
+	}
+	return Value();
+}
+
+
+StringRef Value::keyAt(std::size_t index) const
+{
+	if (!isObject() || index >= _pNode->size)
+		throw RangeException("Invalid JSON object member index");
+
+	const Member& member = _pNode->data.object->members[index];
+	return StringRef(member.key, member.keySize);
+}
+
+
+Value Value::valueAt(std::size_t index) const
+{
+	if (!isObject() || index >= _pNode->size) return Value();
+
+	return Value(&_pNode->data.object->members[index].value);
+}
+
+
+Dynamic::Var Value::toVar() const
+{
+	if (!_pNode) return Dynamic::Var();
+
+	switch (_pNode->type)
+	{
+	case VALUE_BOOLEAN:
+		return _pNode->data.b;
+	case VALUE_INTEGER:
+		return _pNode->data.i;
+	case VALUE_UNSIGNED:
+		return _pNode->data.u;
+	case VALUE_DOUBLE:
+		return _pNode->data.d;
+	case VALUE_STRING:
+		return std::string(_pNode->data.s, _pNode->size);
+	case VALUE_ARRAY:
+		{
+			Array::Ptr pArray = new Array;
+			for (std::size_t i = 0; i < _pNode->size; ++i)
+				pArray->add(Value(_pNode->data.elements + i).toVar());
+			return pArray;
+		}
+	case VALUE_OBJECT:
+		{
+			JSON::Object::Ptr pObject = new JSON::Object(Poco::JSON_PRESERVE_KEY_ORDER);
+			for (std::size_t i = 0; i < _pNode->size; ++i)
+			{
+				const Member& member = _pNode->data.object->members[i];
+				pObject->set(std::string(member.key, member.keySize), Value(&member.value).toVar());
+			}
+			return pObject;
+		}
+	default:
+		return Dynamic::Var();
+	}
+}
+
+
+void Value::stringify(std::ostream& out, unsigned int indent, int step, int options) const
+{
+	if (step < 0) step = indent;
+
+	std::string buffer;
+	stringifyImpl(out, indent, step, options, buffer);
+}
+
+
+void Value::stringifyImpl(std::ostream& out, unsigned int indent, int step, int options, std::string& buffer) const
+{
+	if (!_pNode)
+	{
+		out << "null";
+		return;
+	}
+
+	switch (_pNode->type)
+	{
+	case VALUE_NULL:
+		out << "null";
+		break;
+	case VALUE_BOOLEAN:
+		out << (_pNode->data.b ? "true" : "false");
+		break;
+	case VALUE_INTEGER:
+		buffer.clear();
+		NumberFormatter::append(buffer, _pNode->data.i);
+		out << buffer;
+		break;
+	case VALUE_UNSIGNED:
+		buffer.clear();
+		NumberFormatter::append(buffer, _pNode->data.u);
+		out << buffer;
+		break;
+	case VALUE_DOUBLE:
+		buffer.clear();
+		NumberFormatter::append(buffer, _pNode->data.d);
+		out << buffer;
+		break;
+	case VALUE_STRING:
+		buffer.assign(_pNode->data.s, _pNode->size);
+		toJSON(buffer, out, options);
+		break;
+	case VALUE_ARRAY:
+		out << '[';
+		if (indent > 0) out << '\n';
+		for (std::size_t i = 0; i < _pNode->size; ++i)
+		{
+			for (unsigned int s = 0; s < indent; ++s) out << ' ';
+			Value(_pNode->data.elements + i).stringifyImpl(out, indent + step, step, options, buffer);
+			if (i + 1 < _pNode->size)
+			{
+				out << ',';
+				if (step > 0) out << '\n';
+			}
+		}
+		if (step > 0) out << '\n';
+		if (indent >= static_cast<unsigned int>(step)) indent -= step;
+		for (unsigned int s = 0; s < indent; ++s) out << ' ';
+		out << ']';
+		break;
+	case VALUE_OBJECT:
+		out << '{';
+		if (indent > 0) out << '\n';
+		for (std::size_t i = 0; i < _pNode->size; ++i)
+		{
+			const Member& member = _pNode->data.object->members[i];
+			for (unsigned int s = 0; s < indent; ++s) out << ' ';
+			buffer.assign(member.key, member.keySize);
+			toJSON(buffer, out, options);
+			out << ((indent > 0) ? " : " : ":");
+			Value(&member.value).stringifyImpl(out, indent + step, step, options, buffer);
+			if (i + 1 < _pNode->size) out << ',';
+			if (step > 0) out << '\n';
+		}
+		if (indent >= static_cast<unsigned int>(step)) indent -= step;
+		for (unsigned int s = 0; s < indent; ++s) out << ' ';
+		out << '}';
+		break;
+	}
+}
+
+
+} } // namespace Poco::JSON
@@ -23,7 +23,11 @@
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/DateTime.h"
 #include "Poco/DateTimeFormatter.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/JSON/StreamParser.h"
+#include "Poco/JSON/Document.h"
 #include <set>
+#include <limits>
 #include <iostream>
 
 
@@ -2153,6 +2157,290 @@ void JSONTest::testMove()
 }
 
 
+namespace
+{
+	class EventRecorder: public StreamHandler
+	{
+	public:
+		void startDocument() { _events.append("<"); }
+		void endDocument() { _events.append(">\n"); }
+		void startObject() { _events.append("{"); }
+		void endObject() { _events.append("}"); }
+		void startArray() { _events.append("["); }
+		void endArray() { _events.append("]"); }
+		void key(const Poco::StringRef& k) { _events.append("k:").append(k.data(), k.size()).append(" "); }
+		void null() { _events.append("null "); }
+		void value(Poco::Int64 v) { _events.append("i:").append(Poco::NumberFormatter::format(v)).append(" "); }
+		void value(Poco::UInt64 v) { _events.append("u:").append(Poco::NumberFormatter::format(v)).append(" "); }
+		void value(double d) { _events.append("d:").append(Poco::NumberFormatter::format(d)).append(" "); }
+		void value(bool b) { _events.append(b ? "true " : "false "); }
+		void value(const Poco::StringRef& s) { _events.append("s:").append(s.data(), s.size()).append(" "); }
+
+		const std::string& events() const { return _events; }
+
+	private:
+		std::string _events;
+	};
+}
+
+
+void JSONTest::testStreamParser()
+{
+	std::string json =
+		"{\"level\":\"info\",\"id\":-42,\"big\":18446744073709551615,\"ratio\":0.5,\"tags\":[\"a\\\"b\",true,null]}\n"
+		"\n"
+		"  [1e3, false, {}, [], \"\\u00e4\"]\r\n"
+		"\"plain\" 7";
+
+	// small buffer sizes force tokens to span several chunks
+	for (std::size_t bufferSize = 1; bufferSize < 16; bufferSize += 7)
+	{
+		std::istringstream istr(json);
+		StreamParser parser(istr, bufferSize);
+		EventRecorder recorder;
+		assertTrue (parser.parse(recorder) == 4);
+		assertTrue (parser.documentCount() == 4);
+		assertTrue (recorder.events() ==
+			"<{k:level s:info k:id i:-42 k:big u:18446744073709551615 k:ratio d:0.5 k:tags [s:a\"b true null ]}>\n"
+			"<[d:1000 false {}[]s:\xC3\xA4 ]>\n"
+			"<s:plain >\n"
+			"<i:7 >\n");
+		assertTrue (!parser.parseDocument(recorder));
+	}
+
+	std::istringstream empty(" \n ");
+	StreamParser emptyParser(empty);
+	EventRecorder recorder;
+	assertTrue (emptyParser.parse(recorder) == 0);
+	assertTrue (recorder.events().empty());
+
+	std::istringstream invalid("{\"a\":1}\n{\"b\":2}\n{\"c\":}\n");
+	StreamParser invalidParser(invalid);
+	try
+	{
+		invalidParser.parse(recorder);
+		fail("invalid JSON - must throw");
+	}
+	catch (JSONException& exc)
+	{
+		assertTrue (invalidParser.documentCount() == 2);
+		assertTrue (exc.message().find("line 3") != std::string::npos);
+	}
+
+	// Parser reads streams through StreamParser
+	std::istringstream istr("{ \"name\" : \"Franky\", \"children\" : [ \"Jonas\", \"Ellen\" ], \"age\" : 3 }");
+	Parser parser;
+	Var result = parser.parse(istr);
+	Object::Ptr pObject = result.extract<Object::Ptr>();
+	assertTrue (pObject->getValue<std::string>("name") == "Franky");
+	assertTrue (pObject->getArray("children")->size() == 2);
+	assertTrue (pObject->getValue<int>("age") == 3);
+
+	std::istringstream excess("{} {}");
+	parser.reset();
+	try
+	{
+		parser.parse(excess);
+		fail("excess characters - must throw");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
+void JSONTest::testStreamParserPull()
+{
+	std::istringstream istr(
+		"{\"skip\":{\"x\":[1,{\"y\":2}]},\"n\":-9223372036854775808,\"f\":2.5,\"s\":\"str\"}\n"
+		"[[1,2],3]");
+	StreamParser parser(istr, 5);
+
+	assertTrue (parser.next() == StreamParser::TOKEN_OBJECT_START);
+	assertTrue (parser.next() == StreamParser::TOKEN_KEY);
+	assertTrue (parser.text() == "skip");
+	parser.skip();
+	assertTrue (parser.next() == StreamParser::TOKEN_KEY);
+	assertTrue (parser.text() == "n");
+	assertTrue (parser.next() == StreamParser::TOKEN_NUMBER);
+	assertTrue (parser.asInt64() == std::numeric_limits<Poco::Int64>::min());
+	try
+	{
+		parser.asUInt64();
+		fail("negative number - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+	assertTrue (parser.next() == StreamParser::TOKEN_KEY);
+	assertTrue (parser.text() == "f");
+	assertTrue (parser.next() == StreamParser::TOKEN_NUMBER);
+	assertTrue (parser.text() == "2.5");
+	assertTrue (parser.asDouble() == 2.5);
+	try
+	{
+		parser.asInt64();
+		fail("not an integer - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+	assertTrue (parser.next() == StreamParser::TOKEN_KEY);
+	assertTrue (parser.next() == StreamParser::TOKEN_STRING);
+	assertTrue (parser.text() == "str");
+	assertTrue (parser.next() == StreamParser::TOKEN_OBJECT_END);
+	assertTrue (parser.next() == StreamParser::TOKEN_DOCUMENT_END);
+
+	assertTrue (parser.next() == StreamParser::TOKEN_ARRAY_START);
+	assertTrue (parser.next() == StreamParser::TOKEN_ARRAY_START);
+	parser.skip();
+	assertTrue (parser.next() == StreamParser::TOKEN_NUMBER);
+	assertTrue (parser.asUInt64() == 3);
+	assertTrue (parser.next() == StreamParser::TOKEN_ARRAY_END);
+	assertTrue (parser.next() == StreamParser::TOKEN_DOCUMENT_END);
+	assertTrue (parser.lineNumber() == 2);
+	assertTrue (parser.next() == StreamParser::TOKEN_END);
+	assertTrue (parser.next() == StreamParser::TOKEN_END);
+}
+
+
+void JSONTest::testDocument()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"age\" : 3, \"big\" : 18446744073709551615, \"ratio\" : -0.5,"
+		" \"alive\" : true, \"spouse\" : null, \"children\" : [ { \"name\" : \"Jonas\" }, { \"name\" : \"Ellen\" } ],"
+		" \"dup\" : 1, \"dup\" : 2, \"empty\" : {}, \"none\" : [] }";
+
+	Document doc(json);
+	Value root = doc.root();
+	assertTrue (root.isObject());
+	assertTrue (root.size() == 11);
+	assertTrue (root.get("name").getString() == "Franky");
+	assertTrue (root.get("age").type() == Value::VALUE_INTEGER);
+	assertTrue (root.get("age").getInt64() == 3);
+	assertTrue (root.get("age").getDouble() == 3.0);
+	assertTrue (root.get("big").type() == Value::VALUE_UNSIGNED);
+	assertTrue (root.get("big").getUInt64() == 18446744073709551615ULL);
+	assertTrue (root.get("ratio").getDouble() == -0.5);
+	assertTrue (root.get("alive").getBool());
+	assertTrue (root.get("spouse").isNull());
+	assertTrue (root.get("dup").getInt64() == 2);
+	assertTrue (root.get("empty").isObject() && root.get("empty").size() == 0);
+	assertTrue (root.get("none").isArray() && root.get("none").size() == 0);
+	assertTrue (root.get("children").size() == 2);
+	assertTrue (root.get("children")[1].get("name").getString() == "Ellen");
+	assertTrue (root.keyAt(0) == "name");
+	assertTrue (root.valueAt(1) == root.get("age"));
+
+	assertTrue (root.get("missing").isEmpty());
+	assertTrue (root.get("children")[2].isEmpty());
+	assertTrue (root.get("missing").get("name").isEmpty());
+	assertTrue (!root.has("missing"));
+	try
+	{
+		root.get("name").getInt64();
+		fail("not a number - must throw");
+	}
+	catch (Poco::BadCastException&)
+	{
+	}
+	try
+	{
+		root.get("big").getInt64();
+		fail("out of range - must throw");
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+
+	// objects above the index threshold are looked up via hash index
+	std::ostringstream ostr;
+	ostr << '{';
+	for (int i = 0; i < 100; ++i)
+	{
+		if (i > 0) ostr << ',';
+		ostr << "\"key" << i << "\":" << i;
+	}
+	ostr << ",\"key42\":-1}";
+	std::istringstream istr(ostr.str());
+	Document large(istr);
+	assertTrue (large.root().size() == 101);
+	for (int i = 0; i < 100; ++i)
+	{
+		std::string key = "key" + Poco::NumberFormatter::format(i);
+		assertTrue (large.root().get(key).getInt64() == (i == 42 ? -1 : i));
+	}
+	assertTrue (large.root().get("key100").isEmpty());
+
+	Var var = root.toVar();
+	Object::Ptr pObject = var.extract<Object::Ptr>();
+	assertTrue (pObject->getValue<std::string>("name") == "Franky");
+	assertTrue (pObject->getArray("children")->getObject(0)->getValue<std::string>("name") == "Jonas");
+	assertTrue (pObject->isNull("spouse"));
+
+	try
+	{
+		Document invalid("{ \"a\" : 1 } x");
+		fail("excess characters - must throw");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
+void JSONTest::testDocumentQuery()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"children\" : [ \"Jonas\", \"Ellen\" ], "
+		"\"address\" : { \"street\" : \"Main\", \"number\" : 42 }, \"spouse\" : null }";
+	Document::Ptr pDoc = new Document(json);
+
+	Query query(pDoc);
+	assertTrue (query.findValue("name", "") == "Franky");
+	assertTrue (query.findValue("children[1]", "") == "Ellen");
+	assertTrue (query.findValue<int>("address.number", 0) == 42);
+	assertTrue (query.find("address.number").type() == typeid(Poco::Int64));
+	assertTrue (query.find("children[2]").isEmpty());
+	assertTrue (query.find("spouse").isEmpty());
+	assertTrue (query.find("nobody.name").isEmpty());
+
+	Var address = query.find("address");
+	assertTrue (address.type() == typeid(Value));
+	assertTrue (address.extract<Value>().get("street").getString() == "Main");
+	Object::Ptr pAddress = query.findObject("address");
+	assertTrue (!pAddress.isNull());
+	assertTrue (pAddress->getValue<int>("number") == 42);
+	Poco::JSON::Array::Ptr pChildren = query.findArray("children");
+	assertTrue (!pChildren.isNull() && pChildren->size() == 2);
+
+	Query valueQuery(pDoc->root().get("address"));
+	assertTrue (valueQuery.findValue("street", "") == "Main");
+
+	// Document stringifies the same way as Object does
+	Parser parser;
+	Var result = parser.parse(json);
+	Object::Ptr pObject = result.extract<Object::Ptr>();
+	for (unsigned int indent = 0; indent < 3; indent += 2)
+	{
+		std::ostringstream docStream;
+		Stringifier::stringify(pDoc, docStream, indent);
+		Object::Ptr pFromDoc = parser.parse(docStream.str()).extract<Object::Ptr>();
+		parser.reset();
+
+		std::ostringstream objStream;
+		Stringifier::stringify(pFromDoc, objStream, indent);
+		assertTrue (docStream.str().size() == objStream.str().size());
+
+		std::ostringstream valueStream;
+		Stringifier::stringify(pDoc->root(), valueStream, indent);
+		assertTrue (valueStream.str() == docStream.str());
+	}
+	std::ostringstream condensed;
+	Stringifier::condense(pDoc, condensed);
+	assertTrue (condensed.str() == "{\"name\":\"Franky\",\"children\":[\"Jonas\",\"Ellen\"],"
+		"\"address\":{\"street\":\"Main\",\"number\":42},\"spouse\":null}");
+}
+
+
 CppUnit::Test* JSONTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("JSONTest");
@@ -2203,6 +2491,10 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testEscapeUnicode);
 	CppUnit_addTest(pSuite, JSONTest, testCopy);
 	CppUnit_addTest(pSuite, JSONTest, testMove);
+	CppUnit_addTest(pSuite, JSONTest, testStreamParser);
+	CppUnit_addTest(pSuite, JSONTest, testStreamParserPull);
+	CppUnit_addTest(pSuite, JSONTest, testDocument);
+	CppUnit_addTest(pSuite, JSONTest, testDocumentQuery);
 
 	return pSuite;
 }
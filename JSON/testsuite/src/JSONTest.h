@@ -82,6 +82,11 @@ public:
 	void testCopy();
 	void testMove();
 
+	void testStreamParser();
+	void testStreamParserPull();
+	void testDocument();
+	void testDocumentQuery();
+
 	void setUp();
 	void tearDown();
 
@@ -0,0 +1,179 @@
+//
+// HTTPCompressingStream.h
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPCompressingStream
+//
+// Definition of the HTTPCompressingStream class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPCompressingStream_INCLUDED
+#define Net_HTTPCompressingStream_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPBasicStreamBuf.h"
+#include "Poco/Buffer.h"
+#include <cstddef>
+#include <ostream>
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPServerResponseImpl;
+
+
+class Net_API HTTPDeflater
+	/// This class compresses HTTP message bodies using
+	/// the gzip or deflate content coding.
+	///
+	/// The zlib stream state is kept between messages and
+	/// reset with deflateReset(), so that a connection sending
+	/// many compressed responses sets up zlib only once.
+{
+public:
+	enum Encoding
+	{
+		ENCODING_GZIP,    /// gzip content coding (RFC 1952)
+		ENCODING_DEFLATE  /// deflate content coding (zlib format, RFC 1950)
+	};
+
+	explicit HTTPDeflater(int level);
+		/// Creates the HTTPDeflater using the given
+		/// zlib compression level.
+
+	~HTTPDeflater();
+		/// Destroys the HTTPDeflater.
+
+	void begin(Encoding encoding);
+		/// Prepares the HTTPDeflater for compressing
+		/// a new message body.
+
+	void deflate(const char* buffer, std::size_t length, std::ostream& ostr);
+		/// Compresses the given data and writes any
+		/// compressed output available to ostr.
+
+	void flush(std::ostream& ostr);
+		/// Writes all compressed output for the data passed
+		/// to deflate() so far to ostr (Z_SYNC_FLUSH) and
+		/// flushes ostr, so that the receiver can decompress
+		/// everything sent up to now.
+
+	void finish(std::ostream& ostr);
+		/// Completes the current message body and writes
+		/// the remaining compressed output to ostr.
+
+	int level() const;
+		/// Returns the compression level.
+
+	static const std::string& encodingName(Encoding encoding);
+		/// Returns the Content-Encoding header value
+		/// for the given encoding.
+
+private:
+	enum
+	{
+		BUFFER_SIZE = 16384
+	};
+
+	void compress(int flush, std::ostream& ostr);
+
+	int _level;
+	Encoding _encoding;
+	bool _initialized;
+	z_stream _zstr;
+	Poco::Buffer<char> _buffer;
+
+	HTTPDeflater(const HTTPDeflater&);
+	HTTPDeflater& operator = (const HTTPDeflater&);
+};
+
+
+class Net_API HTTPCompressingStreamBuf: public HTTPBasicStreamBuf
+	/// This is the streambuf class used for compressing
+	/// the body of a server response.
+	///
+	/// Unless the response has a Content-Length, sending the
+	/// response header is delayed until either the body reaches
+	/// the minimum size for compression, in which case the body
+	/// is compressed and sent in chunked transfer coding, or
+	/// the stream is closed, in which case the body is sent
+	/// uncompressed.
+	///
+	/// Flushing the stream sends the header, if it has not been
+	/// sent yet, and all data written so far, compressed with
+	/// a zlib sync flush. This allows for streaming responses,
+	/// at the cost of a slightly worse compression ratio.
+{
+public:
+	HTTPCompressingStreamBuf(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize);
+	~HTTPCompressingStreamBuf();
+	void close();
+	int sync();
+
+protected:
+	int writeToDevice(const char* buffer, std::streamsize length);
+
+private:
+	void beginCompression();
+
+	HTTPServerResponseImpl& _response;
+	HTTPDeflater&           _deflater;
+	HTTPDeflater::Encoding  _encoding;
+	std::size_t             _minSize;
+	std::string             _pending;
+	std::ostream*           _pStream;
+	bool                    _compressing;
+	bool                    _closed;
+};
+
+
+class Net_API HTTPCompressingIOS: public virtual std::ios
+	/// The base class for HTTPCompressingOutputStream.
+{
+public:
+	HTTPCompressingIOS(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize);
+	~HTTPCompressingIOS();
+	HTTPCompressingStreamBuf* rdbuf();
+
+protected:
+	HTTPCompressingStreamBuf _buf;
+};
+
+
+class Net_API HTTPCompressingOutputStream: public HTTPCompressingIOS, public std::ostream
+	/// This class is for internal use by HTTPServerResponseImpl only.
+{
+public:
+	HTTPCompressingOutputStream(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize);
+	~HTTPCompressingOutputStream();
+};
+
+
+//
+// inlines
+//
+inline int HTTPDeflater::level() const
+{
+	return _level;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPCompressingStream_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
+#include "Poco/DescriptorStreamBuf.h"
 #include "Poco/MemoryPool.h"
 #include <cstddef>
 #include <istream>
@@ -33,15 +34,32 @@ namespace Net {
 class HTTPSession;
 
 
-class Net_API HTTPHeaderStreamBuf: public HTTPBasicStreamBuf
+class Net_API HTTPHeaderStreamBuf: public HTTPBasicStreamBuf, public Poco::DescriptorStreamBuf
 	/// This is the streambuf class used for reading from a HTTP header
 	/// in a HTTPSession.
+	///
+	/// For writing, the session's socket descriptor is made available
+	/// through the DescriptorStreamBuf interface, so that
+	/// HTTPServerResponse::sendFile() can send the file
+	/// with sendfile().
 {
 public:
 	typedef HTTPBasicStreamBuf::openmode openmode;
 
 	HTTPHeaderStreamBuf(HTTPSession& session, openmode mode);
 	~HTTPHeaderStreamBuf();
+
+	int readDescriptor();
+		/// Returns -1, as headers are read through
+		/// the session's buffer.
+
+	int writeDescriptor();
+		/// Flushes buffered output data and returns the socket
+		/// descriptor if the session's socket is not secure,
+		/// or -1 otherwise.
+
+	void transferred(Poco::UInt64 count);
+		/// Does nothing.
 	
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
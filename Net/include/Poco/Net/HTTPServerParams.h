@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/TCPServerParams.h"
+#include <vector>
 
 
 namespace Poco {
@@ -43,6 +44,13 @@ public:
 		///   - keepAlive:            true
 		///   - maxKeepAliveRequests: 0
 		///   - keepAliveTimeout:     10 seconds
+		///   - compressionLevel:     0 (no compression)
+		///   - compressionMinSize:   1024 bytes
+		///   - compressionMediaTypes: text/plain, text/html, text/css,
+		///     text/csv, text/javascript, text/xml, application/json,
+		///     application/javascript, application/xml, image/svg+xml
+		///     (not text/event-stream, as buffering in the compressor
+		///     would delay events)
 		
 	void setServerName(const std::string& serverName);
 		/// Sets the name and port (name:port) that the server uses to identify itself.
@@ -95,6 +103,51 @@ public:
 		/// during a persistent connection, or 0 if
 		/// unlimited connections are allowed.
 
+	void setCompressionLevel(int level);
+		/// Sets the zlib compression level (1 - 9) used for
+		/// compressing response bodies.
+		///
+		/// If set to a non-zero value, the server compresses
+		/// responses with the gzip or deflate content coding,
+		/// if the client accepts one of them in its Accept-Encoding
+		/// header field, and if the response has one of the
+		/// media types given in setCompressionMediaTypes()
+		/// and a body of at least getCompressionMinSize() bytes.
+		/// Partial content (status 206 or a Content-Range header)
+		/// is never compressed.
+		///
+		/// A level of 0 (the default) disables compression.
+
+	int getCompressionLevel() const;
+		/// Returns the zlib compression level used for
+		/// compressing response bodies, or 0 if compression
+		/// is disabled.
+
+	void setCompressionMinSize(std::size_t size);
+		/// Sets the minimum size of a response body, in bytes,
+		/// for the body to be compressed.
+		///
+		/// Smaller bodies are sent uncompressed, as compression
+		/// would save little or nothing.
+
+	std::size_t getCompressionMinSize() const;
+		/// Returns the minimum size of a response body
+		/// for the body to be compressed.
+
+	void setCompressionMediaTypes(const std::vector<std::string>& mediaTypes);
+		/// Sets the media types of responses that can be compressed.
+		///
+		/// Each entry is either a media type (e.g., "application/json"),
+		/// or a type followed by a wildcard subtype (e.g., "text/*").
+		/// Parameters of the response's Content-Type are ignored.
+
+	const std::vector<std::string>& getCompressionMediaTypes() const;
+		/// Returns the media types of responses that can be compressed.
+
+	bool isCompressibleMediaType(const std::string& contentType) const;
+		/// Returns true iff the given Content-Type header value
+		/// matches one of the compressible media types.
+
 protected:
 	virtual ~HTTPServerParams();
 		/// Destroys the HTTPServerParams.
@@ -106,6 +159,9 @@ private:
 	bool           _keepAlive;
 	int            _maxKeepAliveRequests;
 	Poco::Timespan _keepAliveTimeout;
+	int            _compressionLevel;
+	std::size_t    _compressionMinSize;
+	std::vector<std::string> _compressionMediaTypes;
 };
 
 
@@ -148,6 +204,24 @@ inline const Poco::Timespan& HTTPServerParams::getKeepAliveTimeout() const
 }
 
 
+inline int HTTPServerParams::getCompressionLevel() const
+{
+	return _compressionLevel;
+}
+
+
+inline std::size_t HTTPServerParams::getCompressionMinSize() const
+{
+	return _compressionMinSize;
+}
+
+
+inline const std::vector<std::string>& HTTPServerParams::getCompressionMediaTypes() const
+{
+	return _compressionMediaTypes;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPCompressingStream.h"
 
 
 namespace Poco {
@@ -28,6 +29,7 @@ namespace Net {
 
 class HTTPServerSession;
 class HTTPServerRequestImpl;
+class HTTPCompressingStreamBuf;
 
 
 class Net_API HTTPServerResponseImpl: public HTTPServerResponse
@@ -40,6 +42,10 @@ class Net_API HTTPServerResponseImpl: public HTTPServerResponse
 	/// handleRequest() must set a status code
 	/// and optional reason phrase, set headers
 	/// as necessary, and provide a message body.
+	///
+	/// If compression is enabled in the HTTPServerParams,
+	/// send() and sendBuffer() transparently compress the
+	/// message body, if the client accepts it.
 {
 public:
 	HTTPServerResponseImpl(HTTPServerSession& session);
@@ -62,6 +68,14 @@ public:
 		///
 		/// Must not be called after sendFile(), sendBuffer()
 		/// or redirect() has been called.
+		///
+		/// If the response body can be compressed, but
+		/// neither a Content-Length has been set nor chunked
+		/// transfer encoding has been enabled, the body is sent
+		/// in chunked transfer encoding. Sending the header is
+		/// then delayed until the body has reached the
+		/// minimum size for compression, or until the
+		/// stream is closed.
 		
 	void sendFile(const std::string& path, const std::string& mediaType);
 		/// Sends the response header to the client, followed
@@ -79,7 +93,9 @@ public:
 		/// by the contents of the given buffer.
 		///
 		/// The Content-Length header of the response is set
-		/// to length and chunked transfer encoding is disabled.
+		/// to length (or the length of the compressed body,
+		/// if the body is compressed) and chunked transfer
+		/// encoding is disabled.
 		///
 		/// If both the HTTP message header and body (from the
 		/// given buffer) fit into one single network packet, the
@@ -110,11 +126,23 @@ protected:
 	void attachRequest(HTTPServerRequestImpl* pRequest);
 	
 private:
+	bool canCompress(HTTPDeflater::Encoding& encoding);
+		/// Returns true if the response body can be compressed
+		/// and stores the content coding accepted by the client
+		/// in encoding.
+
+	std::ostream* beginBody();
+		/// Sends the response header and returns a new
+		/// stream for sending the (not compressed) body,
+		/// depending on the Content-Length and
+		/// Transfer-Encoding of the response.
+
 	HTTPServerSession& _session;
 	HTTPServerRequestImpl* _pRequest;
 	std::ostream*      _pStream;
 	
 	friend class HTTPServerRequestImpl;
+	friend class HTTPCompressingStreamBuf;
 };
 
 
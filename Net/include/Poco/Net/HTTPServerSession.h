@@ -23,6 +23,7 @@
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/HTTPServerSession.h"
 #include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPCompressingStream.h"
 #include "Poco/Timespan.h"
 
 
@@ -53,11 +54,17 @@ public:
 		
 	SocketAddress serverAddress();
 		/// Returns the server's address.
+
+	HTTPDeflater& deflater(int level);
+		/// Returns the HTTPDeflater used for compressing
+		/// responses sent over this session, creating it
+		/// with the given compression level on first use.
 		
 private:
 	bool           _firstRequest;
 	Poco::Timespan _keepAliveTimeout;
 	int            _maxKeepAliveRequests;
+	HTTPDeflater*  _pDeflater;
 };
 
 
@@ -23,6 +23,8 @@
 #include "Poco/Net/PollSet.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
+#include "Poco/TimerWheel.h"
+#include "Poco/Clock.h"
 #include "Poco/Observer.h"
 #include "Poco/AutoPtr.h"
 #include <map>
@@ -111,6 +113,12 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// from another thread while the SocketReactor is running. Also,
 	/// it is safe to call addEventHandler() and removeEventHandler()
 	/// from event handlers.
+	///
+	/// In addition to the TimeoutNotification, which is sent to all
+	/// event handlers, the SocketReactor manages individual timers
+	/// (see schedule()), which are kept in a Poco::TimerWheel and run
+	/// in the reactor's thread. These are suitable for per-connection
+	/// timeouts, even with many thousands of connections.
 {
 public:
 	SocketReactor();
@@ -169,6 +177,25 @@ public:
 	bool has(const Socket& socket) const;
 		/// Returns true if socket is registered with this rector.
 
+	Poco::TimerWheel::Handle schedule(const Poco::TimerWheel::Callback& callback, long delay);
+		/// Schedules the callback to be called by the reactor's
+		/// thread once, after the given delay in milliseconds.
+		/// Returns a handle that can be passed to cancel().
+		///
+		/// The SocketReactor shortens its poll timeout as needed for
+		/// its timers. A timer scheduled from another thread while the
+		/// reactor is waiting for socket events may therefore be called
+		/// up to the reactor's timeout late.
+
+	Poco::TimerWheel::Handle schedule(const Poco::TimerWheel::Callback& callback, long delay, long interval);
+		/// Schedules the callback to be called by the reactor's
+		/// thread first after the given delay, then repeatedly at
+		/// the given interval (both in milliseconds), until cancelled.
+
+	bool cancel(Poco::TimerWheel::Handle handle);
+		/// Cancels the timer with the given handle. Returns true
+		/// if the timer was pending, false otherwise.
+
 protected:
 	virtual void onTimeout();
 		/// Called if the timeout expires and no other events are available.
@@ -213,6 +240,7 @@ private:
 	typedef MutexType::ScopedLock             ScopedLock;
 
 	bool hasSocketHandlers();
+	Poco::Timespan waitTimeout() const;
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
 	NotifierPtr getNotifier(const Socket& socket, bool makeNew = false);
 
@@ -227,6 +255,7 @@ private:
 	bool              _stop;
 #endif
 	Poco::Timespan    _timeout;
+	Poco::Clock       _timeoutStart;
 	EventHandlerMap   _handlers;
 	PollSet           _pollSet;
 	NotificationPtr   _pReadableNotification;
@@ -236,6 +265,7 @@ private:
 	NotificationPtr   _pIdleNotification;
 	NotificationPtr   _pShutdownNotification;
 	MutexType         _mutex;
+	Poco::TimerWheel  _timers;
 	Poco::Thread*     _pThread;
 
 	friend class SocketNotifier;
@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/BufferedBidirectionalStreamBuf.h"
+#include "Poco/DescriptorStreamBuf.h"
 #include <istream>
 #include <ostream>
 
@@ -32,7 +33,7 @@ namespace Net {
 class StreamSocketImpl;
 
 
-class Net_API SocketStreamBuf: public Poco::BufferedBidirectionalStreamBuf
+class Net_API SocketStreamBuf: public Poco::BufferedBidirectionalStreamBuf, public Poco::DescriptorStreamBuf
 	/// This is the streambuf class used for reading from and writing to a socket.
 {
 public:
@@ -47,6 +48,17 @@ public:
 		
 	StreamSocketImpl* socketImpl() const;
 		/// Returns the internal SocketImpl.
+
+	int readDescriptor();
+		/// Returns the socket descriptor if no input data is buffered
+		/// and the socket is not secure, or -1 otherwise.
+
+	int writeDescriptor();
+		/// Flushes buffered output data and returns the socket
+		/// descriptor if the socket is not secure, or -1 otherwise.
+
+	void transferred(Poco::UInt64 count);
+		/// Does nothing.
 	
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
@@ -27,6 +27,7 @@
 #include "Poco/Runnable.h"
 #include "Poco/Thread.h"
 #include "Poco/ThreadPool.h"
+#include <vector>
 
 
 namespace Poco {
@@ -100,6 +101,15 @@ class Net_API TCPServer: public Poco::Runnable
 	/// Thus, the call to start() returns immediately, and the server
 	/// continues to run in the background.
 	///
+	/// On platforms supporting SO_REUSEPORT, the server can use more
+	/// than one thread to accept connections (see
+	/// TCPServerParams::setAcceptorThreads()). Each additional acceptor
+	/// thread gets its own listening socket, bound to the address of
+	/// the ServerSocket, and its own connection queue. The ServerSocket
+	/// must then have been bound with reusePort set to true (which is
+	/// the default). The connection statistics reported by the server
+	/// are the sums over all acceptor threads.
+	///
 	/// To stop the server from accepting new connections, call stop().
 	///
 	/// After calling stop(), no new connections will be accepted and
@@ -159,6 +169,12 @@ public:
 		///
 		/// Before start() is called, the ServerSocket passed to
 		/// TCPServer must have been bound and put into listening state.
+		///
+		/// If more than one acceptor thread has been requested,
+		/// the additional listening sockets are opened here.
+		/// If one of them cannot be opened, all additional acceptors
+		/// are closed and released, leaving a single one, and the
+		/// exception is rethrown.
 
 	void stop();
 		/// Stops the server.
@@ -192,6 +208,9 @@ public:
 	const ServerSocket& socket() const;
 		/// Returns the underlying server socket.
 
+	int acceptorThreads() const;
+		/// Returns the number of threads accepting connections.
+
 	Poco::UInt16 port() const;
 		/// Returns the port the server socket listens on.
 		
@@ -219,14 +238,22 @@ protected:
 		/// Returns a thread name for the server thread.
 
 private:
+	class Acceptor;
+
 	TCPServer();
 	TCPServer(const TCPServer&);
 	TCPServer& operator = (const TCPServer&);
-	
+
+	void init(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool& threadPool, TCPServerParams::Ptr pParams);
+	void acceptConnections(ServerSocket& socket, TCPServerDispatcher& dispatcher, int cpu);
+
+	typedef std::vector<Acceptor*> AcceptorVec;
+
 	ServerSocket _socket;
 	TCPServerDispatcher* _pDispatcher;
 	TCPServerConnectionFilter::Ptr _pConnectionFilter;
 	Poco::Thread _thread;
+	AcceptorVec _acceptors;
 	bool _stopped;
 };
 
@@ -252,6 +279,12 @@ inline TCPServerConnectionFilter::Ptr TCPServer::getConnectionFilter() const
 }
 
 
+inline int TCPServer::acceptorThreads() const
+{
+	return static_cast<int>(_acceptors.size()) + 1;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -45,6 +45,8 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - acceptorThreads:      1
+		///   - acceptorAffinity:     false
 
 	void setThreadIdleTime(const Poco::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -92,6 +94,36 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer.
 
+	void setAcceptorThreads(int count);
+		/// Sets the number of threads accepting connections
+		/// in the TCPServer. Must be greater than 0.
+		///
+		/// If more than one acceptor thread is requested,
+		/// the TCPServer opens an additional listening socket
+		/// for each additional thread, bound to the same address
+		/// with SO_REUSEPORT, and the kernel distributes incoming
+		/// connections among the sockets. Every acceptor thread has
+		/// its own connection queue and TCPServerDispatcher, so
+		/// the maxThreads and maxQueued limits apply to each
+		/// acceptor thread separately.
+		///
+		/// On platforms without SO_REUSEPORT, only one acceptor
+		/// thread is used.
+		///
+		/// The default is 1.
+
+	int getAcceptorThreads() const;
+		/// Returns the number of threads accepting connections.
+
+	void setAcceptorAffinity(bool flag);
+		/// If flag is true, the TCPServer binds each acceptor
+		/// thread to a CPU, starting with the first CPU.
+		///
+		/// The default is false.
+
+	bool getAcceptorAffinity() const;
+		/// Returns true if acceptor threads are bound to CPUs.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -101,6 +133,8 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Poco::Thread::Priority _threadPriority;
+	int _acceptorThreads;
+	bool _acceptorAffinity;
 };
 
 
@@ -131,6 +165,18 @@ inline Poco::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline int TCPServerParams::getAcceptorThreads() const
+{
+	return _acceptorThreads;
+}
+
+
+inline bool TCPServerParams::getAcceptorAffinity() const
+{
+	return _acceptorAffinity;
+}
+
+
 } } // namespace Poco::Net
 
 
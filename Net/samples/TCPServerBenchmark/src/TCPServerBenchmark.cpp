@@ -0,0 +1,171 @@
+//
+// TCPServerBenchmark.cpp
+//
+// This sample measures the rate at which a TCPServer accepts and
+// serves short-lived connections, first with a single acceptor
+// thread and then with the given number of acceptor threads.
+//
+// Usage: TCPServerBenchmark [<acceptor threads> [<client threads> [<connections per client thread>]]]
+//
+// Every connection is served by sending a single byte and closing
+// the connection. Clients connect to the server on the loopback
+// interface.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/TCPServer.h"
+#include "Poco/Net/TCPServerConnection.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/TCPServerParams.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Net::TCPServer;
+using Poco::Net::TCPServerConnection;
+using Poco::Net::TCPServerConnectionFactoryImpl;
+using Poco::Net::TCPServerParams;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+class ByteConnection: public TCPServerConnection
+{
+public:
+	ByteConnection(const StreamSocket& s): TCPServerConnection(s)
+	{
+	}
+
+	void run()
+	{
+		try
+		{
+			socket().sendBytes("x", 1);
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+};
+
+
+class Client: public Poco::Runnable
+{
+public:
+	Client(const SocketAddress& address, int count):
+		_address(address),
+		_count(count),
+		_failed(0)
+	{
+	}
+
+	void run()
+	{
+		for (int i = 0; i < _count; ++i)
+		{
+			try
+			{
+				StreamSocket socket(_address);
+				char buffer[16];
+				while (socket.receiveBytes(buffer, sizeof(buffer)) > 0)
+				{
+				}
+			}
+			catch (Poco::Exception&)
+			{
+				++_failed;
+			}
+		}
+	}
+
+	int failed() const
+	{
+		return _failed;
+	}
+
+private:
+	SocketAddress _address;
+	int _count;
+	int _failed;
+};
+
+
+void benchmark(int acceptors, int clients, int count)
+{
+	ServerSocket socket(SocketAddress("127.0.0.1", 0), 1024);
+	TCPServerParams::Ptr pParams = new TCPServerParams;
+	pParams->setMaxThreads(16);
+	pParams->setMaxQueued(1024);
+	pParams->setAcceptorThreads(acceptors);
+	pParams->setAcceptorAffinity(true);
+	TCPServer server(new TCPServerConnectionFactoryImpl<ByteConnection>(), socket, pParams);
+	server.start();
+
+	SocketAddress address("127.0.0.1", server.port());
+	std::vector<Client*> runnables;
+	std::vector<Thread*> threads;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < clients; ++i)
+	{
+		runnables.push_back(new Client(address, count));
+		threads.push_back(new Thread);
+		threads.back()->start(*runnables.back());
+	}
+	int failed = 0;
+	for (int i = 0; i < clients; ++i)
+	{
+		threads[i]->join();
+		failed += runnables[i]->failed();
+		delete threads[i];
+		delete runnables[i];
+	}
+	sw.stop();
+	server.stop();
+
+	double connections = static_cast<double>(clients)*count - failed;
+	std::cout << std::setw(3) << server.acceptorThreads() << " acceptor thread(s): "
+		<< std::setw(10) << std::fixed << std::setprecision(0)
+		<< connections*1000000/sw.elapsed() << " connections/s"
+		<< std::setw(8) << failed << " failed" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		int acceptors = argc > 1 ? Poco::NumberParser::parse(argv[1]) : static_cast<int>(Poco::Environment::processorCount());
+		int clients = argc > 2 ? Poco::NumberParser::parse(argv[2]) : 4;
+		int count = argc > 3 ? Poco::NumberParser::parse(argv[3]) : 5000;
+
+		std::cout << clients << " client thread(s), " << count << " connections per thread" << std::endl;
+
+		benchmark(1, clients, count);
+		if (acceptors > 1) benchmark(acceptors, clients, count);
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 1;
+	}
+	return 0;
+}
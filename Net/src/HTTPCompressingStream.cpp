@@ -0,0 +1,277 @@
+//
+// HTTPCompressingStream.cpp
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPCompressingStream
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPCompressingStream.h"
+#include "Poco/Net/HTTPServerResponseImpl.h"
+#include "Poco/Net/HTTPMessage.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// HTTPDeflater
+//
+
+
+HTTPDeflater::HTTPDeflater(int level):
+	_level(level),
+	_encoding(ENCODING_GZIP),
+	_initialized(false),
+	_buffer(BUFFER_SIZE)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+}
+
+
+HTTPDeflater::~HTTPDeflater()
+{
+	if (_initialized) deflateEnd(&_zstr);
+}
+
+
+void HTTPDeflater::begin(Encoding encoding)
+{
+	int rc;
+	if (_initialized && encoding == _encoding)
+	{
+		rc = deflateReset(&_zstr);
+	}
+	else
+	{
+		if (_initialized)
+		{
+			deflateEnd(&_zstr);
+			_initialized = false;
+		}
+		rc = deflateInit2(&_zstr, _level, Z_DEFLATED, 15 + (encoding == ENCODING_GZIP ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
+		_initialized = (rc == Z_OK);
+		_encoding = encoding;
+	}
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+void HTTPDeflater::deflate(const char* buffer, std::size_t length, std::ostream& ostr)
+{
+	poco_assert_dbg (_initialized);
+
+	_zstr.next_in  = (unsigned char*) buffer;
+	_zstr.avail_in = static_cast<unsigned>(length);
+	compress(Z_NO_FLUSH, ostr);
+}
+
+
+void HTTPDeflater::flush(std::ostream& ostr)
+{
+	poco_assert_dbg (_initialized);
+
+	_zstr.next_in  = 0;
+	_zstr.avail_in = 0;
+	compress(Z_SYNC_FLUSH, ostr);
+	ostr.flush();
+}
+
+
+void HTTPDeflater::finish(std::ostream& ostr)
+{
+	poco_assert_dbg (_initialized);
+
+	_zstr.next_in  = 0;
+	_zstr.avail_in = 0;
+	compress(Z_FINISH, ostr);
+	ostr.flush();
+}
+
+
+void HTTPDeflater::compress(int flush, std::ostream& ostr)
+{
+	int rc;
+	do
+	{
+		_zstr.next_out  = (unsigned char*) _buffer.begin();
+		_zstr.avail_out = static_cast<unsigned>(_buffer.size());
+		rc = ::deflate(&_zstr, flush);
+		if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) throw IOException(zError(rc));
+		std::size_t n = _buffer.size() - _zstr.avail_out;
+		if (n > 0)
+		{
+			ostr.write(_buffer.begin(), static_cast<std::streamsize>(n));
+			if (!ostr.good()) throw IOException("Failed to write compressed HTTP message body");
+		}
+	}
+	while (_zstr.avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+	_zstr.next_in = 0;
+}
+
+
+const std::string& HTTPDeflater::encodingName(Encoding encoding)
+{
+	static const std::string GZIP("gzip");
+	static const std::string DEFLATE("deflate");
+
+	return encoding == ENCODING_GZIP ? GZIP : DEFLATE;
+}
+
+
+//
+// HTTPCompressingStreamBuf
+//
+
+
+HTTPCompressingStreamBuf::HTTPCompressingStreamBuf(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize):
+	HTTPBasicStreamBuf(HTTPBufferAllocator::BUFFER_SIZE, std::ios::out),
+	_response(response),
+	_deflater(deflater),
+	_encoding(encoding),
+	_minSize(minSize),
+	_pStream(0),
+	_compressing(false),
+	_closed(false)
+{
+	if (response.hasContentLength())
+		beginCompression();
+}
+
+
+HTTPCompressingStreamBuf::~HTTPCompressingStreamBuf()
+{
+	delete _pStream;
+}
+
+
+void HTTPCompressingStreamBuf::close()
+{
+	if (_closed) return;
+
+	HTTPBasicStreamBuf::sync();
+	_closed = true;
+	if (_compressing)
+	{
+		_deflater.finish(*_pStream);
+	}
+	else
+	{
+		_pStream = _response.beginBody();
+		_pStream->write(_pending.data(), static_cast<std::streamsize>(_pending.size()));
+		_pStream->flush();
+		std::string().swap(_pending);
+	}
+}
+
+
+int HTTPCompressingStreamBuf::sync()
+{
+	if (HTTPBasicStreamBuf::sync())
+		return -1;
+
+	if (!_closed)
+	{
+		if (!_compressing) beginCompression();
+		_deflater.flush(*_pStream);
+	}
+	return 0;
+}
+
+
+int HTTPCompressingStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	if (_closed) return -1;
+
+	if (_compressing)
+	{
+		_deflater.deflate(buffer, static_cast<std::size_t>(length), *_pStream);
+	}
+	else
+	{
+		_pending.append(buffer, static_cast<std::size_t>(length));
+		if (_pending.size() >= _minSize)
+			beginCompression();
+	}
+	return static_cast<int>(length);
+}
+
+
+void HTTPCompressingStreamBuf::beginCompression()
+{
+	_response.set("Content-Encoding", HTTPDeflater::encodingName(_encoding));
+	_response.setContentLength(HTTPMessage::UNKNOWN_CONTENT_LENGTH);
+	_response.setChunkedTransferEncoding(true);
+	_deflater.begin(_encoding);
+	_pStream = _response.beginBody();
+	_compressing = true;
+	if (!_pending.empty())
+	{
+		_deflater.deflate(_pending.data(), _pending.size(), *_pStream);
+		std::string().swap(_pending);
+	}
+}
+
+
+//
+// HTTPCompressingIOS
+//
+
+
+HTTPCompressingIOS::HTTPCompressingIOS(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize):
+	_buf(response, deflater, encoding, minSize)
+{
+	poco_ios_init(&_buf);
+}
+
+
+HTTPCompressingIOS::~HTTPCompressingIOS()
+{
+	try
+	{
+		_buf.close();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+HTTPCompressingStreamBuf* HTTPCompressingIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+//
+// HTTPCompressingOutputStream
+//
+
+
+HTTPCompressingOutputStream::HTTPCompressingOutputStream(HTTPServerResponseImpl& response, HTTPDeflater& deflater, HTTPDeflater::Encoding encoding, std::size_t minSize):
+	HTTPCompressingIOS(response, deflater, encoding, minSize),
+	std::ostream(&_buf)
+{
+}
+
+
+HTTPCompressingOutputStream::~HTTPCompressingOutputStream()
+{
+}
+
+
+} } // namespace Poco::Net
@@ -67,6 +67,27 @@ int HTTPHeaderStreamBuf::writeToDevice(const char* buffer, std::streamsize lengt
 }
 
 
+int HTTPHeaderStreamBuf::readDescriptor()
+{
+	return -1;
+}
+
+
+int HTTPHeaderStreamBuf::writeDescriptor()
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	if (!_session.socket().secure() && sync() != -1)
+		return _session.socket().impl()->sockfd();
+#endif
+	return -1;
+}
+
+
+void HTTPHeaderStreamBuf::transferred(Poco::UInt64)
+{
+}
+
+
 //
 // HTTPHeaderIOS
 //
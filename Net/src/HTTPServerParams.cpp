@@ -13,6 +13,7 @@
 
 
 #include "Poco/Net/HTTPServerParams.h"
+#include "Poco/String.h"
 
 
 namespace Poco {
@@ -23,8 +24,20 @@ HTTPServerParams::HTTPServerParams():
 	_timeout(60000000),
 	_keepAlive(true),
 	_maxKeepAliveRequests(0),
-	_keepAliveTimeout(15000000)
+	_keepAliveTimeout(15000000),
+	_compressionLevel(0),
+	_compressionMinSize(1024)
 {
+	_compressionMediaTypes.push_back("text/plain");
+	_compressionMediaTypes.push_back("text/html");
+	_compressionMediaTypes.push_back("text/css");
+	_compressionMediaTypes.push_back("text/csv");
+	_compressionMediaTypes.push_back("text/javascript");
+	_compressionMediaTypes.push_back("text/xml");
+	_compressionMediaTypes.push_back("application/json");
+	_compressionMediaTypes.push_back("application/javascript");
+	_compressionMediaTypes.push_back("application/xml");
+	_compressionMediaTypes.push_back("image/svg+xml");
 }
 
 
@@ -68,6 +81,46 @@ void HTTPServerParams::setMaxKeepAliveRequests(int maxKeepAliveRequests)
 	poco_assert (maxKeepAliveRequests >= 0);
 	_maxKeepAliveRequests = maxKeepAliveRequests;
 }
+
+
+void HTTPServerParams::setCompressionLevel(int level)
+{
+	poco_assert (level >= 0 && level <= 9);
+	_compressionLevel = level;
+}
+
+
+void HTTPServerParams::setCompressionMinSize(std::size_t size)
+{
+	_compressionMinSize = size;
+}
+
+
+void HTTPServerParams::setCompressionMediaTypes(const std::vector<std::string>& mediaTypes)
+{
+	_compressionMediaTypes = mediaTypes;
+}
+
+
+bool HTTPServerParams::isCompressibleMediaType(const std::string& contentType) const
+{
+	std::string mediaType(contentType, 0, contentType.find(';'));
+	Poco::trimInPlace(mediaType);
+	for (std::vector<std::string>::const_iterator it = _compressionMediaTypes.begin(); it != _compressionMediaTypes.end(); ++it)
+	{
+		std::string::size_type n = it->size();
+		if (n > 1 && (*it)[n - 1] == '*' && (*it)[n - 2] == '/')
+		{
+			if (mediaType.size() > n - 1 && Poco::icompare(mediaType, n - 1, *it) == 0)
+				return true;
+		}
+		else if (Poco::icompare(mediaType, *it) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
 	
 
 } } // namespace Poco::Net
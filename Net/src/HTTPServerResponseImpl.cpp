@@ -28,6 +28,9 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
+#include <sstream>
 
 
 using Poco::File;
@@ -68,6 +71,7 @@ std::ostream& HTTPServerResponseImpl::send()
 {
 	poco_assert (!_pStream);
 
+	HTTPDeflater::Encoding encoding = HTTPDeflater::ENCODING_GZIP;
 	if ((_pRequest && _pRequest->getMethod() == HTTPRequest::HTTP_HEAD) ||
 		getStatus() < 200 ||
 		getStatus() == HTTPResponse::HTTP_NO_CONTENT ||
@@ -78,30 +82,47 @@ std::ostream& HTTPServerResponseImpl::send()
 		_pStream = new HTTPFixedLengthOutputStream(_session, cs.chars());
 		write(*_pStream);
 	}
-	else if (getChunkedTransferEncoding())
+	else if (canCompress(encoding))
+	{
+		const HTTPServerParams& params = _pRequest->serverParams();
+		if (!hasContentLength()) setChunkedTransferEncoding(true);
+		_pStream = new HTTPCompressingOutputStream(*this, _session.deflater(params.getCompressionLevel()), encoding, params.getCompressionMinSize());
+	}
+	else
+	{
+		_pStream = beginBody();
+	}
+	return *_pStream;
+}
+
+
+std::ostream* HTTPServerResponseImpl::beginBody()
+{
+	std::ostream* pStream;
+	if (getChunkedTransferEncoding())
 	{
 		HTTPHeaderOutputStream hs(_session);
 		write(hs);
-		_pStream = new HTTPChunkedOutputStream(_session);
+		pStream = new HTTPChunkedOutputStream(_session);
 	}
 	else if (hasContentLength())
 	{
 		Poco::CountingOutputStream cs;
 		write(cs);
 #if defined(POCO_HAVE_INT64)	
-		_pStream = new HTTPFixedLengthOutputStream(_session, getContentLength64() + cs.chars());
+		pStream = new HTTPFixedLengthOutputStream(_session, getContentLength64() + cs.chars());
 #else
-		_pStream = new HTTPFixedLengthOutputStream(_session, getContentLength() + cs.chars());
+		pStream = new HTTPFixedLengthOutputStream(_session, getContentLength() + cs.chars());
 #endif
-		write(*_pStream);
+		write(*pStream);
 	}
 	else
 	{
-		_pStream = new HTTPOutputStream(_session);
+		pStream = new HTTPOutputStream(_session);
 		setKeepAlive(false);
-		write(*_pStream);
+		write(*pStream);
 	}
-	return *_pStream;
+	return pStream;
 }
 
 
@@ -141,7 +162,25 @@ void HTTPServerResponseImpl::sendBuffer(const void* pBuffer, std::size_t length)
 
 	setContentLength(static_cast<int>(length));
 	setChunkedTransferEncoding(false);
-	
+
+	HTTPDeflater::Encoding encoding = HTTPDeflater::ENCODING_GZIP;
+	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && canCompress(encoding))
+	{
+		HTTPDeflater& deflater = _session.deflater(_pRequest->serverParams().getCompressionLevel());
+		std::ostringstream ostr;
+		deflater.begin(encoding);
+		deflater.deflate(static_cast<const char*>(pBuffer), length, ostr);
+		deflater.finish(ostr);
+		std::string body = ostr.str();
+		set("Content-Encoding", HTTPDeflater::encodingName(encoding));
+		setContentLength(static_cast<int>(body.size()));
+
+		_pStream = new HTTPHeaderOutputStream(_session);
+		write(*_pStream);
+		_pStream->write(body.data(), static_cast<std::streamsize>(body.size()));
+		return;
+	}
+
 	_pStream = new HTTPHeaderOutputStream(_session);
 	write(*_pStream);
 	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
@@ -178,4 +217,73 @@ void HTTPServerResponseImpl::requireAuthentication(const std::string& realm)
 }
 
 
+bool HTTPServerResponseImpl::canCompress(HTTPDeflater::Encoding& encoding)
+{
+	if (!_pRequest) return false;
+
+	const HTTPServerParams& params = _pRequest->serverParams();
+	if (params.getCompressionLevel() == 0 ||
+		getVersion() != HTTPMessage::HTTP_1_1 ||
+		getStatus() < 200 ||
+		getStatus() == HTTPResponse::HTTP_NO_CONTENT ||
+		getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT ||
+		getStatus() == HTTPResponse::HTTP_NOT_MODIFIED ||
+		has("Content-Encoding") ||
+		has("Content-Range") ||
+		!params.isCompressibleMediaType(getContentType()))
+	{
+		return false;
+	}
+#if defined(POCO_HAVE_INT64)
+	if (hasContentLength() && getContentLength64() < static_cast<Poco::Int64>(params.getCompressionMinSize()))
+#else
+	if (hasContentLength() && getContentLength() < static_cast<std::streamsize>(params.getCompressionMinSize()))
+#endif
+	{
+		return false;
+	}
+
+	const std::string& vary = get("Vary", EMPTY);
+	if (vary.empty())
+		set("Vary", "Accept-Encoding");
+	else if (Poco::toLower(vary).find("accept-encoding") == std::string::npos)
+		set("Vary", vary + ", Accept-Encoding");
+
+	double gzipQ = -1;
+	double deflateQ = -1;
+	double anyQ = 0;
+	std::vector<std::string> elements;
+	splitElements(_pRequest->get("Accept-Encoding", EMPTY), elements);
+	for (std::vector<std::string>::const_iterator it = elements.begin(); it != elements.end(); ++it)
+	{
+		std::string coding;
+		NameValueCollection parameters;
+		splitParameters(*it, coding, parameters);
+		double q = 1;
+		const std::string& qValue = parameters.get("q", EMPTY);
+		if (!qValue.empty() && !Poco::NumberParser::tryParseFloat(qValue, q)) q = 0;
+		if (Poco::icompare(coding, "gzip") == 0 || Poco::icompare(coding, "x-gzip") == 0)
+			gzipQ = q;
+		else if (Poco::icompare(coding, "deflate") == 0)
+			deflateQ = q;
+		else if (coding == "*")
+			anyQ = q;
+	}
+	if (gzipQ < 0) gzipQ = anyQ;
+	if (deflateQ < 0) deflateQ = anyQ;
+
+	if (gzipQ > 0 && gzipQ >= deflateQ)
+	{
+		encoding = HTTPDeflater::ENCODING_GZIP;
+		return true;
+	}
+	else if (deflateQ > 0)
+	{
+		encoding = HTTPDeflater::ENCODING_DEFLATE;
+		return true;
+	}
+	return false;
+}
+
+
 } } // namespace Poco::Net
@@ -23,7 +23,8 @@ HTTPServerSession::HTTPServerSession(const StreamSocket& socket, HTTPServerParam
 	HTTPSession(socket, pParams->getKeepAlive()),
 	_firstRequest(true),
 	_keepAliveTimeout(pParams->getKeepAliveTimeout()),
-	_maxKeepAliveRequests(pParams->getMaxKeepAliveRequests())
+	_maxKeepAliveRequests(pParams->getMaxKeepAliveRequests()),
+	_pDeflater(0)
 {
 	setTimeout(pParams->getTimeout());
 	this->socket().setReceiveTimeout(pParams->getTimeout());
@@ -32,6 +33,7 @@ HTTPServerSession::HTTPServerSession(const StreamSocket& socket, HTTPServerParam
 
 HTTPServerSession::~HTTPServerSession()
 {
+	delete _pDeflater;
 }
 
 
@@ -67,4 +69,16 @@ SocketAddress HTTPServerSession::serverAddress()
 }
 
 
+HTTPDeflater& HTTPServerSession::deflater(int level)
+{
+	if (!_pDeflater || _pDeflater->level() != level)
+	{
+		delete _pDeflater;
+		_pDeflater = 0;
+		_pDeflater = new HTTPDeflater(level);
+	}
+	return *_pDeflater;
+}
+
+
 } } // namespace Poco::Net
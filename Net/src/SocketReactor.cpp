@@ -66,21 +66,23 @@ SocketReactor::~SocketReactor()
 void SocketReactor::run()
 {
 	_pThread = Thread::current();
+	_timeoutStart.update();
 	while (!_stop)
 	{
 		try
 		{
+			Timespan timeout = waitTimeout();
 			if (!hasSocketHandlers())
 			{
 				onIdle();
-				Timespan::TimeDiff ms = _timeout.totalMilliseconds();
+				Timespan::TimeDiff ms = timeout.totalMilliseconds();
 				poco_assert_dbg(ms <= std::numeric_limits<long>::max());
 				Thread::trySleep(static_cast<long>(ms));
 			}
 			else
 			{
 				bool readable = false;
-				PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
+				PollSet::SocketModeMap sm = _pollSet.poll(timeout);
 				if (sm.size() > 0)
 				{
 					onBusy();
@@ -97,8 +99,20 @@ void SocketReactor::run()
 						if (it->second & PollSet::POLL_ERROR) dispatch(it->first, _pErrorNotification);
 					}
 				}
-				if (!readable) onTimeout();
+				// The poll may have been shortened for a timer, so
+				// the timeout is measured from the last readable event
+				// or timeout notification.
+				if (readable)
+				{
+					_timeoutStart.update();
+				}
+				else if (timeout == _timeout || _timeoutStart.isElapsed(_timeout.totalMicroseconds()))
+				{
+					_timeoutStart.update();
+					onTimeout();
+				}
 			}
+			_timers.process();
 		}
 		catch (Exception& exc)
 		{
@@ -117,6 +131,16 @@ void SocketReactor::run()
 }
 
 
+Timespan SocketReactor::waitTimeout() const
+{
+	long ms = _timers.nextTimeout();
+	if (ms >= 0 && ms < _timeout.totalMilliseconds())
+		return Timespan(static_cast<Timespan::TimeDiff>(ms)*1000);
+	else
+		return _timeout;
+}
+
+
 bool SocketReactor::hasSocketHandlers()
 {
 	if (!_pollSet.empty())
@@ -140,6 +164,28 @@ void SocketReactor::stop()
 }
 
 
+Poco::TimerWheel::Handle SocketReactor::schedule(const Poco::TimerWheel::Callback& callback, long delay)
+{
+	Poco::TimerWheel::Handle handle = _timers.schedule(callback, delay);
+	if (Thread::current() != _pThread) wakeUp();
+	return handle;
+}
+
+
+Poco::TimerWheel::Handle SocketReactor::schedule(const Poco::TimerWheel::Callback& callback, long delay, long interval)
+{
+	Poco::TimerWheel::Handle handle = _timers.schedule(callback, delay, interval);
+	if (Thread::current() != _pThread) wakeUp();
+	return handle;
+}
+
+
+bool SocketReactor::cancel(Poco::TimerWheel::Handle handle)
+{
+	return _timers.cancel(handle);
+}
+
+
 void SocketReactor::wakeUp()
 {
 	if (_pThread) _pThread->wakeUp();
@@ -59,6 +59,31 @@ int SocketStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
 }
 
 
+int SocketStreamBuf::readDescriptor()
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	if (gptr() == egptr() && !_pImpl->secure())
+		return _pImpl->sockfd();
+#endif
+	return -1;
+}
+
+
+int SocketStreamBuf::writeDescriptor()
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	if (!_pImpl->secure() && sync() != -1)
+		return _pImpl->sockfd();
+#endif
+	return -1;
+}
+
+
+void SocketStreamBuf::transferred(Poco::UInt64)
+{
+}
+
+
 //
 // SocketIOS
 //
@@ -19,6 +19,8 @@
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/Environment.h"
+#include "Poco/NumberFormatter.h"
 
 
 using Poco::ErrorHandler;
@@ -38,6 +40,85 @@ TCPServerConnectionFilter::~TCPServerConnectionFilter()
 }
 
 
+//
+// TCPServer::Acceptor
+//
+
+
+class TCPServer::Acceptor: public Poco::Runnable
+	/// An additional thread accepting connections on its
+	/// own listening socket, bound with SO_REUSEPORT.
+{
+public:
+	Acceptor(TCPServer& server, TCPServerDispatcher* pDispatcher, int index):
+		_server(server),
+		_pDispatcher(pDispatcher),
+		_index(index),
+		_cpu(-1)
+	{
+	}
+
+	~Acceptor()
+	{
+		_pDispatcher->release();
+	}
+
+	void open(const ServerSocket& socket)
+	{
+		SocketAddress address = socket.address();
+#if defined(POCO_HAVE_IPv6)
+		if (address.family() == SocketAddress::IPv6)
+		{
+			int ipV6Only = 0;
+			socket.getOption(IPPROTO_IPV6, IPV6_V6ONLY, ipV6Only);
+			_socket.bind6(address, true, true, ipV6Only != 0);
+		}
+		else
+#endif
+		_socket.bind(address, true, true);
+		_socket.listen();
+	}
+
+	void close()
+	{
+		_socket.close();
+		_pDispatcher->stop();
+	}
+
+	void start(int cpu)
+	{
+		_cpu = cpu;
+		_thread.setName(threadName(_socket) + " #" + NumberFormatter::format(_index));
+		_thread.start(*this);
+	}
+
+	void join()
+	{
+		_thread.join();
+		_socket.close();
+		_pDispatcher->stop();
+	}
+
+	TCPServerDispatcher& dispatcher()
+	{
+		return *_pDispatcher;
+	}
+
+	void run()
+	{
+		_server.acceptConnections(_socket, *_pDispatcher, _cpu);
+	}
+
+private:
+	TCPServer& _server;
+	ServerSocket _socket;
+	TCPServerDispatcher* _pDispatcher;
+	int _index;
+	int _cpu;
+	Poco::Thread _thread;
+};
+
+
 //
 // TCPServer
 //
@@ -45,41 +126,43 @@ TCPServerConnectionFilter::~TCPServerConnectionFilter()
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 portNumber, TCPServerParams::Ptr pParams):
 	_socket(ServerSocket(portNumber)),
+	_pDispatcher(0),
 	_thread(threadName(_socket)),
 	_stopped(true)
 {	
 	Poco::ThreadPool& pool = Poco::ThreadPool::defaultPool();
 	if (pParams)
 	{
-		int toAdd = pParams->getMaxThreads() - pool.capacity();
+		int toAdd = pParams->getMaxThreads()*pParams->getAcceptorThreads() - pool.capacity();
 		if (toAdd > 0) pool.addCapacity(toAdd);
 	}
-	_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
-	
+	init(pFactory, pool, pParams);
 }
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, const ServerSocket& socket, TCPServerParams::Ptr pParams):
 	_socket(socket),
+	_pDispatcher(0),
 	_thread(threadName(socket)),
 	_stopped(true)
 {
 	Poco::ThreadPool& pool = Poco::ThreadPool::defaultPool();
 	if (pParams)
 	{
-		int toAdd = pParams->getMaxThreads() - pool.capacity();
+		int toAdd = pParams->getMaxThreads()*pParams->getAcceptorThreads() - pool.capacity();
 		if (toAdd > 0) pool.addCapacity(toAdd);
 	}
-	_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
+	init(pFactory, pool, pParams);
 }
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, TCPServerParams::Ptr pParams):
 	_socket(socket),
-	_pDispatcher(new TCPServerDispatcher(pFactory, threadPool, pParams)),
+	_pDispatcher(0),
 	_thread(threadName(socket)),
 	_stopped(true)
 {
+	init(pFactory, threadPool, pParams);
 }
 
 
@@ -89,6 +172,10 @@ TCPServer::~TCPServer()
 	{
 		stop();
 		_pDispatcher->release();
+		for (AcceptorVec::iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+		{
+			delete *it;
+		}
 	}
 	catch (...)
 	{
@@ -97,6 +184,28 @@ TCPServer::~TCPServer()
 }
 
 
+void TCPServer::init(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool& threadPool, TCPServerParams::Ptr pParams)
+{
+	_pDispatcher = new TCPServerDispatcher(pFactory, threadPool, pParams);
+
+	// Additional acceptors need SO_REUSEPORT, which makes
+	// no sense for local sockets.
+#if defined(SO_REUSEPORT)
+	bool reusePort = true;
+#if defined(POCO_OS_FAMILY_UNIX)
+	reusePort = _socket.address().family() != AddressFamily::UNIX_LOCAL;
+#endif
+	if (pParams && reusePort)
+	{
+		for (int i = 1; i < pParams->getAcceptorThreads(); i++)
+		{
+			_acceptors.push_back(new Acceptor(*this, new TCPServerDispatcher(pFactory, threadPool, pParams), i));
+		}
+	}
+#endif
+}
+
+
 const TCPServerParams& TCPServer::params() const
 {
 	return _pDispatcher->params();
@@ -107,8 +216,34 @@ void TCPServer::start()
 {
 	poco_assert (_stopped);
 
+	try
+	{
+		for (AcceptorVec::iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+		{
+			(*it)->open(_socket);
+		}
+	}
+	catch (...)
+	{
+		// The kernel would keep queueing connections on the
+		// sockets already opened, with nobody accepting them.
+		for (AcceptorVec::iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+		{
+			(*it)->close();
+			delete *it;
+		}
+		_acceptors.clear();
+		throw;
+	}
+
+	bool affinity = _pDispatcher->params().getAcceptorAffinity();
+	int cpus = Poco::Environment::processorCount();
 	_stopped = false;
 	_thread.start(*this);
+	for (std::size_t i = 0; i < _acceptors.size(); i++)
+	{
+		_acceptors[i]->start(affinity ? static_cast<int>((i + 1) % cpus) : -1);
+	}
 }
 
 	
@@ -119,22 +254,44 @@ void TCPServer::stop()
 		_stopped = true;
 		_thread.join();
 		_pDispatcher->stop();
+		for (AcceptorVec::iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+		{
+			(*it)->join();
+		}
 	}
 }
 
 
 void TCPServer::run()
 {
+	acceptConnections(_socket, *_pDispatcher, _pDispatcher->params().getAcceptorAffinity() ? 0 : -1);
+}
+
+
+void TCPServer::acceptConnections(ServerSocket& socket, TCPServerDispatcher& dispatcher, int cpu)
+{
+	if (cpu >= 0)
+	{
+		try
+		{
+			Poco::Thread::current()->setAffinity(cpu);
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+	}
+
 	while (!_stopped)
 	{
 		Poco::Timespan timeout(250000);
 		try
 		{
-			if (_socket.poll(timeout, Socket::SELECT_READ))
+			if (socket.poll(timeout, Socket::SELECT_READ))
 			{
 				try
 				{
-					StreamSocket ss = _socket.acceptConnection();
+					StreamSocket ss = socket.acceptConnection();
 					
 					if (!_pConnectionFilter || _pConnectionFilter->accept(ss))
 					{
@@ -145,7 +302,7 @@ void TCPServer::run()
 						{
 							ss.setNoDelay(true);
 						}
-						_pDispatcher->enqueue(ss);
+						dispatcher.enqueue(ss);
 					}
 				}
 				catch (Poco::Exception& exc)
@@ -175,43 +332,78 @@ void TCPServer::run()
 
 int TCPServer::currentThreads() const
 {
-	return _pDispatcher->currentThreads();
+	int n = _pDispatcher->currentThreads();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().currentThreads();
+	}
+	return n;
 }
 
 
 int TCPServer::maxThreads() const
 {
-	return _pDispatcher->maxThreads();
+	int n = _pDispatcher->maxThreads();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().maxThreads();
+	}
+	return n;
 }
 
 	
 int TCPServer::totalConnections() const
 {
-	return _pDispatcher->totalConnections();
+	int n = _pDispatcher->totalConnections();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().totalConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::currentConnections() const
 {
-	return _pDispatcher->currentConnections();
+	int n = _pDispatcher->currentConnections();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().currentConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::maxConcurrentConnections() const
 {
-	return _pDispatcher->maxConcurrentConnections();
+	int n = _pDispatcher->maxConcurrentConnections();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().maxConcurrentConnections();
+	}
+	return n;
 }
 
 	
 int TCPServer::queuedConnections() const
 {
-	return _pDispatcher->queuedConnections();
+	int n = _pDispatcher->queuedConnections();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().queuedConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::refusedConnections() const
 {
-	return _pDispatcher->refusedConnections();
+	int n = _pDispatcher->refusedConnections();
+	for (AcceptorVec::const_iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		n += (*it)->dispatcher().refusedConnections();
+	}
+	return n;
 }
 
 
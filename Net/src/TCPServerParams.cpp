@@ -23,7 +23,9 @@ TCPServerParams::TCPServerParams():
 	_threadIdleTime(10000000),
 	_maxThreads(0),
 	_maxQueued(64),
-	_threadPriority(Poco::Thread::PRIO_NORMAL)
+	_threadPriority(Poco::Thread::PRIO_NORMAL),
+	_acceptorThreads(1),
+	_acceptorAffinity(false)
 {
 }
 
@@ -61,4 +63,18 @@ void TCPServerParams::setThreadPriority(Poco::Thread::Priority prio)
 }
 
 
+void TCPServerParams::setAcceptorThreads(int count)
+{
+	poco_assert (count > 0);
+
+	_acceptorThreads = count;
+}
+
+
+void TCPServerParams::setAcceptorAffinity(bool flag)
+{
+	_acceptorAffinity = flag;
+}
+
+
 } } // namespace Poco::Net
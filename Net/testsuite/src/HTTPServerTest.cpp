@@ -22,6 +22,15 @@
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/InflatingStream.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Event.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
 #include <sstream>
 
 
@@ -38,6 +47,10 @@ using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
 using Poco::StreamCopier;
+using Poco::InflatingInputStream;
+using Poco::InflatingStreamBuf;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
 
 
 namespace
@@ -104,11 +117,69 @@ namespace
 		}
 	};
 	
+	class JSONBufferRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string data("[");
+			for (int i = 0; i < 500; i++)
+			{
+				if (i > 0) data += ',';
+				data += "{\"id\":1}";
+			}
+			data += ']';
+			if (request.has("Range"))
+			{
+				response.setStatus(HTTPResponse::HTTP_PARTIAL_CONTENT);
+				response.set("Content-Range", "bytes 0-4500/4501");
+			}
+			response.setContentType("application/json");
+			response.sendBuffer(data.data(), data.length());
+		}
+	};
+	
+	Poco::Event flushEvent;
+
+	class FlushRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.setChunkedTransferEncoding(true);
+			response.setContentType("text/plain");
+			std::ostream& ostr = response.send();
+			ostr << "hello";
+			ostr.flush();
+			flushEvent.tryWait(5000);
+			ostr << " world";
+		}
+	};
+	
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		FileRequestHandler(const std::string& path):
+			_path(path)
+		{
+		}
+
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.sendFile(_path, "application/octet-stream");
+		}
+
+	private:
+		std::string _path;
+	};
+
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
 		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
 		{
+			if (request.getURI().compare(0, 6, "/file?") == 0)
+				return new FileRequestHandler(request.getURI().substr(6));
 			if (request.getURI() == "/echoBody")
 				return new EchoBodyRequestHandler;
 			else if (request.getURI() == "/echoHeader")
@@ -119,6 +190,10 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/bufferJSON")
+				return new JSONBufferRequestHandler();
+			else if (request.getURI() == "/flush")
+				return new FlushRequestHandler();
 			else
 				return 0;
 		}
@@ -516,6 +591,210 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testFile()
+{
+	std::string data;
+	for (int i = 0; i < 200000; ++i) data += char('a' + i % 26);
+	TemporaryFile file;
+	{
+		FileOutputStream ostr(file.path());
+		ostr << data;
+	}
+
+	HTTPServer srv(new RequestHandlerFactory, 0);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.socket().address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file?" + file.path(), HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.getContentLength() == static_cast<std::streamsize>(data.size()));
+	assertTrue (response.getContentType() == "application/octet-stream");
+	assertTrue (rbody == data);
+
+	// the connection must still be usable after the file
+	request.setURI("/buffer");
+	cs.sendRequest(request);
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (rbody == "xxxxxxxxxx");
+}
+
+
+void HTTPServerTest::testCompression()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setCompressionLevel(6);
+	pParams->setCompressionMinSize(100);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	std::string body(5000, 'x');
+
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setChunkedTransferEncoding(true);
+	request.setContentType("text/plain");
+	request.set("Accept-Encoding", "gzip, deflate");
+	cs.sendRequest(request) << body;
+	HTTPResponse response1;
+	std::istream& rs1 = cs.receiveResponse(response1);
+	assertTrue (response1.getChunkedTransferEncoding());
+	assertTrue (response1.get("Content-Encoding") == "gzip");
+	assertTrue (response1.get("Vary") == "Accept-Encoding");
+	InflatingInputStream gzipStream(rs1, InflatingStreamBuf::STREAM_GZIP);
+	std::string rbody;
+	StreamCopier::copyToString(gzipStream, rbody);
+	assertTrue (rbody == body);
+
+	request.setChunkedTransferEncoding(false);
+	request.setContentLength((int) body.length());
+	request.set("Accept-Encoding", "gzip;q=0.5, deflate");
+	cs.sendRequest(request) << body;
+	HTTPResponse response2;
+	std::istream& rs2 = cs.receiveResponse(response2);
+	assertTrue (response2.getChunkedTransferEncoding());
+	assertTrue (response2.get("Content-Encoding") == "deflate");
+	InflatingInputStream deflateStream(rs2, InflatingStreamBuf::STREAM_ZLIB);
+	rbody.clear();
+	StreamCopier::copyToString(deflateStream, rbody);
+	assertTrue (rbody == body);
+
+	std::string small(50, 'x');
+	request.setContentLength((int) small.length());
+	request.set("Accept-Encoding", "gzip");
+	cs.sendRequest(request) << small;
+	HTTPResponse response3;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response3), rbody);
+	assertTrue (!response3.has("Content-Encoding"));
+	assertTrue (response3.getContentLength() == small.size());
+	assertTrue (rbody == small);
+
+	request.setContentLength((int) body.length());
+	request.setContentType("image/png");
+	cs.sendRequest(request) << body;
+	HTTPResponse response4;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response4), rbody);
+	assertTrue (!response4.has("Content-Encoding"));
+	assertTrue (rbody == body);
+
+	request.setContentType("text/plain");
+	request.set("Accept-Encoding", "gzip;q=0, identity");
+	cs.sendRequest(request) << body;
+	HTTPResponse response5;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response5), rbody);
+	assertTrue (!response5.has("Content-Encoding"));
+	assertTrue (response5.get("Vary") == "Accept-Encoding");
+	assertTrue (rbody == body);
+
+	request.setChunkedTransferEncoding(true);
+	request.set("Accept-Encoding", "gzip");
+	cs.sendRequest(request) << small;
+	HTTPResponse response6;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response6), rbody);
+	assertTrue (!response6.has("Content-Encoding"));
+	assertTrue (response6.getChunkedTransferEncoding());
+	assertTrue (rbody == small);
+	assertTrue (srv.totalConnections() == 1);
+}
+
+
+void HTTPServerTest::testCompressedBuffer()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	pParams->setCompressionLevel(9);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	HTTPRequest request("GET", "/bufferJSON", HTTPMessage::HTTP_1_1);
+	request.set("Accept-Encoding", "gzip");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.get("Content-Encoding") == "gzip");
+	assertTrue (response.getContentLength() < 1000);
+	InflatingInputStream gzipStream(rs, InflatingStreamBuf::STREAM_GZIP);
+	std::string rbody;
+	StreamCopier::copyToString(gzipStream, rbody);
+	assertTrue (rbody.size() == 4501);
+	assertTrue (rbody.compare(0, 10, "[{\"id\":1},") == 0);
+
+	// partial content is never compressed
+	HTTPClientSession cs2("127.0.0.1", svs.address().port());
+	request.set("Range", "bytes=0-");
+	cs2.sendRequest(request);
+	HTTPResponse response2;
+	rbody.clear();
+	StreamCopier::copyToString(cs2.receiveResponse(response2), rbody);
+	assertTrue (response2.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (!response2.has("Content-Encoding"));
+	assertTrue (response2.get("Content-Range") == "bytes 0-4500/4501");
+	assertTrue (rbody.size() == 4501);
+}
+
+
+void HTTPServerTest::testCompressedFlush()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	pParams->setCompressionLevel(6);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	HTTPRequest request("GET", "/flush", HTTPMessage::HTTP_1_1);
+	request.set("Accept-Encoding", "gzip");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	assertTrue (response.get("Content-Encoding") == "gzip");
+
+	// the flushed part of the body must arrive before the handler completes
+	z_stream zstr = z_stream();
+	assertTrue (inflateInit2(&zstr, 15 + 16) == Z_OK);
+	std::string rbody;
+	char buffer[64];
+	bool flushed = false;
+	int c;
+	while ((c = rs.get()) != std::char_traits<char>::eof())
+	{
+		unsigned char in = static_cast<unsigned char>(c);
+		zstr.next_in   = &in;
+		zstr.avail_in  = 1;
+		zstr.next_out  = reinterpret_cast<unsigned char*>(buffer);
+		zstr.avail_out = sizeof(buffer);
+		int rc = inflate(&zstr, Z_SYNC_FLUSH);
+		assertTrue (rc == Z_OK || rc == Z_STREAM_END || rc == Z_BUF_ERROR);
+		rbody.append(buffer, sizeof(buffer) - zstr.avail_out);
+		if (!flushed && rbody.size() >= 5)
+		{
+			assertTrue (rbody == "hello");
+			flushed = true;
+			flushEvent.set();
+		}
+	}
+	inflateEnd(&zstr);
+	assertTrue (flushed);
+	assertTrue (rbody == "hello world");
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -544,6 +823,10 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testCompression);
+	CppUnit_addTest(pSuite, HTTPServerTest, testCompressedBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testCompressedFlush);
 
 	return pSuite;
 }
@@ -38,6 +38,10 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testFile();
+	void testCompression();
+	void testCompressedBuffer();
+	void testCompressedFlush();
 
 	void setUp();
 	void tearDown();
@@ -22,6 +22,7 @@
 #include "Poco/Observer.h"
 #include "Poco/Exception.h"
 #include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
 #include <sstream>
 
 
@@ -40,6 +41,7 @@ using Poco::Net::ShutdownNotification;
 using Poco::Observer;
 using Poco::IllegalStateException;
 using Poco::Thread;
+using Poco::Stopwatch;
 
 
 namespace
@@ -298,6 +300,29 @@ namespace
 		bool _shutdown;
 	};
 
+
+	class TimeoutCounter
+	{
+	public:
+		TimeoutCounter(): _count(0)
+		{
+		}
+
+		void onTimeout(TimeoutNotification* pNf)
+		{
+			pNf->release();
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		int _count;
+	};
+
 	class DataServiceHandler
 	{
 	public:
@@ -557,6 +582,72 @@ void SocketReactorTest::testDataCollection()
 }
 
 
+void SocketReactorTest::testTimers()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+
+	Thread* pThread = 0;
+	Poco::Timestamp::TimeDiff elapsed = 0;
+	int count = 0;
+	bool cancelled = false;
+	Stopwatch sw;
+	sw.start();
+	reactor.schedule([&]()
+		{
+			pThread = Thread::current();
+			elapsed = sw.elapsed();
+		}, 50);
+	Poco::TimerWheel::Handle handle = reactor.schedule([&]() { cancelled = true; }, 100);
+	reactor.schedule([&]()
+		{
+			if (++count == 5) reactor.stop();
+		}, 100, 20);
+	assertTrue (reactor.cancel(handle));
+	assertTrue (!reactor.cancel(handle));
+
+	reactor.run();
+	sw.stop();
+	assertTrue (pThread == Thread::current());
+	assertTrue (elapsed >= 50000 && elapsed < 150000);
+	assertTrue (count == 5);
+	assertTrue (!cancelled);
+	assertTrue (sw.elapsed() >= 180000 && sw.elapsed() < 400000);
+}
+
+
+void SocketReactorTest::testTimeoutWithTimers()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor(Poco::Timespan(0, 100000));
+	SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+	TimeoutCounter counter;
+	reactor.addEventHandler(ss, Observer<TimeoutCounter, TimeoutNotification>(counter, &TimeoutCounter::onTimeout));
+
+	// a timer firing more often than the reactor timeout
+	// must not suppress timeout notifications; the bounds
+	// are event counts, not wall-clock time, so the test
+	// does not depend on the scheduling of a loaded machine
+	int ticks = 0;
+	bool expired = false;
+	reactor.schedule([&]()
+		{
+			++ticks;
+			if (counter.count() >= 3) reactor.stop();
+		}, 10, 10);
+	reactor.schedule([&]() { expired = true; reactor.stop(); }, 30000);
+	reactor.run();
+
+	assertTrue (!expired);
+	assertTrue (counter.count() >= 3);
+	assertTrue (ticks >= counter.count());
+	reactor.removeEventHandler(ss, Observer<TimeoutCounter, TimeoutNotification>(counter, &TimeoutCounter::onTimeout));
+}
+
+
 void SocketReactorTest::setUp()
 {
 	ClientServiceHandler::setCloseOnTimeout(false);
@@ -578,6 +669,8 @@ CppUnit::Test* SocketReactorTest::suite()
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorFail);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorTimeout);
 	CppUnit_addTest(pSuite, SocketReactorTest, testDataCollection);
+	CppUnit_addTest(pSuite, SocketReactorTest, testTimers);
+	CppUnit_addTest(pSuite, SocketReactorTest, testTimeoutWithTimers);
 
 	return pSuite;
 }
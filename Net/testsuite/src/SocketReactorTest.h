@@ -30,6 +30,8 @@ public:
 	void testSocketConnectorFail();
 	void testSocketConnectorTimeout();
 	void testDataCollection();
+	void testTimers();
+	void testTimeoutWithTimers();
 
 	void setUp();
 	void tearDown();
@@ -19,6 +19,9 @@
 #include "Poco/Net/NetException.h"
 #include "Poco/Timespan.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
 
 
 using Poco::Net::Socket;
@@ -31,6 +34,10 @@ using Poco::Timespan;
 using Poco::Stopwatch;
 using Poco::TimeoutException;
 using Poco::InvalidArgumentException;
+using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
 
 
 SocketStreamTest::SocketStreamTest(const std::string& name): CppUnit::TestCase(name)
@@ -91,6 +98,48 @@ void SocketStreamTest::testLargeStreamEcho()
 }
 
 
+void SocketStreamTest::testCopyStream()
+{
+	const int msgSize = 50000;
+	std::string payload;
+	for (int i = 0; i < msgSize; ++i) payload += char('a' + i % 26);
+	TemporaryFile srcFile;
+	TemporaryFile destFile;
+	{
+		FileOutputStream ostr(srcFile.path());
+		ostr << payload;
+	}
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	ss.setSendBufferSize(2*msgSize);
+	ss.setReceiveBufferSize(2*msgSize);
+	SocketStream str(ss);
+	str << '<';
+	FileInputStream istr(srcFile.path());
+	std::streamsize n = StreamCopier::copyStream(istr, str);
+	assertTrue (n == msgSize);
+	str << '>';
+	str.flush();
+	assertTrue (str.good());
+	ss.shutdownSend();
+
+	assertTrue (str.get() == '<');
+	FileOutputStream ostr(destFile.path());
+	n = StreamCopier::copyStream(str, ostr);
+	assertTrue (n == msgSize + 1);
+	ostr.close();
+
+	FileInputStream resultStr(destFile.path());
+	std::string result;
+	StreamCopier::copyToString(resultStr, result);
+	assertTrue (result == payload + '>');
+
+	ss.close();
+}
+
+
 void SocketStreamTest::testEOF()
 {
 	StreamSocket ss;
@@ -136,6 +185,7 @@ CppUnit::Test* SocketStreamTest::suite()
 
 	CppUnit_addTest(pSuite, SocketStreamTest, testStreamEcho);
 	CppUnit_addTest(pSuite, SocketStreamTest, testLargeStreamEcho);
+	CppUnit_addTest(pSuite, SocketStreamTest, testCopyStream);
 	CppUnit_addTest(pSuite, SocketStreamTest, testEOF);
 
 	return pSuite;
@@ -26,6 +26,7 @@ public:
 
 	void testStreamEcho();
 	void testLargeStreamEcho();
+	void testCopyStream();
 	void testEOF();
 
 	void setUp();
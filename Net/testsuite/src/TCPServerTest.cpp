@@ -18,7 +18,10 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/Mutex.h"
 #include <iostream>
+#include <vector>
+#include <set>
 
 
 using Poco::Net::TCPServer;
@@ -70,6 +73,28 @@ namespace
 			return false;
 		}
 	};
+
+	class AcceptorFilter: public TCPServerConnectionFilter
+		/// Records the names of the threads accepting connections.
+	{
+	public:
+		bool accept(const StreamSocket&)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_threads.insert(Thread::current()->name());
+			return true;
+		}
+
+		std::size_t threads() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _threads.size();
+		}
+
+	private:
+		mutable Poco::FastMutex _mutex;
+		std::set<std::string> _threads;
+	};
 }
 
 
@@ -277,6 +302,88 @@ void TCPServerTest::testFilter()
 }
 
 
+void TCPServerTest::testMultipleAcceptors()
+{
+	const int connections = 64;
+	ServerSocket svs(0);
+	TCPServerParams* pParams = new TCPServerParams;
+	pParams->setAcceptorThreads(4);
+	pParams->setAcceptorAffinity(true);
+	pParams->setMaxThreads(connections);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), svs, pParams);
+	Poco::AutoPtr<AcceptorFilter> pFilter = new AcceptorFilter;
+	srv.setConnectionFilter(pFilter);
+	srv.start();
+	assertTrue (srv.acceptorThreads() == 4 || srv.acceptorThreads() == 1);
+
+	SocketAddress sa("127.0.0.1", srv.socket().address().port());
+	std::vector<StreamSocket> sockets;
+	for (int i = 0; i < connections; i++)
+	{
+		sockets.push_back(StreamSocket(sa));
+		sockets.back().setReceiveTimeout(Poco::Timespan(10, 0));
+	}
+	std::string data("hello, world");
+	for (int i = 0; i < connections; i++)
+	{
+		sockets[i].sendBytes(data.data(), (int) data.size());
+		char buffer[256];
+		int n = sockets[i].receiveBytes(buffer, sizeof(buffer));
+		assertTrue (std::string(buffer, n) == data);
+	}
+	assertTrue (srv.totalConnections() == connections);
+	assertTrue (srv.currentConnections() == connections);
+	assertTrue (srv.queuedConnections() == 0);
+
+	// The kernel spreads the connections over all listening sockets;
+	// missing one of four with 64 connections is very unlikely.
+	assertTrue (pFilter->threads() == static_cast<std::size_t>(srv.acceptorThreads()));
+
+	for (int i = 0; i < connections; i++)
+	{
+		sockets[i].close();
+	}
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+	srv.stop();
+}
+
+
+void TCPServerTest::testAcceptorsOpenFailure()
+{
+	// Without SO_REUSEPORT on the server socket, additional
+	// acceptors cannot bind to its address.
+	ServerSocket svs;
+	svs.bind(SocketAddress("127.0.0.1", 0), true, false);
+	svs.listen();
+	TCPServerParams* pParams = new TCPServerParams;
+	pParams->setAcceptorThreads(3);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), svs, pParams);
+	if (srv.acceptorThreads() > 1)
+	{
+		try
+		{
+			srv.start();
+			fail("acceptor cannot bind - must throw");
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		assertTrue (srv.acceptorThreads() == 1);
+	}
+
+	srv.start();
+	StreamSocket ss(svs.address());
+	std::string data("hello, world");
+	ss.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, n) == data);
+	ss.close();
+	srv.stop();
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -296,6 +403,8 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testThreadCapacity);
 	CppUnit_addTest(pSuite, TCPServerTest, testFilter);
+	CppUnit_addTest(pSuite, TCPServerTest, testMultipleAcceptors);
+	CppUnit_addTest(pSuite, TCPServerTest, testAcceptorsOpenFailure);
 
 	return pSuite;
 }
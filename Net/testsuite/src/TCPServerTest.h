@@ -29,6 +29,8 @@ public:
 	void testMultiConnections();
 	void testThreadCapacity();
 	void testFilter();
+	void testMultipleAcceptors();
+	void testAcceptorsOpenFailure();
 
 	void setUp();
 	void tearDown();
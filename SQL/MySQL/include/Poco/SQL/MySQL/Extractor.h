@@ -25,6 +25,10 @@
 #include "Poco/SQL/LOB.h"
 #include "Poco/SQL/Date.h"
 #include "Poco/SQL/Time.h"
+#include "Poco/DateTime.h"
+#include <vector>
+#include <cstring>
+#include <cstdlib>
 
 
 namespace Poco {
@@ -120,12 +124,26 @@ public:
 
 	virtual bool isNull(std::size_t col, std::size_t row);
 		/// Returns true if the value at [col,row] position is null.
+		/// A valid row refers to the bulk row buffer.
 
 	virtual void reset();
 		/// Resets any information internally cached by the extractor.
 
+	void startBulk(std::size_t rows);
+		/// Switches the extractor into bulk mode and clears the bulk
+		/// row buffer, reserving space for the given number of rows.
+
+	void fetchBulkRow();
+		/// Appends the current fetched row to the bulk row buffer.
+		/// The raw bound result buffers are copied as-is, so the
+		/// container extract() overloads can convert whole columns
+		/// in one pass without per-value mysql_stmt_fetch_column() calls.
+
+	std::size_t bulkRowCount() const;
+		/// Returns the number of rows in the bulk row buffer.
+
 	////////////
-	// Not implemented extract functions
+	// Bulk extract functions
 	////////////
 	
 	virtual bool extract(std::size_t pos, std::vector<Poco::Int8>& val);
@@ -301,6 +319,10 @@ public:
 	virtual bool extract(std::size_t pos, std::list<Time>& val);
 		/// Extracts a Time list.
 
+	////////////
+	// Not implemented extract functions
+	////////////
+
 	virtual bool extract(std::size_t pos, std::vector<Any>& val);
 		/// Extracts an Any vector.
 
@@ -324,6 +346,147 @@ private:
 	bool realExtractFixed(std::size_t pos, enum_field_types type, void* buffer, bool isUnsigned = false);
 	bool realExtractFixedBlob(std::size_t pos, enum_field_types type, void* buffer, size_t len);
 
+	struct BulkCell
+		/// Position of a single bulk-fetched raw value in the bulk data buffer.
+	{
+		bool        isNull;
+		std::size_t offset;
+		std::size_t length;
+	};
+
+	typedef std::vector<BulkCell>   BulkColumn;
+	typedef std::vector<BulkColumn> BulkColumnVec;
+
+	const BulkColumn& bulkColumn(std::size_t pos) const;
+		/// Returns the bulk column at pos. Throws if the extractor is
+		/// not in bulk mode or pos is out of range.
+
+	template <typename T, typename R>
+	static T bulkRaw(const char* pData)
+	{
+		R raw;
+		std::memcpy(&raw, pData, sizeof(R));
+		return static_cast<T>(raw);
+	}
+
+	template <typename T>
+	T bulkNumber(const MYSQL_BIND& bind, const BulkCell& cell) const
+		/// Converts the raw bound buffer value of the cell to T.
+	{
+		if (cell.isNull || cell.length == 0) return T();
+		const char* pData = &_bulkData[cell.offset];
+		bool isUnsigned = bind.is_unsigned != 0;
+		switch (bind.buffer_type)
+		{
+		case MYSQL_TYPE_TINY:
+			return isUnsigned ? bulkRaw<T, Poco::UInt8>(pData) : bulkRaw<T, Poco::Int8>(pData);
+		case MYSQL_TYPE_SHORT:
+			return isUnsigned ? bulkRaw<T, Poco::UInt16>(pData) : bulkRaw<T, Poco::Int16>(pData);
+		case MYSQL_TYPE_INT24:
+		case MYSQL_TYPE_LONG:
+			return isUnsigned ? bulkRaw<T, Poco::UInt32>(pData) : bulkRaw<T, Poco::Int32>(pData);
+		case MYSQL_TYPE_LONGLONG:
+			return isUnsigned ? bulkRaw<T, Poco::UInt64>(pData) : bulkRaw<T, Poco::Int64>(pData);
+		case MYSQL_TYPE_FLOAT:
+			return bulkRaw<T, float>(pData);
+		case MYSQL_TYPE_DOUBLE:
+			return bulkRaw<T, double>(pData);
+		default:
+		{
+			std::string str(pData, cell.length);
+			if (str.find_first_of(".eE") == std::string::npos)
+				return static_cast<T>(std::strtoll(str.c_str(), 0, 10));
+			return static_cast<T>(std::strtod(str.c_str(), 0));
+		}
+		}
+	}
+
+	template <typename C>
+	bool extractBulkNumber(std::size_t pos, C& val)
+		/// Fills the container with numeric values of the bulk column at pos.
+		/// Null values are extracted as default-constructed values.
+	{
+		typedef typename C::value_type T;
+		const BulkColumn& column = bulkColumn(pos);
+		const MYSQL_BIND& bind = _metadata.row()[pos];
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+			*it = bulkNumber<T>(bind, column[row]);
+		return true;
+	}
+
+	template <typename C>
+	bool extractBulkString(std::size_t pos, C& val)
+		/// Fills the container with string values of the bulk column at pos.
+	{
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+		{
+			const BulkCell& cell = column[row];
+			if (cell.length)
+				it->assign(&_bulkData[cell.offset], cell.length);
+			else
+				it->clear();
+		}
+		return true;
+	}
+
+	template <typename C>
+	bool extractBulkLOB(std::size_t pos, C& val)
+		/// Fills the container with BLOB or CLOB values of the bulk column at pos.
+	{
+		typedef typename C::value_type LOBType;
+		typedef typename LOBType::ValueType T;
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+		{
+			const BulkCell& cell = column[row];
+			if (cell.length)
+				it->assignRaw(reinterpret_cast<const T*>(&_bulkData[cell.offset]), cell.length);
+			else
+				*it = LOBType();
+		}
+		return true;
+	}
+
+	static void bulkAssign(Poco::DateTime& val, const MYSQL_TIME& mt)
+	{
+		val.assign(mt.year, mt.month, mt.day, mt.hour, mt.minute, mt.second, mt.second_part / 1000, mt.second_part % 1000);
+	}
+
+	static void bulkAssign(Date& val, const MYSQL_TIME& mt)
+	{
+		val.assign(mt.year, mt.month, mt.day);
+	}
+
+	static void bulkAssign(Time& val, const MYSQL_TIME& mt)
+	{
+		val.assign(mt.hour, mt.minute, mt.second);
+	}
+
+	template <typename C>
+	bool extractBulkTime(std::size_t pos, C& val)
+		/// Fills the container with DateTime, Date or Time values of the bulk column at pos.
+	{
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+		{
+			const BulkCell& cell = column[row];
+			if (cell.length < sizeof(MYSQL_TIME)) continue;
+			MYSQL_TIME mt;
+			std::memcpy(&mt, &_bulkData[cell.offset], sizeof(MYSQL_TIME));
+			bulkAssign(*it, mt);
+		}
+		return true;
+	}
+
 	template<typename T>
 	T extractAny(std::size_t pos, bool& success)
 	{
@@ -342,8 +505,22 @@ private:
 
 	StatementExecutor& _stmt;
 	ResultMetadata& _metadata;
+	bool _bulk;
+	std::size_t _bulkRows;
+	BulkColumnVec _bulkColumns;
+	std::vector<char> _bulkData;
 };
 
+
+//
+// inlines
+//
+inline std::size_t Extractor::bulkRowCount() const
+{
+	return _bulkRows;
+}
+
+
 template<typename T>
 bool Extractor::extractToDynamic(std::size_t pos, T &val)
 {
@@ -88,6 +88,14 @@ private:
 		NEXT_FALSE
 	};
 
+	bool isBulk() const;
+		/// Returns true if the extractions are set up for bulk extraction.
+
+	std::size_t fetchBulk();
+		/// Copies up to the extraction limit rows, starting with the
+		/// current one, into the extractor's bulk row buffer and
+		/// returns the number of rows fetched.
+
 	StatementExecutor _stmt;
 	ResultMetadata    _metadata;
 	Binder::Ptr       _pBinder;
@@ -53,6 +53,11 @@ public:
 	void bindResult(MYSQL_BIND* result);
 		/// Binds result.
 
+	void setPrefetchRows(std::size_t rows);
+		/// Opens a read-only cursor on execution and sets the number
+		/// of rows fetched from the server per round trip.
+		/// Must be called before execute().
+
 	void execute();
 		/// Executes the statement.
 
@@ -23,7 +23,11 @@ namespace SQL {
 namespace MySQL {
 
 
-Extractor::Extractor(StatementExecutor& st, ResultMetadata& md): _stmt(st), _metadata(md)
+Extractor::Extractor(StatementExecutor& st, ResultMetadata& md):
+	_stmt(st),
+	_metadata(md),
+	_bulk(false),
+	_bulkRows(0)
 {
 }
 
@@ -251,7 +255,13 @@ bool Extractor::extract(std::size_t pos, Dynamic::Var& val)
 
 bool Extractor::isNull(std::size_t col, std::size_t row)
 {
-	poco_assert(row == POCO_DATA_INVALID_ROW);
+	if (row != POCO_DATA_INVALID_ROW)
+	{
+		const BulkColumn& column = bulkColumn(col);
+		if (row >= _bulkRows)
+			throw RangeException("Extractor: bulk row out of range");
+		return column[row].isNull;
+	}
 
 	if (_metadata.columnsReturned() <= col)
 		throw MySQLException("Extractor: attempt to extract more parameters, than query result contain");
@@ -268,6 +278,72 @@ void Extractor::reset()
 }
 
 
+void Extractor::startBulk(std::size_t rows)
+{
+	_bulk = true;
+	_bulkRows = 0;
+	_bulkData.clear();
+	_bulkColumns.resize(_metadata.columnsReturned());
+	BulkColumnVec::iterator it = _bulkColumns.begin();
+	BulkColumnVec::iterator end = _bulkColumns.end();
+	for (; it != end; ++it)
+	{
+		it->clear();
+		it->reserve(rows);
+	}
+}
+
+
+void Extractor::fetchBulkRow()
+{
+	poco_assert_dbg (_bulk);
+
+	std::size_t columns = _bulkColumns.size();
+	for (std::size_t pos = 0; pos < columns; ++pos)
+	{
+		BulkCell cell;
+		cell.isNull = _metadata.isNull(pos);
+		cell.offset = _bulkData.size();
+		cell.length = 0;
+		if (!cell.isNull)
+		{
+			const MYSQL_BIND& bind = _metadata.row()[pos];
+			const unsigned char* pRaw = _metadata.rawData(pos);
+			std::size_t length = _metadata.length(pos);
+			if (pRaw == 0 && length > 0)
+			{
+				// zero-sized buffer for BLOBs; the data has to be fetched now,
+				// before the next row replaces it
+				_bulkData.resize(cell.offset + length);
+				if (!realExtractFixedBlob(pos, bind.buffer_type, &_bulkData[cell.offset], length))
+					cell.isNull = true;
+				else
+					cell.length = length;
+			}
+			else if (pRaw)
+			{
+				if (length > bind.buffer_length) length = bind.buffer_length;
+				const char* pData = reinterpret_cast<const char*>(pRaw);
+				_bulkData.insert(_bulkData.end(), pData, pData + length);
+				cell.length = length;
+			}
+		}
+		_bulkColumns[pos].push_back(cell);
+	}
+	++_bulkRows;
+}
+
+
+const Extractor::BulkColumn& Extractor::bulkColumn(std::size_t pos) const
+{
+	if (!_bulk)
+		throw InvalidAccessException("Extractor: not in bulk mode");
+	if (pos >= _bulkColumns.size())
+		throw MySQLException("Extractor: attempt to extract more parameters, than query result contain");
+	return _bulkColumns[pos];
+}
+
+
 bool Extractor::realExtractFixed(std::size_t pos, enum_field_types type, void* buffer, bool isUnsigned)
 {
 	MYSQL_BIND bind = {0};
@@ -301,354 +377,359 @@ bool Extractor::realExtractFixedBlob(std::size_t pos, enum_field_types type, voi
 }
 
 //////////////
-// Not implemented
+// Bulk
 //////////////
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::Int8>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int8>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::Int8>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int8>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::Int8>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int8>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 	
 	
-bool Extractor::extract(std::size_t , std::vector<Poco::UInt8>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt8>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::UInt8>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt8>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::UInt8>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt8>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::Int16>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int16>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::Int16>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int16>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::Int16>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int16>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::UInt16>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt16>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::UInt16>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt16>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::UInt16>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt16>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::Int32>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int32>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::Int32>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int32>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::Int32>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int32>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::UInt32>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt32>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::UInt32>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt32>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::UInt32>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt32>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::Int64>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int64>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::Int64>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int64>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::Int64>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int64>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Poco::UInt64>& )
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt64>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Poco::UInt64>& )
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt64>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Poco::UInt64>& )
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt64>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
 #ifndef POCO_LONG_IS_64_BIT
-bool Extractor::extract(std::size_t , std::vector<long>& )
+bool Extractor::extract(std::size_t pos, std::vector<long>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<long>& )
+bool Extractor::extract(std::size_t pos, std::deque<long>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<long>& )
+bool Extractor::extract(std::size_t pos, std::list<long>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 #endif
 
 
-bool Extractor::extract(std::size_t , std::vector<bool>& )
+bool Extractor::extract(std::size_t pos, std::vector<bool>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<bool>& )
+bool Extractor::extract(std::size_t pos, std::deque<bool>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<bool>& )
+bool Extractor::extract(std::size_t pos, std::list<bool>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<float>& )
+bool Extractor::extract(std::size_t pos, std::vector<float>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<float>& )
+bool Extractor::extract(std::size_t pos, std::deque<float>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<float>& )
+bool Extractor::extract(std::size_t pos, std::list<float>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<double>& )
+bool Extractor::extract(std::size_t pos, std::vector<double>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<double>& )
+bool Extractor::extract(std::size_t pos, std::deque<double>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<double>& )
+bool Extractor::extract(std::size_t pos, std::list<double>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<char>& )
+bool Extractor::extract(std::size_t pos, std::vector<char>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<char>& )
+bool Extractor::extract(std::size_t pos, std::deque<char>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<char>& )
+bool Extractor::extract(std::size_t pos, std::list<char>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkNumber(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<std::string>& )
+bool Extractor::extract(std::size_t pos, std::vector<std::string>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkString(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<std::string>& )
+bool Extractor::extract(std::size_t pos, std::deque<std::string>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkString(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<std::string>& )
+bool Extractor::extract(std::size_t pos, std::list<std::string>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkString(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<BLOB>& )
+bool Extractor::extract(std::size_t pos, std::vector<BLOB>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<BLOB>& )
+bool Extractor::extract(std::size_t pos, std::deque<BLOB>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<BLOB>& )
+bool Extractor::extract(std::size_t pos, std::list<BLOB>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<CLOB>& )
+bool Extractor::extract(std::size_t pos, std::vector<CLOB>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<CLOB>& )
+bool Extractor::extract(std::size_t pos, std::deque<CLOB>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<CLOB>& )
+bool Extractor::extract(std::size_t pos, std::list<CLOB>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkLOB(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<DateTime>& )
+bool Extractor::extract(std::size_t pos, std::vector<DateTime>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<DateTime>& )
+bool Extractor::extract(std::size_t pos, std::deque<DateTime>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<DateTime>& )
+bool Extractor::extract(std::size_t pos, std::list<DateTime>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Date>& )
+bool Extractor::extract(std::size_t pos, std::vector<Date>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Date>& )
+bool Extractor::extract(std::size_t pos, std::deque<Date>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Date>& )
+bool Extractor::extract(std::size_t pos, std::list<Date>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::vector<Time>& )
+bool Extractor::extract(std::size_t pos, std::vector<Time>& val)
 {
-	throw NotImplementedException("std::vector extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::deque<Time>& )
+bool Extractor::extract(std::size_t pos, std::deque<Time>& val)
 {
-	throw NotImplementedException("std::deque extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
-bool Extractor::extract(std::size_t , std::list<Time>& )
+bool Extractor::extract(std::size_t pos, std::list<Time>& val)
 {
-	throw NotImplementedException("std::list extractor must be implemented.");
+	return extractBulkTime(pos, val);
 }
 
 
+//////////////
+// Not implemented
+//////////////
+
+
 bool Extractor::extract(std::size_t , std::vector<Any>& )
 {
 	throw NotImplementedException("std::vector extractor must be implemented.");
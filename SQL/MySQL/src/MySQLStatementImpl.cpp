@@ -86,6 +86,10 @@ std::size_t MySQLStatementImpl::next()
 	if (!hasNext())
 		throw StatementException("No data received");
 
+	std::size_t rows = 1;
+	bool bulk = isBulk();
+	if (bulk) rows = fetchBulk();
+
 	Poco::SQL::AbstractExtractionVec::iterator it = extractions().begin();
 	Poco::SQL::AbstractExtractionVec::iterator itEnd = extractions().end();
 	std::size_t pos = 0;
@@ -96,8 +100,35 @@ std::size_t MySQLStatementImpl::next()
 		pos += (*it)->numOfColumnsHandled();
 	}
 
-	_hasNext = NEXT_DONTKNOW;
-	return 1;
+	// fetchBulk() has already fetched past the extracted rows
+	if (!bulk) _hasNext = NEXT_DONTKNOW;
+	return rows;
+}
+
+
+bool MySQLStatementImpl::isBulk() const
+{
+	const Poco::SQL::AbstractExtractionVec& extracts = extractions();
+	return !extracts.empty() && extracts.front()->isBulk();
+}
+
+
+std::size_t MySQLStatementImpl::fetchBulk()
+{
+	std::size_t limit = getExtractionLimit();
+	if (limit == Limit::LIMIT_UNLIMITED)
+		throw InvalidArgumentException("Bulk operation not allowed without limit.");
+
+	_pExtractor->startBulk(limit);
+	std::size_t rows = 0;
+	do
+	{
+		_pExtractor->fetchBulkRow();
+		_hasNext = NEXT_DONTKNOW;
+	}
+	while (++rows < limit && hasNext());
+
+	return rows;
 }
 
 
@@ -142,6 +173,8 @@ void MySQLStatementImpl::bindImpl()
 	}
 
 	_stmt.bindParams(_pBinder->getBindArray(), _pBinder->size());
+	if (isBulk() && getExtractionLimit() != Limit::LIMIT_UNLIMITED)
+		_stmt.setPrefetchRows(getExtractionLimit());
 	_stmt.execute();
 	_hasNext = NEXT_DONTKNOW;
 }
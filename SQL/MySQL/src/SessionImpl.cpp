@@ -148,6 +148,7 @@ void SessionImpl::open(const std::string& connect)
 	addFeature("autoCommit",
 		&SessionImpl::autoCommit,
 		&SessionImpl::isAutoCommit);
+	setFeature("bulk", true);
 
 	_connected = true;
 }
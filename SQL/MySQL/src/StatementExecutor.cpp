@@ -95,6 +95,21 @@ void StatementExecutor::bindResult(MYSQL_BIND* result)
 }
 
 
+void StatementExecutor::setPrefetchRows(std::size_t rows)
+{
+	if (_state < STMT_COMPILED)
+		throw StatementException("Statement is not compiled yet");
+
+	unsigned long cursorType = static_cast<unsigned long>(CURSOR_TYPE_READ_ONLY);
+	if (mysql_stmt_attr_set(_pHandle, STMT_ATTR_CURSOR_TYPE, &cursorType) != 0)
+		throw StatementException("mysql_stmt_attr_set(STMT_ATTR_CURSOR_TYPE) error", _pHandle, _query);
+
+	unsigned long prefetchRows = static_cast<unsigned long>(rows);
+	if (mysql_stmt_attr_set(_pHandle, STMT_ATTR_PREFETCH_ROWS, &prefetchRows) != 0)
+		throw StatementException("mysql_stmt_attr_set(STMT_ATTR_PREFETCH_ROWS) error", _pHandle, _query);
+}
+
+
 void StatementExecutor::execute()
 {
 	if (_state < STMT_COMPILED)
@@ -241,6 +241,15 @@ void MySQLTest::testLimitZero()
 }
 
 
+void MySQLTest::testBulkExtraction()
+{
+	if (!_pSession) fail ("Test not available.");
+
+	recreateStringsTable();
+	_pExecutor->bulkExtraction();
+}
+
+
 void MySQLTest::testLimitOnce()
 {
 	if (!_pSession) fail ("Test not available.");
@@ -977,6 +986,7 @@ CppUnit::Test* MySQLTest::suite()
 	CppUnit_addTest(pSuite, MySQLTest, testLimitOnce);
 	CppUnit_addTest(pSuite, MySQLTest, testLimitPrepare);
 	CppUnit_addTest(pSuite, MySQLTest, testLimitZero);
+	CppUnit_addTest(pSuite, MySQLTest, testBulkExtraction);
 	CppUnit_addTest(pSuite, MySQLTest, testPrepare);
 	CppUnit_addTest(pSuite, MySQLTest, testSetSimple);
 	CppUnit_addTest(pSuite, MySQLTest, testSetComplex);
@@ -55,6 +55,7 @@ public:
 	void testLimitOnce();
 	void testLimitPrepare();
 	void testLimitZero();
+	void testBulkExtraction();
 	void testPrepare();
 
 	void testSetSimple();
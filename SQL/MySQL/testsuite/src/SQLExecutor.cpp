@@ -726,6 +726,39 @@ void SQLExecutor::limits()
 }
 
 
+void SQLExecutor::bulkExtraction()
+{
+	std::string funct = "bulkExtraction()";
+	std::vector<int> data;
+	for (int x = 0; x < 100; ++x)
+	{
+		data.push_back(x);
+	}
+
+	try { *_pSession << "INSERT INTO Strings VALUES (?)", use(data), now; }
+	catch(ConnectionException& ce){ std::cout << ce.displayText() << std::endl; fail (funct); }
+	catch(StatementException& se){ std::cout << se.displayText() << std::endl; fail (funct); }
+
+	std::vector<int> retData;
+	Statement stmt = (*_pSession << "SELECT * FROM Strings", into(retData, bulk(30)));
+	std::size_t offset = 0;
+	while (!stmt.done())
+	{
+		std::size_t count = 0;
+		try { count = stmt.execute(); }
+		catch(ConnectionException& ce){ std::cout << ce.displayText() << std::endl; fail (funct); }
+		catch(StatementException& se){ std::cout << se.displayText() << std::endl; fail (funct); }
+		poco_assert (count == retData.size());
+		for (std::size_t x = 0; x < count; ++x)
+		{
+			poco_assert (data[offset + x] == retData[x]);
+		}
+		offset += count;
+	}
+	poco_assert (offset == data.size());
+}
+
+
 void SQLExecutor::limitZero()
 {
 	std::string funct = "limitZero()";
@@ -56,6 +56,7 @@ public:
 	void limitOnce();
 	void limitPrepare();
 	void limitZero();
+	void bulkExtraction();
 	void prepare();
 
 	void setSimple();
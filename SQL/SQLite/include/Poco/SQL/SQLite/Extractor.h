@@ -30,8 +30,12 @@
 #include "Poco/SQL/Time.h"
 #include "Poco/Any.h"
 #include "Poco/DynamicAny.h"
+#include "Poco/DateTimeParser.h"
 #include "sqlite3.h"
 #include <vector>
+#include <deque>
+#include <list>
+#include <cstdlib>
 #include <utility>
 
 
@@ -122,6 +126,180 @@ public:
 	bool extract(std::size_t pos, Poco::DynamicAny& val);
 		/// Extracts a DynamicAny.
 
+	bool extract(std::size_t pos, std::vector<Poco::Int8>& val);
+		/// Extracts an Int8 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int8>& val);
+		/// Extracts an Int8 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::Int8>& val);
+		/// Extracts an Int8 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt8>& val);
+		/// Extracts an UInt8 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt8>& val);
+		/// Extracts an UInt8 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt8>& val);
+		/// Extracts an UInt8 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int16>& val);
+		/// Extracts an Int16 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int16>& val);
+		/// Extracts an Int16 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::Int16>& val);
+		/// Extracts an Int16 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt16>& val);
+		/// Extracts an UInt16 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt16>& val);
+		/// Extracts an UInt16 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt16>& val);
+		/// Extracts an UInt16 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int32>& val);
+		/// Extracts an Int32 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int32>& val);
+		/// Extracts an Int32 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::Int32>& val);
+		/// Extracts an Int32 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt32>& val);
+		/// Extracts an UInt32 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt32>& val);
+		/// Extracts an UInt32 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt32>& val);
+		/// Extracts an UInt32 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int64>& val);
+		/// Extracts an Int64 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int64>& val);
+		/// Extracts an Int64 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::Int64>& val);
+		/// Extracts an Int64 list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt64>& val);
+		/// Extracts an UInt64 vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt64>& val);
+		/// Extracts an UInt64 deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt64>& val);
+		/// Extracts an UInt64 list from the bulk row buffer.
+
+#ifndef POCO_LONG_IS_64_BIT
+	bool extract(std::size_t pos, std::vector<long>& val);
+		/// Extracts a long vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<long>& val);
+		/// Extracts a long deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<long>& val);
+		/// Extracts a long list from the bulk row buffer.
+
+#endif
+
+	bool extract(std::size_t pos, std::vector<bool>& val);
+		/// Extracts a boolean vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<bool>& val);
+		/// Extracts a boolean deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<bool>& val);
+		/// Extracts a boolean list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<float>& val);
+		/// Extracts a float vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<float>& val);
+		/// Extracts a float deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<float>& val);
+		/// Extracts a float list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<double>& val);
+		/// Extracts a double vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<double>& val);
+		/// Extracts a double deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<double>& val);
+		/// Extracts a double list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<char>& val);
+		/// Extracts a character vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<char>& val);
+		/// Extracts a character deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<char>& val);
+		/// Extracts a character list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<std::string>& val);
+		/// Extracts a string vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<std::string>& val);
+		/// Extracts a string deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<std::string>& val);
+		/// Extracts a string list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::SQL::BLOB>& val);
+		/// Extracts a BLOB vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::SQL::BLOB>& val);
+		/// Extracts a BLOB deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::SQL::BLOB>& val);
+		/// Extracts a BLOB list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::SQL::CLOB>& val);
+		/// Extracts a CLOB vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::SQL::CLOB>& val);
+		/// Extracts a CLOB deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::SQL::CLOB>& val);
+		/// Extracts a CLOB list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::SQL::Date>& val);
+		/// Extracts a Date vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::SQL::Date>& val);
+		/// Extracts a Date deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::SQL::Date>& val);
+		/// Extracts a Date list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::SQL::Time>& val);
+		/// Extracts a Time vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::SQL::Time>& val);
+		/// Extracts a Time deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::SQL::Time>& val);
+		/// Extracts a Time list from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::vector<Poco::DateTime>& val);
+		/// Extracts a DateTime vector from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::deque<Poco::DateTime>& val);
+		/// Extracts a DateTime deque from the bulk row buffer.
+
+	bool extract(std::size_t pos, std::list<Poco::DateTime>& val);
+		/// Extracts a DateTime list from the bulk row buffer.
+
 	bool isNull(std::size_t pos, std::size_t row = POCO_DATA_INVALID_ROW);
 		/// Returns true if the current row value at pos column is null.
 		/// Because of the loss of information about null-ness of the
@@ -135,12 +313,26 @@ public:
 		/// bool value in the pair is true if the null indicator has
 		/// been set and the second bool value in the pair is true if
 		/// the column is actually null.
-		/// The row argument, needed for connectors with bulk capabilities,
-		/// is ignored in this implementation.
+		/// The row argument is used in bulk mode only, where it selects
+		/// the row in the bulk row buffer; otherwise it is ignored.
 
 	void reset();
 		/// Clears the cached nulls indicator vector.
 
+	void startBulk(std::size_t rows);
+		/// Switches the extractor into bulk mode and clears the bulk
+		/// row buffer, reserving space for the given number of rows.
+
+	void fetchBulkRow();
+		/// Appends the current statement row to the bulk row buffer.
+		/// Every column value is copied once, through the sqlite3_column_*
+		/// function matching its storage class, into a column-wise store
+		/// from which the container extract() overloads fill their
+		/// results without further calls into SQLite.
+
+	std::size_t bulkRowCount() const;
+		/// Returns the number of rows in the bulk row buffer.
+
 private:
 	template <typename T>
 	bool extractImpl(std::size_t pos, T& val)
@@ -281,8 +473,143 @@ private:
 		return true;
 	}
 
+	struct BulkCell
+		/// A single bulk-fetched value, tagged with its SQLite storage class.
+		/// Text and blob values are kept in the shared bulk data buffer.
+	{
+		int type;
+		union
+		{
+			Poco::Int64 intValue;
+			double      realValue;
+		};
+		std::size_t offset;
+		std::size_t length;
+	};
+
+	typedef std::vector<BulkCell>   BulkColumn;
+	typedef std::vector<BulkColumn> BulkColumnVec;
+
+	const BulkColumn& bulkColumn(std::size_t pos) const;
+		/// Returns the bulk column at pos. Throws if the extractor is
+		/// not in bulk mode or pos is out of range.
+
+	void bulkText(const BulkCell& cell, std::string& val) const;
+		/// Assigns the textual representation of the cell to val,
+		/// as sqlite3_column_text() would have returned it.
+
+	template <typename T>
+	static T bulkNumber(const BulkCell& cell, const char* pData)
+	{
+		switch (cell.type)
+		{
+		case SQLITE_INTEGER:
+			return static_cast<T>(cell.intValue);
+		case SQLITE_FLOAT:
+			return static_cast<T>(cell.realValue);
+		case SQLITE_TEXT:
+		case SQLITE_BLOB:
+		{
+			std::string str(pData + cell.offset, cell.length);
+			if (str.find_first_of(".eE") == std::string::npos)
+				return static_cast<T>(std::strtoll(str.c_str(), 0, 10));
+			return static_cast<T>(std::strtod(str.c_str(), 0));
+		}
+		default:
+			return T();
+		}
+	}
+
+	template <typename C>
+	bool extractBulkNumber(std::size_t pos, C& val)
+		/// Fills the container with numeric values of the bulk column at pos.
+		/// Null values are extracted as default-constructed values.
+	{
+		typedef typename C::value_type T;
+		const BulkColumn& column = bulkColumn(pos);
+		const char* pData = _bulkData.empty() ? 0 : &_bulkData[0];
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+			*it = bulkNumber<T>(column[row], pData);
+		return true;
+	}
+
+	template <typename C>
+	bool extractBulkString(std::size_t pos, C& val)
+		/// Fills the container with string values of the bulk column at pos.
+	{
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+			bulkText(column[row], *it);
+		return true;
+	}
+
+	template <typename C>
+	bool extractBulkLOB(std::size_t pos, C& val)
+		/// Fills the container with BLOB or CLOB values of the bulk column at pos.
+	{
+		typedef typename C::value_type LOBType;
+		typedef typename LOBType::ValueType T;
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		std::string str;
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+		{
+			const BulkCell& cell = column[row];
+			if (cell.type == SQLITE_BLOB || cell.type == SQLITE_TEXT)
+			{
+				*it = LOBType(reinterpret_cast<const T*>(&_bulkData[0] + cell.offset), cell.length);
+			}
+			else if (cell.type != SQLITE_NULL)
+			{
+				bulkText(cell, str);
+				*it = LOBType(reinterpret_cast<const T*>(str.data()), str.size());
+			}
+			else *it = LOBType();
+		}
+		return true;
+	}
+
+	template <typename C>
+	bool extractBulkDateTime(std::size_t pos, C& val, const std::string& fmt)
+		/// Fills the container with Date, Time or DateTime values of the
+		/// bulk column at pos, parsing the stored text with the given format.
+		/// If the format is empty, the text is parsed by DateTimeParser
+		/// guessing the format. Null values are extracted as
+		/// default-constructed values.
+	{
+		typedef typename C::value_type T;
+		const BulkColumn& column = bulkColumn(pos);
+		val.resize(_bulkRows);
+		typename C::iterator it = val.begin();
+		std::string str;
+		int tzd;
+		for (std::size_t row = 0; row < _bulkRows; ++row, ++it)
+		{
+			if (column[row].type == SQLITE_NULL)
+			{
+				*it = T();
+				continue;
+			}
+			bulkText(column[row], str);
+			if (fmt.empty())
+				*it = DateTimeParser::parse(str, tzd);
+			else
+				*it = DateTimeParser::parse(fmt, str, tzd);
+		}
+		return true;
+	}
+
 	sqlite3_stmt* _pStmt;
 	NullIndVec    _nulls;
+	bool          _bulk;
+	std::size_t   _bulkRows;
+	BulkColumnVec _bulkColumns;
+	std::vector<char> _bulkData;
 };
 
 
@@ -295,6 +622,12 @@ inline void Extractor::reset()
 }
 
 
+inline std::size_t Extractor::bulkRowCount() const
+{
+	return _bulkRows;
+}
+
+
 inline bool Extractor::extract(std::size_t pos, Poco::SQL::BLOB& val)
 {
 	return extractLOB<Poco::SQL::BLOB::ValueType>(pos, val);
@@ -95,6 +95,14 @@ private:
 	void clear();
 		/// Removes the _pStmt
 
+	bool isBulk() const;
+		/// Returns true if the extractions are set up for bulk extraction.
+
+	std::size_t fetchBulk();
+		/// Copies up to the extraction limit rows, starting with the
+		/// current one, into the extractor's bulk row buffer and
+		/// returns the number of rows fetched.
+
 	typedef Poco::SharedPtr<Binder>             BinderPtr;
 	typedef Poco::SharedPtr<Extractor>          ExtractorPtr;
 	typedef Poco::SQL::AbstractBindingVec      Bindings;
@@ -37,7 +37,9 @@ namespace SQLite {
 
 
 Extractor::Extractor(sqlite3_stmt* pStmt):
-	_pStmt(pStmt)
+	_pStmt(pStmt),
+	_bulk(false),
+	_bulkRows(0)
 {
 }
 
@@ -220,8 +222,454 @@ bool Extractor::extract(std::size_t pos, Poco::DynamicAny& val)
 }
 
 
-bool Extractor::isNull(std::size_t pos, std::size_t)
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int8>& val)
 {
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int8>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int8>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt8>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt8>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt8>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt16>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt32>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt64>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+#ifndef POCO_LONG_IS_64_BIT
+bool Extractor::extract(std::size_t pos, std::vector<long>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<long>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<long>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+#endif
+
+
+bool Extractor::extract(std::size_t pos, std::vector<bool>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<bool>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<bool>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<float>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<float>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<float>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<double>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<double>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<double>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<char>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<char>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<char>& val)
+{
+	return extractBulkNumber(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<std::string>& val)
+{
+	return extractBulkString(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<std::string>& val)
+{
+	return extractBulkString(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<std::string>& val)
+{
+	return extractBulkString(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::SQL::BLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::SQL::BLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::SQL::BLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::SQL::CLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::SQL::CLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::SQL::CLOB>& val)
+{
+	return extractBulkLOB(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::SQL::Date>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_DATE_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::SQL::Date>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_DATE_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::SQL::Date>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_DATE_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::SQL::Time>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_TIME_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::SQL::Time>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_TIME_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::SQL::Time>& val)
+{
+	return extractBulkDateTime(pos, val, Utility::SQLITE_TIME_FORMAT);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::DateTime>& val)
+{
+	return extractBulkDateTime(pos, val, std::string());
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::DateTime>& val)
+{
+	return extractBulkDateTime(pos, val, std::string());
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::DateTime>& val)
+{
+	return extractBulkDateTime(pos, val, std::string());
+}
+
+
+void Extractor::startBulk(std::size_t rows)
+{
+	int columns = sqlite3_column_count(_pStmt);
+	_bulk = true;
+	_bulkRows = 0;
+	_bulkData.clear();
+	_bulkColumns.resize(static_cast<std::size_t>(columns));
+	BulkColumnVec::iterator it = _bulkColumns.begin();
+	BulkColumnVec::iterator end = _bulkColumns.end();
+	for (; it != end; ++it)
+	{
+		it->clear();
+		it->reserve(rows);
+	}
+}
+
+
+void Extractor::fetchBulkRow()
+{
+	poco_assert_dbg (_bulk);
+
+	int columns = static_cast<int>(_bulkColumns.size());
+	for (int pos = 0; pos < columns; ++pos)
+	{
+		BulkCell cell;
+		cell.type = sqlite3_column_type(_pStmt, pos);
+		cell.intValue = 0;
+		cell.offset = 0;
+		cell.length = 0;
+		switch (cell.type)
+		{
+		case SQLITE_INTEGER:
+			cell.intValue = sqlite3_column_int64(_pStmt, pos);
+			break;
+		case SQLITE_FLOAT:
+			cell.realValue = sqlite3_column_double(_pStmt, pos);
+			break;
+		case SQLITE_TEXT:
+		case SQLITE_BLOB:
+		{
+			const char* pBuf = static_cast<const char*>(sqlite3_column_blob(_pStmt, pos));
+			cell.length = static_cast<std::size_t>(sqlite3_column_bytes(_pStmt, pos));
+			cell.offset = _bulkData.size();
+			if (pBuf) _bulkData.insert(_bulkData.end(), pBuf, pBuf + cell.length);
+			break;
+		}
+		default:
+			break;
+		}
+		_bulkColumns[pos].push_back(cell);
+	}
+	++_bulkRows;
+}
+
+
+const Extractor::BulkColumn& Extractor::bulkColumn(std::size_t pos) const
+{
+	if (!_bulk)
+		throw InvalidAccessException("Extractor: not in bulk mode");
+	if (pos >= _bulkColumns.size())
+		throw RangeException("Extractor: column position out of range");
+	return _bulkColumns[pos];
+}
+
+
+void Extractor::bulkText(const BulkCell& cell, std::string& val) const
+{
+	char buffer[64];
+	switch (cell.type)
+	{
+	case SQLITE_INTEGER:
+		sqlite3_snprintf(sizeof(buffer), buffer, "%lld", static_cast<sqlite3_int64>(cell.intValue));
+		val.assign(buffer);
+		break;
+	case SQLITE_FLOAT:
+		sqlite3_snprintf(sizeof(buffer), buffer, "%!.15g", cell.realValue);
+		val.assign(buffer);
+		break;
+	case SQLITE_TEXT:
+	case SQLITE_BLOB:
+		if (cell.length)
+			val.assign(&_bulkData[0] + cell.offset, cell.length);
+		else
+			val.clear();
+		break;
+	default:
+		val.clear();
+		break;
+	}
+}
+
+
+bool Extractor::isNull(std::size_t pos, std::size_t row)
+{
+	if (_bulk && row != POCO_DATA_INVALID_ROW)
+	{
+		const BulkColumn& column = bulkColumn(pos);
+		if (row >= _bulkRows)
+			throw RangeException("Extractor: bulk row out of range");
+		return column[row].type == SQLITE_NULL;
+	}
+
 	if (pos >= _nulls.size())
 		_nulls.resize(pos + 1);
 
@@ -262,10 +262,14 @@ bool SQLiteStatementImpl::hasNext()
 
 std::size_t SQLiteStatementImpl::next()
 {
+	std::size_t rows = 1;
 	if (SQLITE_ROW == _nextResponse)
 	{
 		poco_assert (columnsReturned() == sqlite3_column_count(_pStmt));
 
+		bool bulk = isBulk();
+		if (bulk) rows = fetchBulk();
+
 		Extractions& extracts = extractions();
 		Extractions::iterator it    = extracts.begin();
 		Extractions::iterator itEnd = extracts.end();
@@ -276,7 +280,8 @@ std::size_t SQLiteStatementImpl::next()
 			pos += (*it)->numOfColumnsHandled();
 			_isExtracted = true;
 		}
-		_stepCalled = false;
+		// fetchBulk() has already stepped past the extracted rows
+		if (!bulk) _stepCalled = false;
 		if (_affectedRowCount == POCO_SQLITE_INV_ROW_CNT) _affectedRowCount = 0;
 
 		if (extracts.size())
@@ -295,7 +300,33 @@ std::size_t SQLiteStatementImpl::next()
 		Utility::throwException(_pDB, _nextResponse, std::string("Iterator Error: trying to access the next value"));
 	}
 	
-	return 1u;
+	return rows;
+}
+
+
+bool SQLiteStatementImpl::isBulk() const
+{
+	const Poco::SQL::AbstractExtractionVec& extracts = extractions();
+	return !extracts.empty() && extracts.front()->isBulk();
+}
+
+
+std::size_t SQLiteStatementImpl::fetchBulk()
+{
+	std::size_t limit = getExtractionLimit();
+	if (limit == Limit::LIMIT_UNLIMITED)
+		throw InvalidArgumentException("Bulk operation not allowed without limit.");
+
+	_pExtractor->startBulk(limit);
+	std::size_t rows = 0;
+	do
+	{
+		_pExtractor->fetchBulkRow();
+		_stepCalled = false;
+	}
+	while (++rows < limit && hasNext());
+
+	return rows;
 }
 
 
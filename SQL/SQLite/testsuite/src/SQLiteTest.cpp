@@ -15,7 +15,9 @@
 #include "Poco/SQL/Time.h"
 #include "Poco/SQL/LOB.h"
 #include "Poco/SQL/Statement.h"
+#include "Poco/SQL/BulkExtraction.h"
 #include "Poco/SQL/RecordSet.h"
+#include "Poco/SQL/ColumnStore.h"
 #include "Poco/SQL/RowFilter.h"
 #include "Poco/SQL/JSONRowFormatter.h"
 #include "Poco/SQL/SQLChannel.h"
@@ -49,6 +51,7 @@ using namespace Poco::SQL::Keywords;
 using Poco::SQL::Session;
 using Poco::SQL::Statement;
 using Poco::SQL::RecordSet;
+using Poco::SQL::ColumnStore;
 using Poco::SQL::RowFilter;
 using Poco::SQL::JSONRowFormatter;
 using Poco::SQL::Column;
@@ -60,7 +63,9 @@ using Poco::SQL::CLOB;
 using Poco::SQL::Date;
 using Poco::SQL::Time;
 using Poco::SQL::Transaction;
+using Poco::SQL::AbstractExtraction;
 using Poco::SQL::AbstractExtractionVec;
+using Poco::SQL::BulkExtraction;
 using Poco::SQL::AbstractExtractionVecVec;
 using Poco::SQL::AbstractBindingVec;
 using Poco::SQL::NotConnectedException;
@@ -87,6 +92,8 @@ using Poco::SQL::SQLite::ConstraintViolationException;
 using Poco::SQL::SQLite::ParameterCountMismatchException;
 using Poco::Int32;
 using Poco::Int64;
+using Poco::UInt32;
+using Poco::StringRef;
 using Poco::Dynamic::Var;
 using Poco::SQL::SQLite::Utility;
 using Poco::delegate;
@@ -768,6 +775,94 @@ void SQLiteTest::testInsertSingleBulkVec()
 }
 
 
+void SQLiteTest::testBulkExtraction()
+{
+	Session tmp (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS BulkTest", now;
+	tmp << "CREATE TABLE BulkTest (i INTEGER, d REAL, s VARCHAR(30), b BLOB)", now;
+
+	const int rows = 25;
+	for (int x = 0; x < rows; ++x)
+	{
+		std::string str = Poco::format("str%d", x);
+		double d = x + 0.5;
+		if (x % 5 == 0)
+			tmp << "INSERT INTO BulkTest VALUES(?, NULL, ?, NULL)", use(x), use(str), now;
+		else
+		{
+			CLOB blob(str);
+			tmp << "INSERT INTO BulkTest VALUES(?, ?, ?, ?)", use(x), use(d), use(str), use(blob), now;
+		}
+	}
+
+	std::vector<int> ints;
+	std::deque<double> doubles;
+	std::list<std::string> strings;
+	std::vector<CLOB> blobs;
+	Statement stmt = (tmp << "SELECT i, d, s, b FROM BulkTest ORDER BY i",
+		into(ints, bulk(10)), into(doubles, bulk(10)), into(strings, bulk(10)), into(blobs, bulk(10)));
+
+	int offset = 0;
+	while (!stmt.done())
+	{
+		std::size_t count = stmt.execute();
+		assertTrue (count == (offset + 10 <= rows ? 10 : rows - offset));
+		assertTrue (ints.size() == count);
+		assertTrue (doubles.size() == count);
+		assertTrue (strings.size() == count);
+		assertTrue (blobs.size() == count);
+
+		std::deque<double>::const_iterator dIt = doubles.begin();
+		std::list<std::string>::const_iterator sIt = strings.begin();
+		for (std::size_t i = 0; i < count; ++i, ++dIt, ++sIt)
+		{
+			int x = offset + static_cast<int>(i);
+			assertTrue (ints[i] == x);
+			assertTrue (*sIt == Poco::format("str%d", x));
+			if (x % 5 == 0)
+			{
+				assertTrue (*dIt == 0.0);
+				assertTrue (blobs[i].size() == 0);
+			}
+			else
+			{
+				assertTrue (*dIt == x + 0.5);
+				assertTrue (std::string(blobs[i].rawContent(), blobs[i].size()) == *sIt);
+			}
+		}
+		offset += static_cast<int>(count);
+	}
+	assertTrue (offset == rows);
+
+	std::vector<std::string> numbers;
+	tmp << "SELECT i FROM BulkTest WHERE i < 3 ORDER BY i", into(numbers, bulk(5)), now;
+	assertTrue (numbers.size() == 3);
+	assertTrue (numbers[0] == "0");
+	assertTrue (numbers[2] == "2");
+
+	RecordSet rs(tmp, "SELECT i, d FROM BulkTest ORDER BY i");
+	assertTrue (rs.rowCount() == rows);
+
+	// null values get the extraction's default, not the
+	// value of the previous batch
+	tmp << "DROP TABLE IF EXISTS BulkDates", now;
+	tmp << "CREATE TABLE BulkDates (i INTEGER, t DATETIME)", now;
+	DateTime dt(2018, 5, 17, 10, 20, 30);
+	tmp << "INSERT INTO BulkDates VALUES(0, ?)", use(dt), now;
+	tmp << "INSERT INTO BulkDates VALUES(1, ?)", use(dt), now;
+	tmp << "INSERT INTO BulkDates VALUES(2, NULL)", now;
+	tmp << "INSERT INTO BulkDates VALUES(3, NULL)", now;
+	std::vector<DateTime> dates;
+	DateTime defaultDate(2000, 1, 1);
+	Statement dateStmt = (tmp << "SELECT t FROM BulkDates ORDER BY i",
+		AbstractExtraction::Ptr(new BulkExtraction<std::vector<DateTime> >(dates, defaultDate, 2)));
+	assertTrue (dateStmt.execute() == 2);
+	assertTrue (dates[0] == dt && dates[1] == dt);
+	assertTrue (dateStmt.execute() == 2);
+	assertTrue (dates[0] == defaultDate && dates[1] == defaultDate);
+}
+
+
 void SQLiteTest::testLimit()
 {
 	Session tmp (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
@@ -2214,6 +2309,114 @@ void SQLiteTest::testNullable()
 }
 
 
+void SQLiteTest::testColumnStore()
+{
+	Session tmp (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS ColumnStoreTest", now;
+	tmp << "CREATE TABLE ColumnStoreTest (Id INTEGER, Amount REAL, City VARCHAR(30), Data BLOB, Born DATETIME)", now;
+
+	const char* cities[] = { "Vienna", "Graz", "Linz" };
+	const int rows = 30;
+	for (int x = 0; x < rows; ++x)
+	{
+		std::string city(cities[x % 3]);
+		double amount = x * 1.5;
+		DateTime born(1970 + x, 1, 1);
+		if (x % 10 == 0)
+			tmp << "INSERT INTO ColumnStoreTest VALUES(?, NULL, NULL, NULL, ?)", use(x), use(born), now;
+		else
+		{
+			CLOB data(city);
+			tmp << "INSERT INTO ColumnStoreTest VALUES(?, ?, ?, ?, ?)", use(x), use(amount), use(city), use(data), use(born), now;
+		}
+	}
+
+	RecordSet rs(tmp, "SELECT * FROM ColumnStoreTest ORDER BY Id");
+	ColumnStore store(rs);
+	assertTrue (store.rowCount() == rows);
+	assertTrue (store.columnCount() == 5);
+	assertTrue (store.columnIndex("city") == 2);
+	assertTrue (store.storageType(0) == ColumnStore::STORE_INT);
+	assertTrue (store.storageType(1) == ColumnStore::STORE_REAL);
+	assertTrue (store.storageType(2) == ColumnStore::STORE_STRING);
+	assertTrue (store.storageType(3) == ColumnStore::STORE_LOB);
+	assertTrue (store.storageType(4) == ColumnStore::STORE_DATE);
+
+	try
+	{
+		store.columnIndex("Nonexistent");
+		fail ("must fail");
+	}
+	catch (NotFoundException&) { }
+
+	const Int64* pId = store.intData(0);
+	const double* pAmount = store.realData(1);
+	const UInt32* pCity = store.stringCodes(2);
+	assertTrue (store.dictionarySize(2) == 4);
+	for (int x = 0; x < rows; ++x)
+	{
+		assertTrue (pId[x] == x);
+		assertTrue (store.getInt64(0, x) == x);
+		assertTrue (store.value(4, x) == DateTime(1970 + x, 1, 1));
+		if (x % 10 == 0)
+		{
+			assertTrue (store.isNull(1, x));
+			assertTrue (store.isNull(2, x));
+			assertTrue (store.isNull(3, x));
+			assertTrue (pAmount[x] == 0);
+			assertTrue (pCity[x] == 0);
+			assertTrue (store.getString(2, x).empty());
+			assertTrue (store.value(1, x).isEmpty());
+		}
+		else
+		{
+			assertTrue (!store.isNull(1, x));
+			assertTrue (pAmount[x] == x * 1.5);
+			assertTrue (store.getDouble(1, x) == x * 1.5);
+			assertTrue (store.getString(2, x) == StringRef(cities[x % 3]));
+			assertTrue (store.dictionaryValue(2, pCity[x]) == StringRef(cities[x % 3]));
+			assertTrue (store.getString(3, x) == StringRef(cities[x % 3]));
+			assertTrue (store.value(2, x) == std::string(cities[x % 3]));
+		}
+		assertTrue (store.value(0, x) == rs.value(0, x));
+		assertTrue (store.value(1, x) == rs.value(1, x));
+	}
+
+	try
+	{
+		store.getString(0, 0);
+		fail ("must fail");
+	}
+	catch (BadCastException&) { }
+
+	Row row;
+	store.fillRow(1, row);
+	assertTrue (row.fieldCount() == 5);
+	assertTrue (row["City"] == "Graz");
+	store.fillRow(2, row);
+	assertTrue (row["City"] == "Linz");
+	assertTrue (row["Id"] == 2);
+
+	ColumnStore range(rs, 10, 5);
+	assertTrue (range.rowCount() == 5);
+	assertTrue (range.getInt64(0, 0) == 10);
+	assertTrue (range.isNull(2, 0));
+
+	try
+	{
+		ColumnStore invalid(rs, 25, 10);
+		fail ("must fail");
+	}
+	catch (RangeException&) { }
+
+	std::ostringstream ostr;
+	rs.copyValues(ostr, 1, 2);
+	assertTrue (ostr.str().find("Graz") != std::string::npos);
+	assertTrue (ostr.str().find("Linz") != std::string::npos);
+	assertTrue (ostr.str().find("Vienna") == std::string::npos);
+}
+
+
 void SQLiteTest::testNulls()
 {
 	Session ses (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
@@ -3758,6 +3961,7 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testAffectedRows);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulk);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulkVec);
+	CppUnit_addTest(pSuite, SQLiteTest, testBulkExtraction);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimit);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitOnce);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitPrepare);
@@ -3808,6 +4012,7 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testInternalExtraction);
 	CppUnit_addTest(pSuite, SQLiteTest, testPrimaryKeyConstraint);
 	CppUnit_addTest(pSuite, SQLiteTest, testNullable);
+	CppUnit_addTest(pSuite, SQLiteTest, testColumnStore);
 	CppUnit_addTest(pSuite, SQLiteTest, testNulls);
 	CppUnit_addTest(pSuite, SQLiteTest, testRowIterator);
 	CppUnit_addTest(pSuite, SQLiteTest, testRowIteratorLimit);
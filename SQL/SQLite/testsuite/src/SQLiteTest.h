@@ -48,6 +48,7 @@ public:
 	void testAffectedRows();
 	void testInsertSingleBulk();
 	void testInsertSingleBulkVec();
+	void testBulkExtraction();
 
 	void testLimit();
 	void testLimitOnce();
@@ -104,6 +105,7 @@ public:
 	void testInternalExtraction();
 	void testPrimaryKeyConstraint();
 	void testNullable();
+	void testColumnStore();
 	void testNulls();
 	void testRowIterator();
 	void testRowIteratorLimit();
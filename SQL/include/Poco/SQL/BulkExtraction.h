@@ -101,7 +101,9 @@ public:
 		typename C::iterator end = _rResult.end();
 		for (int row = 0; it !=end; ++it, ++row)
 		{
-			_nulls.push_back(isValueNull(*it, pExt->isNull(col, row)));
+			bool isNull = pExt->isNull(col, row);
+			if (isNull) *it = _default;
+			_nulls.push_back(isValueNull(*it, isNull));
 		}
 
 		return _rResult.size();
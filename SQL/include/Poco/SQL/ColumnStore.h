@@ -0,0 +1,281 @@
+//
+// ColumnStore.h
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnStore
+//
+// Definition of the ColumnStore class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SQL_ColumnStore_INCLUDED
+#define SQL_ColumnStore_INCLUDED
+
+
+#include "Poco/SQL/SQL.h"
+#include "Poco/SQL/MetaColumn.h"
+#include "Poco/SQL/Row.h"
+#include "Poco/StringRef.h"
+#include "Poco/Dynamic/Var.h"
+#include <vector>
+#include <string>
+#include <map>
+
+
+namespace Poco {
+namespace SQL {
+
+
+class RecordSet;
+
+
+class Poco_SQL_API ColumnStore
+	/// ColumnStore holds the rows of a RecordSet in columnar, typed form.
+	///
+	/// Every column is kept in a single contiguous array of its storage
+	/// type, accompanied by a null bitmap:
+	///
+	///   - integral and boolean values are stored as Int64 (UInt64 values
+	///     are stored bit-for-bit),
+	///   - floating point values are stored as double,
+	///   - dates, times and timestamps are stored as Int64 (yyyymmdd,
+	///     seconds since midnight and UTC microseconds, respectively),
+	///   - strings are dictionary-encoded: each row holds a UInt32 code
+	///     referring to a distinct value in the column's dictionary;
+	///     UTF-16 strings are stored UTF-8 encoded,
+	///   - BLOBs and CLOBs are stored in a single byte buffer.
+	///
+	/// Values can be read without conversion through typed accessors,
+	/// and strings and LOBs through StringRef without copying. The raw
+	/// column arrays are available for tight loops over whole columns:
+	///
+	///     ColumnStore store(rs);
+	///     const Int64* pAge = store.intData(store.columnIndex("Age"));
+	///     for (std::size_t row = 0; row < store.rowCount(); ++row)
+	///         total += pAge[row];
+	///
+	/// Row indices are RecordSet row indices, i.e. rows rejected by the
+	/// RecordSet filter are not stored.
+	///
+	/// Rows can be materialized into Row objects (e.g., for use with a
+	/// RowFormatter); the Dynamic::Var values created carry the original
+	/// column type.
+{
+public:
+	enum StorageType
+	{
+		STORE_INT,
+		STORE_REAL,
+		STORE_STRING,
+		STORE_LOB,
+		STORE_DATE
+	};
+
+	ColumnStore();
+		/// Creates an empty ColumnStore.
+
+	explicit ColumnStore(const RecordSet& recordSet);
+		/// Creates the ColumnStore and loads all rows
+		/// of the recordSet into it.
+
+	ColumnStore(const RecordSet& recordSet, std::size_t offset, std::size_t length);
+		/// Creates the ColumnStore and loads length rows, starting
+		/// at offset, of the recordSet into it.
+		/// Throws RangeException if the range exceeds the recordSet.
+
+	~ColumnStore();
+		/// Destroys the ColumnStore.
+
+	void load(const RecordSet& recordSet, std::size_t offset, std::size_t length);
+		/// Replaces the contents of the store with length rows,
+		/// starting at offset, of the recordSet.
+		/// Throws RangeException if the range exceeds the recordSet.
+
+	void clear();
+		/// Removes all rows and columns.
+
+	std::size_t rowCount() const;
+		/// Returns the number of rows.
+
+	std::size_t columnCount() const;
+		/// Returns the number of columns.
+
+	const std::string& columnName(std::size_t col) const;
+		/// Returns the name of the column at the given position.
+
+	MetaColumn::ColumnDataType columnType(std::size_t col) const;
+		/// Returns the original data type of the column at the given position.
+
+	StorageType storageType(std::size_t col) const;
+		/// Returns the storage type of the column at the given position.
+
+	std::size_t columnIndex(const std::string& name) const;
+		/// Returns the position of the column with the given
+		/// (case-insensitive) name. Throws NotFoundException
+		/// if there is no such column.
+
+	bool isNull(std::size_t col, std::size_t row) const;
+		/// Returns true if the value at [col, row] is null.
+
+	Int64 getInt64(std::size_t col, std::size_t row) const;
+		/// Returns the value at [col, row] as Int64.
+		/// Valid for integral, boolean, floating point, date and time columns.
+		/// Returns zero for null values.
+
+	UInt64 getUInt64(std::size_t col, std::size_t row) const;
+		/// Returns the value at [col, row] as UInt64.
+		/// Valid for integral, boolean and floating point columns.
+		/// Returns zero for null values.
+
+	double getDouble(std::size_t col, std::size_t row) const;
+		/// Returns the value at [col, row] as double.
+		/// Valid for integral, boolean and floating point columns.
+		/// Returns zero for null values.
+
+	bool getBool(std::size_t col, std::size_t row) const;
+		/// Returns the value at [col, row] as bool.
+		/// Valid for integral, boolean and floating point columns.
+		/// Returns false for null values.
+
+	StringRef getString(std::size_t col, std::size_t row) const;
+		/// Returns a reference to the string or LOB value at [col, row].
+		/// Returns an empty reference for null values.
+		/// The reference stays valid until the store is cleared,
+		/// reloaded or destroyed.
+
+	Poco::Dynamic::Var value(std::size_t col, std::size_t row) const;
+		/// Returns the value at [col, row], converted to the original
+		/// column type, or an empty Var for null values.
+
+	const Int64* intData(std::size_t col) const;
+		/// Returns the value array of an integral, boolean, date or time column.
+		/// Elements for null values are zero.
+
+	const double* realData(std::size_t col) const;
+		/// Returns the value array of a floating point column.
+		/// Elements for null values are zero.
+
+	const UInt32* stringCodes(std::size_t col) const;
+		/// Returns the dictionary code array of a string column.
+		/// Elements for null values are zero.
+
+	std::size_t dictionarySize(std::size_t col) const;
+		/// Returns the number of distinct values in the dictionary
+		/// of a string column.
+
+	StringRef dictionaryValue(std::size_t col, UInt32 code) const;
+		/// Returns the dictionary value with the given code.
+
+	void fillRow(std::size_t row, Row& rRow) const;
+		/// Assigns the values of the given row to rRow.
+		/// If rRow has no fields yet, they are appended using
+		/// the column names; otherwise, rRow must have as many
+		/// fields as the store has columns.
+
+private:
+	ColumnStore(const ColumnStore&);
+	ColumnStore& operator = (const ColumnStore&);
+
+	struct ColumnData
+	{
+		std::string                name;
+		MetaColumn::ColumnDataType type;
+		StorageType                storage;
+		std::vector<Int64>         ints;
+		std::vector<double>        reals;
+		std::vector<UInt32>        codes;
+		std::vector<std::size_t>   offsets;
+		std::string                bytes;
+		std::vector<UInt64>        nulls;
+	};
+
+	typedef std::vector<ColumnData>             ColumnVec;
+	typedef std::map<std::string, std::size_t> IndexMap;
+
+	class Appender;
+		/// Appends typed values to a ColumnData.
+
+	static StorageType storageFor(MetaColumn::ColumnDataType type);
+	const ColumnData& columnData(std::size_t col) const;
+	const ColumnData& columnData(std::size_t col, StorageType storage) const;
+	void checkRow(std::size_t row) const;
+
+	static void dataRows(const RecordSet& recordSet, std::size_t offset, std::size_t length, std::vector<std::size_t>& rows);
+		/// Collects the storage indices of length rows, starting at
+		/// offset, of the recordSet, skipping rows rejected by its filter.
+
+	void loadRows(const RecordSet& recordSet, const std::vector<std::size_t>& rows);
+		/// Replaces the contents of the store with the given (ascending)
+		/// storage rows of the recordSet.
+
+	template <typename T>
+	void loadColumn(const RecordSet& recordSet, std::size_t col, const std::vector<std::size_t>& rows, ColumnData& data);
+		/// Loads the given data rows of the column with value type T.
+
+	std::size_t _rowCount;
+	ColumnVec   _columns;
+	IndexMap    _index;
+
+	friend class RecordSet;
+};
+
+
+///
+/// inlines
+///
+inline std::size_t ColumnStore::rowCount() const
+{
+	return _rowCount;
+}
+
+
+inline std::size_t ColumnStore::columnCount() const
+{
+	return _columns.size();
+}
+
+
+inline const ColumnStore::ColumnData& ColumnStore::columnData(std::size_t col) const
+{
+	if (col >= _columns.size())
+		throw RangeException("Invalid column index.");
+	return _columns[col];
+}
+
+
+inline const std::string& ColumnStore::columnName(std::size_t col) const
+{
+	return columnData(col).name;
+}
+
+
+inline MetaColumn::ColumnDataType ColumnStore::columnType(std::size_t col) const
+{
+	return columnData(col).type;
+}
+
+
+inline ColumnStore::StorageType ColumnStore::storageType(std::size_t col) const
+{
+	return columnData(col).storage;
+}
+
+
+inline bool ColumnStore::isNull(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	return (data.nulls[row >> 6] & (UInt64(1) << (row & 63))) != 0;
+}
+
+
+} } // namespace Poco::SQL
+
+
+#endif // SQL_ColumnStore_INCLUDED
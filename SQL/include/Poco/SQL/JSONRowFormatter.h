@@ -91,6 +91,16 @@ public:
 	std::string& formatValues(const ValueVec& vals, std::string& formattedValues);
 		// Formats values.
 
+	std::ostream& formatNames(const NameVecPtr pNames, std::ostream& ostr);
+		/// Writes formatted names to ostr.
+
+	std::ostream& formatValues(const ValueVec& vals, std::ostream& ostr);
+		/// Writes formatted values to ostr.
+		///
+		/// Numbers are written without going through intermediate
+		/// Dynamic::Var string conversion; strings, dates and times
+		/// are escaped directly into the stream.
+
 	void setJSONMode(int mode);
 		/// Sets the mode. Valid mode values are:
 		///   JSON_FMT_MODE_SMALL
@@ -117,10 +127,12 @@ public:
 
 private:
 	void adjustPrefix();
+	void writeValue(const Poco::Dynamic::Var& val, std::ostream& ostr);
 
-	NameVecPtr _pNames;
-	int        _mode;
-	bool       _firstTime;
+	NameVecPtr  _pNames;
+	int         _mode;
+	bool        _firstTime;
+	std::string _buffer;
 };
 
 
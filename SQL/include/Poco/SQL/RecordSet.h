@@ -355,7 +355,9 @@ public:
 	std::ostream& copyValues(std::ostream& os,
 		std::size_t offset = 0,
 		std::size_t length = RowIterator::POSITION_END) const;
-		/// Copies the data values to the supplied output stream.
+		/// Writes the data values to the supplied output stream.
+		/// Rows are formatted one at a time directly into the stream,
+		/// so the formatted result is never held in memory as a whole.
 		/// The data set to be copied is starting at the specified offset
 		/// from the recordset beginning. The number of rows to be copied
 		/// is specified by length argument.
@@ -376,6 +378,12 @@ public:
 		std::size_t length = RowIterator::POSITION_END) const;
 		/// Copies the column names and values to the target output stream.
 		/// Copied strings are formatted by the current RowFormatter.
+		///
+		/// In progressive formatting mode, rows are written to the stream
+		/// as they are formatted, so a large recordset can be streamed
+		/// directly to its destination, e.g.:
+		///
+		///     rs.copy(response.send());
 
 	bool isFiltered() const;
 		/// Returns true if recordset is filtered.
@@ -454,6 +462,12 @@ private:
 		}
 	}
 
+	void formatRows(std::ostream* pOS, std::size_t offset, std::size_t length) const;
+		/// Formats the rows in the given range, either writing them
+		/// to pOS or, if pOS is null, into the (bulk mode) formatter.
+		/// Values are read straight from the extraction containers into
+		/// a single reused Row.
+
 	size_t storageRowCount() const;
 
 	bool isAllowed(std::size_t row) const;
@@ -474,6 +488,7 @@ private:
 
 	friend class RowIterator;
 	friend class RowFilter;
+	friend class ColumnStore;
 };
 
 
@@ -188,12 +188,18 @@ public:
 	void formatNames() const;
 		/// Formats the column names.
 
+	std::ostream& namesToStream(std::ostream& ostr) const;
+		/// Writes the formatted column names to ostr.
+
 	const std::string& valuesToString() const;
 		/// Converts the row values to string and returns the formatted string.
 
 	void formatValues() const;
 		/// Formats the row values.
 
+	std::ostream& valuesToStream(std::ostream& ostr) const;
+		/// Writes the formatted row values to ostr.
+
 	bool operator == (const Row& other) const;
 		/// Equality operator.
 
@@ -327,6 +333,12 @@ inline void Row::formatValues() const
 }
 
 
+inline std::ostream& Row::valuesToStream(std::ostream& ostr) const
+{
+	return _pFormatter->formatValues(values(), ostr);
+}
+
+
 } } // namespace Poco::SQL
 
 
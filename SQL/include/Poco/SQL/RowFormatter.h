@@ -23,6 +23,7 @@
 #include "Poco/RefCountedObject.h"
 #include "Poco/Dynamic/Var.h"
 #include <sstream>
+#include <ostream>
 #include <vector>
 
 
@@ -105,6 +106,19 @@ public:
 		/// Should be implemented to format the row fields values.
 		/// The default implementation does nothing.
 
+	virtual std::ostream& formatNames(const NameVecPtr pNames, std::ostream& ostr);
+		/// Writes the formatted row fields names to ostr and returns it.
+		/// The default implementation writes the string returned by
+		/// formatNames(pNames, std::string&); formatters should override
+		/// it to write directly to the stream.
+
+	virtual std::ostream& formatValues(const ValueVec& vals, std::ostream& ostr);
+		/// Writes the formatted row fields values to ostr and returns it.
+		/// The default implementation writes the string returned by
+		/// formatValues(vals, std::string&); formatters should override
+		/// it to write directly to the stream, so that large result sets
+		/// can be streamed row by row without building the output in memory.
+
 	virtual const std::string& toString();
 		/// Throws NotImplementedException. Formatters operating in bulk mode should
 		/// implement this member function to return valid pointer to the formatted result.
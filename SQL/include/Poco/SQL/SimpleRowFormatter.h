@@ -55,6 +55,12 @@ public:
 	std::string& formatValues(const ValueVec& vals, std::string& formattedValues);
 		/// Formats the row values.
 
+	std::ostream& formatNames(const NameVecPtr pNames, std::ostream& ostr);
+		/// Writes the formatted row field names to ostr.
+
+	std::ostream& formatValues(const ValueVec& vals, std::ostream& ostr);
+		/// Writes the formatted row values to ostr.
+
 	int rowCount() const;
 		/// Returns row count.
 
@@ -68,9 +74,13 @@ public:
 		/// Returns the spacing.
 
 private:
+	void writeField(const std::string& field, bool alignRight, std::ostream& ostr) const;
+	static void writeSpaces(std::streamsize count, std::ostream& ostr);
+
 	std::streamsize _colWidth;
 	std::streamsize _spacing;
 	int             _rowCount;
+	std::string     _buffer;
 };
 
 
@@ -0,0 +1,108 @@
+//
+// BulkExtraction.cpp
+//
+// This sample compares row-by-row and bulk extraction of a large result set.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+
+
+#include "Poco/SQL/Session.h"
+#include "Poco/SQL/SQLite/Connector.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include <vector>
+#include <string>
+#include <iostream>
+
+
+using namespace Poco::SQL::Keywords;
+using Poco::SQL::Session;
+using Poco::SQL::Statement;
+using Poco::Stopwatch;
+
+
+void fill(Session& session, int rows)
+{
+	session << "DROP TABLE IF EXISTS Bench", now;
+	session << "CREATE TABLE Bench (id INTEGER, value REAL, name VARCHAR(30))", now;
+
+	std::vector<int> ids;
+	std::vector<double> values;
+	std::vector<std::string> names;
+	ids.reserve(rows);
+	values.reserve(rows);
+	names.reserve(rows);
+	for (int i = 0; i < rows; ++i)
+	{
+		ids.push_back(i);
+		values.push_back(i * 0.25);
+		names.push_back("name");
+		names.back().append(1, 'a' + i % 26);
+	}
+
+	session.begin();
+	session << "INSERT INTO Bench VALUES (?, ?, ?)", use(ids), use(values), use(names), now;
+	session.commit();
+}
+
+
+Poco::Int64 extractRows(Session& session, int rows)
+{
+	std::vector<int> ids;
+	std::vector<double> values;
+	std::vector<std::string> names;
+
+	Stopwatch sw;
+	sw.start();
+	session << "SELECT id, value, name FROM Bench", into(ids), into(values), into(names), now;
+	sw.stop();
+
+	poco_assert (ids.size() == static_cast<std::size_t>(rows));
+	return sw.elapsed();
+}
+
+
+Poco::Int64 extractBulk(Session& session, int rows, int blockSize)
+{
+	std::vector<int> ids;
+	std::vector<double> values;
+	std::vector<std::string> names;
+
+	Stopwatch sw;
+	sw.start();
+	Statement stmt = (session << "SELECT id, value, name FROM Bench",
+		into(ids, bulk(blockSize)), into(values, bulk(blockSize)), into(names, bulk(blockSize)));
+	std::size_t total = 0;
+	while (!stmt.done())
+		total += stmt.execute();
+	sw.stop();
+
+	poco_assert (total == static_cast<std::size_t>(rows));
+	return sw.elapsed();
+}
+
+
+int main(int argc, char** argv)
+{
+	int rows = 1000000;
+	if (argc > 1) rows = Poco::NumberParser::parse(argv[1]);
+
+	Session session("SQLite", ":memory:");
+
+	std::cout << "Filling table with " << rows << " rows ..." << std::endl;
+	fill(session, rows);
+
+	std::cout << "Row-by-row extraction: " << extractRows(session, rows) / 1000 << " [ms]" << std::endl;
+
+	const int blockSizes[] = { 100, 1000, 10000 };
+	for (std::size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+	{
+		std::cout << "Bulk extraction (" << blockSizes[i] << " rows per block): "
+			<< extractBulk(session, rows, blockSizes[i]) / 1000 << " [ms]" << std::endl;
+	}
+
+	return 0;
+}
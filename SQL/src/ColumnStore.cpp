@@ -0,0 +1,553 @@
+//
+// ColumnStore.cpp
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnStore
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SQL/ColumnStore.h"
+#include "Poco/SQL/RecordSet.h"
+#include "Poco/SQL/Date.h"
+#include "Poco/SQL/Time.h"
+#include "Poco/SQL/LOB.h"
+#include "Poco/DateTime.h"
+#include "Poco/Timestamp.h"
+#include "Poco/UTFString.h"
+#include "Poco/UnicodeConverter.h"
+#include "Poco/String.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+#include <unordered_map>
+
+
+namespace Poco {
+namespace SQL {
+
+
+class ColumnStore::Appender
+{
+public:
+	Appender(ColumnData& data, std::size_t rows):
+		_data(data)
+	{
+		switch (_data.storage)
+		{
+		case STORE_INT:
+		case STORE_DATE:
+			_data.ints.reserve(rows);
+			break;
+		case STORE_REAL:
+			_data.reals.reserve(rows);
+			break;
+		case STORE_STRING:
+			// code 0 is reserved for the empty string (and nulls)
+			_data.codes.reserve(rows);
+			_data.offsets.push_back(0);
+			_data.offsets.push_back(0);
+			_dictionary[std::string()] = 0;
+			break;
+		case STORE_LOB:
+			_data.offsets.reserve(rows + 1);
+			_data.offsets.push_back(0);
+			break;
+		}
+	}
+
+	template <typename C>
+	void append(const Column<C>& column, const std::vector<std::size_t>& rows, const std::vector<bool>& nulls)
+		/// Appends the values of column at the given (ascending) data rows.
+	{
+		std::vector<std::size_t>::const_iterator itRow = rows.begin();
+		std::vector<std::size_t>::const_iterator itRowEnd = rows.end();
+		std::size_t dataRow = 0;
+		std::size_t i = 0;
+		typename Column<C>::Iterator it = column.begin();
+		typename Column<C>::Iterator itEnd = column.end();
+		for (; it != itEnd && itRow != itRowEnd; ++it, ++dataRow)
+		{
+			if (dataRow != *itRow) continue;
+			if (nulls[i]) appendNull();
+			else appendValue(*it);
+			++itRow;
+			++i;
+		}
+		if (itRow != itRowEnd)
+			throw RangeException("Column has fewer rows than the recordset.");
+	}
+
+private:
+	void appendNull()
+	{
+		switch (_data.storage)
+		{
+		case STORE_INT:
+		case STORE_DATE:
+			_data.ints.push_back(0);
+			break;
+		case STORE_REAL:
+			_data.reals.push_back(0);
+			break;
+		case STORE_STRING:
+			_data.codes.push_back(0);
+			break;
+		case STORE_LOB:
+			_data.offsets.push_back(_data.bytes.size());
+			break;
+		}
+	}
+
+	void appendValue(bool val)   { _data.ints.push_back(val ? 1 : 0); }
+	void appendValue(Int8 val)   { _data.ints.push_back(val); }
+	void appendValue(UInt8 val)  { _data.ints.push_back(val); }
+	void appendValue(Int16 val)  { _data.ints.push_back(val); }
+	void appendValue(UInt16 val) { _data.ints.push_back(val); }
+	void appendValue(Int32 val)  { _data.ints.push_back(val); }
+	void appendValue(UInt32 val) { _data.ints.push_back(val); }
+	void appendValue(Int64 val)  { _data.ints.push_back(val); }
+	void appendValue(UInt64 val) { _data.ints.push_back(static_cast<Int64>(val)); }
+	void appendValue(float val)  { _data.reals.push_back(val); }
+	void appendValue(double val) { _data.reals.push_back(val); }
+
+	void appendValue(const std::string& val)
+	{
+		std::pair<Dictionary::iterator, bool> res = _dictionary.insert(Dictionary::value_type(val, static_cast<UInt32>(_dictionary.size())));
+		if (res.second)
+		{
+			_data.bytes.append(val);
+			_data.offsets.push_back(_data.bytes.size());
+		}
+		_data.codes.push_back(res.first->second);
+	}
+
+	void appendValue(const UTF16String& val)
+	{
+		std::string utf8;
+		UnicodeConverter::convert(val, utf8);
+		appendValue(utf8);
+	}
+
+	template <typename T>
+	void appendValue(const LOB<T>& val)
+	{
+		if (val.size()) _data.bytes.append(reinterpret_cast<const char*>(val.rawContent()), val.size());
+		_data.offsets.push_back(_data.bytes.size());
+	}
+
+	void appendValue(const Date& val)
+	{
+		_data.ints.push_back(Int64(val.year())*10000 + val.month()*100 + val.day());
+	}
+
+	void appendValue(const Time& val)
+	{
+		_data.ints.push_back(Int64(val.hour())*3600 + val.minute()*60 + val.second());
+	}
+
+	void appendValue(const DateTime& val)
+	{
+		_data.ints.push_back(val.timestamp().epochMicroseconds());
+	}
+
+	typedef std::unordered_map<std::string, UInt32> Dictionary;
+
+	ColumnData& _data;
+	Dictionary  _dictionary;
+};
+
+
+ColumnStore::ColumnStore():
+	_rowCount(0)
+{
+}
+
+
+ColumnStore::ColumnStore(const RecordSet& recordSet):
+	_rowCount(0)
+{
+	load(recordSet, 0, RowIterator::POSITION_END);
+}
+
+
+ColumnStore::ColumnStore(const RecordSet& recordSet, std::size_t offset, std::size_t length):
+	_rowCount(0)
+{
+	load(recordSet, offset, length);
+}
+
+
+ColumnStore::~ColumnStore()
+{
+}
+
+
+void ColumnStore::clear()
+{
+	_rowCount = 0;
+	_columns.clear();
+	_index.clear();
+}
+
+
+void ColumnStore::load(const RecordSet& recordSet, std::size_t offset, std::size_t length)
+{
+	std::vector<std::size_t> rows;
+	dataRows(recordSet, offset, length, rows);
+	loadRows(recordSet, rows);
+}
+
+
+void ColumnStore::dataRows(const RecordSet& recordSet, std::size_t offset, std::size_t length, std::vector<std::size_t>& rows)
+{
+	rows.clear();
+	std::size_t storageRows = recordSet.storageRowCount();
+	if (!recordSet.isFiltered())
+	{
+		if (offset > storageRows || (length != RowIterator::POSITION_END && length > storageRows - offset))
+			throw RangeException("Invalid recordset range.");
+		std::size_t end = length != RowIterator::POSITION_END ? offset + length : storageRows;
+		rows.reserve(end - offset);
+		for (std::size_t dataRow = offset; dataRow < end; ++dataRow) rows.push_back(dataRow);
+		return;
+	}
+
+	std::size_t skip = offset;
+	for (std::size_t dataRow = 0; dataRow < storageRows && rows.size() < length; ++dataRow)
+	{
+		if (!recordSet.isAllowed(dataRow)) continue;
+		if (skip > 0) --skip;
+		else rows.push_back(dataRow);
+	}
+	if (skip > 0 || (length != RowIterator::POSITION_END && rows.size() < length))
+		throw RangeException("Invalid recordset range.");
+}
+
+
+void ColumnStore::loadRows(const RecordSet& recordSet, const std::vector<std::size_t>& rows)
+{
+	clear();
+
+	std::size_t columns = recordSet.columnCount();
+	if (0 == columns) return;
+
+	_columns.resize(columns);
+	for (std::size_t col = 0; col < columns; ++col)
+	{
+		ColumnData& data = _columns[col];
+		data.name = recordSet.columnName(col);
+		data.type = recordSet.columnType(col);
+		data.storage = storageFor(data.type);
+		_index.insert(IndexMap::value_type(Poco::toLower(data.name), col));
+
+		switch (data.type)
+		{
+		case MetaColumn::FDT_BOOL:      loadColumn<bool>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_INT8:      loadColumn<Int8>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_UINT8:     loadColumn<UInt8>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_INT16:     loadColumn<Int16>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_UINT16:    loadColumn<UInt16>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_INT32:     loadColumn<Int32>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_UINT32:    loadColumn<UInt32>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_INT64:     loadColumn<Int64>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_UINT64:    loadColumn<UInt64>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_FLOAT:     loadColumn<float>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_DOUBLE:    loadColumn<double>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_STRING:    loadColumn<std::string>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_WSTRING:   loadColumn<UTF16String>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_BLOB:      loadColumn<BLOB>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_CLOB:      loadColumn<CLOB>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_DATE:      loadColumn<Date>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_TIME:      loadColumn<Time>(recordSet, col, rows, data); break;
+		case MetaColumn::FDT_TIMESTAMP: loadColumn<DateTime>(recordSet, col, rows, data); break;
+		default:
+			throw UnknownTypeException("Data type not supported.");
+		}
+	}
+	_rowCount = rows.size();
+}
+
+
+template <typename T>
+void ColumnStore::loadColumn(const RecordSet& recordSet, std::size_t col, const std::vector<std::size_t>& rows, ColumnData& data)
+{
+	std::vector<bool> nulls(rows.size());
+	data.nulls.assign((rows.size() + 63)/64, 0);
+	for (std::size_t i = 0; i < rows.size(); ++i)
+	{
+		if (recordSet.isNull(col, rows[i]))
+		{
+			nulls[i] = true;
+			data.nulls[i >> 6] |= UInt64(1) << (i & 63);
+		}
+	}
+
+	Appender appender(data, rows.size());
+	switch (recordSet.storage())
+	{
+	case Statement::STORAGE_VECTOR:
+		appender.append(recordSet.column<std::vector<T> >(col), rows, nulls);
+		break;
+	case Statement::STORAGE_LIST:
+		appender.append(recordSet.column<std::list<T> >(col), rows, nulls);
+		break;
+	case Statement::STORAGE_DEQUE:
+	case Statement::STORAGE_UNKNOWN:
+		appender.append(recordSet.column<std::deque<T> >(col), rows, nulls);
+		break;
+	default:
+		throw IllegalStateException("Invalid storage setting.");
+	}
+}
+
+
+ColumnStore::StorageType ColumnStore::storageFor(MetaColumn::ColumnDataType type)
+{
+	switch (type)
+	{
+	case MetaColumn::FDT_FLOAT:
+	case MetaColumn::FDT_DOUBLE:
+		return STORE_REAL;
+	case MetaColumn::FDT_STRING:
+	case MetaColumn::FDT_WSTRING:
+		return STORE_STRING;
+	case MetaColumn::FDT_BLOB:
+	case MetaColumn::FDT_CLOB:
+		return STORE_LOB;
+	case MetaColumn::FDT_DATE:
+	case MetaColumn::FDT_TIME:
+	case MetaColumn::FDT_TIMESTAMP:
+		return STORE_DATE;
+	default:
+		return STORE_INT;
+	}
+}
+
+
+const ColumnStore::ColumnData& ColumnStore::columnData(std::size_t col, StorageType storage) const
+{
+	const ColumnData& data = columnData(col);
+	if (data.storage != storage)
+		throw BadCastException(Poco::format("Column %s has incompatible storage type.", data.name));
+	return data;
+}
+
+
+void ColumnStore::checkRow(std::size_t row) const
+{
+	if (row >= _rowCount)
+		throw RangeException("Invalid row index.");
+}
+
+
+std::size_t ColumnStore::columnIndex(const std::string& name) const
+{
+	IndexMap::const_iterator it = _index.find(Poco::toLower(name));
+	if (it == _index.end())
+		throw NotFoundException(Poco::format("Column name: %s", name));
+	return it->second;
+}
+
+
+Int64 ColumnStore::getInt64(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	switch (data.storage)
+	{
+	case STORE_INT:
+	case STORE_DATE:
+		return data.ints[row];
+	case STORE_REAL:
+		return static_cast<Int64>(data.reals[row]);
+	default:
+		throw BadCastException(Poco::format("Column %s is not numeric.", data.name));
+	}
+}
+
+
+UInt64 ColumnStore::getUInt64(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	switch (data.storage)
+	{
+	case STORE_INT:
+		return static_cast<UInt64>(data.ints[row]);
+	case STORE_REAL:
+		return static_cast<UInt64>(data.reals[row]);
+	default:
+		throw BadCastException(Poco::format("Column %s is not numeric.", data.name));
+	}
+}
+
+
+double ColumnStore::getDouble(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	switch (data.storage)
+	{
+	case STORE_INT:
+		if (data.type == MetaColumn::FDT_UINT64)
+			return static_cast<double>(static_cast<UInt64>(data.ints[row]));
+		return static_cast<double>(data.ints[row]);
+	case STORE_REAL:
+		return data.reals[row];
+	default:
+		throw BadCastException(Poco::format("Column %s is not numeric.", data.name));
+	}
+}
+
+
+bool ColumnStore::getBool(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	switch (data.storage)
+	{
+	case STORE_INT:
+		return data.ints[row] != 0;
+	case STORE_REAL:
+		return data.reals[row] != 0;
+	default:
+		throw BadCastException(Poco::format("Column %s is not numeric.", data.name));
+	}
+}
+
+
+StringRef ColumnStore::getString(std::size_t col, std::size_t row) const
+{
+	const ColumnData& data = columnData(col);
+	checkRow(row);
+	switch (data.storage)
+	{
+	case STORE_STRING:
+	{
+		UInt32 code = data.codes[row];
+		return StringRef(data.bytes.data() + data.offsets[code], data.offsets[code + 1] - data.offsets[code]);
+	}
+	case STORE_LOB:
+		return StringRef(data.bytes.data() + data.offsets[row], data.offsets[row + 1] - data.offsets[row]);
+	default:
+		throw BadCastException(Poco::format("Column %s is not a string.", data.name));
+	}
+}
+
+
+Poco::Dynamic::Var ColumnStore::value(std::size_t col, std::size_t row) const
+{
+	if (isNull(col, row)) return Poco::Dynamic::Var();
+
+	const ColumnData& data = _columns[col];
+	switch (data.type)
+	{
+	case MetaColumn::FDT_BOOL:   return data.ints[row] != 0;
+	case MetaColumn::FDT_INT8:   return static_cast<Int8>(data.ints[row]);
+	case MetaColumn::FDT_UINT8:  return static_cast<UInt8>(data.ints[row]);
+	case MetaColumn::FDT_INT16:  return static_cast<Int16>(data.ints[row]);
+	case MetaColumn::FDT_UINT16: return static_cast<UInt16>(data.ints[row]);
+	case MetaColumn::FDT_INT32:  return static_cast<Int32>(data.ints[row]);
+	case MetaColumn::FDT_UINT32: return static_cast<UInt32>(data.ints[row]);
+	case MetaColumn::FDT_INT64:  return data.ints[row];
+	case MetaColumn::FDT_UINT64: return static_cast<UInt64>(data.ints[row]);
+	case MetaColumn::FDT_FLOAT:  return static_cast<float>(data.reals[row]);
+	case MetaColumn::FDT_DOUBLE: return data.reals[row];
+	case MetaColumn::FDT_STRING: return getString(col, row).toString();
+	case MetaColumn::FDT_WSTRING:
+	{
+		StringRef ref = getString(col, row);
+		UTF16String str;
+		UnicodeConverter::convert(ref.data(), ref.size(), str);
+		return str;
+	}
+	case MetaColumn::FDT_BLOB:
+	{
+		StringRef ref = getString(col, row);
+		return BLOB(reinterpret_cast<const unsigned char*>(ref.data()), ref.size());
+	}
+	case MetaColumn::FDT_CLOB:
+	{
+		StringRef ref = getString(col, row);
+		return CLOB(ref.data(), ref.size());
+	}
+	case MetaColumn::FDT_DATE:
+	{
+		Int64 d = data.ints[row];
+		return Date(static_cast<int>(d/10000), static_cast<int>(d/100%100), static_cast<int>(d%100));
+	}
+	case MetaColumn::FDT_TIME:
+	{
+		Int64 t = data.ints[row];
+		return Time(static_cast<int>(t/3600), static_cast<int>(t/60%60), static_cast<int>(t%60));
+	}
+	case MetaColumn::FDT_TIMESTAMP:
+		return DateTime(Timestamp(data.ints[row]));
+	default:
+		throw UnknownTypeException("Data type not supported.");
+	}
+}
+
+
+const Int64* ColumnStore::intData(std::size_t col) const
+{
+	const ColumnData& data = columnData(col);
+	if (data.storage != STORE_INT && data.storage != STORE_DATE)
+		throw BadCastException(Poco::format("Column %s is not integral.", data.name));
+	return data.ints.empty() ? 0 : &data.ints[0];
+}
+
+
+const double* ColumnStore::realData(std::size_t col) const
+{
+	const ColumnData& data = columnData(col, STORE_REAL);
+	return data.reals.empty() ? 0 : &data.reals[0];
+}
+
+
+const UInt32* ColumnStore::stringCodes(std::size_t col) const
+{
+	const ColumnData& data = columnData(col, STORE_STRING);
+	return data.codes.empty() ? 0 : &data.codes[0];
+}
+
+
+std::size_t ColumnStore::dictionarySize(std::size_t col) const
+{
+	return columnData(col, STORE_STRING).offsets.size() - 1;
+}
+
+
+StringRef ColumnStore::dictionaryValue(std::size_t col, UInt32 code) const
+{
+	const ColumnData& data = columnData(col, STORE_STRING);
+	if (code + 1 >= data.offsets.size())
+		throw RangeException("Invalid dictionary code.");
+	return StringRef(data.bytes.data() + data.offsets[code], data.offsets[code + 1] - data.offsets[code]);
+}
+
+
+void ColumnStore::fillRow(std::size_t row, Row& rRow) const
+{
+	checkRow(row);
+	std::size_t columns = _columns.size();
+	if (0 == rRow.fieldCount())
+	{
+		for (std::size_t col = 0; col < columns; ++col)
+			rRow.append(_columns[col].name, value(col, row));
+	}
+	else if (rRow.fieldCount() == columns)
+	{
+		for (std::size_t col = 0; col < columns; ++col)
+			rRow.set(col, value(col, row));
+	}
+	else throw InvalidArgumentException("Row field count mismatch.");
+}
+
+
+} } // namespace Poco::SQL
@@ -16,11 +16,16 @@
 #include "Poco/String.h"
 #include "Poco/JSONString.h"
 #include "Poco/Format.h"
+#include "Poco/Ascii.h"
+#include "Poco/NumberFormatter.h"
+#include <typeinfo>
 
 
 using Poco::trimInPlace;
 using Poco::format;
 using Poco::toJSON;
+using Poco::Ascii;
+using Poco::NumberFormatter;
 
 
 namespace Poco {
@@ -91,86 +96,117 @@ void JSONRowFormatter::setJSONMode(int mode)
 std::string& JSONRowFormatter::formatValues(const ValueVec& vals, std::string& formattedValues)
 {
 	std::ostringstream str;
-	if (!_firstTime) str << ',';
+	formatValues(vals, str);
+	return formattedValues = str.str();
+}
+
+
+std::ostream& JSONRowFormatter::formatValues(const ValueVec& vals, std::ostream& ostr)
+{
+	if (!_firstTime) ostr << ',';
 	if (isSmall())
 	{
 		if (_firstTime)
 		{
 			if (printColumnNames())
-				str << ",\"values\":";
+				ostr << ",\"values\":";
 
-			str << '[';
+			ostr << '[';
 		}
 
-		str << '[';
+		ostr << '[';
 		ValueVec::const_iterator it = vals.begin();
 		ValueVec::const_iterator end = vals.end();
 		for (; it != end;)
 		{
-			if (!it->isEmpty())
-			{
-				if (it->isString() || it->isDate() || it->isTime())
-				{
-					std::string val = it->convert<std::string>();
-					trimInPlace(val);
-					str << toJSON(val);
-				}
-				else
-					str << it->convert<std::string>();
-			}
-			else
-				str << "null";
-
+			writeValue(*it, ostr);
 			if (++it == end) break;
-			
-			str << ',';
+			ostr << ',';
 		}
-		str << ']';
+		ostr << ']';
 	}
 	else if (isFull())
 	{
-		str << '{';
+		ostr << '{';
 		ValueVec::const_iterator it = vals.begin();
 		ValueVec::const_iterator end = vals.end();
 		NameVec::iterator nIt = _pNames->begin();
 		NameVec::iterator nEnd = _pNames->end();
 		for (; it != end && nIt != nEnd; ++nIt)
 		{
-			if (!it->isEmpty())
+			ostr << '"' << *nIt << "\":";
+			writeValue(*it, ostr);
+			if (++it != end) ostr << ',';
+		}
+		ostr << '}';
+	}
+
+	_firstTime = false;
+	return ostr;
+}
+
+
+void JSONRowFormatter::writeValue(const Poco::Dynamic::Var& val, std::ostream& ostr)
+{
+	if (val.isEmpty())
+	{
+		ostr << "null";
+		return;
+	}
+
+	_buffer.clear();
+	if (val.isString() || val.isDate() || val.isTime())
+	{
+		if (val.type() == typeid(std::string))
+		{
+			const std::string& str = val.extract<std::string>();
+			if (str.empty() || (!Ascii::isSpace(str[0]) && !Ascii::isSpace(str[str.size() - 1])))
 			{
-				if (it->isString() || it->isDate() || it->isTime())
-				{
-					std::string val = it->convert<std::string>();
-					trimInPlace(val);
-					str << '"' << *nIt << "\":" << toJSON(val);
-				}
-				else
-					str << '"' << *nIt << "\":" << it->convert<std::string>();
+				toJSON(str, ostr);
+				return;
 			}
-			else
-				str << '"' << *nIt << "\":null";
-
-			if (++it != end) str << ',';
+			_buffer = str;
 		}
-		str << '}';
+		else val.convert(_buffer);
+		trimInPlace(_buffer);
+		toJSON(_buffer, ostr);
+		return;
 	}
 
-	_firstTime = false;
-	return formattedValues = str.str();
+	if (val.isInteger() && !val.isBoolean() && val.type() != typeid(char))
+	{
+		if (val.isSigned())
+			NumberFormatter::append(_buffer, val.convert<Int64>());
+		else
+			NumberFormatter::append(_buffer, val.convert<UInt64>());
+	}
+	else if (val.type() == typeid(double))
+		NumberFormatter::append(_buffer, val.extract<double>());
+	else if (val.type() == typeid(float))
+		NumberFormatter::append(_buffer, val.extract<float>());
+	else
+		val.convert(_buffer);
+	ostr.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
 }
 
 
 std::string& JSONRowFormatter::formatNames(const NameVecPtr pNames, std::string& formattedNames)
+{
+	std::ostringstream ostr;
+	formatNames(pNames, ostr);
+	return formattedNames = ostr.str();
+}
+
+
+std::ostream& JSONRowFormatter::formatNames(const NameVecPtr pNames, std::ostream& ostr)
 {
 	if (isFull())
 	{
 		// names are used in formatValues
 		if (pNames && !_pNames) _pNames = pNames;
-		return formattedNames = "";
 	}
 	else if (printColumnNames())
 	{
-		std::ostringstream ostr;
 		ostr << "\"names\":[";
 		for (NameVec::const_iterator it = pNames->begin(),
 			end = pNames->end();;)
@@ -180,10 +216,9 @@ std::string& JSONRowFormatter::formatNames(const NameVecPtr pNames, std::string&
 			ostr << ',';
 		}
 		ostr << "]";
-		return formattedNames = ostr.str();
 	}
 
-	return formattedNames = "";
+	return ostr;
 }
 
 
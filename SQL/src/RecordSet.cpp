@@ -18,6 +18,7 @@
 #include "Poco/SQL/SQLException.h"
 #include "Poco/DateTime.h"
 #include "Poco/UTFString.h"
+#include <algorithm>
 
 
 using namespace Poco::SQL::Keywords;
@@ -341,9 +342,7 @@ std::ostream& RecordSet::copyNames(std::ostream& os) const
 {
 	if (begin() == end()) return os;
 
-	std::string names = (*_pBegin)->namesToString();
-	if (!names.empty()) os << names;
-	return os;
+	return (*_pBegin)->namesToStream(os);
 }
 
 
@@ -351,9 +350,7 @@ std::ostream& RecordSet::copyValues(std::ostream& os, std::size_t offset, std::s
 {
 	if (begin() == end()) return os;
 
-	RowIterator it = *_pBegin + offset;
-	RowIterator itEnd = (RowIterator::POSITION_END != length) ? it + length : *_pEnd;
-	std::copy(it, itEnd, std::ostream_iterator<Row>(os));
+	formatRows(&os, offset, length);
 	return os;
 }
 
@@ -362,10 +359,41 @@ void RecordSet::formatValues(std::size_t offset, std::size_t length) const
 {
 	if (begin() == end()) return;
 
-	RowIterator it = *_pBegin + offset;
-	RowIterator itEnd = (RowIterator::POSITION_END != length) ? it + length : *_pEnd;
-	std::string val;
-	for (; it != itEnd; ++it) it->formatValues();
+	formatRows(0, offset, length);
+}
+
+
+void RecordSet::formatRows(std::ostream* pOS, std::size_t offset, std::size_t length) const
+{
+	std::size_t storageRows = storageRowCount();
+	bool filtered = isFiltered();
+	if (!filtered && (offset > storageRows || (length != RowIterator::POSITION_END && length > storageRows - offset)))
+		throw RangeException("Invalid recordset range.");
+
+	std::size_t columns = columnCount();
+	Row row;
+	row.setFormatter(const_cast<RecordSet*>(this)->getRowFormatter());
+	for (std::size_t col = 0; col < columns; ++col)
+		row.append(columnName(col), Poco::Dynamic::Var());
+
+	std::size_t skip = filtered ? offset : 0;
+	std::size_t count = 0;
+	for (std::size_t dataRow = filtered ? 0 : offset; dataRow < storageRows && count < length; ++dataRow)
+	{
+		if (filtered && !isAllowed(dataRow)) continue;
+		if (skip > 0)
+		{
+			--skip;
+			continue;
+		}
+		for (std::size_t col = 0; col < columns; ++col)
+			row.set(col, value(col, dataRow, false));
+		if (pOS) row.valuesToStream(*pOS);
+		else row.formatValues();
+		++count;
+	}
+	if (skip > 0 || (length != RowIterator::POSITION_END && count < length))
+		throw RangeException("Invalid recordset range.");
 }
 
 
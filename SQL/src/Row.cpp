@@ -24,8 +24,7 @@ namespace SQL {
 
 std::ostream& operator << (std::ostream &os, const Row& row)
 {
-	os << row.valuesToString();
-	return os;
+	return row.valuesToStream(os);
 }
 
 
@@ -379,4 +378,13 @@ void Row::formatNames() const
 }
 
 
+std::ostream& Row::namesToStream(std::ostream& ostr) const
+{
+	if (!_pNames)
+		throw NullPointerException();
+
+	return _pFormatter->formatNames(names(), ostr);
+}
+
+
 } } // namespace Poco::SQL
@@ -62,6 +62,20 @@ void RowFormatter::formatValues(const ValueVec& /*vals*/)
 }
 
 
+std::ostream& RowFormatter::formatNames(const NameVecPtr pNames, std::ostream& ostr)
+{
+	std::string names;
+	return ostr << formatNames(pNames, names);
+}
+
+
+std::ostream& RowFormatter::formatValues(const ValueVec& vals, std::ostream& ostr)
+{
+	std::string values;
+	return ostr << formatValues(vals, values);
+}
+
+
 const std::string& RowFormatter::toString()
 {
 	throw NotImplementedException("RowFormatter::toString()");
@@ -14,7 +14,7 @@
 
 #include "Poco/SQL/SimpleRowFormatter.h"
 #include "Poco/Exception.h"
-#include <iomanip>
+#include <sstream>
 
 
 namespace Poco {
@@ -62,51 +62,74 @@ void SimpleRowFormatter::swap(SimpleRowFormatter& other)
 
 std::string& SimpleRowFormatter::formatNames(const NameVecPtr pNames, std::string& formattedNames)
 {
-	_rowCount = 0;
+	std::ostringstream str;
+	formatNames(pNames, str);
+	return formattedNames = str.str();
+}
 
+
+std::string& SimpleRowFormatter::formatValues(const ValueVec& vals, std::string& formattedValues)
+{
 	std::ostringstream str;
-	std::string line(std::string::size_type(pNames->size()*_colWidth + (pNames->size() - 1)*_spacing), '-');
-	std::string space(static_cast<std::size_t>(_spacing), ' ');
+	formatValues(vals, str);
+	return formattedValues = str.str();
+}
+
+
+std::ostream& SimpleRowFormatter::formatNames(const NameVecPtr pNames, std::ostream& ostr)
+{
+	_rowCount = 0;
+
 	NameVec::const_iterator it = pNames->begin();
 	NameVec::const_iterator end = pNames->end();
 	for (; it != end; ++it)
 	{
-		if (it != pNames->begin()) str << space;
-		str << std::left << std::setw(_colWidth) << *it;
+		if (it != pNames->begin()) writeSpaces(_spacing, ostr);
+		writeField(*it, false, ostr);
 	}
-	str << std::endl << line << std::endl;
+	ostr << '\n';
+	std::string line(std::string::size_type(pNames->size()*_colWidth + (pNames->size() - 1)*_spacing), '-');
+	ostr << line << '\n';
 
-	return formattedNames = str.str();
+	return ostr;
 }
 
 
-std::string& SimpleRowFormatter::formatValues(const ValueVec& vals, std::string& formattedValues)
+std::ostream& SimpleRowFormatter::formatValues(const ValueVec& vals, std::ostream& ostr)
 {
-	std::ostringstream str;
-	std::string space(static_cast<std::size_t>(_spacing), ' ');
 	ValueVec::const_iterator it = vals.begin();
 	ValueVec::const_iterator end = vals.end();
 	for (; it != end; ++it)
 	{
-		if (it != vals.begin()) str << space;
-		if (it->isNumeric())
+		if (it != vals.begin()) writeSpaces(_spacing, ostr);
+		if (!it->isEmpty())
 		{
-			str << std::right
-				<< std::fixed
-				<< std::setprecision(2);
+			it->convert(_buffer);
+			writeField(_buffer, it->isNumeric(), ostr);
 		}
-		else str << std::left;
-
-		if (!it->isEmpty())
-			str << std::setw(_colWidth) << it->convert<std::string>();
-		else
-			str << std::setw(_colWidth) << "null";
+		else writeField("null", false, ostr);
 	}
-	str << std::endl;
+	ostr << '\n';
 
 	++_rowCount;
 
-	return formattedValues = str.str();
+	return ostr;
+}
+
+
+void SimpleRowFormatter::writeField(const std::string& field, bool alignRight, std::ostream& ostr) const
+{
+	std::streamsize size = static_cast<std::streamsize>(field.size());
+	std::streamsize padding = size < _colWidth ? _colWidth - size : 0;
+	if (alignRight) writeSpaces(padding, ostr);
+	ostr.write(field.data(), size);
+	if (!alignRight) writeSpaces(padding, ostr);
+}
+
+
+void SimpleRowFormatter::writeSpaces(std::streamsize count, std::ostream& ostr)
+{
+	for (; count > 0; --count) ostr.put(' ');
 }
 
 
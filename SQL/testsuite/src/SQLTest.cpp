@@ -1203,6 +1203,29 @@ void SQLTest::testSimpleRowFormatter()
 		<< spacer
 		<< std::setw(sz) << "4" << std::endl;
 	assertTrue (row1.valuesToString() == os.str());
+
+	std::ostringstream ostr;
+	row1.valuesToStream(ostr);
+	assertTrue (ostr.str() == os.str());
+
+	ostr.str("");
+	row1.append("field5", 5.5);
+	row1.append("field6", "six");
+	row1.append("field7", Var());
+	ostr << row1;
+	os.str("");
+	os << std::right
+		<< std::setw(sz) << "0" << spacer
+		<< std::setw(sz) << "1" << spacer
+		<< std::setw(sz) << "2" << spacer
+		<< std::setw(sz) << "3" << spacer
+		<< std::setw(sz) << "4" << spacer
+		<< std::setw(sz) << "5.5" << spacer
+		<< std::left
+		<< std::setw(sz) << "six" << spacer
+		<< std::setw(sz) << "null" << std::endl;
+	assertTrue (ostr.str() == os.str());
+	assertTrue (row1.valuesToString() == os.str());
 }
 
 
@@ -1235,6 +1258,24 @@ void SQLTest::testJSONRowFormatter()
 	assertTrue (row1.namesToString() == "");
 	assertTrue (row1.valuesToString() == "{\"field0\":0,\"field1\":\"1\",\"field2\":\"2007-03-13T08:12:15Z\",\"field3\":null,\"field4\":4}");
 	assertTrue (row1.valuesToString() == ",{\"field0\":0,\"field1\":\"1\",\"field2\":\"2007-03-13T08:12:15Z\",\"field3\":null,\"field4\":4}");
+
+	Row row2;
+	row2.append("i", Poco::Int64(-42));
+	row2.append("u", Poco::UInt16(42));
+	row2.append("d", 1.5);
+	row2.append("f", 0.25f);
+	row2.append("b", true);
+	row2.append("s", std::string(" \"padded\" "));
+	row2.setFormatter(new JSONRowFormatter);
+	std::ostringstream ostr;
+	row2.namesToStream(ostr);
+	assertTrue (ostr.str() == "\"names\":[\"i\",\"u\",\"d\",\"f\",\"b\",\"s\"]");
+	ostr.str("");
+	row2.valuesToStream(ostr);
+	assertTrue (ostr.str() == ",\"values\":[[-42,42,1.5,0.25,true,\"\\\"padded\\\"\"]");
+	ostr.str("");
+	ostr << row2;
+	assertTrue (ostr.str() == ",[-42,42,1.5,0.25,true,\"\\\"padded\\\"\"]");
 }
 
 
@@ -52,6 +52,10 @@ protected:
 
 	void dispatchNodeRemovedFromDocument();
 	void dispatchNodeInsertedIntoDocument();
+
+	void releaseChildren();
+		/// Removes and releases all child nodes,
+		/// without dispatching any events.
 	
 	static const Node* findNode(XMLString::const_iterator& it, const XMLString::const_iterator& end, const Node* pNode, const NSMap* pNSMap);
 	static const Node* findElement(const XMLString& name, const Node* pNode, const NSMap* pNSMap);
@@ -23,6 +23,7 @@
 #include "Poco/SAX/LexicalHandler.h"
 #include "Poco/SAX/DTDHandler.h"
 #include "Poco/XML/XMLString.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -30,7 +31,6 @@ namespace XML {
 
 
 class XMLReader;
-class Document;
 class InputSource;
 class AbstractNode;
 class AbstractContainerNode;
@@ -53,6 +53,16 @@ public:
 	virtual ~DOMBuilder();
 		/// Destroys the DOMBuilder.
 
+	void setAllocation(Document::Allocation allocation);
+		/// Sets the allocation strategy for the nodes of the
+		/// documents built. Use Document::ALLOC_ARENA to build
+		/// large documents that are mostly read.
+		/// The default is Document::ALLOC_HEAP.
+
+	Document::Allocation getAllocation() const;
+		/// Returns the allocation strategy for the nodes
+		/// of the documents built.
+
 	virtual Document* parse(const XMLString& uri);
 		/// Parse an XML document from a location identified by an URI.
 
@@ -103,9 +113,19 @@ private:
 	AbstractNode*          _pPrevious;
 	bool                   _inCDATA;
 	bool                   _namespaces;
+	Document::Allocation   _allocation;
 };
 
 
+//
+// inlines
+//
+inline Document::Allocation DOMBuilder::getAllocation() const
+{
+	return _allocation;
+}
+
+
 } } // namespace Poco::XML
 
 
@@ -61,7 +61,9 @@ public:
 	void release() const;
 		/// Decreases the object's reference count.
 		/// If the reference count reaches zero,
-		/// the object is deleted.
+		/// the object is deleted. Objects allocated in the
+		/// arena of a Document are only destroyed; their
+		/// memory is released together with the Document.
 		
 	virtual void autoRelease() = 0;
 		/// Adds the object to an appropriate
@@ -78,6 +80,9 @@ private:
 	DOMObject& operator = (const DOMObject&);
 	
 	mutable int _rc;
+	bool        _inArena;
+
+	friend class Document;
 };
 
 
@@ -93,7 +98,12 @@ inline void DOMObject::duplicate() const
 inline void DOMObject::release() const
 {
 	if (--_rc == 0)
-		delete this;
+	{
+		if (_inArena)
+			this->~DOMObject();
+		else
+			delete this;
+	}
 }
 
 
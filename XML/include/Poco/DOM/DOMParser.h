@@ -20,6 +20,7 @@
 
 #include "Poco/XML/XML.h"
 #include "Poco/SAX/SAXParser.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -27,7 +28,6 @@ namespace XML {
 
 
 class NamePool;
-class Document;
 class InputSource;
 class EntityResolver;
 
@@ -70,10 +70,14 @@ public:
 		/// If a feature is not recognized by the DOMParser, it is
 		/// passed on to the underlying XMLReader.
 		///
-		/// The only currently supported feature is
-		/// http://www.appinf.com/features/no-whitespace-in-element-content
-		/// which, when activated, causes the WhitespaceFilter to
-		/// be used.
+		/// The following features are supported:
+		///   * http://www.appinf.com/features/no-whitespace-in-element-content
+		///     which, when activated, causes the WhitespaceFilter to
+		///     be used.
+		///   * http://www.appinf.com/features/arena-allocation
+		///     which, when activated, causes the nodes of the document
+		///     to be allocated in the document's arena
+		///     (see Document::ALLOC_ARENA).
 
 	bool getFeature(const XMLString& name) const;
 		/// Look up the value of a feature.
@@ -81,8 +85,20 @@ public:
 		/// If a feature is not recognized by the DOMParser, the
 		/// DOMParser queries the underlying SAXParser for the feature.
 
+	void setBufferSize(std::size_t size);
+		/// Sets the maximum number of bytes the underlying
+		/// SAXParser passes to expat at a time.
+
+	std::size_t getBufferSize() const;
+		/// Returns the maximum number of bytes the underlying
+		/// SAXParser passes to expat at a time.
+
 	Document* parse(const XMLString& uri);
 		/// Parse an XML document from a location identified by an URI.
+		///
+		/// Large local files are memory-mapped, unless the
+		/// http://www.appinf.com/features/enable-memory-mapping
+		/// feature is disabled.
 
 	Document* parse(InputSource* pInputSource);
 		/// Parse an XML document from a location identified by an InputSource.
@@ -100,14 +116,28 @@ public:
 		/// Sets the entity resolver on the underlying SAXParser.
 
 	static const XMLString FEATURE_FILTER_WHITESPACE;
+	static const XMLString FEATURE_ARENA_ALLOCATION;
+
+protected:
+	Document::Allocation allocation() const;
 	
 private:
 	SAXParser _saxParser;
 	NamePool* _pNamePool;
 	bool      _filterWhitespace;
+	bool      _arenaAllocation;
 };
 
 
+//
+// inlines
+//
+inline Document::Allocation DOMParser::allocation() const
+{
+	return _arenaAllocation ? Document::ALLOC_ARENA : Document::ALLOC_HEAP;
+}
+
+
 } } // namespace Poco::XML
 
 
@@ -41,6 +41,15 @@ class XML_API SAXParser: public XMLReader
 	/// The following proprietary extensions are supported:
 	///   * http://www.appinf.com/features/enable-partial-reads --
 	///     see ParserEngine::setEnablePartialReads()
+	///   * http://www.appinf.com/features/enable-memory-mapping --
+	///     see ParserEngine::setEnableMemoryMapping()
+	///   * http://www.appinf.com/properties/buffer-size --
+	///     a string property holding the decimal buffer size,
+	///     see ParserEngine::setBufferSize()
+	///
+	/// A document given by a system identifier that denotes a
+	/// local file (a path or a file URI) is parsed directly from
+	/// the file, memory-mapping it if it is large enough.
 {
 public:
 	SAXParser();
@@ -84,8 +93,17 @@ public:
 	
 	/// Extensions
 	void parseString(const std::string& xml);
+
+	void setBufferSize(std::size_t size);
+		/// Sets the maximum number of bytes passed to expat at a time.
+		/// See ParserEngine::setBufferSize().
+
+	std::size_t getBufferSize() const;
+		/// Returns the maximum number of bytes passed to expat at a time.
 	
 	static const XMLString FEATURE_PARTIAL_READS;
+	static const XMLString FEATURE_MEMORY_MAPPING;
+	static const XMLString PROPERTY_BUFFER_SIZE;
 
 protected:
 	void setupParse();
@@ -152,9 +152,9 @@ public:
 		/// following elements depend upon responses sent back to
 		/// the peer.
 		///
-		/// Normally, the parser always reads blocks of PARSE_BUFFER_SIZE
-		/// at a time, and blocks until a complete block has been read (or
-		/// the end of the stream has been reached).
+		/// Normally, the parser always reads complete blocks at a time
+		/// (see setBufferSize()), and blocks until a complete block has
+		/// been read (or the end of the stream has been reached).
 		/// This allows for efficient parsing of "complete" XML documents,
 		/// but fails in a case such as XMPP, where only XML fragments
 		/// are sent at a time.
@@ -162,12 +162,51 @@ public:
 	bool getEnablePartialReads() const;
 		/// Returns true if partial reads are enabled (see
 		/// setEnablePartialReads()), false otherwise.
-	
+
+	void setBufferSize(std::size_t size);
+		/// Sets the maximum number of bytes passed to expat at a time.
+		/// The default is DEFAULT_BUFFER_SIZE.
+		///
+		/// Input from a stream is read directly into expat's buffer,
+		/// starting with small blocks, which are doubled in size after
+		/// every complete block, up to the buffer size. Small documents
+		/// thus do not need a large buffer, while large documents are
+		/// read with few large reads.
+		///
+		/// Throws an InvalidArgumentException if size is zero.
+
+	std::size_t getBufferSize() const;
+		/// Returns the maximum number of bytes passed to expat at a time.
+
+	void setEnableMemoryMapping(bool flag = true);
+		/// Enable or disable memory mapping of files passed to
+		/// parseFile() (enabled by default).
+
+	bool getEnableMemoryMapping() const;
+		/// Returns true if memory mapping is enabled (see
+		/// setEnableMemoryMapping()), false otherwise.
+
 	void parse(InputSource* pInputSource);
 		/// Parse an XML document from the given InputSource.
 		
 	void parse(const char* pBuffer, std::size_t size);
 		/// Parses an XML document from the given buffer.
+
+	void parseFile(const std::string& path, const XMLString& systemId);
+		/// Parses an XML document from the file with the given path.
+		/// The given systemId is reported by the Locator and is used
+		/// to resolve relative external entities.
+		///
+		/// If memory mapping is enabled and the file is larger than
+		/// the buffer size, the file is memory-mapped and handed to
+		/// expat block by block, without reading it through a stream.
+		/// The file must not be truncated while it is being parsed.
+		/// Otherwise, the file is read like a stream.
+
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 65536
+	};
 	
 	// Locator
 	XMLString getPublicId() const;
@@ -191,6 +230,9 @@ protected:
 
 	void parseCharInputStream(XMLCharInputStream& istr);
 		/// Parses an entity from the given stream.
+
+	void parseBuffer(const char* pBuffer, std::size_t size);
+		/// Parses an entity from the given buffer.
 		
 	std::streamsize readBytes(XMLByteInputStream& istr, char* pBuffer, std::streamsize bufferSize);
 		/// Reads at most bufferSize bytes from the given stream into the given buffer.
@@ -211,6 +253,13 @@ protected:
 	void parseExternalCharInputStream(XML_Parser extParser, XMLCharInputStream& istr);
 		/// Parses an external entity from the given stream, with a separate parser.
 
+	void parseBytes(XML_Parser parser, XMLByteInputStream& istr);
+		/// Parses an entity from the given stream, reading the stream
+		/// directly into the parser's buffer.
+
+	void parseChars(XML_Parser parser, XMLCharInputStream& istr);
+		/// Parses an entity from the given stream.
+
 	void pushContext(XML_Parser parser, InputSource* pInputSource);
 		/// Pushes a new entry to the context stack.
 		
@@ -253,14 +302,15 @@ private:
 	typedef std::map<XMLString, Poco::TextEncoding*> EncodingMap;
 	typedef std::vector<ContextLocator*> ContextStack;
 	
-	XML_Parser _parser;
-	char*      _pBuffer;
-	bool       _encodingSpecified;
-	XMLString  _encoding;
-	bool       _expandInternalEntities;
-	bool       _externalGeneralEntities;
-	bool       _externalParameterEntities;
-	bool       _enablePartialReads;
+	XML_Parser  _parser;
+	std::size_t _bufferSize;
+	bool        _encodingSpecified;
+	XMLString   _encoding;
+	bool        _expandInternalEntities;
+	bool        _externalGeneralEntities;
+	bool        _externalParameterEntities;
+	bool        _enablePartialReads;
+	bool        _enableMemoryMapping;
 	NamespaceStrategy* _pNamespaceStrategy;
 	EncodingMap        _encodings;
 	ContextStack       _context;
@@ -286,6 +336,18 @@ inline const XMLString& ParserEngine::getEncoding() const
 }
 
 
+inline std::size_t ParserEngine::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
+inline bool ParserEngine::getEnableMemoryMapping() const
+{
+	return _enableMemoryMapping;
+}
+
+
 inline NamespaceStrategy* ParserEngine::getNamespaceStrategy() const
 {
 	return _pNamespaceStrategy;
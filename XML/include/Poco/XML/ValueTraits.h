@@ -22,10 +22,13 @@
 
 
 #include "XMLStreamParserException.h"
+#include "Poco/NumericString.h"
 #include <string>
 #include <cstddef>
 #include <iostream>
 #include <sstream>
+#include <limits>
+#include <type_traits>
 
 
 namespace Poco {
@@ -36,6 +39,84 @@ class XMLStreamParser;
 class XMLStreamSerializer;
 
 
+namespace Impl {
+
+
+template <typename T,
+	bool = std::is_integral<T>::value && (sizeof(T) > 1),
+	bool = std::is_floating_point<T>::value && (sizeof(T) <= sizeof(double))>
+struct ValueParser
+	/// Converts a string to a value using the stream
+	/// extraction operator.
+{
+	static bool parse(const std::string& s, T& r)
+	{
+		std::istringstream is(s);
+		return (is >> r) && is.eof();
+	}
+};
+
+
+template <typename T>
+struct ValueParser<T, true, false>
+	/// Converts a string to an integer without going through a stream.
+	/// As with the stream extraction operator, leading whitespace is
+	/// skipped and the number may be preceded by a sign. The rest of
+	/// the string must be a decimal number that fits into T.
+{
+	static bool parse(const std::string& s, T& r)
+	{
+		typedef typename std::make_unsigned<T>::type U;
+
+		const char* it = s.data();
+		const char* end = it + s.size();
+		while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r')) ++it;
+
+		bool negative = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+		if (it == end) return false;
+
+		const U limit = negative ? static_cast<U>(U(0) - static_cast<U>(std::numeric_limits<T>::min())) : static_cast<U>(std::numeric_limits<T>::max());
+		const U limitTens = static_cast<U>(limit/10);
+		const unsigned limitDigit = static_cast<unsigned>(limit % 10);
+		U value = 0;
+		for (; it != end; ++it)
+		{
+			unsigned digit = static_cast<unsigned char>(*it) - static_cast<unsigned>('0');
+			if (digit > 9) return false;
+			if (value > limitTens || (value == limitTens && digit > limitDigit)) return false;
+			value = static_cast<U>(value*10 + digit);
+		}
+		r = static_cast<T>(negative ? static_cast<U>(U(0) - value) : value);
+		return true;
+	}
+};
+
+
+template <typename T>
+struct ValueParser<T, false, true>
+	/// Converts a string to a float or double without going
+	/// through a stream, using Poco::strToDouble().
+{
+	static bool parse(const std::string& s, T& r)
+	{
+		if (s.find_first_not_of(" \t\n\r") == std::string::npos) return false;
+
+		double d = Poco::strToDouble(s.c_str());
+		if (d != d) return false; // NaN signals an invalid number
+		r = static_cast<T>(d);
+		return true;
+	}
+};
+
+
+} // namespace Impl
+
+
 template <typename T>
 struct DefaultValueTraits
 {
@@ -91,8 +172,7 @@ template <typename T>
 T DefaultValueTraits<T>::parse(std::string s, const XMLStreamParser& p)
 {
 	T r;
-	std::istringstream is(s);
-	if (!(is >> r && is.eof()))
+	if (!Impl::ValueParser<T>::parse(s, r))
 		throw XMLStreamParserException(p, "invalid value '" + s + "'");
 	return r;
 }
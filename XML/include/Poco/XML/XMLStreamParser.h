@@ -30,6 +30,7 @@
 #include "Poco/XML/QName.h"
 #include "Poco/XML/ValueTraits.h"
 #include "Poco/XML/Content.h"
+#include "Poco/StringRef.h"
 #if defined(POCO_UNBUNDLED)
 #include <expat.h>
 #else
@@ -69,6 +70,12 @@ class XML_API XMLStreamParser
 	/// the map is still valid after peek() that returned end_element until
 	/// this end_element event is retrieved with next().
 	///
+	/// Character data is not copied unless needed. valueRef() returns
+	/// a reference to the characters in the Expat buffer, which is valid
+	/// until the next call to next() or peek(). The characters are only
+	/// copied if Expat reports them in several pieces (e.g., because they
+	/// contain line breaks or entity references), or if value() is called.
+	///
 	/// Using parser:
 	///
 	///     XMLStreamParser p(ifs, argv[1]);
@@ -122,7 +129,85 @@ public:
 		mutable bool handled;
 	};
 
-	typedef std::map<QName, AttributeValueType> AttributeMapType;
+	class XML_API AttributeMapType
+		/// A flat map of attribute names to values, with the
+		/// interface of a std::map<QName, AttributeValueType>.
+		///
+		/// Attributes are kept in a vector, sorted by name like
+		/// in a std::map, which is faster than a tree for the few
+		/// attributes of a typical element. Entries are reused for
+		/// subsequent elements, so once the parser has seen a few
+		/// elements, it no longer allocates memory for attributes.
+		///
+		/// Unlike with a std::map, inserting an attribute invalidates
+		/// iterators and references to other attributes. The names
+		/// of the attributes must not be changed through an iterator.
+	{
+	public:
+		typedef QName key_type;
+		typedef AttributeValueType mapped_type;
+		typedef std::pair<QName, AttributeValueType> value_type;
+		typedef std::vector<value_type>::size_type size_type;
+		typedef std::vector<value_type>::iterator iterator;
+		typedef std::vector<value_type>::const_iterator const_iterator;
+
+		AttributeMapType();
+			/// Creates an empty AttributeMapType.
+
+		iterator begin();
+		const_iterator begin() const;
+			/// Returns an iterator to the first attribute.
+
+		iterator end();
+		const_iterator end() const;
+			/// Returns the end iterator.
+
+		iterator find(const QName& qname);
+		const_iterator find(const QName& qname) const;
+			/// Returns an iterator to the attribute with the given
+			/// name, or end() if there is no such attribute.
+
+		iterator lower_bound(const QName& qname);
+		const_iterator lower_bound(const QName& qname) const;
+			/// Returns an iterator to the first attribute whose
+			/// name is not less than the given name.
+
+		iterator upper_bound(const QName& qname);
+		const_iterator upper_bound(const QName& qname) const;
+			/// Returns an iterator to the first attribute whose
+			/// name is greater than the given name.
+
+		size_type count(const QName& qname) const;
+			/// Returns 1 if the attribute with the given name
+			/// exists, otherwise 0.
+
+		AttributeValueType& at(const QName& qname);
+		const AttributeValueType& at(const QName& qname) const;
+			/// Returns the value of the attribute with the given name.
+			/// Throws a std::out_of_range if there is no such attribute.
+
+		AttributeValueType& operator [] (const QName& qname);
+			/// Returns the value of the attribute with the given name,
+			/// inserting an empty, unhandled value if there is no
+			/// such attribute.
+
+		size_type size() const;
+			/// Returns the number of attributes.
+
+		bool empty() const;
+			/// Returns true if there are no attributes.
+
+	private:
+		value_type& add();
+		void sort();
+		void clear();
+
+		std::vector<value_type> _entries;
+		size_type _size;
+
+		friend class XMLStreamParser;
+	};
+
 
 	struct XML_API Iterator
 		// C++11 range-based for support. Generally, the iterator interface
@@ -216,6 +301,12 @@ public:
 	const std::string& prefix() const;
 	std::string& value();
 	const std::string& value() const;
+	StringRef valueRef() const;
+		/// Returns a reference to the characters of the current
+		/// EV_CHARACTERS event, without copying them.
+		///
+		/// The returned reference is only valid until the next
+		/// call to next() or peek().
 	template <typename T> T value() const;
 	Poco::UInt64 line() const;
 	Poco::UInt64 column() const;
@@ -279,6 +370,7 @@ private:
 	EventType nextImpl(bool peek);
 	EventType nextBody();
 	void handleError();
+	void copyValue() const;
 
 	// If _size is 0, then data is std::istream. Otherwise, it is a buffer.
 	union
@@ -301,6 +393,8 @@ private:
 	std::string _value;
 	const QName* _qualifiedName;
 	std::string* _pvalue;
+	mutable StringRef _valueRef;
+	mutable bool _valuePending; // Whether _valueRef has not been copied to _value yet.
 	Poco::UInt64 _line;
 	Poco::UInt64 _column;
 
@@ -331,17 +425,21 @@ private:
 
 		std::size_t depth;
 		Content content;
-		AttributeMapType attributeMap;
 		mutable AttributeMapType::size_type attributesUnhandled;
 	};
 
 	typedef std::vector<ElementEntry> ElementState;
 	std::vector<ElementEntry> _elementState;
 
+	typedef std::vector<AttributeMapType> AttributeMaps;
+	AttributeMaps _attributeMaps; // The attributes of each entry in _elementState.
+
 	const AttributeMapType _emptyAttrMap;
 
 	const ElementEntry* getElement() const;
 	const ElementEntry* getElementImpl() const;
+	const AttributeMapType& elementAttributes(const ElementEntry* e) const;
+	void pushElement(std::size_t depth, Content c = Content::Mixed);
 	void popElement();
 };
 
@@ -391,16 +489,24 @@ inline const std::string& XMLStreamParser::prefix() const
 
 inline std::string& XMLStreamParser::value()
 {
+	if (_valuePending) copyValue();
 	return *_pvalue;
 }
 
 
 inline const std::string& XMLStreamParser::value() const
 {
+	if (_valuePending) copyValue();
 	return *_pvalue;
 }
 
 
+inline StringRef XMLStreamParser::valueRef() const
+{
+	return _valuePending ? _valueRef : StringRef(*_pvalue);
+}
+
+
 inline Poco::UInt64 XMLStreamParser::line() const
 {
 	return _line;
@@ -477,7 +583,7 @@ inline const XMLStreamParser::AttributeMapType& XMLStreamParser::attributeMap()
 	if (const ElementEntry* e = getElement())
 	{
 		e->attributesUnhandled = 0; // Assume all handled.
-		return e->attributeMap;
+		return elementAttributes(e);
 	}
 
 	return _emptyAttrMap;
@@ -575,7 +681,7 @@ inline void XMLStreamParser::content(Content c)
 	if (!_elementState.empty() && _elementState.back().depth == _depth)
 		_elementState.back().content = c;
 	else
-		_elementState.push_back(ElementEntry(_depth, c));
+		pushElement(_depth, c);
 }
 
 
@@ -593,14 +699,83 @@ inline const XMLStreamParser::ElementEntry* XMLStreamParser::getElement() const
 }
 
 
+inline const XMLStreamParser::AttributeMapType& XMLStreamParser::elementAttributes(const ElementEntry* e) const
+{
+	return _attributeMaps[e - &_elementState.front()];
+}
+
+
+inline XMLStreamParser::AttributeMapType::iterator XMLStreamParser::AttributeMapType::begin()
+{
+	return _entries.begin();
+}
+
+
+inline XMLStreamParser::AttributeMapType::const_iterator XMLStreamParser::AttributeMapType::begin() const
+{
+	return _entries.begin();
+}
+
+
+inline XMLStreamParser::AttributeMapType::iterator XMLStreamParser::AttributeMapType::end()
+{
+	return _entries.begin() + _size;
+}
+
+
+inline XMLStreamParser::AttributeMapType::const_iterator XMLStreamParser::AttributeMapType::end() const
+{
+	return _entries.begin() + _size;
+}
+
+
+inline XMLStreamParser::AttributeMapType::iterator XMLStreamParser::AttributeMapType::find(const QName& qname)
+{
+	iterator i(lower_bound(qname));
+	return i != end() && !(qname < i->first) ? i : end();
+}
+
+
+inline XMLStreamParser::AttributeMapType::const_iterator XMLStreamParser::AttributeMapType::find(const QName& qname) const
+{
+	const_iterator i(lower_bound(qname));
+	return i != end() && !(qname < i->first) ? i : end();
+}
+
+
+inline XMLStreamParser::AttributeMapType::size_type XMLStreamParser::AttributeMapType::count(const QName& qname) const
+{
+	return find(qname) != end() ? 1 : 0;
+}
+
+
+inline XMLStreamParser::AttributeMapType::size_type XMLStreamParser::AttributeMapType::size() const
+{
+	return _size;
+}
+
+
+inline bool XMLStreamParser::AttributeMapType::empty() const
+{
+	return _size == 0;
+}
+
+
+inline void XMLStreamParser::AttributeMapType::clear()
+{
+	_size = 0;
+}
+
+
 template <typename T>
 T XMLStreamParser::attribute(const QName& qn, const T& dv) const
 {
 	if (const ElementEntry* e = getElement())
 	{
-		AttributeMapType::const_iterator i(e->attributeMap.find(qn));
+		const AttributeMapType& attributes(elementAttributes(e));
+		AttributeMapType::const_iterator i(attributes.find(qn));
 
-		if (i != e->attributeMap.end())
+		if (i != attributes.end())
 		{
 			if (!i->second.handled)
 			{
@@ -45,8 +45,15 @@ AbstractContainerNode::AbstractContainerNode(Document* pOwnerDocument, const Abs
 
 
 AbstractContainerNode::~AbstractContainerNode()
+{
+	releaseChildren();
+}
+
+
+void AbstractContainerNode::releaseChildren()
 {
 	AbstractNode* pChild = static_cast<AbstractNode*>(_pFirstChild);
+	_pFirstChild = 0;
 	while (pChild)
 	{
 		AbstractNode* pDelNode = pChild;
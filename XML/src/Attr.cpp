@@ -126,7 +126,7 @@ XMLString Attr::innerText() const
 
 Node* Attr::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new Attr(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<Attr>(*this);
 }
 
 
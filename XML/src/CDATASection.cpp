@@ -67,7 +67,7 @@ unsigned short CDATASection::nodeType() const
 
 Node* CDATASection::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new CDATASection(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<CDATASection>(*this);
 }
 
 
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/Comment.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -53,7 +54,7 @@ unsigned short Comment::nodeType() const
 
 Node* Comment::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new Comment(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<Comment>(*this);
 }
 
 
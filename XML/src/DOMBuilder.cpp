@@ -44,7 +44,8 @@ DOMBuilder::DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool):
 	_pParent(0),
 	_pPrevious(0),
 	_inCDATA(false),
-	_namespaces(true)
+	_namespaces(true),
+	_allocation(Document::ALLOC_HEAP)
 {
 	_xmlReader.setContentHandler(this);
 	_xmlReader.setDTDHandler(this);
@@ -60,6 +61,12 @@ DOMBuilder::~DOMBuilder()
 }
 
 
+void DOMBuilder::setAllocation(Document::Allocation allocation)
+{
+	_allocation = allocation;
+}
+
+
 Document* DOMBuilder::parse(const XMLString& uri)
 {
 	setupParse();
@@ -128,7 +135,7 @@ Document* DOMBuilder::parseMemoryNP(const char* xml, std::size_t size)
 
 void DOMBuilder::setupParse()
 {
-	_pDocument  = new Document(_pNamePool);
+	_pDocument  = new Document(_pNamePool, _allocation);
 	_pParent    = _pDocument;
 	_pPrevious  = 0;
 	_inCDATA    = false;
@@ -194,7 +201,7 @@ void DOMBuilder::startElement(const XMLString& uri, const XMLString& localName,
 	Attr* pPrevAttr = 0;
 	for (AttributesImpl::iterator it = attrs.begin(); it != attrs.end(); ++it)
 	{
-		AutoPtr<Attr> pAttr = new Attr(_pDocument, 0, it->namespaceURI, it->localName, it->qname, it->value, it->specified);
+		AutoPtr<Attr> pAttr = _pDocument->createNode<Attr>(static_cast<Element*>(0), it->namespaceURI, it->localName, it->qname, it->value, it->specified);
 		pPrevAttr = pElem->addAttributeNodeNP(pPrevAttr, pAttr);
 	}
 	appendNode(pElem);
@@ -270,7 +277,7 @@ void DOMBuilder::skippedEntity(const XMLString& name)
 
 void DOMBuilder::startDTD(const XMLString& name, const XMLString& publicId, const XMLString& systemId)
 {
-	AutoPtr<DocumentType> pDoctype = new DocumentType(_pDocument, name, publicId, systemId);
+	AutoPtr<DocumentType> pDoctype = _pDocument->createNode<DocumentType>(name, publicId, systemId);
 	_pDocument->setDoctype(pDoctype);
 }
 
@@ -19,7 +19,9 @@ namespace Poco {
 namespace XML {
 
 
-DOMObject::DOMObject(): _rc(1)
+DOMObject::DOMObject():
+	_rc(1),
+	_inArena(false)
 {
 }
 
@@ -25,11 +25,13 @@ namespace XML {
 
 
 const XMLString DOMParser::FEATURE_FILTER_WHITESPACE = toXMLString("http://www.appinf.com/features/no-whitespace-in-element-content");
+const XMLString DOMParser::FEATURE_ARENA_ALLOCATION = toXMLString("http://www.appinf.com/features/arena-allocation");
 
 
 DOMParser::DOMParser(NamePool* pNamePool):
 	_pNamePool(pNamePool),
-	_filterWhitespace(false)
+	_filterWhitespace(false),
+	_arenaAllocation(false)
 {
 	if (_pNamePool) _pNamePool->duplicate();
 	_saxParser.setFeature(XMLReader::FEATURE_NAMESPACES, true);
@@ -39,7 +41,8 @@ DOMParser::DOMParser(NamePool* pNamePool):
 
 DOMParser::DOMParser(unsigned long namePoolSize):
 	_pNamePool(new NamePool(namePoolSize)),
-	_filterWhitespace(false)
+	_filterWhitespace(false),
+	_arenaAllocation(false)
 {
 	_saxParser.setFeature(XMLReader::FEATURE_NAMESPACES, true);
 	_saxParser.setFeature(XMLReader::FEATURE_NAMESPACE_PREFIXES, true);
@@ -74,6 +77,8 @@ void DOMParser::setFeature(const XMLString& name, bool state)
 {
 	if (name == FEATURE_FILTER_WHITESPACE)
 		_filterWhitespace = state;
+	else if (name == FEATURE_ARENA_ALLOCATION)
+		_arenaAllocation = state;
 	else
 		_saxParser.setFeature(name, state);
 }
@@ -83,22 +88,38 @@ bool DOMParser::getFeature(const XMLString& name) const
 {
 	if (name == FEATURE_FILTER_WHITESPACE)
 		return _filterWhitespace;
+	else if (name == FEATURE_ARENA_ALLOCATION)
+		return _arenaAllocation;
 	else
 		return _saxParser.getFeature(name);
 }
 
 
+void DOMParser::setBufferSize(std::size_t size)
+{
+	_saxParser.setBufferSize(size);
+}
+
+
+std::size_t DOMParser::getBufferSize() const
+{
+	return _saxParser.getBufferSize();
+}
+
+
 Document* DOMParser::parse(const XMLString& uri)
 {
 	if (_filterWhitespace)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parse(uri);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parse(uri);
 	}
 }
@@ -110,11 +131,13 @@ Document* DOMParser::parse(InputSource* pInputSource)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parse(pInputSource);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parse(pInputSource);
 	}
 }
@@ -132,11 +155,13 @@ Document* DOMParser::parseMemory(const char* xml, std::size_t size)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parseMemoryNP(xml, size);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setAllocation(allocation());
 		return builder.parseMemoryNP(xml, size);
 	}
 }
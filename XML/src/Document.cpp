@@ -36,12 +36,17 @@ namespace XML {
 
 
 const XMLString Document::NODE_NAME = toXMLString("#document");
+const std::size_t Document::BLOCK_SIZE;
 
 
 Document::Document(NamePool* pNamePool):
 	AbstractContainerNode(0),
 	_pDocumentType(0),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_allocation(ALLOC_HEAP),
+	_pFree(0),
+	_available(0),
+	_arenaSize(0)
 {
 	if (pNamePool)
 	{
@@ -59,7 +64,11 @@ Document::Document(unsigned long namePoolSize):
 	AbstractContainerNode(0),
 	_pDocumentType(0),
 	_pNamePool(new NamePool(namePoolSize)),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_allocation(ALLOC_HEAP),
+	_pFree(0),
+	_available(0),
+	_arenaSize(0)
 {
 }
 
@@ -67,7 +76,11 @@ Document::Document(unsigned long namePoolSize):
 Document::Document(DocumentType* pDocumentType, NamePool* pNamePool):
 	AbstractContainerNode(0),
 	_pDocumentType(pDocumentType),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_allocation(ALLOC_HEAP),
+	_pFree(0),
+	_available(0),
+	_arenaSize(0)
 {
 	if (pNamePool)
 	{
@@ -90,7 +103,11 @@ Document::Document(DocumentType* pDocumentType, unsigned long namePoolSize):
 	AbstractContainerNode(0),
 	_pDocumentType(pDocumentType),
 	_pNamePool(new NamePool(namePoolSize)),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_allocation(ALLOC_HEAP),
+	_pFree(0),
+	_available(0),
+	_arenaSize(0)
 {
 	if (_pDocumentType)
 	{
@@ -100,10 +117,69 @@ Document::Document(DocumentType* pDocumentType, unsigned long namePoolSize):
 }
 
 
+Document::Document(NamePool* pNamePool, Allocation allocation):
+	AbstractContainerNode(0),
+	_pDocumentType(0),
+	_eventSuspendLevel(0),
+	_allocation(allocation),
+	_pFree(0),
+	_available(0),
+	_arenaSize(0)
+{
+	if (pNamePool)
+	{
+		_pNamePool = pNamePool;
+		_pNamePool->duplicate();
+	}
+	else
+	{
+		_pNamePool = new NamePool;
+	}
+}
+
+
 Document::~Document()
 {
+	if (_allocation == ALLOC_ARENA)
+	{
+		// Nodes in the arena must be destroyed before the arena,
+		// and thus before the base class destructor runs.
+		releaseChildren();
+		_autoReleasePool.release();
+	}
 	if (_pDocumentType) _pDocumentType->release();
 	_pNamePool->release();
+	for (std::vector<char*>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		delete [] *it;
+	}
+}
+
+
+void* Document::allocate(std::size_t size, std::size_t alignment)
+{
+	std::size_t padding = (alignment - reinterpret_cast<std::size_t>(_pFree) % alignment) % alignment;
+	if (size + padding > _available)
+	{
+		if (size > BLOCK_SIZE/4)
+		{
+			// large nodes get a block of their own, so that
+			// the remainder of the current block is not wasted
+			char* pBlock = new char[size];
+			_blocks.push_back(pBlock);
+			_arenaSize += size;
+			return pBlock;
+		}
+		_pFree = new char[BLOCK_SIZE];
+		_blocks.push_back(_pFree);
+		_available = BLOCK_SIZE;
+		_arenaSize += BLOCK_SIZE;
+		padding = 0;
+	}
+	char* p = _pFree + padding;
+	_pFree     += padding + size;
+	_available -= padding + size;
+	return p;
 }
 
 
@@ -155,49 +231,49 @@ Element* Document::documentElement() const
 
 Element* Document::createElement(const XMLString& tagName) const
 {
-	return new Element(const_cast<Document*>(this), EMPTY_STRING, EMPTY_STRING, tagName);
+	return createNode<Element>(EMPTY_STRING, EMPTY_STRING, tagName);
 }
 
 
 DocumentFragment* Document::createDocumentFragment() const
 {
-	return new DocumentFragment(const_cast<Document*>(this));
+	return createNode<DocumentFragment>();
 }
 
 
 Text* Document::createTextNode(const XMLString& data) const
 {
-	return new Text(const_cast<Document*>(this), data);
+	return createNode<Text>(data);
 }
 
 
 Comment* Document::createComment(const XMLString& data) const
 {
-	return new Comment(const_cast<Document*>(this), data);
+	return createNode<Comment>(data);
 }
 
 
 CDATASection* Document::createCDATASection(const XMLString& data) const
 {
-	return new CDATASection(const_cast<Document*>(this), data);
+	return createNode<CDATASection>(data);
 }
 
 
 ProcessingInstruction* Document::createProcessingInstruction(const XMLString& target, const XMLString& data) const
 {
-	return new ProcessingInstruction(const_cast<Document*>(this), target, data);
+	return createNode<ProcessingInstruction>(target, data);
 }
 
 
 Attr* Document::createAttribute(const XMLString& name) const
 {
-	return new Attr(const_cast<Document*>(this), 0, EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING);
+	return createNode<Attr>(static_cast<Element*>(0), EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING);
 }
 
 
 EntityReference* Document::createEntityReference(const XMLString& name) const
 {
-	return new EntityReference(const_cast<Document*>(this), name);
+	return createNode<EntityReference>(name);
 }
 
 
@@ -227,13 +303,13 @@ Node* Document::importNode(Node* importedNode, bool deep)
 
 Element* Document::createElementNS(const XMLString& namespaceURI, const XMLString& qualifiedName) const
 {
-	return new Element(const_cast<Document*>(this), namespaceURI, Name::localName(qualifiedName), qualifiedName);
+	return createNode<Element>(namespaceURI, Name::localName(qualifiedName), qualifiedName);
 }
 
 
 Attr* Document::createAttributeNS(const XMLString& namespaceURI, const XMLString& qualifiedName) const
 {
-	return new Attr(const_cast<Document*>(this), 0, namespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING);
+	return createNode<Attr>(static_cast<Element*>(0), namespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING);
 }
 
 
@@ -297,13 +373,13 @@ bool Document::events() const
 
 Entity* Document::createEntity(const XMLString& name, const XMLString& publicId, const XMLString& systemId, const XMLString& notationName) const
 {
-	return new Entity(const_cast<Document*>(this), name, publicId, systemId, notationName);
+	return createNode<Entity>(name, publicId, systemId, notationName);
 }
 
 
 Notation* Document::createNotation(const XMLString& name, const XMLString& publicId, const XMLString& systemId) const
 {
-	return new Notation(const_cast<Document*>(this), name, publicId, systemId);
+	return createNode<Notation>(name, publicId, systemId);
 }
 
 
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/DocumentFragment.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -53,7 +54,7 @@ unsigned short DocumentFragment::nodeType() const
 
 Node* DocumentFragment::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	DocumentFragment* pClone = new DocumentFragment(pOwnerDocument, *this);
+	DocumentFragment* pClone = pOwnerDocument->createNode<DocumentFragment>(*this);
 	if (deep)
 	{
 		Node* pCur = firstChild();
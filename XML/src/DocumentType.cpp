@@ -77,7 +77,10 @@ const XMLString& DocumentType::internalSubset() const
 
 Node* DocumentType::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new DocumentType(pOwnerDocument, *this);
+	if (pOwnerDocument)
+		return pOwnerDocument->createNode<DocumentType>(*this);
+	else
+		return new DocumentType(0, *this);
 }
 
 
@@ -389,7 +389,7 @@ void Element::dispatchNodeInsertedIntoDocument()
 
 Node* Element::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	Element* pClone = new Element(pOwnerDocument, *this);
+	Element* pClone = pOwnerDocument->createNode<Element>(*this);
 	if (deep)
 	{
 		Node* pNode = firstChild();
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/Entity.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -61,7 +62,7 @@ unsigned short Entity::nodeType() const
 
 Node* Entity::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new Entity(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<Entity>(*this);
 }
 
 
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/EntityReference.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -52,7 +53,7 @@ unsigned short EntityReference::nodeType() const
 
 Node* EntityReference::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new EntityReference(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<EntityReference>(*this);
 }
 
 
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/Notation.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -56,7 +57,7 @@ unsigned short Notation::nodeType() const
 
 Node* Notation::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new Notation(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<Notation>(*this);
 }
 
 
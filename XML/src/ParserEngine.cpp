@@ -27,7 +27,13 @@
 #include "Poco/SAX/LocatorImpl.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/URI.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/Exception.h"
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 
 using Poco::URI;
@@ -85,12 +91,13 @@ const XMLString ParserEngine::EMPTY_STRING;
 
 ParserEngine::ParserEngine():
 	_parser(0),
-	_pBuffer(0),
+	_bufferSize(DEFAULT_BUFFER_SIZE),
 	_encodingSpecified(false),
 	_expandInternalEntities(true),
 	_externalGeneralEntities(false),
 	_externalParameterEntities(false),
 	_enablePartialReads(false),
+	_enableMemoryMapping(true),
 	_pNamespaceStrategy(new NoNamespacesStrategy()),
 	_pEntityResolver(0),
 	_pDTDHandler(0),
@@ -104,13 +111,14 @@ ParserEngine::ParserEngine():
 
 ParserEngine::ParserEngine(const XMLString& encoding):
 	_parser(0),
-	_pBuffer(0),
+	_bufferSize(DEFAULT_BUFFER_SIZE),
 	_encodingSpecified(true),
 	_encoding(encoding),
 	_expandInternalEntities(true),
 	_externalGeneralEntities(false),
 	_externalParameterEntities(false),
 	_enablePartialReads(false),
+	_enableMemoryMapping(true),
 	_pNamespaceStrategy(new NoNamespacesStrategy()),
 	_pEntityResolver(0),
 	_pDTDHandler(0),
@@ -126,7 +134,6 @@ ParserEngine::~ParserEngine()
 {
 	resetContext();
 	if (_parser) XML_ParserFree(_parser);
-	delete [] _pBuffer;
 	delete _pNamespaceStrategy;
 }
 
@@ -218,6 +225,20 @@ void ParserEngine::setEnablePartialReads(bool flag)
 }
 
 
+void ParserEngine::setBufferSize(std::size_t size)
+{
+	if (size == 0) throw Poco::InvalidArgumentException("XML parser buffer size must not be zero");
+
+	_bufferSize = size;
+}
+
+
+void ParserEngine::setEnableMemoryMapping(bool flag)
+{
+	_enableMemoryMapping = flag;
+}
+
+
 void ParserEngine::parse(InputSource* pInputSource)
 {
 	init();
@@ -243,51 +264,66 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 	pushContext(_parser, &src);
 	if (_pContentHandler) _pContentHandler->setDocumentLocator(this);
 	if (_pContentHandler) _pContentHandler->startDocument();
-	std::size_t processed = 0;
-	while (processed < size)
-	{
-		const int bufferSize = processed + PARSE_BUFFER_SIZE < size ? PARSE_BUFFER_SIZE : static_cast<int>(size - processed);
-		if (!XML_Parse(_parser, pBuffer + processed, bufferSize, 0))
-			handleError(XML_GetErrorCode(_parser));
-		processed += bufferSize;
-	}
-	if (!XML_Parse(_parser, pBuffer+processed, 0, 1))
-		handleError(XML_GetErrorCode(_parser));
+	parseBuffer(pBuffer, size);
 	if (_pContentHandler) _pContentHandler->endDocument();
 	popContext();
 }
 
 
-void ParserEngine::parseByteInputStream(XMLByteInputStream& istr)
+void ParserEngine::parseFile(const std::string& path, const XMLString& systemId)
 {
-	std::streamsize n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
-	while (n > 0)
+	Poco::File file(path);
+	if (_enableMemoryMapping && file.exists() && file.isFile() && file.getSize() > _bufferSize)
 	{
-		if (!XML_Parse(_parser, _pBuffer, static_cast<int>(n), 0))
-			handleError(XML_GetErrorCode(_parser));
-		if (istr.good())
-			n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
-		else
-			n = 0;
+		Poco::SharedMemory mem(file, Poco::SharedMemory::AM_READ);
+		if (mem.begin())
+		{
+			init();
+			resetContext();
+			InputSource src(systemId);
+			pushContext(_parser, &src);
+			if (_pContentHandler) _pContentHandler->setDocumentLocator(this);
+			if (_pContentHandler) _pContentHandler->startDocument();
+			parseBuffer(mem.begin(), mem.end() - mem.begin());
+			if (_pContentHandler) _pContentHandler->endDocument();
+			popContext();
+			return;
+		}
 	}
-	if (!XML_Parse(_parser, _pBuffer, 0, 1))
-		handleError(XML_GetErrorCode(_parser));
+	Poco::FileInputStream istr(path);
+	InputSource src(systemId);
+	src.setByteStream(istr);
+	parse(&src);
+}
+
+
+void ParserEngine::parseByteInputStream(XMLByteInputStream& istr)
+{
+	parseBytes(_parser, istr);
 }
 
 
 void ParserEngine::parseCharInputStream(XMLCharInputStream& istr)
 {
-	std::streamsize n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), PARSE_BUFFER_SIZE/sizeof(XMLChar));
-	while (n > 0)
+	parseChars(_parser, istr);
+}
+
+
+void ParserEngine::parseBuffer(const char* pBuffer, std::size_t size)
+{
+	// expat copies the input into its own buffer, which grows
+	// to the size of the largest block, so large buffers are
+	// passed in blocks of the configured size.
+	const std::size_t blockSize = std::min<std::size_t>(_bufferSize, std::numeric_limits<int>::max());
+	std::size_t processed = 0;
+	while (processed < size)
 	{
-		if (!XML_Parse(_parser, _pBuffer, static_cast<int>(n*sizeof(XMLChar)), 0))
+		const int n = static_cast<int>(std::min(blockSize, size - processed));
+		if (!XML_Parse(_parser, pBuffer + processed, n, 0))
 			handleError(XML_GetErrorCode(_parser));
-		if (istr.good())
-			n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), PARSE_BUFFER_SIZE/sizeof(XMLChar));
-		else
-			n = 0;
+		processed += n;
 	}
-	if (!XML_Parse(_parser, _pBuffer, 0, 1))
+	if (!XML_Parse(_parser, pBuffer + processed, 0, 1))
 		handleError(XML_GetErrorCode(_parser));
 }
 
@@ -306,55 +342,58 @@ void ParserEngine::parseExternal(XML_Parser extParser, InputSource* pInputSource
 
 void ParserEngine::parseExternalByteInputStream(XML_Parser extParser, XMLByteInputStream& istr)
 {
-	char *pBuffer = new char[PARSE_BUFFER_SIZE];
-	try
-	{
-		std::streamsize n = readBytes(istr, pBuffer, PARSE_BUFFER_SIZE);
-		while (n > 0)
-		{
-			if (!XML_Parse(extParser, pBuffer, static_cast<int>(n), 0))
-				handleError(XML_GetErrorCode(extParser));
-			if (istr.good())
-				n = readBytes(istr, pBuffer, PARSE_BUFFER_SIZE);
-			else
-				n = 0;
-		}
-		if (!XML_Parse(extParser, pBuffer, 0, 1))
-			handleError(XML_GetErrorCode(extParser));
-	}
-	catch (...)
+	parseBytes(extParser, istr);
+}
+
+
+void ParserEngine::parseExternalCharInputStream(XML_Parser extParser, XMLCharInputStream& istr)
+{
+	parseChars(extParser, istr);
+}
+
+
+void ParserEngine::parseBytes(XML_Parser parser, XMLByteInputStream& istr)
+{
+	const std::size_t maxBlockSize = std::min<std::size_t>(_bufferSize, std::numeric_limits<int>::max());
+	std::size_t blockSize = std::min<std::size_t>(PARSE_BUFFER_SIZE, maxBlockSize);
+	for (;;)
 	{
-		delete [] pBuffer;
-		throw;
+		char* pBuffer = static_cast<char*>(XML_GetBuffer(parser, static_cast<int>(blockSize)));
+		if (!pBuffer)
+			handleError(XML_GetErrorCode(parser));
+		std::streamsize n = readBytes(istr, pBuffer, static_cast<std::streamsize>(blockSize));
+		if (n <= 0) break;
+		if (!XML_ParseBuffer(parser, static_cast<int>(n), 0))
+			handleError(XML_GetErrorCode(parser));
+		if (!istr.good()) break;
+		if (static_cast<std::size_t>(n) == blockSize && blockSize < maxBlockSize)
+			blockSize = std::min(2*blockSize, maxBlockSize);
 	}
-	delete [] pBuffer;
+	if (!XML_Parse(parser, 0, 0, 1))
+		handleError(XML_GetErrorCode(parser));
 }
 
 
-void ParserEngine::parseExternalCharInputStream(XML_Parser extParser, XMLCharInputStream& istr)
+void ParserEngine::parseChars(XML_Parser parser, XMLCharInputStream& istr)
 {
-	XMLChar *pBuffer = new XMLChar[PARSE_BUFFER_SIZE/sizeof(XMLChar)];
-	try
+	const std::size_t maxBlockSize = std::max<std::size_t>(std::min<std::size_t>(_bufferSize, std::numeric_limits<int>::max())/sizeof(XMLChar), 1);
+	std::size_t blockSize = std::min<std::size_t>(PARSE_BUFFER_SIZE/sizeof(XMLChar), maxBlockSize);
+	std::vector<XMLChar> buffer(blockSize);
+	for (;;)
 	{
-		std::streamsize n = readChars(istr, pBuffer, PARSE_BUFFER_SIZE/sizeof(XMLChar));
-		while (n > 0)
+		std::streamsize n = readChars(istr, &buffer[0], static_cast<std::streamsize>(blockSize));
+		if (n <= 0) break;
+		if (!XML_Parse(parser, reinterpret_cast<const char*>(&buffer[0]), static_cast<int>(n*sizeof(XMLChar)), 0))
+			handleError(XML_GetErrorCode(parser));
+		if (!istr.good()) break;
+		if (static_cast<std::size_t>(n) == blockSize && blockSize < maxBlockSize)
 		{
-			if (!XML_Parse(extParser, reinterpret_cast<char*>(pBuffer), static_cast<int>(n*sizeof(XMLChar)), 0))
-				handleError(XML_GetErrorCode(extParser));
-			if (istr.good())
-				n = readChars(istr, pBuffer, static_cast<int>(PARSE_BUFFER_SIZE/sizeof(XMLChar)));
-			else
-				n = 0;
+			blockSize = std::min(2*blockSize, maxBlockSize);
+			buffer.resize(blockSize);
 		}
-		if (!XML_Parse(extParser, reinterpret_cast<char*>(pBuffer), 0, 1))
-			handleError(XML_GetErrorCode(extParser));
-	}
-	catch (...)
-	{
-		delete [] pBuffer;
-		throw;
 	}
-	delete [] pBuffer;
+	if (!XML_Parse(parser, 0, 0, 1))
+		handleError(XML_GetErrorCode(parser));
 }
 
 
@@ -442,9 +481,6 @@ void ParserEngine::init()
 	if (_parser)
 		XML_ParserFree(_parser);
 
-	if (!_pBuffer)
-		_pBuffer  = new char[PARSE_BUFFER_SIZE];
-
 	if (dynamic_cast<NoNamespacePrefixesStrategy*>(_pNamespaceStrategy))
 	{
 		_parser = XML_ParserCreateNS(_encodingSpecified ? _encoding.c_str() : 0, '\t');
@@ -13,6 +13,7 @@
 
 
 #include "Poco/DOM/ProcessingInstruction.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -72,7 +73,7 @@ unsigned short ProcessingInstruction::nodeType() const
 
 Node* ProcessingInstruction::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new ProcessingInstruction(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<ProcessingInstruction>(*this);
 }
 
 
@@ -17,6 +17,9 @@
 #include "Poco/SAX/EntityResolverImpl.h"
 #include "Poco/SAX/InputSource.h"
 #include "Poco/XML/NamespaceStrategy.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Path.h"
+#include "Poco/URI.h"
 #include <sstream>
 
 
@@ -25,6 +28,41 @@ namespace XML {
 
 
 const XMLString SAXParser::FEATURE_PARTIAL_READS = toXMLString("http://www.appinf.com/features/enable-partial-reads");
+const XMLString SAXParser::FEATURE_MEMORY_MAPPING = toXMLString("http://www.appinf.com/features/enable-memory-mapping");
+const XMLString SAXParser::PROPERTY_BUFFER_SIZE = toXMLString("http://www.appinf.com/properties/buffer-size");
+
+
+namespace
+{
+	bool isLocalFile(const XMLString& systemId, std::string& path)
+		/// Returns true and the path if the systemId denotes a file,
+		/// using the same rules as Poco::URIStreamOpener.
+	{
+		std::string sid = fromXMLString(systemId);
+		Poco::Path p;
+		try
+		{
+			Poco::URI uri(sid);
+			if (uri.getScheme() == "file")
+			{
+				std::string uriPath = uri.getPath();
+				if (uriPath.compare(0, 2, "./") == 0) uriPath.erase(0, 2);
+				if (!p.tryParse(uriPath, Poco::Path::PATH_UNIX)) return false;
+				p.setNode(uri.getHost());
+			}
+			else if (uri.getScheme().length() > 1 || !p.tryParse(sid, Poco::Path::PATH_GUESS))
+			{
+				return false;
+			}
+		}
+		catch (Poco::URISyntaxException&)
+		{
+			if (!p.tryParse(sid, Poco::Path::PATH_GUESS)) return false;
+		}
+		path = p.toString();
+		return true;
+	}
+}
 
 
 SAXParser::SAXParser():
@@ -127,6 +165,8 @@ void SAXParser::setFeature(const XMLString& featureId, bool state)
 		_namespacePrefixes = state;
 	else if (featureId == FEATURE_PARTIAL_READS)
 		_engine.setEnablePartialReads(state);
+	else if (featureId == FEATURE_MEMORY_MAPPING)
+		_engine.setEnableMemoryMapping(state);
 	else throw SAXNotRecognizedException(fromXMLString(featureId));
 }
 
@@ -145,13 +185,17 @@ bool SAXParser::getFeature(const XMLString& featureId) const
 		return _namespacePrefixes;
 	else if (featureId == FEATURE_PARTIAL_READS)
 		return _engine.getEnablePartialReads();
+	else if (featureId == FEATURE_MEMORY_MAPPING)
+		return _engine.getEnableMemoryMapping();
 	else throw SAXNotRecognizedException(fromXMLString(featureId));
 }
 
 
-void SAXParser::setProperty(const XMLString& propertyId, const XMLString& /*value*/)
+void SAXParser::setProperty(const XMLString& propertyId, const XMLString& value)
 {
-	if (propertyId == XMLReader::PROPERTY_DECLARATION_HANDLER || propertyId == XMLReader::PROPERTY_LEXICAL_HANDLER)
+	if (propertyId == PROPERTY_BUFFER_SIZE)
+		_engine.setBufferSize(Poco::NumberParser::parseUnsigned64(fromXMLString(value)));
+	else if (propertyId == XMLReader::PROPERTY_DECLARATION_HANDLER || propertyId == XMLReader::PROPERTY_LEXICAL_HANDLER)
 		throw SAXNotSupportedException(std::string("property does not take a string value: ") + fromXMLString(propertyId));
 	else
 		throw SAXNotRecognizedException(fromXMLString(propertyId));
@@ -192,6 +236,12 @@ void SAXParser::parse(InputSource* pInputSource)
 void SAXParser::parse(const XMLString& systemId)
 {
 	setupParse();
+	std::string path;
+	if (isLocalFile(systemId, path))
+	{
+		_engine.parseFile(path, systemId);
+		return;
+	}
 	EntityResolverImpl entityResolver;
 	InputSource* pInputSource = entityResolver.resolveEntity(0, systemId);
 	if (pInputSource)
@@ -217,6 +267,18 @@ void SAXParser::parseString(const std::string& xml)
 }
 
 
+void SAXParser::setBufferSize(std::size_t size)
+{
+	_engine.setBufferSize(size);
+}
+
+
+std::size_t SAXParser::getBufferSize() const
+{
+	return _engine.getBufferSize();
+}
+
+
 void SAXParser::parseMemoryNP(const char* xml, std::size_t size)
 {
 	setupParse();
@@ -73,7 +73,7 @@ XMLString Text::innerText() const
 
 Node* Text::copyNode(bool /*deep*/, Document* pOwnerDocument) const
 {
-	return new Text(pOwnerDocument, *this);
+	return pOwnerDocument->createNode<Text>(*this);
 }
 
 
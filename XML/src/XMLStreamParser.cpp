@@ -17,6 +17,8 @@
 
 #include "Poco/XML/XMLStreamParser.h"
 #include <new>
+#include <algorithm>
+#include <stdexcept>
 #include <cstring>
 #include <istream>
 #include <ostream>
@@ -85,6 +87,91 @@ std::ostream& operator << (std::ostream& os, XMLStreamParser::EventType e)
 }
 
 
+XMLStreamParser::AttributeMapType::AttributeMapType():
+	_size(0)
+{
+}
+
+
+XMLStreamParser::AttributeMapType::iterator XMLStreamParser::AttributeMapType::lower_bound(const QName& qn)
+{
+	return std::lower_bound(begin(), end(), qn, [](const value_type& v, const QName& n) { return v.first < n; });
+}
+
+
+XMLStreamParser::AttributeMapType::const_iterator XMLStreamParser::AttributeMapType::lower_bound(const QName& qn) const
+{
+	return std::lower_bound(begin(), end(), qn, [](const value_type& v, const QName& n) { return v.first < n; });
+}
+
+
+XMLStreamParser::AttributeMapType::iterator XMLStreamParser::AttributeMapType::upper_bound(const QName& qn)
+{
+	return std::upper_bound(begin(), end(), qn, [](const QName& n, const value_type& v) { return n < v.first; });
+}
+
+
+XMLStreamParser::AttributeMapType::const_iterator XMLStreamParser::AttributeMapType::upper_bound(const QName& qn) const
+{
+	return std::upper_bound(begin(), end(), qn, [](const QName& n, const value_type& v) { return n < v.first; });
+}
+
+
+XMLStreamParser::AttributeValueType& XMLStreamParser::AttributeMapType::at(const QName& qn)
+{
+	iterator i(find(qn));
+	if (i == end())
+		throw std::out_of_range("attribute " + qn.toString() + " not found");
+	return i->second;
+}
+
+
+const XMLStreamParser::AttributeValueType& XMLStreamParser::AttributeMapType::at(const QName& qn) const
+{
+	const_iterator i(find(qn));
+	if (i == end())
+		throw std::out_of_range("attribute " + qn.toString() + " not found");
+	return i->second;
+}
+
+
+XMLStreamParser::AttributeValueType& XMLStreamParser::AttributeMapType::operator [] (const QName& qn)
+{
+	iterator i(lower_bound(qn));
+	if (i != end() && !(qn < i->first))
+		return i->second;
+
+	size_type pos(i - begin());
+	value_type& value(add());
+	value.first = qn;
+	value.second.value.clear();
+	value.second.handled = false;
+	std::rotate(begin() + pos, end() - 1, end());
+	return _entries[pos].second;
+}
+
+
+XMLStreamParser::AttributeMapType::value_type& XMLStreamParser::AttributeMapType::add()
+{
+	// Reuse a previous entry, if any, so that its strings
+	// keep their capacity.
+	//
+	if (_size == _entries.size())
+		_entries.push_back(value_type());
+
+	return _entries[_size++];
+}
+
+
+void XMLStreamParser::AttributeMapType::sort()
+{
+	// Expat reports attributes in document order, but they are
+	// iterated over in the order of a std::map.
+	//
+	std::sort(begin(), end(), [](const value_type& x, const value_type& y) { return x.first < y.first; });
+}
+
+
 XMLStreamParser::XMLStreamParser(std::istream& is, const std::string& iname, FeatureType f):
 	_size(0),
 	_inputName(iname),
@@ -122,6 +209,7 @@ void XMLStreamParser::init()
 
 	_qualifiedName = &_qname;
 	_pvalue = &_value;
+	_valuePending = false;
 
 	_line = 0;
 	_column = 0;
@@ -189,6 +277,16 @@ void XMLStreamParser::handleError()
 }
 
 
+void XMLStreamParser::copyValue() const
+{
+	// Characters are only referenced, not copied, for element
+	// content, so _pvalue points to _value.
+	//
+	_pvalue->assign(_valueRef.data(), _valueRef.size());
+	_valuePending = false;
+}
+
+
 XMLStreamParser::EventType XMLStreamParser::next()
 {
 	if (_parserState == state_next)
@@ -227,9 +325,10 @@ const std::string& XMLStreamParser::attribute(const QName& qn) const
 {
 	if (const ElementEntry* e = getElement())
 	{
-		AttributeMapType::const_iterator i(e->attributeMap.find(qn));
+		const AttributeMapType& attributes(elementAttributes(e));
+		AttributeMapType::const_iterator i(attributes.find(qn));
 
-		if (i != e->attributeMap.end())
+		if (i != attributes.end())
 		{
 			if (!i->second.handled)
 			{
@@ -248,9 +347,10 @@ std::string XMLStreamParser::attribute(const QName& qn, const std::string& dv) c
 {
 	if (const ElementEntry* e = getElement())
 	{
-		AttributeMapType::const_iterator i(e->attributeMap.find(qn));
+		const AttributeMapType& attributes(elementAttributes(e));
+		AttributeMapType::const_iterator i(attributes.find(qn));
 
-		if (i != e->attributeMap.end())
+		if (i != attributes.end())
 		{
 			if (!i->second.handled)
 			{
@@ -269,9 +369,10 @@ bool XMLStreamParser::attributePresent(const QName& qn) const
 {
 	if (const ElementEntry* e = getElement())
 	{
-		AttributeMapType::const_iterator i(e->attributeMap.find(qn));
+		const AttributeMapType& attributes(elementAttributes(e));
+		AttributeMapType::const_iterator i(attributes.find(qn));
 
-		if (i != e->attributeMap.end())
+		if (i != attributes.end())
 		{
 			if (!i->second.handled)
 			{
@@ -358,6 +459,17 @@ const XMLStreamParser::ElementEntry* XMLStreamParser::getElementImpl() const
 }
 
 
+void XMLStreamParser::pushElement(std::size_t depth, Content c)
+{
+	_elementState.push_back(ElementEntry(depth, c));
+
+	if (_attributeMaps.size() < _elementState.size())
+		_attributeMaps.resize(_elementState.size());
+
+	_attributeMaps[_elementState.size() - 1].clear();
+}
+
+
 void XMLStreamParser::popElement()
 {
 	// Make sure there are no unhandled attributes left.
@@ -367,7 +479,8 @@ void XMLStreamParser::popElement()
 	{
 		// Find the first unhandled attribute and report it.
 		//
-		for (AttributeMapType::const_iterator i(e.attributeMap.begin()); i != e.attributeMap.end(); ++i)
+		const AttributeMapType& attributes(elementAttributes(&e));
+		for (AttributeMapType::const_iterator i(attributes.begin()); i != attributes.end(); ++i)
 		{
 			if (!i->second.handled)
 				throw XMLStreamParserException(*this, "unexpected attribute '" + i->first.toString() + "'");
@@ -484,6 +597,7 @@ XMLStreamParser::EventType XMLStreamParser::nextBody()
 		{
 			_currentEvent = EV_CHARACTERS;
 			_pvalue = &_attributes[_currentAttributeIndex].value;
+			_valuePending = false;
 			return _currentEvent;
 		}
 		case EV_CHARACTERS:
@@ -562,9 +676,12 @@ XMLStreamParser::EventType XMLStreamParser::nextBody()
 		return _currentEvent;
 	}
 
-	// Reset the character accumulation flag.
+	// Reset the character accumulation flag. Characters of the
+	// previous event that have not been copied become invalid
+	// once Expat continues.
 	//
 	_accumulateContent = false;
+	_valuePending = false;
 
 	XML_ParsingStatus ps;
 	XML_GetParsingStatus(_parser, &ps);
@@ -635,6 +752,12 @@ XMLStreamParser::EventType XMLStreamParser::nextBody()
 		{
 			const size_t cap(4096);
 
+			// Getting the buffer may move the data of the current chunk,
+			// so characters accumulated so far must be copied now.
+			//
+			if (_valuePending)
+				copyValue();
+
 			char* b(static_cast<char*>(XML_GetBuffer(_parser, cap)));
 			if (b == 0)
 				throw std::bad_alloc();
@@ -753,10 +876,12 @@ void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name,
 		// Provision an entry for this element.
 		//
 		ElementEntry* pe(0);
+		AttributeMapType* pm(0);
 		if (am)
 		{
-			p._elementState.push_back(ElementEntry(p._depth + 1));
+			p.pushElement(p._depth + 1);
 			pe = &p._elementState.back();
+			pm = &p._attributeMaps[p._elementState.size() - 1];
 		}
 
 		if (am || ae)
@@ -765,12 +890,10 @@ void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name,
 			{
 				if (am)
 				{
-					QName qn;
-					splitName(*atts, qn);
-					AttributeMapType::value_type value(qn, AttributeValueType());
+					AttributeMapType::value_type& value(pm->add());
+					splitName(*atts, value.first);
 					value.second.value = *(atts + 1);
 					value.second.handled = false;
-					pe->attributeMap.insert(value);
 				}
 				else
 				{
@@ -781,7 +904,10 @@ void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name,
 			}
 
 			if (am)
-				pe->attributesUnhandled = pe->attributeMap.size();
+			{
+				pm->sort();
+				pe->attributesUnhandled = pm->size();
+			}
 		}
 	}
 
@@ -877,12 +1003,31 @@ void XMLCALL XMLStreamParser::handleCharacters(void* v, const XML_Char* s, int n
 	if (p._accumulateContent || ps.parsing != XML_PARSING)
 	{
 		poco_assert(p._currentEvent == EV_CHARACTERS);
+		if (p._valuePending)
+			p.copyValue();
 		p._value.append(s, n);
 	}
 	else
 	{
 		p._currentEvent = EV_CHARACTERS;
-		p._value.assign(s, n);
+
+		// Only reference the characters if they are in the Expat buffer.
+		// Characters that Expat has converted (e.g., line breaks and
+		// character references) are in temporary storage.
+		//
+		int offset(0);
+		int size(0);
+		const char* pBuffer(XML_GetInputContext(p._parser, &offset, &size));
+		if (pBuffer != 0 && s >= pBuffer && s + n <= pBuffer + size)
+		{
+			p._valueRef = StringRef(s, n);
+			p._valuePending = true;
+		}
+		else
+		{
+			p._value.assign(s, n);
+			p._valuePending = false;
+		}
 
 		p._line = XML_GetCurrentLineNumber(p._parser);
 		p._column = XML_GetCurrentColumnNumber(p._parser);
@@ -262,6 +262,49 @@ void DocumentTest::testElementByIdNS()
 }
 
 
+void DocumentTest::testArena()
+{
+	AutoPtr<Document> pDoc1 = new Document;
+	AutoPtr<Element> pRoot1 = pDoc1->createElement("root");
+	pDoc1->appendChild(pRoot1);
+	for (int i = 0; i < 1000; i++)
+	{
+		AutoPtr<Element> pElem = pDoc1->createElement("elem");
+		pElem->setAttribute("id", "a long attribute value, which does not fit into a short string");
+		AutoPtr<Text> pText = pDoc1->createTextNode("text");
+		pElem->appendChild(pText);
+		pRoot1->appendChild(pElem);
+	}
+	assertTrue (pDoc1->allocation() == Document::ALLOC_HEAP);
+	assertTrue (pDoc1->arenaSize() == 0);
+
+	AutoPtr<Document> pDoc2 = new Document(0, Document::ALLOC_ARENA);
+	assertTrue (pDoc2->allocation() == Document::ALLOC_ARENA);
+	AutoPtr<Element> pRoot2 = static_cast<Element*>(pDoc2->importNode(pRoot1, true));
+	pDoc2->appendChild(pRoot2);
+	assertTrue (pDoc2->arenaSize() >= 3000*sizeof(Text));
+	assertTrue (pRoot2->ownerDocument() == pDoc2);
+
+	AutoPtr<NodeList> pList = pDoc2->getElementsByTagName("elem");
+	assertTrue (pList->length() == 1000);
+	Element* pElem = static_cast<Element*>(pList->item(999));
+	assertTrue (pElem->getAttribute("id") == "a long attribute value, which does not fit into a short string");
+	assertTrue (pElem->innerText() == "text");
+
+	pRoot2->removeChild(pRoot2->firstChild())->release();
+	assertTrue (pList->length() == 999);
+
+	AutoPtr<Element> pClone = static_cast<Element*>(pElem->cloneNode(true));
+	assertTrue (pClone->innerText() == "text");
+	pDoc2->autoReleasePool().add(pDoc2->createElement("garbage"));
+
+	pClone = 0;
+	pList = 0;
+	pRoot2 = 0;
+	pDoc2 = 0;
+}
+
+
 void DocumentTest::setUp()
 {
 }
@@ -283,6 +326,7 @@ CppUnit::Test* DocumentTest::suite()
 	CppUnit_addTest(pSuite, DocumentTest, testElementsByTagNameNS);
 	CppUnit_addTest(pSuite, DocumentTest, testElementById);
 	CppUnit_addTest(pSuite, DocumentTest, testElementByIdNS);
+	CppUnit_addTest(pSuite, DocumentTest, testArena);
 
 	return pSuite;
 }
@@ -31,6 +31,7 @@ public:
 	void testElementsByTagNameNS();
 	void testElementById();
 	void testElementByIdNS();
+	void testArena();
 
 	void setUp();
 	void tearDown();
@@ -104,6 +104,25 @@ void ParserWriterTest::testParseWriteSimple()
 }
 
 
+void ParserWriterTest::testParseWriteArena()
+{
+	std::ostringstream ostr;
+
+	DOMParser parser;
+	parser.setFeature(XMLReader::FEATURE_NAMESPACE_PREFIXES, false);
+	parser.setFeature(DOMParser::FEATURE_ARENA_ALLOCATION, true);
+	assertTrue (parser.getFeature(DOMParser::FEATURE_ARENA_ALLOCATION));
+	DOMWriter writer;
+	AutoPtr<Document> pDoc = parser.parseString(XHTML);
+	assertTrue (pDoc->allocation() == Document::ALLOC_ARENA);
+	assertTrue (pDoc->arenaSize() > 0);
+	writer.writeNode(ostr, pDoc);
+
+	std::string xml = ostr.str();
+	assertTrue (xml == XHTML);
+}
+
+
 void ParserWriterTest::setUp()
 {
 }
@@ -121,6 +140,7 @@ CppUnit::Test* ParserWriterTest::suite()
 	CppUnit_addTest(pSuite, ParserWriterTest, testParseWriteXHTML);
 	CppUnit_addTest(pSuite, ParserWriterTest, testParseWriteXHTML2);
 	CppUnit_addTest(pSuite, ParserWriterTest, testParseWriteSimple);
+	CppUnit_addTest(pSuite, ParserWriterTest, testParseWriteArena);
 
 	return pSuite;
 }
@@ -28,6 +28,7 @@ public:
 	void testParseWriteXHTML2();
 	void testParseWriteWSDL();
 	void testParseWriteSimple();
+	void testParseWriteArena();
 
 	void setUp();
 	void tearDown();
@@ -19,6 +19,8 @@
 #include "Poco/XML/XMLWriter.h"
 #include "Poco/Latin9Encoding.h"
 #include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Path.h"
 #include <sstream>
 
 
@@ -313,6 +315,83 @@ void SAXParserTest::testParsePartialReads()
 }
 
 
+void SAXParserTest::testParseFile()
+{
+	Poco::TemporaryFile tempFile;
+	{
+		Poco::FileOutputStream ostr(tempFile.path());
+		ostr << WSDL;
+	}
+
+	SAXParser parser;
+	assertTrue (parser.getFeature(SAXParser::FEATURE_MEMORY_MAPPING));
+	parser.setBufferSize(512);
+
+	std::ostringstream ostr1;
+	XMLWriter writer1(ostr1, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT);
+	writer1.setNewLine(XMLWriter::NEWLINE_LF);
+	parser.setContentHandler(&writer1);
+	parser.setDTDHandler(&writer1);
+	parser.setProperty(XMLReader::PROPERTY_LEXICAL_HANDLER, static_cast<Poco::XML::LexicalHandler*>(&writer1));
+	parser.parse(tempFile.path());
+	assertTrue (ostr1.str() == WSDL);
+
+	parser.setFeature(SAXParser::FEATURE_MEMORY_MAPPING, false);
+	assertTrue (!parser.getFeature(SAXParser::FEATURE_MEMORY_MAPPING));
+	std::ostringstream ostr2;
+	XMLWriter writer2(ostr2, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT);
+	writer2.setNewLine(XMLWriter::NEWLINE_LF);
+	parser.setContentHandler(&writer2);
+	parser.setDTDHandler(&writer2);
+	parser.setProperty(XMLReader::PROPERTY_LEXICAL_HANDLER, static_cast<Poco::XML::LexicalHandler*>(&writer2));
+	parser.parse("file://" + Poco::Path(tempFile.path()).makeAbsolute().toString(Poco::Path::PATH_UNIX));
+	assertTrue (ostr2.str() == WSDL);
+
+	parser.setFeature(SAXParser::FEATURE_MEMORY_MAPPING, true);
+	Poco::TemporaryFile badFile;
+	{
+		Poco::FileOutputStream ostr(badFile.path());
+		ostr << WSDL.substr(0, WSDL.size() - 10);
+	}
+	try
+	{
+		parser.parse(badFile.path());
+		fail("incomplete document - must throw");
+	}
+	catch (SAXParseException& exc)
+	{
+		assertTrue (exc.getSystemId() == badFile.path());
+	}
+}
+
+
+void SAXParserTest::testBufferSize()
+{
+	SAXParser parser;
+	assertTrue (parser.getBufferSize() == Poco::XML::ParserEngine::DEFAULT_BUFFER_SIZE);
+
+	parser.setBufferSize(1);
+	std::string xml = parse(parser, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT, WSDL);
+	assertTrue (xml == WSDL);
+	xml = parseMemory(parser, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT, WSDL);
+	assertTrue (xml == WSDL);
+
+	parser.setProperty(SAXParser::PROPERTY_BUFFER_SIZE, XMLString("1000"));
+	assertTrue (parser.getBufferSize() == 1000);
+	xml = parse(parser, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT, WSDL);
+	assertTrue (xml == WSDL);
+
+	try
+	{
+		parser.setBufferSize(0);
+		fail("zero buffer size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
 void SAXParserTest::setUp()
 {
 }
@@ -378,6 +457,8 @@ CppUnit::Test* SAXParserTest::suite()
 	CppUnit_addTest(pSuite, SAXParserTest, testCharacters);
 	CppUnit_addTest(pSuite, SAXParserTest, testParseMemory);
 	CppUnit_addTest(pSuite, SAXParserTest, testParsePartialReads);
+	CppUnit_addTest(pSuite, SAXParserTest, testParseFile);
+	CppUnit_addTest(pSuite, SAXParserTest, testBufferSize);
 
 	return pSuite;
 }
@@ -48,6 +48,8 @@ public:
 	void testParseMemory();
 	void testCharacters();
 	void testParsePartialReads();
+	void testParseFile();
+	void testBufferSize();
 
 	void setUp();
 	void tearDown();
@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 
 using namespace Poco::XML;
@@ -483,6 +485,157 @@ void XMLStreamParserTest::testParser()
 }
 
 
+void XMLStreamParserTest::testValueRef()
+{
+	// Characters in a single piece are referenced, others are copied.
+	//
+	{
+		std::istringstream is("<root><a>abc</a><b>x&amp;y</b><c>1\n2</c></root>");
+		XMLStreamParser p(is, "test");
+
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "root", Content::Complex);
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "a");
+		p.nextExpect(XMLStreamParser::EV_CHARACTERS);
+		assertTrue (p.valueRef() == "abc");
+		const char* pRef = p.valueRef().data();
+		assertTrue (p.value() == "abc");
+		assertTrue (p.valueRef() == "abc");
+		assertTrue (p.valueRef().data() != pRef);
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "b", Content::Simple);
+		p.nextExpect(XMLStreamParser::EV_CHARACTERS);
+		assertTrue (p.valueRef() == "x&y");
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+		assertTrue (p.element("c") == "1\n2");
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+	}
+
+	// Simple content spanning several input chunks.
+	//
+	{
+		std::string text(10000, 'x');
+		for (std::size_t i = 0; i < text.size(); i += 7) text[i] = 'a' + i % 26;
+		std::istringstream is("<root><a>" + text + "</a><b>42</b></root>");
+		XMLStreamParser p(is, "test");
+
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "root", Content::Complex);
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "a", Content::Simple);
+		p.nextExpect(XMLStreamParser::EV_CHARACTERS);
+		assertTrue (p.valueRef() == text);
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+		assertTrue (p.element<int>("b") == 42);
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+	}
+
+	// Attribute map, sorted by name and reused for subsequent elements.
+	//
+	{
+		std::string xml("<root xmlns:n='urn:n'><e n:b='2' c='3' a='1'/><e c='4'/><e/></root>");
+		XMLStreamParser p(xml.data(), xml.size(), "test");
+
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "root", Content::Complex);
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "e");
+		const XMLStreamParser::AttributeMapType& attrs = p.attributeMap();
+		assertTrue (attrs.size() == 3);
+		XMLStreamParser::AttributeMapType::const_iterator it = attrs.begin();
+		assertTrue (it->first == QName("a") && it->second.value == "1");
+		++it;
+		assertTrue (it->first == QName("c") && it->second.value == "3");
+		++it;
+		assertTrue (it->first == QName("urn:n", "b") && it->first.prefix() == "n" && it->second.value == "2");
+		assertTrue (++it == attrs.end());
+		assertTrue (attrs.find(QName("b")) == attrs.end());
+		assertTrue (attrs.count(QName("urn:n", "b")) == 1);
+		assertTrue (attrs.lower_bound(QName("b")) == attrs.find(QName("c")));
+		assertTrue (attrs.upper_bound(QName("c")) == attrs.find(QName("urn:n", "b")));
+		assertTrue (attrs.at(QName("c")).value == "3");
+		try
+		{
+			attrs.at(QName("b"));
+			failmsg("no such attribute - must throw");
+		}
+		catch (const std::out_of_range&)
+		{
+		}
+
+		XMLStreamParser::AttributeMapType copy(attrs);
+		copy[QName("b")].value = "4";
+		copy[QName("a")].value = "5";
+		assertTrue (copy.size() == 4);
+		it = copy.begin();
+		assertTrue (it->first == QName("a") && it->second.value == "5");
+		assertTrue ((++it)->first == QName("b") && it->second.value == "4" && !it->second.handled);
+		assertTrue ((++it)->first == QName("c"));
+		for (XMLStreamParser::AttributeMapType::iterator i = copy.begin(); i != copy.end(); ++i)
+			i->second.value.clear();
+		assertTrue (copy.at(QName("c")).value.empty());
+		assertTrue (attrs.at(QName("c")).value == "3");
+
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "e");
+		assertTrue (p.attribute<int>("c") == 4);
+		assertTrue (!p.attributePresent("a"));
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "e");
+		assertTrue (p.attributeMap().empty());
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+	}
+
+	// Unhandled attributes are still detected.
+	//
+	try
+	{
+		std::istringstream is("<root d='1' c='2' a='3' b='4'/>");
+		XMLStreamParser p(is, "test");
+		p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "root");
+		p.attribute("a");
+		p.nextExpect(XMLStreamParser::EV_END_ELEMENT);
+		failmsg("unexpected attribute - must throw");
+	}
+	catch (const XMLStreamParserException& exc)
+	{
+		// The first unhandled attribute by name is reported.
+		assertTrue (exc.description() == "unexpected attribute 'b'");
+	}
+}
+
+
+void XMLStreamParserTest::testValueTraits()
+{
+	std::string xml("<root i=' -42' u='4294967295' s='-32768' l='-9223372036854775808' d='1.5e3' f='0.25'"
+		" bad1='4294967296' bad2='-1' bad3='12a' bad4='' bad5='128' bad6='1.5x' bad7=' '/>");
+	XMLStreamParser p(xml.data(), xml.size(), "test");
+
+	p.nextExpect(XMLStreamParser::EV_START_ELEMENT, "root");
+	assertTrue (p.attribute<int>("i") == -42);
+	assertTrue (p.attribute<Poco::UInt32>("u") == 4294967295U);
+	assertTrue (p.attribute<short>("s") == -32768);
+	assertTrue (p.attribute<Poco::Int64>("l") == std::numeric_limits<Poco::Int64>::min());
+	assertTrue (p.attribute<double>("d") == 1500.0);
+	assertTrue (p.attribute<float>("f") == 0.25f);
+
+	const char* bad[] = { "bad1", "bad2", "bad3", "bad4", "bad6", "bad7" };
+	for (std::size_t i = 0; i < sizeof(bad)/sizeof(bad[0]); i++)
+	{
+		try
+		{
+			if (std::string(bad[i]) == "bad6" || std::string(bad[i]) == "bad7")
+				p.attribute<double>(bad[i]);
+			else
+				p.attribute<Poco::UInt32>(bad[i]);
+			failmsg(std::string("invalid value must throw: ") + bad[i]);
+		}
+		catch (const XMLStreamParserException&)
+		{
+		}
+	}
+	assertTrue (p.attribute<short>("bad5") == 128);
+}
+
+
 void XMLStreamParserTest::setUp()
 {
 }
@@ -498,6 +651,8 @@ CppUnit::Test* XMLStreamParserTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XMLStreamParserTest");
 
 	CppUnit_addTest(pSuite, XMLStreamParserTest, testParser);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testValueRef);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testValueTraits);
 
 	return pSuite;
 }
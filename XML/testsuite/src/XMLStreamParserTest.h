@@ -25,6 +25,8 @@ public:
 	~XMLStreamParserTest();
 
 	void testParser();
+	void testValueRef();
+	void testValueTraits();
 
 	void setUp();
 	void tearDown();